@@ -32,6 +32,20 @@ class Location : NSObject {
     }
   }
 
+  class var privateCachesURL: URL {
+    get {
+      guard let identifier = Bundle.main.bundleIdentifier else {
+        fatalError("Could not retrieve the main bundle identifier")
+      }
+      guard let searchPath = NSSearchPathForDirectoriesInDomains(
+          .cachesDirectory, .userDomainMask, true).first else {
+        fatalError("Could not retrieve user's caches directory")
+      }
+      return URL(fileURLWithPath: searchPath)
+          .appendingPathComponent(identifier)
+    }
+  }
+
   class var adobeFDKURL: URL {
     return privateLibraryURL.appendingPathComponent("FDK")
   }
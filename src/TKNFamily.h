@@ -0,0 +1,43 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#import <AppKit/AppKit.h>
+
+#import "TKNStroker.h"
+
+typedef void (^TKNFamilyProgressHandler)(NSUInteger, NSUInteger);
+typedef void (^TKNFamilyCompletionHandler)(NSError * _Nullable);
+
+extern NSString * const _Nonnull TKNFamilyErrorDomain;
+
+// A font of a family, which is stroked from the source of the family in the
+// given width and written to the URL, in WOFF when its extension is woff.
+@interface TKNFamilyMember : NSObject
+
+- (nonnull instancetype)initWithURL:(nonnull NSURL *)url;
+
+@property (nonatomic, copy, readonly, nonnull) NSURL *url;
+@property (nonatomic, assign) double strokeWidth;
+@property (nonatomic, assign) double UPEM;
+@property (nonatomic, copy, nullable) NSString *styleName;
+@property (nonatomic, copy, nullable) NSString *fullName;
+@property (nonatomic, copy, nullable) NSString *postscriptName;
+
+@end
+
+// Builds fonts in several widths from a single stroker, which shares its
+// parsed source and kerning with all of them. Glyphs of every width are
+// stroked on one shared pool, whereas the fonts are compiled a limited
+// number at a time.
+@interface TKNFamily : NSObject
+
+- (nonnull instancetype)initWithStroker:(nonnull TKNStroker *)stroker;
+
+@property (nonatomic, strong, readonly, nonnull) TKNStroker *stroker;
+@property (nonatomic, assign) NSUInteger maxConcurrentFontCount;
+
+- (void)createFontsForMembers:(nonnull NSArray<TKNFamilyMember *> *)members
+    progressHandler:(nullable TKNFamilyProgressHandler)progressHandler
+    completionHandler:(nullable TKNFamilyCompletionHandler)completionHandler;
+
+@end
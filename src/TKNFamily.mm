@@ -0,0 +1,110 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#import "TKNFamily.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "token/pipeline.h"
+#include "token/thread_pool.h"
+
+NSString * const TKNFamilyErrorDomain = @"TKNFamilyErrorDomain";
+
+@implementation TKNFamilyMember
+
+- (instancetype)initWithURL:(NSURL *)url {
+  self = [super init];
+  if (self) {
+    _url = [url copy];
+  }
+  return self;
+}
+
+@end
+
+@implementation TKNFamily
+
+- (instancetype)initWithStroker:(TKNStroker *)stroker {
+  self = [super init];
+  if (self) {
+    _stroker = stroker;
+    // Compiling a font mostly waits for its glyphs stroked on the shared
+    // pool, so a few fonts at a time keep the pool busy.
+    _maxConcurrentFontCount = std::max(
+        std::thread::hardware_concurrency() / 4, 1U);
+  }
+  return self;
+}
+
+- (void)createFontsForMembers:(NSArray<TKNFamilyMember *> *)members
+    progressHandler:(TKNFamilyProgressHandler)progressHandler
+    completionHandler:(TKNFamilyCompletionHandler)completionHandler {
+  // Copies of the stroker share the source font, and setting a different
+  // stroke width only clears the caches of the copy.
+  const auto pipeline = std::make_shared<token::Pipeline>();
+  for (TKNFamilyMember *member in members) {
+    TKNStroker *stroker = [_stroker copy];
+    stroker.strokeWidth = member.strokeWidth;
+    if (member.UPEM > 0.0) {
+      stroker.UPEM = member.UPEM;
+    }
+    if (member.styleName) {
+      stroker.styleName = member.styleName;
+    }
+    if (member.fullName) {
+      stroker.fullName = member.fullName;
+    }
+    if (member.postscriptName) {
+      stroker.postscriptName = member.postscriptName;
+    }
+    NSURL *url = member.url;
+    pipeline->add(url.lastPathComponent.UTF8String, [stroker, url] {
+      @autoreleasepool {
+        NSData *data = ([url.pathExtension isEqualToString:@"woff"] ?
+                        [stroker WOFFData] : [stroker openTypeFontData]);
+        return static_cast<bool>([data writeToURL:url atomically:YES]);
+      }
+    });
+  }
+  if (progressHandler) {
+    pipeline->set_progress_handler([progressHandler](
+        const std::string& stage,
+        std::size_t completed,
+        std::size_t total) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        progressHandler(completed, total);
+      });
+    });
+  }
+  const std::size_t concurrency = std::max<NSUInteger>(
+      _maxConcurrentFontCount, 1);
+  dispatch_async(dispatch_get_global_queue(
+      DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
+    token::ThreadPool pool(concurrency);
+    NSError *error = nil;
+    if (!pipeline->run(&pool)) {
+      NSString *description = [NSString stringWithFormat:
+          @"Failed to create %s.", pipeline->failed_stage().c_str()];
+      if (!pipeline->error().empty()) {
+        description = [description stringByAppendingFormat:@" %s",
+            pipeline->error().c_str()];
+      }
+      error = [NSError errorWithDomain:TKNFamilyErrorDomain
+                                  code:0
+                              userInfo:@{
+        NSLocalizedDescriptionKey: description
+      }];
+    }
+    if (completionHandler) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        completionHandler(error);
+      });
+    }
+  });
+}
+
+@end
@@ -3,6 +3,12 @@
 
 #import <AppKit/AppKit.h>
 
+extern NSString * const _Nonnull TKNStrokerErrorDomain;
+
+// The path in saved UFOs to the list of the glyphs that still have overlaps
+// after stroking, one name per line, which only checkOutlinesUFO removes.
+extern NSString * const _Nonnull TKNStrokerOverlappingGlyphsPath;
+
 @interface TKNStroker : NSObject <NSCopying>
 
 // MARK: Opening and Saving
@@ -37,9 +43,33 @@
 - (double)glyphAdvanceForName:(nonnull NSString *)name;
 - (CGRect)glyphBoundsForName:(nonnull NSString *)name;
 
+// The positions of the glyphs along a line, by their advances and the
+// kerning between them. The line width is set to the sum of both.
+- (nonnull NSArray<NSNumber *> *)
+    glyphPositionsForNames:(nonnull NSArray<NSString *> *)names
+                 lineWidth:(nullable double *)lineWidth;
+
+// Coverage masks of glyphs rendered at the scale from units to pixels, which
+// are cached for each stroke width and scale. The bounds are set to the
+// rectangle in units the mask covers.
+- (nullable CGImageRef)glyphImageForName:(nonnull NSString *)name
+                                   scale:(double)scale
+                                  bounds:(nullable CGRect *)bounds
+    CF_RETURNS_NOT_RETAINED;
+
 // MARK: Saving
 
+// Saving fails when any of the glyphs couldn't be stroked, and compiling
+// throws std::runtime_error naming the glyph.
 - (BOOL)saveToURL:(nonnull NSURL *)url
             error:(NSError * _Nullable * _Nullable)error;
+- (nonnull NSData *)compactFontFormatData;
+- (nonnull NSData *)openTypeFontData;
+- (nonnull NSData *)WOFFData;
+
+// Fonts only with the glyphs needed to render the text, which are the only
+// glyphs stroked and compiled.
+- (nonnull NSData *)openTypeFontDataForText:(nonnull NSString *)text;
+- (nonnull NSData *)WOFFDataForText:(nonnull NSString *)text;
 
 @end
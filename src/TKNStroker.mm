@@ -5,40 +5,144 @@
 
 #include <cassert>
 #include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
 #include <iterator>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 #include <unordered_map>
-
-#include <boost/filesystem.hpp>
+#include <utility>
+#include <vector>
 
 #include "shotamatsuda/graphics.h"
 #include "shotamatsuda/math.h"
+#include "token/afdko/hinting.h"
+#include "token/cff.h"
+#include "token/glyph_atlas.h"
 #include "token/glyph_outline.h"
 #include "token/glyph_stroker.h"
+#include "token/outline_validator.h"
+#include "token/sfnt.h"
+#include "token/snapshot.h"
+#include "token/text_layout.h"
+#include "token/thread_pool.h"
 #include "token/ufo.h"
 
 namespace shota = shotamatsuda;
 
+NSString * const TKNStrokerErrorDomain = @"TKNStrokerErrorDomain";
+NSString * const TKNStrokerOverlappingGlyphsPath =
+    @"data/com.shotamatsuda.token.overlaps";
+
+namespace {
+
+token::ThreadPool& sharedThreadPool() {
+  static token::ThreadPool pool;
+  return pool;
+}
+
+// The results of stroking a glyph, which are computed apart from the caches
+// of strokers so that glyphs can be stroked in parallel. The error is set
+// to the reason when the glyph couldn't be stroked.
+struct StrokedGlyph final {
+  token::GlyphOutline outline;
+  shota::Shape2d shape;
+  token::ufo::glif::Advance advance;
+  std::vector<token::ufo::glif::Anchor> anchors;
+  bool overlapping;
+  std::string error;
+};
+
+StrokedGlyph strokeGlyph(const token::GlyphStroker& stroker,
+                         const token::ufo::FontInfo& fontInfo,
+                         const token::ufo::Glyph& glyph,
+                         const token::Snapshot::Outlines *sourceOutlines) {
+  StrokedGlyph result{};
+  bool found{};
+  if (sourceOutlines) {
+    const auto source = sourceOutlines->find(glyph.name);
+    if (source != std::end(*sourceOutlines)) {
+      result.outline = source->second;
+      found = true;
+    }
+  }
+  try {
+    if (!found) {
+      result.outline = token::GlyphOutline(glyph);
+    }
+    auto pair = stroker(fontInfo, glyph, result.outline);
+    result.anchors = stroker.anchors(
+        fontInfo, glyph, result.outline, pair.first);
+    // Fix what checkOutlinesUFO would otherwise fix after saving, and leave
+    // only the overlaps to it.
+    result.overlapping = !token::OutlineValidator()(&pair.first).clean();
+    result.shape = std::move(pair.first);
+    result.advance = pair.second;
+  } catch (const std::exception& e) {
+    result.error = e.what();
+    if (result.error.empty()) {
+      result.error = "Unknown error.";
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
 @interface TKNStroker () {
  @private
   token::ufo::FontInfo _fontInfo;
-  token::ufo::Glyphs _glyphs;
+  std::shared_ptr<const token::ufo::Glyphs> _glyphs;
+  std::shared_ptr<const token::Snapshot::Outlines> _sourceOutlines;
+  std::shared_future<std::shared_ptr<const token::sfnt::KerningCompiler>>
+      _kerningCompiler;
+  std::shared_future<std::shared_ptr<const token::ufo::GlyphIndex>>
+      _glyphIndex;
   std::unordered_map<std::string, token::GlyphOutline> _glyphOutlines;
   std::unordered_map<std::string, shota::Shape2d> _glyphShapes;
   std::unordered_map<std::string, shota::Rect2d> _glyphBounds;
   std::unordered_map<std::string, token::ufo::glif::Advance> _glyphAdvances;
+  std::unordered_map<std::string, std::vector<token::ufo::glif::Anchor>>
+      _glyphAnchors;
+  std::unordered_map<std::string, bool> _glyphOverlaps;
+  std::unordered_map<std::string, std::string> _glyphErrors;
   NSMutableDictionary *_glyphBezierPaths;
+  token::GlyphAtlas _glyphAtlas;
+  std::unordered_map<const token::GlyphAtlas::Region *, id> _glyphImages;
+  std::size_t _glyphImagesGeneration;
+  std::unique_ptr<token::TextLayout> _textLayout;
 }
 
+// MARK: Snapshot
+
++ (NSString *)snapshotPathForURL:(NSURL *)url;
+
 // MARK: Glyphs
 
 - (BOOL)strokeGlyph:(const token::ufo::Glyph&)glyph;
+- (void)strokeGlyphsInSubset:(const token::ufo::Subset *)subset;
+- (std::vector<const token::ufo::Glyph *>)glyphsInSubset:
+    (const token::ufo::Subset *)subset;
+- (token::GlyphStroker)glyphStroker;
+- (BOOL)storeStrokedGlyph:(StrokedGlyph&&)glyph
+                  forName:(const std::string&)name;
+- (void)checkStrokedGlyphForName:(const std::string&)name;
 - (NSBezierPath *)bezierPathWithShape:(const shota::Shape2d&)shape;
 
 // MARK: Exporting
 
-- (BOOL)saveFontInfoAtPath:(const std::string&)path;
-- (BOOL)saveGlyphsAtPath:(const std::string&)path;
+- (token::sfnt::Font)openTypeFontWithSubset:
+    (const token::ufo::Subset *)subset;
+- (token::cff::Font)compactFontWithBuilder:(token::sfnt::Builder *)builder
+                                    subset:(const token::ufo::Subset *)subset;
+- (token::ufo::FontInfo)strokedFontInfo;
+- (BOOL)saveFontInfoWithSaver:(token::ufo::Saver *)saver;
+- (BOOL)saveGlyphsWithSaver:(token::ufo::Saver *)saver;
+- (BOOL)saveOverlappingGlyphsWithSaver:(token::ufo::Saver *)saver;
 
 @end
 
@@ -47,8 +151,49 @@ namespace shota = shotamatsuda;
 - (instancetype)initWithContentsOfURL:(nonnull NSURL *)url {
   self = [super init];
   if (self) {
-    _fontInfo = token::ufo::FontInfo(url.path.UTF8String);
-    _glyphs = token::ufo::Glyphs(url.path.UTF8String);
+    // The source font is shared between copies because it is never modified.
+    // It comes from the snapshot when it is up to date, otherwise glyphs keep
+    // being parsed in the background after initialization, and a new snapshot
+    // is written once they are all parsed.
+    const std::string path(url.path.UTF8String);
+    const std::string snapshotPath(
+        [[self class] snapshotPathForURL:url].UTF8String);
+    auto snapshot = std::make_shared<token::Snapshot>();
+    if (snapshot->open(snapshotPath, path)) {
+      _fontInfo = snapshot->font_info;
+      _glyphs = std::shared_ptr<const token::ufo::Glyphs>(
+          snapshot, &snapshot->glyphs);
+      _sourceOutlines = std::shared_ptr<const token::Snapshot::Outlines>(
+          snapshot, &snapshot->outlines);
+    } else {
+      const auto loader = std::make_shared<token::ufo::Loader>(
+          path, &sharedThreadPool());
+      _fontInfo = *loader->font_info().get();
+      _glyphs = std::shared_ptr<const token::ufo::Glyphs>(
+          loader, &loader->glyphs());
+      sharedThreadPool().enqueue([loader, path, snapshotPath] {
+        // The pool runs tasks in order, so that the glyphs enqueued by the
+        // loader are already taken by other workers when this starts.
+        loader->wait();
+        token::Snapshot snapshot;
+        snapshot.font_info = *loader->font_info().get();
+        snapshot.glyphs = loader->glyphs();
+        snapshot.save(snapshotPath, path);
+      });
+    }
+    // Kerning is compiled from the source, which the stroked UFO shares. It
+    // is read once when first needed, and shared between copies.
+    _kerningCompiler = std::async(std::launch::deferred, [path] {
+      return std::make_shared<const token::sfnt::KerningCompiler>(
+          token::ufo::Kerning(path), token::ufo::Groups(path));
+    }).share();
+    // The index of characters is built on the first subset, and shared
+    // between copies as well.
+    const auto glyphs = _glyphs;
+    _glyphIndex = std::async(std::launch::deferred, [glyphs] {
+      return std::make_shared<const token::ufo::GlyphIndex>(
+          *glyphs, &sharedThreadPool());
+    }).share();
     _glyphBezierPaths = [NSMutableDictionary dictionary];
     _styleName = [NSString stringWithUTF8String:
         _fontInfo.style_name.c_str()];
@@ -68,11 +213,19 @@ namespace shota = shotamatsuda;
   TKNStroker *copy = [[[self class] allocWithZone:zone] init];
   copy->_fontInfo = _fontInfo;
   copy->_glyphs = _glyphs;
+  copy->_sourceOutlines = _sourceOutlines;
+  copy->_kerningCompiler = _kerningCompiler;
+  copy->_glyphIndex = _glyphIndex;
   copy->_glyphOutlines = _glyphOutlines;
   copy->_glyphShapes = _glyphShapes;
   copy->_glyphBounds = _glyphBounds;
   copy->_glyphAdvances = _glyphAdvances;
+  copy->_glyphAnchors = _glyphAnchors;
+  copy->_glyphOverlaps = _glyphOverlaps;
+  copy->_glyphErrors = _glyphErrors;
   copy->_glyphBezierPaths = [_glyphBezierPaths copy];
+  // The atlas and the layout are left to the original, which is the one
+  // drawing previews.
   copy->_url = [_url copy];
   copy->_strokeWidth = _strokeWidth;
   copy->_strokePrecision = _strokePrecision;
@@ -95,6 +248,9 @@ namespace shota = shotamatsuda;
     _glyphShapes.clear();
     _glyphBounds.clear();
     _glyphAdvances.clear();
+    _glyphAnchors.clear();
+    _glyphOverlaps.clear();
+    _glyphErrors.clear();
     [_glyphBezierPaths removeAllObjects];
   }
 }
@@ -136,12 +292,44 @@ namespace shota = shotamatsuda;
   return _fontInfo.open_type_hhea_line_gap;
 }
 
+// MARK: Snapshot
+
++ (NSString *)snapshotPathForURL:(NSURL *)url {
+  // Store the snapshot next to the UFO, unless the UFO is a resource of the
+  // application or its directory is not writable.
+  NSString *name = [url.lastPathComponent.stringByDeletingPathExtension
+      stringByAppendingPathExtension:@"tknsnapshot"];
+  NSString *directory = url.path.stringByDeletingLastPathComponent;
+  NSString *resourcePath = [NSBundle mainBundle].resourcePath;
+  NSFileManager *fileManager = [NSFileManager defaultManager];
+  if (![directory hasPrefix:resourcePath] &&
+      [fileManager isWritableFileAtPath:directory]) {
+    return [directory stringByAppendingPathComponent:name];
+  }
+  NSURL *cachesURL = [fileManager URLForDirectory:NSCachesDirectory
+                                         inDomain:NSUserDomainMask
+                                appropriateForURL:nil
+                                           create:YES
+                                            error:nil];
+  NSString *bundleIdentifier = [NSBundle mainBundle].bundleIdentifier;
+  if (bundleIdentifier) {
+    cachesURL = [cachesURL URLByAppendingPathComponent:bundleIdentifier];
+  }
+  [fileManager createDirectoryAtURL:cachesURL
+        withIntermediateDirectories:YES
+                         attributes:nil
+                              error:nil];
+  return [cachesURL URLByAppendingPathComponent:name].path;
+}
+
 // MARK: Glyphs
 
 - (NSBezierPath *)glyphBezierPathForName:(NSString *)name {
   [self strokeGlyphForName:name];
   const auto shape = _glyphShapes.find(name.UTF8String);
-  assert(shape != std::end(_glyphShapes));
+  if (shape == std::end(_glyphShapes)) {
+    return nil;
+  }
   auto bezierPath = [self bezierPathWithShape:shape->second];
   _glyphBezierPaths[name] = bezierPath;
   return bezierPath;
@@ -161,37 +349,184 @@ namespace shota = shotamatsuda;
   return static_cast<CGRect>(bounds->second);
 }
 
+- (NSArray<NSNumber *> *)glyphPositionsForNames:(NSArray<NSString *> *)names
+                                     lineWidth:(double *)lineWidth {
+  if (!_textLayout) {
+    const auto kerningCompiler = _kerningCompiler.get();
+    _textLayout = std::make_unique<token::TextLayout>(
+        kerningCompiler->kerning, kerningCompiler->groups);
+  }
+  std::vector<std::string> glyphNames;
+  for (NSString *name in names) {
+    glyphNames.emplace_back(name.UTF8String);
+  }
+  const auto& run = (*_textLayout)(
+      glyphNames, _strokeWidth, [self](const std::string& name) {
+        [self strokeGlyphForName:@(name.c_str())];
+        const auto advance = _glyphAdvances.find(name);
+        assert(advance != std::end(_glyphAdvances));
+        return advance->second.width;
+      });
+  NSMutableArray<NSNumber *> *positions =
+      [NSMutableArray arrayWithCapacity:run.glyphs.size()];
+  for (const auto& glyph : run.glyphs) {
+    [positions addObject:@(glyph.position)];
+  }
+  if (lineWidth) {
+    *lineWidth = run.width;
+  }
+  return positions;
+}
+
+- (CGImageRef)glyphImageForName:(NSString *)name
+                          scale:(double)scale
+                         bounds:(CGRect *)bounds {
+  [self strokeGlyphForName:name];
+  const std::string glyphName(name.UTF8String);
+  auto region = _glyphAtlas.find(glyphName, _strokeWidth, scale);
+  if (!region) {
+    const auto shape = _glyphShapes.find(glyphName);
+    if (shape == std::end(_glyphShapes)) {
+      return nil;
+    }
+    region = _glyphAtlas.insert(glyphName, _strokeWidth, scale, shape->second);
+  }
+  if (!region || region->empty()) {
+    return nil;
+  }
+  // The image of a region is made once and drawn on every redraw, until the
+  // atlas starts over and overwrites the pixels of the region.
+  if (_glyphImagesGeneration != _glyphAtlas.generation()) {
+    _glyphImages.clear();
+    _glyphImagesGeneration = _glyphAtlas.generation();
+  }
+  auto& cached = _glyphImages[region];
+  if (!cached) {
+    const auto width = static_cast<std::size_t>(region->width);
+    const auto height = static_cast<std::size_t>(region->height);
+    NSMutableData *data = [NSMutableData dataWithLength:width * height];
+    const auto bytes = static_cast<std::uint8_t *>(data.mutableBytes);
+    for (std::size_t y{}; y < height; ++y) {
+      std::memcpy(bytes + y * width,
+                  (_glyphAtlas.data() +
+                   (region->y + y) * _glyphAtlas.width() + region->x),
+                  width);
+    }
+    CGDataProviderRef provider =
+        CGDataProviderCreateWithCFData((__bridge CFDataRef)data);
+    CGColorSpaceRef colorSpace = CGColorSpaceCreateDeviceGray();
+    cached = (__bridge_transfer id)CGImageCreate(
+        width, height, 8, 8, width, colorSpace, kCGImageAlphaNone, provider,
+        nullptr, false, kCGRenderingIntentDefault);
+    CGColorSpaceRelease(colorSpace);
+    CGDataProviderRelease(provider);
+    if (!cached) {
+      return nil;
+    }
+  }
+  if (bounds) {
+    *bounds = CGRectMake(region->left / scale,
+                         -(region->top + region->height) / scale,
+                         region->width / scale,
+                         region->height / scale);
+  }
+  // The caller may keep the image after the cache drops it.
+  return (CGImageRef)CFAutorelease(CFRetain((__bridge CFTypeRef)cached));
+}
+
 - (BOOL)strokeGlyphForName:(nonnull NSString *)name {
-  auto glyph = _glyphs.find(name.UTF8String);
+  const auto glyph = _glyphs->find(name.UTF8String);
   assert(glyph);
   return [self strokeGlyph:*glyph];
 }
 
 - (BOOL)strokeGlyph:(const token::ufo::Glyph&)glyph {
-  const auto found = _glyphOutlines.find(glyph.name);
-  if (found != std::end(_glyphOutlines)) {
+  if (_glyphOutlines.find(glyph.name) != std::end(_glyphOutlines)) {
     return NO;
   }
-  const auto& outline = _glyphOutlines.emplace(
-      glyph.name,
-      token::GlyphOutline(glyph)).first->second;
+  return [self storeStrokedGlyph:strokeGlyph(
+      [self glyphStroker], _fontInfo, glyph, _sourceOutlines.get())
+                         forName:glyph.name];
+}
+
+- (void)strokeGlyphsInSubset:(const token::ufo::Subset *)subset {
+  // Glyphs are stroked independently of each other on the shared pool,
+  // where the glyphs of other strokers can be stroked at the same time.
+  const auto stroker = [self glyphStroker];
+  const auto fontInfo = std::make_shared<token::ufo::FontInfo>(_fontInfo);
+  std::vector<std::pair<std::string, std::future<StrokedGlyph>>> futures;
+  for (const auto glyph : [self glyphsInSubset:subset]) {
+    if (_glyphOutlines.find(glyph->name) != std::end(_glyphOutlines)) {
+      continue;
+    }
+    futures.emplace_back(glyph->name, sharedThreadPool().enqueue([
+        stroker,
+        fontInfo,
+        sourceOutlines = _sourceOutlines,
+        glyph]() {
+      return strokeGlyph(stroker, *fontInfo, *glyph, sourceOutlines.get());
+    }));
+  }
+  for (auto& future : futures) {
+    [self storeStrokedGlyph:future.second.get() forName:future.first];
+  }
+}
+
+- (std::vector<const token::ufo::Glyph *>)glyphsInSubset:
+    (const token::ufo::Subset *)subset {
+  // Looking up the glyphs of a subset by their names leaves the other
+  // glyphs unparsed when the source is still being loaded.
+  std::vector<const token::ufo::Glyph *> result;
+  if (subset) {
+    result.reserve(subset->size());
+    for (const auto& name : subset->names()) {
+      const auto glyph = _glyphs->find(name);
+      assert(glyph);
+      result.emplace_back(glyph);
+    }
+  } else {
+    result.reserve(_glyphs->size());
+    for (const auto& glyph : *_glyphs) {
+      result.emplace_back(&glyph);
+    }
+  }
+  return result;
+}
+
+- (token::GlyphStroker)glyphStroker {
   token::GlyphStroker stroker;
   stroker.set_width(_strokeWidth);
   stroker.set_precision(_strokePrecision);
   stroker.set_shift_increment(_strokeShiftIncrement);
   stroker.set_shift_limit(_strokeShiftLimit);
-  try {
-    auto pair = stroker(_fontInfo, glyph, outline);
-    _glyphShapes.emplace(glyph.name, pair.first);
-    _glyphBounds.emplace(glyph.name, pair.first.bounds(true));
-    _glyphAdvances.emplace(glyph.name, pair.second);
-  } catch (const std::exception& e) {
-    // TODO: Deal with error
+  return stroker;
+}
+
+- (BOOL)storeStrokedGlyph:(StrokedGlyph&&)glyph
+                  forName:(const std::string&)name {
+  _glyphOutlines.emplace(name, std::move(glyph.outline));
+  if (!glyph.error.empty()) {
+    _glyphErrors.emplace(name, std::move(glyph.error));
     return NO;
   }
+  _glyphBounds.emplace(name, glyph.shape.bounds(true));
+  _glyphShapes.emplace(name, std::move(glyph.shape));
+  _glyphAdvances.emplace(name, glyph.advance);
+  _glyphAnchors.emplace(name, std::move(glyph.anchors));
+  _glyphOverlaps.emplace(name, glyph.overlapping);
   return YES;
 }
 
+- (void)checkStrokedGlyphForName:(const std::string&)name {
+  // A glyph missing from a font would break the text that uses it without
+  // notice, which makes the whole font fail instead.
+  const auto error = _glyphErrors.find(name);
+  if (error != std::end(_glyphErrors)) {
+    throw std::runtime_error(
+        "Couldn't stroke the glyph " + name + ". " + error->second);
+  }
+}
+
 - (NSBezierPath *)bezierPathWithShape:(const shota::Shape2d&)shape {
   NSBezierPath *path = [NSBezierPath bezierPath];
   for (const auto& command : shape) {
@@ -231,15 +566,159 @@ namespace shota = shotamatsuda;
       return NO;
     }
   }
-  if (![fileManager copyItemAtURL:_url toURL:url error:error] ||
-      ![self saveFontInfoAtPath:url.path.UTF8String] ||
-      ![self saveGlyphsAtPath:url.path.UTF8String]) {
+  // Only the files that changed since the last save to the same URL are
+  // written, and the rest of the source is cloned.
+  token::ufo::Saver saver(_url.path.UTF8String, url.path.UTF8String);
+  try {
+    if (![self saveFontInfoWithSaver:&saver] ||
+        ![self saveGlyphsWithSaver:&saver] ||
+        ![self saveOverlappingGlyphsWithSaver:&saver] ||
+        !saver.commit()) {
+      return NO;
+    }
+  } catch (const std::exception& e) {
+    if (error) {
+      *error = [NSError errorWithDomain:TKNStrokerErrorDomain
+                                   code:0
+                               userInfo:@{
+        NSLocalizedDescriptionKey: @(e.what())
+      }];
+    }
     return NO;
   }
   return YES;
 }
 
-- (BOOL)saveFontInfoAtPath:(const std::string&)path {
+- (NSData *)compactFontFormatData {
+  const auto data = [self compactFontWithBuilder:nullptr
+                                          subset:nullptr].encode();
+  return [NSData dataWithBytes:data.data() length:data.size()];
+}
+
+- (NSData *)openTypeFontData {
+  const auto data = [self openTypeFontWithSubset:nullptr].encode();
+  return [NSData dataWithBytes:data.data() length:data.size()];
+}
+
+- (NSData *)openTypeFontDataForText:(NSString *)text {
+  const token::ufo::Subset subset(*_glyphs, *_glyphIndex.get(),
+                                  text.UTF8String);
+  const auto data = [self openTypeFontWithSubset:&subset].encode();
+  return [NSData dataWithBytes:data.data() length:data.size()];
+}
+
+- (NSData *)WOFFData {
+  // The metadata block is written from the WOFF data of the font info, and
+  // the tables are compressed on the shared pool.
+  const token::sfnt::WOFFEncoder encoder([self strokedFontInfo]);
+  const auto data = encoder.encode([self openTypeFontWithSubset:nullptr],
+                                   &sharedThreadPool());
+  return [NSData dataWithBytes:data.data() length:data.size()];
+}
+
+- (NSData *)WOFFDataForText:(NSString *)text {
+  const token::ufo::Subset subset(*_glyphs, *_glyphIndex.get(),
+                                  text.UTF8String);
+  const token::sfnt::WOFFEncoder encoder([self strokedFontInfo]);
+  const auto data = encoder.encode([self openTypeFontWithSubset:&subset],
+                                   &sharedThreadPool());
+  return [NSData dataWithBytes:data.data() length:data.size()];
+}
+
+- (token::sfnt::Font)openTypeFontWithSubset:
+    (const token::ufo::Subset *)subset {
+  // The tables other than CFF are built from the font info directly, in
+  // place of the feature files makeotf reads.
+  token::sfnt::Builder builder([self strokedFontInfo]);
+  const auto cff = [self compactFontWithBuilder:&builder
+                                         subset:subset].encode();
+  auto font = builder.build(cff);
+
+  const auto glyphOrder = builder.glyphOrder();
+  token::sfnt::Positioning positioning;
+  const auto kerningCompiler = _kerningCompiler.get();
+  token::sfnt::Lookup kern;
+  if (subset) {
+    // Pruning the pairs first makes resolving them as costly as the subset.
+    const token::sfnt::KerningCompiler subsetKerningCompiler(
+        subset->kerning(kerningCompiler->kerning, kerningCompiler->groups),
+        subset->groups(kerningCompiler->groups));
+    kern = subsetKerningCompiler.lookup(glyphOrder);
+  } else {
+    kern = kerningCompiler->lookup(glyphOrder);
+  }
+  if (!kern.subtables.empty()) {
+    positioning.add("kern", kern);
+  }
+
+  // Marks attach to the anchors moved along with the stroked outlines.
+  token::sfnt::MarkCompiler marks;
+  for (const auto glyph : [self glyphsInSubset:subset]) {
+    assert(_glyphAnchors.find(glyph->name) != std::end(_glyphAnchors));
+    marks.add(glyph->name, _glyphAnchors.at(glyph->name));
+  }
+  const auto mark = marks.markToBase(glyphOrder);
+  if (!mark.subtables.empty()) {
+    positioning.add("mark", mark);
+  }
+  const auto mkmk = marks.markToMark(glyphOrder);
+  if (!mkmk.subtables.empty()) {
+    positioning.add("mkmk", mkmk);
+  }
+  if (!positioning.empty()) {
+    font.set("GPOS", positioning.encode());
+  }
+  const auto definitions = marks.definitions(glyphOrder);
+  if (!definitions.empty()) {
+    font.set("GDEF", definitions);
+  }
+  return font;
+}
+
+- (token::cff::Font)compactFontWithBuilder:(token::sfnt::Builder *)builder
+                                    subset:(const token::ufo::Subset *)subset {
+  // The charstrings are compiled directly from the stroked shapes, which
+  // saves writing and reading back the UFO only to compile its outlines.
+  token::cff::Font font([self strokedFontInfo]);
+  [self strokeGlyphsInSubset:subset];
+  for (const auto glyph : [self glyphsInSubset:subset]) {
+    [self checkStrokedGlyphForName:glyph->name];
+    assert(_glyphShapes.find(glyph->name) != std::end(_glyphShapes));
+    assert(_glyphAdvances.find(glyph->name) != std::end(_glyphAdvances));
+    const auto& shape = _glyphShapes.at(glyph->name);
+    const auto advance = _glyphAdvances.at(glyph->name).width;
+    font.add(glyph->name, shape, advance);
+    if (builder) {
+      std::vector<std::uint32_t> unicodes;
+      for (const auto& unicode : glyph->unicodes) {
+        unicodes.emplace_back(static_cast<std::uint32_t>(
+            std::strtoul(unicode.hex.c_str(), nullptr, 16)));
+      }
+      builder->add({glyph->name, unicodes, advance,
+                    shape.bounds(true), shape.empty()});
+    }
+  }
+  // Stems are all as wide as the stroke, which lets the hinter find them
+  // from the outlines alone, independently for each glyph.
+  const token::cff::Hinter hinter(font.font_info);
+  std::vector<std::future<void>> futures;
+  futures.reserve(font.size());
+  for (auto& glyph : font.glyphs()) {
+    futures.emplace_back(sharedThreadPool().enqueue([&hinter, &glyph]() {
+      hinter(&glyph.charstring);
+    }));
+  }
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  // Stroked glyphs share caps, stems and joins, which are moved into
+  // subroutines.
+  token::cff::Subroutinizer()(&font);
+  return font;
+}
+
+- (token::ufo::FontInfo)strokedFontInfo {
   // TODO(shotamatsuda): Adjust x-height
   // TODO(shotamatsuda): Change style_map_style_name
   token::ufo::FontInfo fontInfo = _fontInfo;
@@ -262,25 +741,74 @@ namespace shota = shotamatsuda;
   fontInfo.postscript_stem_snap_v.emplace_back(_strokeWidth);
   fontInfo.postscript_underline_thickness = _strokeWidth;
   fontInfo.postscript_underline_position = -std::round(_strokeWidth * 2.5);
-  return fontInfo.save(path);
+  return fontInfo;
 }
 
-- (BOOL)saveGlyphsAtPath:(const std::string&)path {
-  const auto glyphsPath = boost::filesystem::path(path) / "glyphs";
-  for (auto glyph : _glyphs) {
-    [self strokeGlyph:glyph];
+- (BOOL)saveFontInfoWithSaver:(token::ufo::Saver *)saver {
+  std::ostringstream stream;
+  const auto fontInfo = [self strokedFontInfo];
+  return fontInfo.save(stream) && saver->write("fontinfo.plist", stream.str());
+}
+
+- (BOOL)saveGlyphsWithSaver:(token::ufo::Saver *)saver {
+  const auto& glyphs = *_glyphs;
+
+  [self strokeGlyphsInSubset:nullptr];
+  const token::cff::Hinter hinter([self strokedFontInfo]);
+  std::vector<std::future<bool>> futures;
+  futures.reserve(glyphs.size());
+  for (auto glyph : glyphs) {
+    [self checkStrokedGlyphForName:glyph.name];
     assert(_glyphOutlines.find(glyph.name) != std::end(_glyphOutlines));
     assert(_glyphShapes.find(glyph.name) != std::end(_glyphShapes));
     assert(_glyphAdvances.find(glyph.name) != std::end(_glyphAdvances));
+    assert(_glyphAnchors.find(glyph.name) != std::end(_glyphAnchors));
     auto outline = _glyphOutlines.at(glyph.name);
     outline.shape() = _glyphShapes.at(glyph.name);
     glyph.advance = _glyphAdvances.at(glyph.name);
-    const auto glyphPath = glyphsPath / _glyphs.filename(glyph.name);
-    if (!outline.glyph(glyph).save(glyphPath.string())) {
-      return NO;
+    glyph.anchors = _glyphAnchors.at(glyph.name);
+    // Glyphs with overlaps are left unhinted, because checkOutlinesUFO
+    // rewrites their contours and the points the hints refer to.
+    const auto overlaps = _glyphOverlaps.find(glyph.name);
+    const bool hinted = (overlaps != std::end(_glyphOverlaps) &&
+                         !overlaps->second);
+    const auto name = "glyphs/" + glyphs.filename(glyph.name);
+    futures.emplace_back(sharedThreadPool().enqueue([
+        saver,
+        &hinter,
+        outline = std::move(outline),
+        glyph = std::move(glyph),
+        hinted,
+        name]() {
+      auto result = outline.glyph(glyph);
+      if (hinted) {
+        token::afdko::storeHints(hinter.hints(token::cff::CharString(
+            outline.shape(), glyph.advance->width)), &result);
+      }
+      std::ostringstream stream;
+      return result.save(stream) && saver->write(name, stream.str());
+    }));
+  }
+  bool result = true;
+  for (auto& future : futures) {
+    result = future.get() && result;
+  }
+  return result;
+}
+
+- (BOOL)saveOverlappingGlyphsWithSaver:(token::ufo::Saver *)saver {
+  // The list is saved even when it's empty, which tells that no glyph needs
+  // checkOutlinesUFO.
+  std::string contents;
+  for (std::size_t id{}; id < _glyphs->size(); ++id) {
+    const auto& name = _glyphs->name(id);
+    const auto overlaps = _glyphOverlaps.find(name);
+    if (overlaps == std::end(_glyphOverlaps) || overlaps->second) {
+      contents += name;
+      contents += '\n';
     }
   }
-  return YES;
+  return saver->write(TKNStrokerOverlappingGlyphsPath.UTF8String, contents);
 }
 
 @end
@@ -4,17 +4,20 @@
 #import <AppKit/AppKit.h>
 
 typedef void (^TKNTypefaceProgressHandler)(NSUInteger, NSUInteger);
+typedef void (^TKNTypefaceCompletionHandler)(NSError * _Nullable);
+
+extern NSString * const _Nonnull TKNTypefaceErrorDomain;
 
 @interface TKNTypeface : NSObject
 
 - (void)createFontWithContentsOfURL:(nonnull NSURL *)contentsURL
     toURL:(nonnull NSURL *)fontURL
     toolsURL:(nonnull NSURL *)toolsURL
-    extraURL:(nonnull NSURL *)extraURL
+    cacheURL:(nullable NSURL *)cacheURL
     progressHandler:(nullable TKNTypefaceProgressHandler)progressHandler
-    completionHandler:(nullable dispatch_block_t)completionHandler;
+    completionHandler:(nullable TKNTypefaceCompletionHandler)completionHandler;
 - (BOOL)correctUPEM:(double)UPEM
        forFontAtURL:(nonnull NSURL *)fontURL
-           toolsURL:(nonnull NSURL *)toolsURL;
+              error:(NSError * _Nullable * _Nullable)error;
 
 @end
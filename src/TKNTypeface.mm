@@ -3,63 +3,178 @@
 
 #import "TKNTypeface.h"
 
+#import "TKNStroker.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <boost/algorithm/string/replace.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
 
 #include "token/afdko.h"
+#include "token/artifact_cache.h"
+#include "token/cff.h"
+#include "token/pipeline.h"
+#include "token/sfnt.h"
+#include "token/thread_pool.h"
 #include "token/ufo.h"
 
+NSString * const TKNTypefaceErrorDomain = @"TKNTypefaceErrorDomain";
+
+namespace {
+
+// Reads the list of glyphs that the stroker left to checkOutlinesUFO, or
+// returns false when the UFO wasn't saved by a stroker.
+bool readOverlappingGlyphs(const std::string& path,
+                           std::vector<std::string> *glyphs) {
+  std::ifstream stream(path);
+  if (!stream) {
+    return false;
+  }
+  std::string name;
+  while (std::getline(stream, name)) {
+    if (!name.empty()) {
+      glyphs->emplace_back(name);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 @implementation TKNTypeface
 
 - (void)createFontWithContentsOfURL:(NSURL *)contentsURL
-                              toURL:(NSURL *)fontURL
-                           toolsURL:(NSURL *)toolsURL
-                           extraURL:(NSURL *)extraURL
-                    progressHandler:(TKNTypefaceProgressHandler)progressHandler
-                  completionHandler:(dispatch_block_t)completionHandler {
+    toURL:(NSURL *)fontURL
+    toolsURL:(NSURL *)toolsURL
+    cacheURL:(NSURL *)cacheURL
+    progressHandler:(TKNTypefaceProgressHandler)progressHandler
+    completionHandler:(TKNTypefaceCompletionHandler)completionHandler {
+  // Makeotf reads the feature files next to the UFO.
   const std::string directoryPath(
-      fontURL.URLByDeletingLastPathComponent.path.UTF8String);
+      contentsURL.URLByDeletingLastPathComponent.path.UTF8String);
   const std::string contentsPath(contentsURL.path.UTF8String);
   const std::string fontPath(fontURL.path.UTF8String);
   const std::string toolsPath(toolsURL.path.UTF8String);
-  const std::string extraPath(extraURL.path.UTF8String);
-  const token::ufo::FontInfo fontInfo(contentsPath);
-  const token::ufo::Glyphs glyphs(contentsPath);
-  NSArray *subtasks = @[
-    ^{ token::afdko::checkOutlines(toolsPath, contentsPath); },
-    ^{ token::afdko::performAutoHinting(toolsPath, contentsPath); },
-    ^{ token::afdko::createFeatures(fontInfo, directoryPath); },
-    ^{ token::afdko::createFontMenuName(fontInfo, directoryPath); },
-    ^{ token::afdko::createGlyphOrderAndAlias(glyphs, directoryPath); },
-    ^{ token::afdko::generateKernFile(extraPath, contentsPath); },
-    ^{ token::afdko::createOpenTypeFont(toolsPath, contentsPath, fontPath); }
-  ];
+  const std::string glyphsPath(
+      [contentsURL URLByAppendingPathComponent:@"glyphs"].path.UTF8String);
+  // The tools load scripts and libraries shared between platforms from the
+  // directory above, all of which belong to the version of the tools.
+  token::ArtifactCache cache(
+      cacheURL ? cacheURL.path.UTF8String : std::string());
+  if (cacheURL) {
+    cache.set_tools(toolsURL.URLByDeletingLastPathComponent.path.UTF8String);
+  }
+  const auto file = [directoryPath](const std::string& name) {
+    return directoryPath + "/" + name;
+  };
+  // The stages outlive this method and share the sources.
+  const auto fontInfo = std::make_shared<token::ufo::FontInfo>(contentsPath);
+  const auto glyphs = std::make_shared<token::ufo::Glyphs>(contentsPath);
+  const auto kerning = std::make_shared<token::ufo::Kerning>(contentsPath);
+  const auto groups = std::make_shared<token::ufo::Groups>(contentsPath);
+  const auto pipeline = std::make_shared<token::Pipeline>();
+  // The tools of AFDKO rewrite the glyphs in place, whereas the other stages
+  // write files next to the UFO, and makeotf reads all of them. The stages
+  // that run the tools are skipped when their outputs are cached for the
+  // same inputs. The stroker has stored the hints in the glyphs, which
+  // makeotf reads in place of running autohint.
+  const auto outlines = pipeline->add("checkOutlines", [=] {
+    // The stroker has already fixed the outlines, and the tool only runs for
+    // the glyphs with overlaps, which can't be removed in process. All the
+    // glyphs are checked when there's no list of them.
+    const auto overlapsPath =
+        contentsPath + "/" + TKNStrokerOverlappingGlyphsPath.UTF8String;
+    std::vector<std::string> names;
+    if (readOverlappingGlyphs(overlapsPath, &names) && names.empty()) {
+      return true;
+    }
+    return cache.run(
+        "checkOutlines", {overlapsPath, glyphsPath}, {glyphsPath},
+        [=] {
+      // The tool exits successfully when it only reports problems it can't
+      // fix, so that a failure means the glyphs may be partially rewritten.
+      // It throws with the output of the tool, which is never cached.
+      token::afdko::checkOutlines(toolsPath, contentsPath, names);
+      return true;
+    });
+  });
+  const auto features = pipeline->add("features", [=] {
+    token::afdko::createFeatures(*fontInfo, directoryPath);
+    return true;
+  });
+  const auto fontMenuName = pipeline->add("FontMenuNameDB", [=] {
+    token::afdko::createFontMenuName(*fontInfo, directoryPath);
+    return true;
+  });
+  const auto glyphOrder = pipeline->add("GlyphOrderAndAliasDB", [=] {
+    token::afdko::createGlyphOrderAndAlias(*glyphs, directoryPath);
+    return true;
+  });
+  const auto kernFeatures = pipeline->add("kern.fea", [=] {
+    token::afdko::createKernFeatures(
+        *kerning, *groups, *glyphs, directoryPath);
+    return true;
+  });
+  // The anchors are read from the glyphs, which must not happen while the
+  // tool or the cache are replacing them, because each glyph is loaded only
+  // once and a glyph read from a partially written file would be skipped.
+  const auto markFeatures = pipeline->add("mark.fea", [=] {
+    token::afdko::createMarkFeatures(*glyphs, directoryPath);
+    return true;
+  }, {outlines});
+  pipeline->add("makeotf", [=] {
+    return cache.run(
+        "makeotf",
+        {contentsPath, file("features"), file("kern.fea"), file("mark.fea"),
+         file("FontMenuNameDB"), file("GlyphOrderAndAliasDB")},
+        {fontPath},
+        [=] {
+      token::afdko::createOpenTypeFont(toolsPath, contentsPath, fontPath);
+      return true;
+    });
+  }, {outlines, features, fontMenuName, glyphOrder, kernFeatures,
+      markFeatures});
+  if (progressHandler) {
+    pipeline->set_progress_handler([progressHandler](
+        const std::string& stage,
+        std::size_t completed,
+        std::size_t total) {
+      dispatch_async(dispatch_get_main_queue(), ^{
+        progressHandler(completed, total);
+      });
+    });
+  }
   dispatch_async(dispatch_get_global_queue(
       DISPATCH_QUEUE_PRIORITY_BACKGROUND, 0), ^{
-    NSUInteger numberOfSubtasks{};
-    for (dispatch_block_t subtask in subtasks) {
-      try {
-        subtask();
-      } catch (const std::exception& e) {
-        // TODO: Deal with error
-        return;
-      }
-      ++numberOfSubtasks;
-      if (progressHandler) {
-        dispatch_async(dispatch_get_main_queue(), ^{
-          progressHandler(numberOfSubtasks, subtasks.count);
-        });
+    token::ThreadPool pool;
+    NSError *error = nil;
+    if (pipeline->run(&pool)) {
+      // The tools and the cache have rewritten some of the glyphs that the
+      // stroker saved, which the next save would write again otherwise.
+      token::ufo::Saver::record(contentsPath);
+    } else {
+      NSString *description = [NSString stringWithFormat:@"%s failed.",
+          pipeline->failed_stage().c_str()];
+      if (!pipeline->error().empty()) {
+        description = [description stringByAppendingFormat:@" %s",
+            pipeline->error().c_str()];
       }
+      error = [NSError errorWithDomain:TKNTypefaceErrorDomain
+                                  code:0
+                              userInfo:@{
+        NSLocalizedDescriptionKey: description
+      }];
     }
     if (completionHandler) {
       dispatch_async(dispatch_get_main_queue(), ^{
-        completionHandler();
+        completionHandler(error);
       });
     }
   });
@@ -67,23 +182,42 @@
 
 - (BOOL)correctUPEM:(double)UPEM
        forFontAtURL:(NSURL *)fontURL
-           toolsURL:(NSURL *)toolsURL {
+              error:(NSError **)error {
   const std::string fontPath(fontURL.path.UTF8String);
-  const std::string toolsPath(toolsURL.path.UTF8String);
-  bool result = false;
+  std::string description;
   try {
-    result = token::afdko::transformFont(
-        toolsPath, fontPath,
-        [UPEM](boost::property_tree::ptree& tree) {
-      tree.put("ttFont.head.unitsPerEm.<xmlattr>.value", UPEM);
-      const auto scale = boost::lexical_cast<std::string>(1.0 / UPEM);
-      const auto fontMatrix = scale + " 0 0 " + scale + " 0 0";
-      tree.put("ttFont.CFF.CFFFont.FontMatrix.<xmlattr>.value", fontMatrix);
-    });
+    token::sfnt::Font font;
+    if (!font.open(fontPath)) {
+      description = "Couldn't read the font.";
+    } else if (!font.edit<token::sfnt::Head>(
+        "head", [UPEM](token::sfnt::Head *head) {
+          head->units_per_em = static_cast<std::uint16_t>(std::round(UPEM));
+        })) {
+      description = "Couldn't patch the head table.";
+    } else if (!font.edit<token::cff::Table>(
+        "CFF ", [UPEM](token::cff::Table *cff) {
+          const auto scale = 1.0 / UPEM;
+          cff->set_font_matrix({scale, 0.0, 0.0, scale, 0.0, 0.0});
+        })) {
+      description = "Couldn't patch the CFF table.";
+    } else if (!font.save(fontPath)) {
+      description = "Couldn't write the font.";
+    }
   } catch (const std::exception& e) {
-    // TODO: Deal with error
+    description = e.what();
+  }
+  if (description.empty()) {
+    return YES;
+  }
+  if (error) {
+    *error = [NSError errorWithDomain:TKNTypefaceErrorDomain
+                                 code:0
+                             userInfo:@{
+      NSLocalizedDescriptionKey: [NSString stringWithFormat:
+          @"Correcting UPEM failed. %s", description.c_str()]
+    }];
   }
-  return result;
+  return NO;
 }
 
 @end
@@ -3,5 +3,6 @@
 
 #import <Sparkle/Sparkle.h>
 
+#import "TKNFamily.h"
 #import "TKNStroker.h"
 #import "TKNTypeface.h"
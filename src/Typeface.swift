@@ -360,10 +360,22 @@ class Typeface : TKNTypeface, TypefaceDelegate {
     return stroker.glyphAdvance(forName: name)
   }
 
+  func glyphPositionsForNames(_ names: [String],
+                              lineWidth: inout Double) -> [Double] {
+    return stroker.glyphPositions(forNames: names, lineWidth: &lineWidth)
+        .map { $0.doubleValue }
+  }
+
   func glyphBoundsForName(_ name: String) -> CGRect {
     return stroker.glyphBounds(forName: name)
   }
 
+  func glyphImageForName(_ name: String,
+                         scale: Double,
+                         bounds: inout CGRect) -> CGImage? {
+    return stroker.glyphImage(forName: name, scale: scale, bounds: &bounds)
+  }
+
   // MARK: Saving
 
   var delegate: TypefaceDelegate?
@@ -373,18 +385,20 @@ class Typeface : TKNTypeface, TypefaceDelegate {
     let workingDirectoryURL = URL(
         fileURLWithPath: NSTemporaryDirectory()).appendingPathComponent(
             ProcessInfo.processInfo.globallyUniqueString)
-    let contentsURL = workingDirectoryURL.appendingPathComponent(
-        stroker.url.deletingPathExtension()
-            .appendingPathExtension("ufo").lastPathComponent)
+    // The UFO is kept between exports of the same font, so that exporting it
+    // again only rewrites the glyphs that changed.
+    let contentsURL = Location.privateCachesURL
+        .appendingPathComponent("Exports")
+        .appendingPathComponent(postscriptName)
+        .appendingPathComponent(
+            stroker.url.deletingPathExtension()
+                .appendingPathExtension("ufo").lastPathComponent)
     let fontURL = workingDirectoryURL.appendingPathComponent(
         stroker.url.deletingPathExtension()
             .appendingPathExtension("otf").lastPathComponent)
     let toolsURL = Location.adobeFDKURL
         .appendingPathComponent("Tools")
         .appendingPathComponent("osx")
-    let extraURL = Bundle.main.url(
-        forResource: "Scripts/fdk-extra",
-        withExtension: nil)!
     stroker.styleName = styleName
     stroker.fullName = fullName
     stroker.postscriptName = postscriptName
@@ -404,7 +418,8 @@ class Typeface : TKNTypeface, TypefaceDelegate {
         withContentsOf: contentsURL,
         to: fontURL,
         toolsURL: toolsURL,
-        extraURL: extraURL,
+        cacheURL: Location.privateCachesURL
+            .appendingPathComponent("Artifacts"),
         progressHandler: { (numberOfSubtasks: UInt,
                             totalNumberOfSubtasks: UInt) in
           (self.delegate ?? self).typeface(
@@ -413,12 +428,16 @@ class Typeface : TKNTypeface, TypefaceDelegate {
               didCompleteNumberOfSubtasks: numberOfSubtasks,
               totalNumberOfSubtasks: totalNumberOfSubtasks)
         },
-        completionHandler: {
-          self.correctUPEM(
-              stroker.upem,
-              forFontAt: fontURL,
-              toolsURL: toolsURL)
+        completionHandler: { (error: Error?) in
+          if let error = error as NSError? {
+            (self.delegate ?? self).typeface(
+                self,
+                didFailToCreateFontAtURL: fontURL,
+                error: error)
+            return
+          }
           do {
+            try self.correctUPEM(stroker.upem, forFontAt: fontURL)
             let fileManager = FileManager.default
             if (try? url.checkResourceIsReachable()) ?? false {
               try fileManager.removeItem(at: url)
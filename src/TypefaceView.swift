@@ -100,24 +100,22 @@ class TypefaceView : NSView {
     guard let typeface = typeface else {
       return
     }
-    // Derive the sum of advances in this line for centering.
-    var lineWidth = CGFloat()
-    for name in line {
-      lineWidth += CGFloat(typeface.glyphAdvanceForName(name))
-    }
+    // Lay out the line once, and center it by its width.
+    var lineWidth = Double()
+    let positions = typeface.glyphPositionsForNames(line, lineWidth: &lineWidth)
     NSGraphicsContext.saveGraphicsState()
     defer {
       NSGraphicsContext.restoreGraphicsState()
     }
     var transform = AffineTransform.identity
-    transform.translate(x: -lineWidth / 2.0, y: 0.0)
+    transform.translate(x: -CGFloat(lineWidth) / 2.0, y: 0.0)
     (transform as NSAffineTransform).concat()
 
-    // Draw every glyphs, moving right by the advance of each glyph.
-    var glyphPosition = position
-    for name in line {
+    // Draw each glyph at its position along the line.
+    for (name, offset) in zip(line, positions) {
+      var glyphPosition = position
+      glyphPosition.x += CGFloat(offset)
       drawGlyph(name, position: glyphPosition, dirtyRect: dirtyRect)
-      glyphPosition.x += CGFloat(typeface.glyphAdvanceForName(name))
     }
   }
 
@@ -145,6 +143,19 @@ class TypefaceView : NSView {
     guard rect1.intersects(rect2) else {
       return
     }
+    if !outlined {
+      // Draw the mask rendered at the scale of the device, which the stroker
+      // caches instead of filling the outline again.
+      let scale = Double(hypot(currentTransform.a, currentTransform.b))
+      var imageBounds = CGRect()
+      if let image = typeface.glyphImageForName(
+          name,
+          scale: scale,
+          bounds: &imageBounds) {
+        drawSolidGlyph(image, in: imageBounds)
+        return
+      }
+    }
     if let outline = typeface.glyphBezierPathForName(name) {
       if outlined {
         drawOutlineGlyph(outline)
@@ -165,6 +176,25 @@ class TypefaceView : NSView {
     outline.fill()
   }
 
+  private func drawSolidGlyph(_ image: CGImage, in rect: CGRect) {
+    guard let context = NSGraphicsContext.current?.cgContext else {
+      return
+    }
+    context.saveGState()
+    defer {
+      context.restoreGState()
+    }
+    var foregroundColor: NSColor?
+    if inverted {
+      foregroundColor = NSColor.white
+    } else {
+      foregroundColor = NSColor.black
+    }
+    foregroundColor!.setFill()
+    context.clip(to: rect, mask: image)
+    rect.fill()
+  }
+
   private func drawOutlineGlyph(_ outline: NSBezierPath) {
     // Scale line width by inverse of scroll view's magnification to get
     // consistent line width.
@@ -256,13 +286,9 @@ class TypefaceView : NSView {
     var size = CGSize()
     size.height = CGFloat(lineHeight * Double(lines.count) - typeface.descender)
     for line in lines {
-      var width = CGFloat()
-      for name in line {
-        width += CGFloat(typeface.glyphAdvanceForName(name))
-        if size.width < width {
-          size.width = width
-        }
-      }
+      var width = Double()
+      _ = typeface.glyphPositionsForNames(line, lineWidth: &width)
+      size.width = max(size.width, CGFloat(width))
     }
     size.width += CGFloat(lineHeight) / 2.0
     size.width *= scale
@@ -5,10 +5,8 @@
 #ifndef TOKEN_AFDKO_H_
 #define TOKEN_AFDKO_H_
 
-#include "token/afdko/extra.h"
 #include "token/afdko/hinting.h"
 #include "token/afdko/opentype.h"
 #include "token/afdko/task.h"
-#include "token/afdko/transform.h"
 
 #endif  // TOKEN_AFDKO_H_
@@ -3,29 +3,104 @@
 
 #include "token/afdko/hinting.h"
 
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/algorithm/string/join.hpp>
 
 #include "token/afdko/task.h"
+#include "token/cff/hinter.h"
+#include "token/ufo/glif.h"
+#include "token/ufo/glyph.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace afdko {
 
-bool checkOutlines(const std::string& directory,
-                   const std::string& input) {
+namespace {
+
+// The tool only runs for the glyphs with overlaps, which takes seconds
+// unless it hangs.
+constexpr std::chrono::minutes kCheckOutlinesTimeout(5);
+
+}  // namespace
+
+void checkOutlines(const std::string& directory,
+                   const std::string& input,
+                   const std::vector<std::string>& glyphs) {
+  std::vector<std::string> arguments{"-e", "-all", "-decimal"};
+  if (!glyphs.empty()) {
+    arguments.emplace_back("-g");
+    arguments.emplace_back(boost::algorithm::join(glyphs, ","));
+  }
+  arguments.emplace_back(input);
   Task task;
   task.set_directory(directory);
   task.set_name("checkOutlinesUFO");
-  task.set_arguments({"-e", "-all", "-decimal", input});
-  return task.execute();
+  task.set_arguments(arguments);
+  task.set_timeout(kCheckOutlinesTimeout);
+  task.execute();
 }
 
-bool performAutoHinting(const std::string& directory,
-                        const std::string& input) {
-  Task task;
-  task.set_directory(directory);
-  task.set_name("autohint");
-  task.set_arguments({"-all", "-decimal", input});
-  return task.execute();
+void storeHints(const cff::Hints& hints, ufo::Glyph *glyph) {
+  assert(glyph);
+  if (hints.empty() || !glyph->outline.exists()) {
+    return;
+  }
+  const auto stem = [](const char *name, const cff::Hints::Stem& stem) {
+    char buffer[32];
+    std::string result(name);
+    result += ' ';
+    result.append(buffer, ufo::xml::format(stem.position, buffer));
+    result += ' ';
+    result.append(buffer, ufo::xml::format(stem.width, buffer));
+    return result;
+  };
+  auto& contours = glyph->outline->contours;
+  auto contour = std::begin(contours);
+  std::vector<ufo::glif::HintSet> hint_sets;
+  for (const auto& set : hints.sets) {
+    // Charstrings have rounded coordinates and no contours without
+    // segments, so that the contour where the set begins is found by its
+    // start point instead of its index.
+    contour = std::find_if(contour, std::end(contours), [&set](
+        const ufo::glif::Contour& contour) {
+      return (!contour.points.empty() &&
+              std::round(contour.points.front().x) == set.x &&
+              std::round(contour.points.front().y) == set.y);
+    });
+    if (contour == std::end(contours)) {
+      break;
+    }
+    char tag[32];
+    std::snprintf(tag, sizeof(tag), "hintSet%04zu", hint_sets.size());
+    ufo::glif::HintSet hint_set;
+    hint_set.point_tag = tag;
+    for (const auto index : set.horizontal) {
+      hint_set.stems.emplace_back(stem("hstem", hints.horizontal[index]));
+    }
+    for (const auto index : set.vertical) {
+      hint_set.stems.emplace_back(stem("vstem", hints.vertical[index]));
+    }
+    contour->points.front().name = tag;
+    hint_sets.emplace_back(std::move(hint_set));
+    ++contour;
+  }
+  if (hint_sets.empty()) {
+    return;
+  }
+  if (!glyph->lib.exists()) {
+    glyph->lib.emplace();
+  }
+  glyph->lib->hint_sets = std::move(hint_sets);
 }
 
 }  // namespace afdko
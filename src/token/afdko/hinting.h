@@ -6,14 +6,24 @@
 #define TOKEN_AFDKO_HINTING_H_
 
 #include <string>
+#include <vector>
+
+#include "token/cff/hinter.h"
+#include "token/ufo/glyph.h"
 
 namespace token {
 namespace afdko {
 
-bool checkOutlines(const std::string& directory,
-                   const std::string& input);
-bool performAutoHinting(const std::string& directory,
-                        const std::string& input);
+// Checks only the glyphs of the names unless they are empty. Throws
+// std::runtime_error when the tool fails.
+void checkOutlines(const std::string& directory,
+                   const std::string& input,
+                   const std::vector<std::string>& glyphs = {});
+
+// Stores the hints in the lib of the glyph in the format of autohint, which
+// makeotf reads in place of running autohint. The first points of the
+// contours where the hint sets begin are named after the sets.
+void storeHints(const cff::Hints& hints, ufo::Glyph *glyph);
 
 }  // namespace afdko
 }  // namespace token
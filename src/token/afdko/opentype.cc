@@ -4,15 +4,20 @@
 #include "token/afdko/opentype.h"
 
 #include <cassert>
+#include <chrono>
+#include <cstddef>
 #include <fstream>
 #include <ostream>
 #include <string>
+#include <vector>
 
 #include <boost/algorithm/string/join.hpp>
 #include <boost/filesystem/path.hpp>
 #include <boost/range/adaptor/transformed.hpp>
 
 #include "token/afdko/task.h"
+#include "token/sfnt/kerning_compiler.h"
+#include "token/sfnt/mark_compiler.h"
 #include "token/ufo.h"
 
 namespace token {
@@ -20,6 +25,9 @@ namespace afdko {
 
 namespace {
 
+// Compiling large fonts takes a few minutes, well within this.
+constexpr std::chrono::minutes kMakeOTFTimeout(15);
+
 inline void write_name(std::ostream *stream,
                        unsigned int id,
                        const std::string& value) {
@@ -32,14 +40,15 @@ inline void write_name(std::ostream *stream,
 
 }  // namespace
 
-bool createOpenTypeFont(const std::string& directory,
+void createOpenTypeFont(const std::string& directory,
                         const std::string& input,
                         const std::string& output) {
   Task task;
   task.set_directory(directory);
   task.set_name("makeotf");
   task.set_arguments({"-r", "-f", input, "-o", output});
-  return task.execute();
+  task.set_timeout(kMakeOTFTimeout);
+  task.execute();
 }
 
 void createFeatures(const ufo::FontInfo& font_info,
@@ -55,6 +64,9 @@ void createFeatures(const ufo::FontInfo& font_info,
   stream << "include (kern.fea)" << std::endl;
   stream << "} kern;" << std::endl;
 
+  // mark, mkmk
+  stream << "include (mark.fea)" << endl;
+
   // head
   stream << "table head {" << std::endl;
   stream << "FontRevision " << font_info.open_type_name_version << endl;
@@ -125,9 +137,41 @@ void createGlyphOrderAndAlias(const ufo::Glyphs& glyphs,
   const auto path = boost::filesystem::path(output) / "GlyphOrderAndAliasDB";
   std::ofstream stream(path.string());
   assert(stream.good());
+  // Names come from the contents so that glyph files are not parsed.
+  for (std::size_t id{}; id < glyphs.size(); ++id) {
+    stream << glyphs.name(id) << " " << glyphs.name(id) << std::endl;
+  }
+  stream.close();
+}
+
+void createKernFeatures(const ufo::Kerning& kerning,
+                        const ufo::Groups& groups,
+                        const ufo::Glyphs& glyphs,
+                        const std::string& output) {
+  std::vector<std::string> glyph_order;
+  glyph_order.reserve(glyphs.size());
+  for (std::size_t id{}; id < glyphs.size(); ++id) {
+    glyph_order.emplace_back(glyphs.name(id));
+  }
+  const auto path = boost::filesystem::path(output) / "kern.fea";
+  std::ofstream stream(path.string());
+  assert(stream.good());
+  stream << sfnt::KerningCompiler(kerning, groups).features(glyph_order);
+  stream.close();
+}
+
+void createMarkFeatures(const ufo::Glyphs& glyphs, const std::string& output) {
+  std::vector<std::string> glyph_order;
+  glyph_order.reserve(glyphs.size());
+  sfnt::MarkCompiler compiler;
   for (const auto& glyph : glyphs) {
-    stream << glyph.name << " " << glyph.name << std::endl;
+    glyph_order.emplace_back(glyph.name);
+    compiler.add(glyph.name, glyph.anchors);
   }
+  const auto path = boost::filesystem::path(output) / "mark.fea";
+  std::ofstream stream(path.string());
+  assert(stream.good());
+  stream << compiler.features(glyph_order);
   stream.close();
 }
 
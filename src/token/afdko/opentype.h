@@ -12,7 +12,8 @@
 namespace token {
 namespace afdko {
 
-bool createOpenTypeFont(const std::string& directory,
+// Throws std::runtime_error when makeotf fails.
+void createOpenTypeFont(const std::string& directory,
                         const std::string& input,
                         const std::string& output);
 void createFeatures(const ufo::FontInfo& font_info,
@@ -21,6 +22,11 @@ void createFontMenuName(const ufo::FontInfo& font_info,
                         const std::string& output);
 void createGlyphOrderAndAlias(const ufo::Glyphs& glyphs,
                               const std::string& output);
+void createKernFeatures(const ufo::Kerning& kerning,
+                        const ufo::Groups& groups,
+                        const ufo::Glyphs& glyphs,
+                        const std::string& output);
+void createMarkFeatures(const ufo::Glyphs& glyphs, const std::string& output);
 
 }  // namespace afdko
 }  // namespace token
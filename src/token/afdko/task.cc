@@ -3,30 +3,89 @@
 
 #include "token/afdko/task.h"
 
+#include <cassert>
+#include <cstddef>
 #include <cstdlib>
-#include <ostream>
-#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <vector>
 
-#include <boost/algorithm/string/join.hpp>
+#include <boost/algorithm/string/trim.hpp>
 #include <boost/filesystem/path.hpp>
-#include <boost/format.hpp>
+
+#include "token/process.h"
+
+extern char **environ;
 
 namespace token {
 namespace afdko {
 
+namespace {
+
+// The tools report the cause of a failure at the end of their output, after
+// their progress, so that only the last lines are kept.
+constexpr std::size_t kMaxMessageSize = 1024;
+
+}  // namespace
+
 // MARK: Executing task
 
-bool Task::execute() {
-  const auto path = (boost::filesystem::path(directory_) / name_).string();
-  const auto arguments = boost::join(arguments_, " ");
-  std::ostringstream oss;
-  oss << "export PATH=${PATH}:'%1%'" << std::endl;
-  oss << "export FDK_EXE='%1%'" << std::endl;
-  oss << "'%2%' %3%" << std::endl;
-  boost::format format(oss.str());
-  const auto command = (format % directory_ % path % arguments).str();
-  return !std::system(command.c_str());
+void Task::execute() {
+  Process process;
+  prepare(&process);
+  const auto result = process.run();
+  output_ = process.output();
+  error_ = process.error();
+  if (!result) {
+    throw std::runtime_error(describe(process));
+  }
+}
+
+void Task::prepare(Process *process) const {
+  assert(process);
+  process->set_path((boost::filesystem::path(directory_) / name_).string());
+  process->set_arguments(arguments_);
+  process->set_timeout(timeout_);
+
+  // The tools find each other through these variables.
+  std::vector<std::string> environment;
+  for (auto variable = environ; *variable; ++variable) {
+    const std::string value(*variable);
+    if (value.compare(0, 5, "PATH=") && value.compare(0, 8, "FDK_EXE=")) {
+      environment.emplace_back(value);
+    }
+  }
+  const auto path = std::getenv("PATH");
+  environment.emplace_back("PATH=" + (path ? std::string(path) + ":" : "") +
+                           directory_);
+  environment.emplace_back("FDK_EXE=" + directory_);
+  process->set_environment(environment);
+}
+
+std::string Task::describe(const Process& process) const {
+  std::string result;
+  if (process.timed_out()) {
+    result = name_ + " didn't finish in " +
+             std::to_string(timeout_.count() / 1000) + " seconds.";
+  } else if (process.exit_status() < 0) {
+    result = "Couldn't launch " + name_ + ".";
+  } else {
+    result = name_ + " exited with status " +
+             std::to_string(process.exit_status()) + ".";
+  }
+  // Some of the tools report errors to the standard output.
+  auto message = error_.find_first_not_of(" \t\r\n") == std::string::npos ?
+      output_ : error_;
+  boost::algorithm::trim(message);
+  if (message.size() > kMaxMessageSize) {
+    const auto line = message.find('\n', message.size() - kMaxMessageSize);
+    message.erase(0, line == std::string::npos ?
+        message.size() - kMaxMessageSize : line + 1);
+  }
+  if (!message.empty()) {
+    result += "\n" + message;
+  }
+  return result;
 }
 
 }  // namespace afdko
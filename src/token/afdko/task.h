@@ -5,22 +5,28 @@
 #ifndef TOKEN_AFDKO_TASK_H_
 #define TOKEN_AFDKO_TASK_H_
 
+#include <chrono>
 #include <string>
 #include <vector>
 
+#include "token/process.h"
+
 namespace token {
 namespace afdko {
 
+// A tool of AFDKO, which is spawned with the directory of the tools in its
+// PATH and FDK_EXE variables. A task that fails throws std::runtime_error
+// describing how it failed, followed by the last lines the tool reported.
 class Task final {
  public:
-  Task() = default;
+  Task();
 
   // Copy semantics
   Task(const Task&) = default;
   Task& operator=(const Task&) = default;
 
   // Executing task
-  bool execute();
+  void execute();
 
   // Modifiers
   const std::string& directory() const;
@@ -29,15 +35,30 @@ class Task final {
   void set_name(const std::string& value);
   const std::vector<std::string>& arguments() const;
   void set_arguments(const std::vector<std::string>& value);
+  std::chrono::milliseconds timeout() const { return timeout_; }
+  void set_timeout(std::chrono::milliseconds value) { timeout_ = value; }
+
+  // Results
+  const std::string& output() const { return output_; }
+  const std::string& error() const { return error_; }
+
+ private:
+  void prepare(Process *process) const;
+  std::string describe(const Process& process) const;
 
  private:
   std::string directory_;
   std::string name_;
   std::vector<std::string> arguments_;
+  std::chrono::milliseconds timeout_;
+  std::string output_;
+  std::string error_;
 };
 
 // MARK: -
 
+inline Task::Task() : timeout_() {}
+
 // MARK: Modifiers
 
 inline const std::string& Task::directory() const {
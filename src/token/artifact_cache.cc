@@ -0,0 +1,449 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/artifact_cache.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cinttypes>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <functional>
+#include <ios>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "token/hash.h"
+#include "token/mapped_file.h"
+
+namespace token {
+
+namespace {
+
+// Bump this when the layout of the cache or the way manifests are written
+// changes.
+constexpr std::uint32_t kVersion = 3;
+
+// Files that no entry refers to yet are left for this long in seconds, since
+// another build may be storing an entry that refers to them.
+constexpr std::int64_t kGracePeriod = 60 * 60;
+
+std::string hexadecimal(std::uint64_t value) {
+  char buffer[17];
+  std::snprintf(buffer, sizeof(buffer), "%016" PRIx64, value);
+  return buffer;
+}
+
+// Objects are named by both the hash and the size of their contents.
+std::string objectName(std::uint64_t contents, std::size_t size) {
+  return hexadecimal(contents) + "-" + std::to_string(size);
+}
+
+// Entries are named by the hashes of their manifests.
+boost::filesystem::path entryPath(const boost::filesystem::path& root,
+                                  const std::string& manifest) {
+  return root / "entries" / hexadecimal(hash(manifest));
+}
+
+// The paths of the regular files in the directory relative to it, in a
+// deterministic order.
+std::vector<std::string> listFiles(const boost::filesystem::path& directory) {
+  std::vector<std::string> result;
+  boost::system::error_code error;
+  boost::filesystem::recursive_directory_iterator itr(directory, error);
+  for (; !error && itr != boost::filesystem::recursive_directory_iterator();
+       itr.increment(error)) {
+    if (boost::filesystem::is_regular_file(itr->status())) {
+      result.emplace_back(itr->path().lexically_relative(directory).string());
+    }
+  }
+  std::sort(std::begin(result), std::end(result));
+  return result;
+}
+
+// A unique temporary path next to the path, since builds running at once
+// may write the same file.
+std::string temporaryPath(const boost::filesystem::path& path) {
+  return (path.string() + "." +
+          boost::filesystem::unique_path("%%%%%%%%").string() + ".tmp");
+}
+
+// Writes the contents to a temporary file and moves it into place, so that
+// readers never see a partially written file.
+bool replace(const MappedFile& contents,
+             const boost::filesystem::path& path) {
+  boost::system::error_code error;
+  boost::filesystem::create_directories(path.parent_path(), error);
+  const auto temporary = temporaryPath(path);
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    stream.write(contents.data(), contents.size());
+    if (!stream.good()) {
+      stream.close();
+      boost::filesystem::remove(temporary, error);
+      return false;
+    }
+  }
+  boost::filesystem::rename(temporary, path, error);
+  if (error) {
+    boost::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+bool equal(const MappedFile& lhs, const MappedFile& rhs) {
+  return (lhs.size() == rhs.size() &&
+          (lhs.empty() ||
+           !std::memcmp(lhs.data(), rhs.data(), lhs.size())));
+}
+
+// Reads the entry, which consists of its manifest, an empty line and the
+// lines of the files of its outputs.
+bool readEntry(const boost::filesystem::path& path,
+               std::string *manifest,
+               std::string *files) {
+  assert(manifest);
+  assert(files);
+  std::ifstream stream(path.string(), std::ios::binary);
+  if (!stream) {
+    return false;
+  }
+  const std::string entry((std::istreambuf_iterator<char>(stream)),
+                          std::istreambuf_iterator<char>());
+  const auto separator = entry.find("\n\n");
+  if (separator == std::string::npos) {
+    return false;
+  }
+  *manifest = entry.substr(0, separator + 1);
+  *files = entry.substr(separator + 2);
+  return true;
+}
+
+// The number of seconds since the file was last written.
+std::int64_t age(const boost::filesystem::path& path, std::time_t now) {
+  boost::system::error_code error;
+  const auto time = boost::filesystem::last_write_time(path, error);
+  return error ? 0 : static_cast<std::int64_t>(now - time);
+}
+
+}  // namespace
+
+// MARK: Running
+
+bool ArtifactCache::run(const std::string& stage,
+                        const std::vector<std::string>& inputs,
+                        const std::vector<std::string>& outputs,
+                        const std::function<bool()>& function) const {
+  assert(function);
+  if (directory_.empty()) {
+    return function();
+  }
+  const auto manifest = this->manifest(stage, inputs);
+  if (restore(manifest, outputs)) {
+    return true;
+  }
+  if (!function()) {
+    return false;
+  }
+  // Failing to store or prune only makes the next build slower.
+  if (store(manifest, outputs)) {
+    prune();
+  }
+  return true;
+}
+
+// MARK: Manifests
+
+std::string ArtifactCache::manifest(
+    const std::string& stage,
+    const std::vector<std::string>& inputs) const {
+  // Every input has a line of whether it's a file, a directory or missing,
+  // and a directory is followed by the lines of its files.
+  std::ostringstream stream;
+  stream << "version " << kVersion << "\n";
+  stream << "tools " << hexadecimal(tools_status_) << "\n";
+  stream << "stage " << stage << "\n";
+  const auto describe = [&stream](std::size_t index,
+                                  const boost::filesystem::path& path,
+                                  const std::string& relative) {
+    const MappedFile contents(path.string());
+    stream << "input " << index << " "
+           << objectName(hash(contents.data(), contents.size()),
+                         contents.size());
+    if (!relative.empty()) {
+      stream << " " << relative;
+    }
+    stream << "\n";
+  };
+  for (std::size_t index{}; index < inputs.size(); ++index) {
+    const boost::filesystem::path input(inputs[index]);
+    boost::system::error_code error;
+    const auto status = boost::filesystem::status(input, error);
+    if (boost::filesystem::is_directory(status)) {
+      stream << "input " << index << " directory\n";
+      for (const auto& file : listFiles(input)) {
+        describe(index, input / file, file);
+      }
+    } else if (boost::filesystem::is_regular_file(status)) {
+      describe(index, input, std::string());
+    } else {
+      stream << "input " << index << " missing\n";
+    }
+  }
+  return stream.str();
+}
+
+void ArtifactCache::hashStatus(const std::string& path, Hasher *hasher) {
+  assert(hasher);
+  const boost::filesystem::path directory(path);
+  const auto files = listFiles(directory);
+  hasher->update(files.size());
+  for (const auto& file : files) {
+    boost::system::error_code error;
+    const auto size = boost::filesystem::file_size(directory / file, error);
+    const auto time = boost::filesystem::last_write_time(
+        directory / file, error);
+    hasher->update(file);
+    hasher->update(static_cast<std::uint64_t>(size));
+    hasher->update(static_cast<std::int64_t>(time));
+  }
+}
+
+// MARK: Tools
+
+void ArtifactCache::set_tools(const std::string& value) {
+  tools_ = value;
+  Hasher hasher;
+  hashStatus(tools_, &hasher);
+  tools_status_ = hasher.value();
+}
+
+// MARK: Restoring and storing
+
+bool ArtifactCache::restore(const std::string& manifest,
+                            const std::vector<std::string>& outputs) const {
+  const boost::filesystem::path root(directory_);
+  const auto entry = entryPath(root, manifest);
+  std::string entry_manifest;
+  std::string entry_files;
+  // The entry is of other inputs when only the hashes of the manifests
+  // collide.
+  if (!readEntry(entry, &entry_manifest, &entry_files) ||
+      entry_manifest != manifest) {
+    return false;
+  }
+  // Every line has the index of the output, the name of the object, and the
+  // path relative to the output when it's a directory.
+  struct File final {
+    std::size_t index;
+    std::string path;
+    MappedFile contents;
+  };
+  std::vector<File> files;
+  std::istringstream stream(entry_files);
+  std::string line;
+  while (std::getline(stream, line)) {
+    std::istringstream fields(line);
+    std::size_t index;
+    std::string name;
+    std::string path;
+    if (!(fields >> index >> name) || index >= outputs.size()) {
+      return false;
+    }
+    std::getline(fields >> std::ws, path);
+    const auto object = root / "objects" / name;
+    MappedFile contents(object.string());
+    if (!contents.is_open()) {
+      return false;  // Evicted
+    }
+    // Verify the contents of the object against its name before anything
+    // is replaced, and drop the object when it's corrupt.
+    if (objectName(hash(contents.data(), contents.size()),
+                   contents.size()) != name) {
+      contents.close();
+      boost::system::error_code error;
+      boost::filesystem::remove(object, error);
+      return false;
+    }
+    files.push_back(File{index, path, std::move(contents)});
+  }
+  std::vector<std::set<std::string>> restored(outputs.size());
+  for (const auto& file : files) {
+    auto path = boost::filesystem::path(outputs[file.index]);
+    if (!file.path.empty()) {
+      path /= file.path;
+      restored[file.index].emplace(file.path);
+    }
+    if (!replace(file.contents, path)) {
+      return false;
+    }
+  }
+  // Remove the files in directories that the cached run didn't produce.
+  for (std::size_t index{}; index < outputs.size(); ++index) {
+    const boost::filesystem::path output(outputs[index]);
+    boost::system::error_code error;
+    if (!boost::filesystem::is_directory(output, error)) {
+      continue;
+    }
+    for (const auto& file : listFiles(output)) {
+      if (!restored[index].count(file)) {
+        boost::filesystem::remove(output / file, error);
+        if (error) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool ArtifactCache::store(const std::string& manifest,
+                          const std::vector<std::string>& outputs) const {
+  const boost::filesystem::path root(directory_);
+  boost::system::error_code error;
+  boost::filesystem::create_directories(root / "objects", error);
+  boost::filesystem::create_directories(root / "entries", error);
+  std::ostringstream entry;
+  entry << manifest << "\n";
+  const auto add = [&root, &entry](std::size_t index,
+                                   const boost::filesystem::path& path,
+                                   const std::string& relative) {
+    const MappedFile file(path.string());
+    if (!file.is_open()) {
+      return false;
+    }
+    const auto name = objectName(hash(file.data(), file.size()), file.size());
+    const auto object = root / "objects" / name;
+    // An existing object with other contents is corrupt, and is replaced.
+    // Otherwise it's touched so that pruning leaves it for this entry.
+    const MappedFile existing(object.string());
+    if (existing.is_open() && equal(existing, file)) {
+      boost::system::error_code error;
+      boost::filesystem::last_write_time(object, std::time(nullptr), error);
+    } else if (!replace(file, object)) {
+      return false;
+    }
+    entry << index << " " << name << " " << relative << "\n";
+    return true;
+  };
+  for (std::size_t index{}; index < outputs.size(); ++index) {
+    const boost::filesystem::path output(outputs[index]);
+    if (boost::filesystem::is_directory(output, error)) {
+      for (const auto& file : listFiles(output)) {
+        if (!add(index, output / file, file)) {
+          return false;
+        }
+      }
+    } else if (!add(index, output, std::string())) {
+      return false;
+    }
+  }
+  const auto path = entryPath(root, manifest);
+  const auto temporary = temporaryPath(path);
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    stream << entry.str();
+    if (!stream.good()) {
+      return false;
+    }
+  }
+  boost::filesystem::rename(temporary, path, error);
+  if (error) {
+    boost::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+// MARK: Pruning
+
+void ArtifactCache::prune() const {
+  const boost::filesystem::path root(directory_);
+  const auto now = std::time(nullptr);
+  boost::system::error_code error;
+  std::map<std::string, std::uint64_t> sizes;
+  boost::filesystem::directory_iterator itr(root / "objects", error);
+  for (; !error && itr != boost::filesystem::directory_iterator();
+       itr.increment(error)) {
+    boost::system::error_code size_error;
+    const auto size = boost::filesystem::file_size(itr->path(), size_error);
+    sizes.emplace(itr->path().filename().string(), size_error ? 0 : size);
+  }
+
+  // Visit the entries from the most recently used one, keeping them until
+  // the objects they refer to exceed the maximum size.
+  struct Entry final {
+    boost::filesystem::path path;
+    std::int64_t age;
+  };
+  std::vector<Entry> entries;
+  itr = boost::filesystem::directory_iterator(root / "entries", error);
+  for (; !error && itr != boost::filesystem::directory_iterator();
+       itr.increment(error)) {
+    entries.push_back(Entry{itr->path(), age(itr->path(), now)});
+  }
+  std::stable_sort(std::begin(entries), std::end(entries),
+                   [](const Entry& lhs, const Entry& rhs) {
+    return lhs.age < rhs.age;
+  });
+  std::set<std::string> referenced;
+  std::uint64_t size{};
+  for (const auto& entry : entries) {
+    // Entries that another build is storing are left for a while.
+    if (entry.path.extension() == ".tmp") {
+      if (entry.age > kGracePeriod) {
+        boost::filesystem::remove(entry.path, error);
+      }
+      continue;
+    }
+    // Entries of the earlier versions have no manifests.
+    std::string manifest;
+    std::string files;
+    if (!readEntry(entry.path, &manifest, &files)) {
+      boost::filesystem::remove(entry.path, error);
+      continue;
+    }
+    std::set<std::string> names;
+    std::uint64_t added{};
+    std::istringstream stream(files);
+    std::string line;
+    while (std::getline(stream, line)) {
+      std::istringstream fields(line);
+      std::size_t index;
+      std::string name;
+      if ((fields >> index >> name) && !referenced.count(name) &&
+          names.emplace(name).second) {
+        const auto found = sizes.find(name);
+        added += found == std::end(sizes) ? 0 : found->second;
+      }
+    }
+    if (entry.age > max_age_ || size + added > max_size_) {
+      boost::filesystem::remove(entry.path, error);
+      continue;
+    }
+    referenced.insert(std::begin(names), std::end(names));
+    size += added;
+  }
+
+  // Objects of another build may be stored before its entry is.
+  for (const auto& object : sizes) {
+    const auto path = root / "objects" / object.first;
+    if (!referenced.count(object.first) && age(path, now) > kGracePeriod) {
+      boost::filesystem::remove(path, error);
+    }
+  }
+}
+
+}  // namespace token
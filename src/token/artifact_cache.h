@@ -0,0 +1,100 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_ARTIFACT_CACHE_H_
+#define TOKEN_ARTIFACT_CACHE_H_
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "token/hash.h"
+
+namespace token {
+
+// A local cache of the files that build stages produce. The outputs of a
+// stage are recorded in an entry keyed by the hash of its manifest, which
+// lists the name of the stage, the hashes and sizes of the contents of its
+// inputs and the files of the tools. Entries keep their manifests so that
+// inputs whose hashes collide aren't mistaken for each other. The contents
+// of the files are stored once by their hashes and sizes so that entries
+// share identical files. Inputs and outputs are either files or directories
+// of files, and a directory is restored to exactly the files it had.
+class ArtifactCache final {
+ public:
+  ArtifactCache();
+  explicit ArtifactCache(const std::string& directory);
+
+  // Copy semantics
+  ArtifactCache(const ArtifactCache&) = default;
+  ArtifactCache& operator=(const ArtifactCache&) = default;
+
+  // Running
+  // Restores the outputs if they are cached for the inputs, or otherwise
+  // runs the function and stores the outputs when it succeeds, pruning the
+  // cache afterwards.
+  bool run(const std::string& stage,
+           const std::vector<std::string>& inputs,
+           const std::vector<std::string>& outputs,
+           const std::function<bool()>& function) const;
+
+  // Manifests
+  std::string manifest(const std::string& stage,
+                       const std::vector<std::string>& inputs) const;
+  static void hashStatus(const std::string& path, Hasher *hasher);
+
+  // Restoring and storing
+  bool restore(const std::string& manifest,
+               const std::vector<std::string>& outputs) const;
+  bool store(const std::string& manifest,
+             const std::vector<std::string>& outputs) const;
+
+  // Pruning
+  // Removes the least recently used entries beyond the maximum size or age,
+  // and then the objects that no entry refers to.
+  void prune() const;
+
+  // Attributes
+  const std::string& directory() const { return directory_; }
+  void set_directory(const std::string& value) { directory_ = value; }
+
+  // The directory of the tools that the stages run, including the scripts
+  // and libraries they load. Its files are fingerprinted by their paths,
+  // sizes and modification times when it's set, so that updating any of
+  // them invalidates the entries.
+  const std::string& tools() const { return tools_; }
+  void set_tools(const std::string& value);
+
+  // Parameters
+  // The total size of the objects in bytes, and the time in seconds since
+  // an entry was last stored or restored, beyond which entries are pruned.
+  std::uint64_t max_size() const { return max_size_; }
+  void set_max_size(std::uint64_t value) { max_size_ = value; }
+  std::int64_t max_age() const { return max_age_; }
+  void set_max_age(std::int64_t value) { max_age_ = value; }
+
+ private:
+  std::string directory_;
+  std::string tools_;
+  std::uint64_t tools_status_;
+  std::uint64_t max_size_;
+  std::int64_t max_age_;
+};
+
+// MARK: -
+
+inline ArtifactCache::ArtifactCache()
+    : tools_status_(),
+      max_size_(std::uint64_t(1) << 30),
+      max_age_(30 * 24 * 60 * 60) {}
+
+inline ArtifactCache::ArtifactCache(const std::string& directory)
+    : ArtifactCache() {
+  directory_ = directory;
+}
+
+}  // namespace token
+
+#endif  // TOKEN_ARTIFACT_CACHE_H_
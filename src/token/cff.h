@@ -0,0 +1,16 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_H_
+#define TOKEN_CFF_H_
+
+#include "token/cff/charstring.h"
+#include "token/cff/dict.h"
+#include "token/cff/font.h"
+#include "token/cff/hinter.h"
+#include "token/cff/index.h"
+#include "token/cff/subroutinizer.h"
+#include "token/cff/table.h"
+
+#endif  // TOKEN_CFF_H_
@@ -0,0 +1,353 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/charstring.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+struct Point final {
+  double x;
+  double y;
+};
+
+inline Point roundPoint(const shota::Vec2d& point) {
+  return Point{std::round(point.x), std::round(point.y)};
+}
+
+inline bool operator==(const Point& lhs, const Point& rhs) {
+  return lhs.x == rhs.x && lhs.y == rhs.y;
+}
+
+// The direction of a tangent, which is horizontal, vertical or neither.
+enum class Tangent { HORIZONTAL, VERTICAL, OTHER };
+
+inline Tangent tangent(double dx, double dy) {
+  if (dy == 0.0) {
+    return Tangent::HORIZONTAL;
+  } else if (dx == 0.0) {
+    return Tangent::VERTICAL;
+  }
+  return Tangent::OTHER;
+}
+
+Operation specializeCurve(const std::vector<double>& args) {
+  assert(args.size() == 6);
+  const auto dx1 = args[0], dy1 = args[1];
+  const auto dx2 = args[2], dy2 = args[3];
+  const auto dx3 = args[4], dy3 = args[5];
+  const auto start = tangent(dx1, dy1);
+  const auto end = tangent(dx3, dy3);
+  if (start == Tangent::HORIZONTAL) {
+    switch (end) {
+      case Tangent::HORIZONTAL:
+        return Operation(Operator::HHCURVETO, {dx1, dx2, dy2, dx3});
+      case Tangent::VERTICAL:
+        return Operation(Operator::HVCURVETO, {dx1, dx2, dy2, dy3});
+      default:
+        return Operation(Operator::HVCURVETO, {dx1, dx2, dy2, dy3, dx3});
+    }
+  } else if (start == Tangent::VERTICAL) {
+    switch (end) {
+      case Tangent::HORIZONTAL:
+        return Operation(Operator::VHCURVETO, {dy1, dx2, dy2, dx3});
+      case Tangent::VERTICAL:
+        return Operation(Operator::VVCURVETO, {dy1, dx2, dy2, dy3});
+      default:
+        return Operation(Operator::VHCURVETO, {dy1, dx2, dy2, dx3, dy3});
+    }
+  }
+  switch (end) {
+    case Tangent::HORIZONTAL:
+      return Operation(Operator::HHCURVETO, {dy1, dx1, dx2, dy2, dx3});
+    case Tangent::VERTICAL:
+      return Operation(Operator::VVCURVETO, {dx1, dy1, dx2, dy2, dy3});
+    default:
+      break;
+  }
+  return Operation(Operator::RRCURVETO, args);
+}
+
+// Returns whether the operation can be followed by the next one in a single
+// operator, and which operator the result has.
+bool mergeable(const Operation& operation,
+               const Operation& next,
+               Operator *result) {
+  const auto size = operation.operands.size();
+  const auto next_size = next.operands.size();
+  *result = operation.op;
+  switch (operation.op) {
+    case Operator::RLINETO:
+      if (next.op == Operator::RLINETO) {
+        return true;
+      } else if (next.op == Operator::RRCURVETO) {
+        *result = Operator::RLINECURVE;
+        return true;
+      }
+      return false;
+    case Operator::RRCURVETO:
+      if (next.op == Operator::RRCURVETO) {
+        return true;
+      } else if (next.op == Operator::RLINETO && next_size == 2) {
+        *result = Operator::RCURVELINE;
+        return true;
+      }
+      return false;
+    case Operator::HLINETO:
+    case Operator::VLINETO: {
+      // Lines alternate between horizontal and vertical.
+      if (next.op != Operator::HLINETO && next.op != Operator::VLINETO) {
+        return false;
+      }
+      const bool horizontal = ((operation.op == Operator::HLINETO) ==
+                               (size % 2 == 0));
+      return (next.op == Operator::HLINETO) == horizontal;
+    }
+    case Operator::HHCURVETO:
+    case Operator::VVCURVETO:
+      // Only the first curve can have the extra leading operand.
+      return next.op == operation.op && next_size % 4 == 0;
+    case Operator::HVCURVETO:
+    case Operator::VHCURVETO: {
+      // Curves alternate between starting horizontal and vertical, and only
+      // the last curve can have the extra trailing operand.
+      if (size % 4 != 0 || (next.op != Operator::HVCURVETO &&
+                            next.op != Operator::VHCURVETO)) {
+        return false;
+      }
+      const bool horizontal = ((operation.op == Operator::HVCURVETO) ==
+                               (size / 4 % 2 == 0));
+      return (next.op == Operator::HVCURVETO) == horizontal;
+    }
+    default:
+      break;
+  }
+  return false;
+}
+
+}  // namespace
+
+constexpr std::size_t CharString::stack_limit;
+
+CharString::CharString(const shota::Shape2d& shape, double width)
+    : width_(width) {
+  generalize(shape);
+  specialize();
+  merge();
+}
+
+CharString::CharString(const std::vector<Operation>& operations,
+                       double width)
+    : width_(width),
+      operations_(operations) {
+  specialize();
+  merge();
+}
+
+// MARK: Encoding
+
+std::string CharString::encode(double default_width,
+                               double nominal_width) const {
+  std::string result;
+  const bool has_width = (width_ != default_width);
+  if (operations_.empty()) {
+    if (has_width) {
+      encodeNumber(width_ - nominal_width, &result);
+    }
+  } else {
+    // The width is the first operand of the first stack-clearing operator,
+    // which is either a hint or a move.
+    auto first = operations_.front();
+    if (has_width) {
+      first.operands.insert(std::begin(first.operands),
+                            width_ - nominal_width);
+    }
+    encodeOperation(first, &result);
+    for (auto itr = std::next(std::begin(operations_));
+         itr != std::end(operations_); ++itr) {
+      encodeOperation(*itr, &result);
+    }
+  }
+  result.push_back(static_cast<char>(Operator::ENDCHAR));
+  return result;
+}
+
+void CharString::encodeNumber(double value, std::string *output) {
+  assert(output);
+  if (std::round(value) == value && value >= -32768.0 && value <= 32767.0) {
+    const auto number = static_cast<int>(value);
+    if (number >= -107 && number <= 107) {
+      output->push_back(static_cast<char>(number + 139));
+    } else if (number >= 108 && number <= 1131) {
+      const auto shifted = number - 108;
+      output->push_back(static_cast<char>((shifted >> 8) + 247));
+      output->push_back(static_cast<char>(shifted & 0xff));
+    } else if (number >= -1131 && number <= -108) {
+      const auto shifted = -number - 108;
+      output->push_back(static_cast<char>((shifted >> 8) + 251));
+      output->push_back(static_cast<char>(shifted & 0xff));
+    } else {
+      output->push_back(28);
+      output->push_back(static_cast<char>((number >> 8) & 0xff));
+      output->push_back(static_cast<char>(number & 0xff));
+    }
+    return;
+  }
+  // Fractional values are encoded in 16.16 fixed point.
+  const auto fixed = static_cast<std::int32_t>(std::round(value * 65536.0));
+  const auto bits = static_cast<std::uint32_t>(fixed);
+  output->push_back(static_cast<char>(255));
+  output->push_back(static_cast<char>((bits >> 24) & 0xff));
+  output->push_back(static_cast<char>((bits >> 16) & 0xff));
+  output->push_back(static_cast<char>((bits >> 8) & 0xff));
+  output->push_back(static_cast<char>(bits & 0xff));
+}
+
+void CharString::encodeOperation(const Operation& operation,
+                                 std::string *output) {
+  assert(output);
+  for (const auto operand : operation.operands) {
+    encodeNumber(operand, output);
+  }
+  const auto op = static_cast<int>(operation.op);
+  if (op >= 1200) {
+    output->push_back(12);
+    output->push_back(static_cast<char>(op - 1200));
+  } else {
+    output->push_back(static_cast<char>(op));
+  }
+  output->append(operation.mask);
+}
+
+// MARK: Conversion
+
+void CharString::generalize(const shota::Shape2d& shape) {
+  auto cubic = shape;
+  cubic.convertConicsToQuadratics();
+  cubic.convertQuadraticsToCubics();
+
+  // Coordinates are rounded before taking differences, so that rounding
+  // errors don't accumulate along a path.
+  Point current{};
+  Point start{};
+  Point previous{};
+  std::size_t path_begin{};
+  for (const auto& path : cubic.paths()) {
+    for (const auto& command : path) {
+      switch (command.type()) {
+        case shota::graphics::CommandType::MOVE: {
+          const auto point = roundPoint(command.point());
+          path_begin = operations_.size();
+          operations_.emplace_back(Operator::RMOVETO, std::vector<double>{
+              point.x - current.x, point.y - current.y});
+          previous = current;
+          current = start = point;
+          break;
+        }
+        case shota::graphics::CommandType::LINE: {
+          const auto point = roundPoint(command.point());
+          if (point == current) {
+            break;
+          }
+          operations_.emplace_back(Operator::RLINETO, std::vector<double>{
+              point.x - current.x, point.y - current.y});
+          previous = current;
+          current = point;
+          break;
+        }
+        case shota::graphics::CommandType::CUBIC: {
+          const auto control1 = roundPoint(command.control1());
+          const auto control2 = roundPoint(command.control2());
+          const auto point = roundPoint(command.point());
+          operations_.emplace_back(Operator::RRCURVETO, std::vector<double>{
+              control1.x - current.x, control1.y - current.y,
+              control2.x - control1.x, control2.y - control1.y,
+              point.x - control2.x, point.y - control2.y});
+          previous = current;
+          current = point;
+          break;
+        }
+        case shota::graphics::CommandType::CLOSE:
+          break;
+        default:
+          assert(false);
+          break;
+      }
+    }
+    if (operations_.size() <= path_begin) {
+      continue;
+    }
+    // Paths are closed implicitly by a line, which makes an explicit line
+    // back to the start redundant. A path without segments is dropped.
+    const auto& last = operations_.back();
+    if (operations_.size() == path_begin + 1 ||
+        (last.op == Operator::RLINETO && current == start)) {
+      operations_.pop_back();
+      current = previous;
+    }
+  }
+}
+
+void CharString::specialize() {
+  for (auto& operation : operations_) {
+    auto& operands = operation.operands;
+    switch (operation.op) {
+      case Operator::RMOVETO:
+        if (operands[0] == 0.0) {
+          operation = Operation(Operator::VMOVETO, {operands[1]});
+        } else if (operands[1] == 0.0) {
+          operation = Operation(Operator::HMOVETO, {operands[0]});
+        }
+        break;
+      case Operator::RLINETO:
+        if (operands[0] == 0.0) {
+          operation = Operation(Operator::VLINETO, {operands[1]});
+        } else if (operands[1] == 0.0) {
+          operation = Operation(Operator::HLINETO, {operands[0]});
+        }
+        break;
+      case Operator::RRCURVETO:
+        operation = specializeCurve(operands);
+        break;
+      default:
+        break;
+    }
+  }
+}
+
+void CharString::merge() {
+  std::vector<Operation> result;
+  result.reserve(operations_.size());
+  for (auto& operation : operations_) {
+    if (!result.empty()) {
+      auto& back = result.back();
+      Operator op;
+      if (back.operands.size() + operation.operands.size() <= stack_limit &&
+          mergeable(back, operation, &op)) {
+        back.op = op;
+        back.operands.insert(std::end(back.operands),
+                             std::begin(operation.operands),
+                             std::end(operation.operands));
+        continue;
+      }
+    }
+    result.emplace_back(std::move(operation));
+  }
+  operations_ = std::move(result);
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,124 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_CHARSTRING_H_
+#define TOKEN_CFF_CHARSTRING_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+namespace cff {
+
+namespace shota = shotamatsuda;
+
+// Type 2 charstring operators. Two-byte operators are offset by 1200.
+enum class Operator : int {
+  HSTEM = 1,
+  VSTEM = 3,
+  VMOVETO = 4,
+  RLINETO = 5,
+  HLINETO = 6,
+  VLINETO = 7,
+  RRCURVETO = 8,
+  CALLSUBR = 10,
+  RETURN = 11,
+  ENDCHAR = 14,
+  HSTEMHM = 18,
+  HINTMASK = 19,
+  CNTRMASK = 20,
+  RMOVETO = 21,
+  HMOVETO = 22,
+  VSTEMHM = 23,
+  RCURVELINE = 24,
+  RLINECURVE = 25,
+  VVCURVETO = 26,
+  HHCURVETO = 27,
+  CALLGSUBR = 29,
+  VHCURVETO = 30,
+  HVCURVETO = 31
+};
+
+struct Operation final {
+  Operation() = default;
+  Operation(Operator op, const std::vector<double>& operands);
+
+  Operator op;
+  std::vector<double> operands;
+
+  // The mask bytes that follow hintmask and cntrmask.
+  std::string mask;
+};
+
+bool operator==(const Operation& lhs, const Operation& rhs);
+bool operator!=(const Operation& lhs, const Operation& rhs);
+
+// A glyph program in the Type 2 charstring format. Outlines are converted to
+// relative operations, and then specialized into the shortest operators,
+// merging runs of lines and curves into single operators wherever the
+// argument stack allows.
+class CharString final {
+ public:
+  // The maximum number of operands in the argument stack.
+  static constexpr std::size_t stack_limit = 48;
+
+ public:
+  CharString();
+  CharString(const shota::Shape2d& shape, double width);
+
+  // Specializes operations that only use rmoveto, rlineto, rrcurveto and
+  // hint operators.
+  CharString(const std::vector<Operation>& operations, double width);
+
+  // Copy semantics
+  CharString(const CharString&) = default;
+  CharString& operator=(const CharString&) = default;
+
+  // Attributes
+  double width() const { return width_; }
+  void set_width(double value) { width_ = value; }
+  const std::vector<Operation>& operations() const { return operations_; }
+  std::vector<Operation>& operations() { return operations_; }
+
+  // Encoding
+  std::string encode(double default_width, double nominal_width) const;
+  static void encodeNumber(double value, std::string *output);
+  static void encodeOperation(const Operation& operation,
+                              std::string *output);
+
+ private:
+  void generalize(const shota::Shape2d& shape);
+  void specialize();
+  void merge();
+
+ private:
+  double width_;
+  std::vector<Operation> operations_;
+};
+
+// MARK: -
+
+inline Operation::Operation(Operator op, const std::vector<double>& operands)
+    : op(op),
+      operands(operands) {}
+
+inline bool operator==(const Operation& lhs, const Operation& rhs) {
+  return (lhs.op == rhs.op &&
+          lhs.operands == rhs.operands &&
+          lhs.mask == rhs.mask);
+}
+
+inline bool operator!=(const Operation& lhs, const Operation& rhs) {
+  return !(lhs == rhs);
+}
+
+inline CharString::CharString() : width_() {}
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_CHARSTRING_H_
@@ -0,0 +1,257 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/dict.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace token {
+namespace cff {
+
+// MARK: Entries
+
+void Dict::set(int op, double operand) {
+  set(op, std::vector<double>{operand});
+}
+
+void Dict::set(int op, const std::vector<double>& operands) {
+  const auto entry = find(op);
+  if (entry) {
+    entry->operands = operands;
+    entry->offset = false;
+  } else {
+    entries_.push_back(Entry{op, operands, false});
+  }
+}
+
+void Dict::setDelta(int op, const std::vector<double>& operands) {
+  std::vector<double> deltas;
+  deltas.reserve(operands.size());
+  double previous{};
+  for (const auto operand : operands) {
+    deltas.emplace_back(operand - previous);
+    previous = operand;
+  }
+  set(op, deltas);
+}
+
+void Dict::setOffset(int op, const std::vector<double>& operands) {
+  set(op, operands);
+  find(op)->offset = true;
+}
+
+const std::vector<double> * Dict::get(int op) const {
+  for (const auto& entry : entries_) {
+    if (entry.op == op) {
+      return &entry.operands;
+    }
+  }
+  return nullptr;
+}
+
+Dict::Entry * Dict::find(int op) {
+  for (auto& entry : entries_) {
+    if (entry.op == op) {
+      return &entry;
+    }
+  }
+  return nullptr;
+}
+
+// MARK: Encoding and decoding
+
+std::string Dict::encode() const {
+  std::string result;
+  for (const auto& entry : entries_) {
+    for (const auto operand : entry.operands) {
+      if (entry.offset) {
+        encodeInteger(static_cast<int>(operand), true, &result);
+      } else {
+        encodeNumber(operand, &result);
+      }
+    }
+    if (entry.op >= 1200) {
+      result.push_back(12);
+      result.push_back(static_cast<char>(entry.op - 1200));
+    } else {
+      result.push_back(static_cast<char>(entry.op));
+    }
+  }
+  return result;
+}
+
+bool Dict::decode(const std::string& data) {
+  entries_.clear();
+  std::vector<double> operands;
+  std::size_t position{};
+  const auto byte = [&data](std::size_t offset) {
+    return static_cast<std::uint8_t>(data[offset]);
+  };
+  while (position < data.size()) {
+    const int b0 = byte(position++);
+    if (b0 <= 21) {
+      int op = b0;
+      if (b0 == 12) {
+        if (position >= data.size()) {
+          return false;
+        }
+        op = 1200 + byte(position++);
+      }
+      // Offsets to other structures are marked, so that they are encoded
+      // again in 5 bytes and can be relocated without changing the size.
+      const bool offset = (op == 15 || op == 16 || op == 17 || op == 18 ||
+                           op == 1236 || op == 1237);
+      entries_.push_back(Entry{op, std::move(operands), offset});
+      operands.clear();
+    } else if (b0 == 28) {
+      if (position + 2 > data.size()) {
+        return false;
+      }
+      operands.emplace_back(static_cast<std::int16_t>(
+          (byte(position) << 8) | byte(position + 1)));
+      position += 2;
+    } else if (b0 == 29) {
+      if (position + 4 > data.size()) {
+        return false;
+      }
+      operands.emplace_back(static_cast<std::int32_t>(
+          (static_cast<std::uint32_t>(byte(position)) << 24) |
+          (byte(position + 1) << 16) |
+          (byte(position + 2) << 8) |
+          byte(position + 3)));
+      position += 4;
+    } else if (b0 == 30) {
+      double value;
+      if (!decodeReal(data, &position, &value)) {
+        return false;
+      }
+      operands.emplace_back(value);
+    } else if (b0 >= 32 && b0 <= 246) {
+      operands.emplace_back(b0 - 139);
+    } else if (b0 >= 247 && b0 <= 254) {
+      if (position >= data.size()) {
+        return false;
+      }
+      const int b1 = byte(position++);
+      if (b0 <= 250) {
+        operands.emplace_back((b0 - 247) * 256 + b1 + 108);
+      } else {
+        operands.emplace_back(-(b0 - 251) * 256 - b1 - 108);
+      }
+    } else {
+      return false;  // Reserved
+    }
+  }
+  return operands.empty();
+}
+
+bool Dict::decodeReal(const std::string& data,
+                      std::size_t *position,
+                      double *value) {
+  assert(position);
+  assert(value);
+  std::string text;
+  while (*position < data.size()) {
+    const auto b = static_cast<std::uint8_t>(data[(*position)++]);
+    for (const int nibble : {b >> 4, b & 0xf}) {
+      if (nibble <= 9) {
+        text.push_back(static_cast<char>('0' + nibble));
+      } else if (nibble == 0xa) {
+        text.push_back('.');
+      } else if (nibble == 0xb) {
+        text.push_back('e');
+      } else if (nibble == 0xc) {
+        text += "e-";
+      } else if (nibble == 0xe) {
+        text.push_back('-');
+      } else if (nibble == 0xf) {
+        *value = std::strtod(text.c_str(), nullptr);
+        return true;
+      } else {
+        return false;  // Reserved
+      }
+    }
+  }
+  return false;
+}
+
+void Dict::encodeNumber(double value, std::string *output) {
+  assert(output);
+  if (std::round(value) == value && std::abs(value) < 2147483648.0) {
+    encodeInteger(static_cast<int>(value), false, output);
+    return;
+  }
+  // Real numbers are encoded in nibbles of decimal digits.
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%.8g", value);
+  std::string nibbles;
+  for (const char *c = buffer; *c; ++c) {
+    if (*c >= '0' && *c <= '9') {
+      nibbles.push_back(*c - '0');
+    } else if (*c == '.') {
+      nibbles.push_back(0xa);
+    } else if (*c == '-') {
+      nibbles.push_back(0xe);
+    } else if (*c == 'e' || *c == 'E') {
+      if (c[1] == '-') {
+        nibbles.push_back(0xc);
+        ++c;
+      } else {
+        nibbles.push_back(0xb);
+        if (c[1] == '+') {
+          ++c;
+        }
+      }
+    }
+  }
+  nibbles.push_back(0xf);
+  if (nibbles.size() % 2) {
+    nibbles.push_back(0xf);
+  }
+  output->push_back(30);
+  for (std::size_t i{}; i < nibbles.size(); i += 2) {
+    output->push_back(static_cast<char>((nibbles[i] << 4) | nibbles[i + 1]));
+  }
+}
+
+void Dict::encodeInteger(int value, bool fixed, std::string *output) {
+  assert(output);
+  if (!fixed) {
+    if (value >= -107 && value <= 107) {
+      output->push_back(static_cast<char>(value + 139));
+      return;
+    } else if (value >= 108 && value <= 1131) {
+      const auto shifted = value - 108;
+      output->push_back(static_cast<char>((shifted >> 8) + 247));
+      output->push_back(static_cast<char>(shifted & 0xff));
+      return;
+    } else if (value >= -1131 && value <= -108) {
+      const auto shifted = -value - 108;
+      output->push_back(static_cast<char>((shifted >> 8) + 251));
+      output->push_back(static_cast<char>(shifted & 0xff));
+      return;
+    } else if (value >= -32768 && value <= 32767) {
+      output->push_back(28);
+      output->push_back(static_cast<char>((value >> 8) & 0xff));
+      output->push_back(static_cast<char>(value & 0xff));
+      return;
+    }
+  }
+  const auto bits = static_cast<std::uint32_t>(value);
+  output->push_back(29);
+  output->push_back(static_cast<char>((bits >> 24) & 0xff));
+  output->push_back(static_cast<char>((bits >> 16) & 0xff));
+  output->push_back(static_cast<char>((bits >> 8) & 0xff));
+  output->push_back(static_cast<char>(bits & 0xff));
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,64 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_DICT_H_
+#define TOKEN_CFF_DICT_H_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace token {
+namespace cff {
+
+// A DICT structure of CFF, which keeps the order of its entries. Operators
+// with two bytes are offset by 1200 as in charstrings.
+class Dict final {
+ public:
+  struct Entry final {
+    int op;
+    std::vector<double> operands;
+
+    // Offsets are always encoded in 5 bytes, so that the size of the DICT
+    // doesn't depend on the values of the offsets it contains.
+    bool offset;
+  };
+
+ public:
+  Dict() = default;
+
+  // Copy semantics
+  Dict(const Dict&) = default;
+  Dict& operator=(const Dict&) = default;
+
+  // Entries
+  bool empty() const { return entries_.empty(); }
+  const std::vector<Entry>& entries() const { return entries_; }
+  const std::vector<double> * get(int op) const;
+  void set(int op, double operand);
+  void set(int op, const std::vector<double>& operands);
+  void setDelta(int op, const std::vector<double>& operands);
+  void setOffset(int op, const std::vector<double>& operands);
+
+  // Encoding and decoding
+  std::string encode() const;
+  bool decode(const std::string& data);
+  static void encodeNumber(double value, std::string *output);
+  static void encodeInteger(int value, bool fixed, std::string *output);
+
+ private:
+  Entry * find(int op);
+  static bool decodeReal(const std::string& data,
+                         std::size_t *position,
+                         double *value);
+
+ private:
+  std::vector<Entry> entries_;
+};
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_DICT_H_
@@ -0,0 +1,361 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/font.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/cff/charstring.h"
+#include "token/cff/dict.h"
+#include "token/cff/index.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+// The leading part of the standard strings of CFF, which covers the names of
+// the glyphs in the standard encodings. The rest of the standard strings are
+// names of expert glyphs, which are stored in the String INDEX when used.
+const char * const kStandardStrings[] = {
+  ".notdef", "space", "exclam", "quotedbl", "numbersign", "dollar",
+  "percent", "ampersand", "quoteright", "parenleft", "parenright",
+  "asterisk", "plus", "comma", "hyphen", "period", "slash", "zero", "one",
+  "two", "three", "four", "five", "six", "seven", "eight", "nine", "colon",
+  "semicolon", "less", "equal", "greater", "question", "at", "A", "B", "C",
+  "D", "E", "F", "G", "H", "I", "J", "K", "L", "M", "N", "O", "P", "Q", "R",
+  "S", "T", "U", "V", "W", "X", "Y", "Z", "bracketleft", "backslash",
+  "bracketright", "asciicircum", "underscore", "quoteleft", "a", "b", "c",
+  "d", "e", "f", "g", "h", "i", "j", "k", "l", "m", "n", "o", "p", "q", "r",
+  "s", "t", "u", "v", "w", "x", "y", "z", "braceleft", "bar", "braceright",
+  "asciitilde", "exclamdown", "cent", "sterling", "fraction", "yen",
+  "florin", "section", "currency", "quotesingle", "quotedblleft",
+  "guillemotleft", "guilsinglleft", "guilsinglright", "fi", "fl", "endash",
+  "dagger", "daggerdbl", "periodcentered", "paragraph", "bullet",
+  "quotesinglbase", "quotedblbase", "quotedblright", "guillemotright",
+  "ellipsis", "perthousand", "questiondown", "grave", "acute", "circumflex",
+  "tilde", "macron", "breve", "dotaccent", "dieresis", "ring", "cedilla",
+  "hungarumlaut", "ogonek", "caron", "emdash", "AE", "ordfeminine",
+  "Lslash", "Oslash", "OE", "ordmasculine", "ae", "dotlessi", "lslash",
+  "oslash", "oe", "germandbls", "onesuperior", "logicalnot", "mu",
+  "trademark", "Eth", "onehalf", "plusminus", "Thorn", "onequarter",
+  "divide", "brokenbar", "degree", "thorn", "threequarters", "twosuperior",
+  "registered", "minus", "eth", "multiply", "threesuperior", "copyright",
+  "Aacute", "Acircumflex", "Adieresis", "Agrave", "Aring", "Atilde",
+  "Ccedilla", "Eacute", "Ecircumflex", "Edieresis", "Egrave", "Iacute",
+  "Icircumflex", "Idieresis", "Igrave", "Ntilde", "Oacute", "Ocircumflex",
+  "Odieresis", "Ograve", "Otilde", "Scaron", "Uacute", "Ucircumflex",
+  "Udieresis", "Ugrave", "Yacute", "Ydieresis", "Zcaron", "aacute",
+  "acircumflex", "adieresis", "agrave", "aring", "atilde", "ccedilla",
+  "eacute", "ecircumflex", "edieresis", "egrave", "iacute", "icircumflex",
+  "idieresis", "igrave", "ntilde", "oacute", "ocircumflex", "odieresis",
+  "ograve", "otilde", "scaron", "uacute", "ucircumflex", "udieresis",
+  "ugrave", "yacute", "ydieresis", "zcaron"
+};
+
+constexpr int kNumberOfStandardStrings = 391;
+
+// Assigns string identifiers, adding strings that are not standard to the
+// String INDEX.
+class Strings final {
+ public:
+  Strings() {
+    for (const auto string : kStandardStrings) {
+      standard_.emplace(string, static_cast<int>(standard_.size()));
+    }
+  }
+
+  int sid(const std::string& string) {
+    const auto standard = standard_.find(string);
+    if (standard != std::end(standard_)) {
+      return standard->second;
+    }
+    const auto custom = custom_.find(string);
+    if (custom != std::end(custom_)) {
+      return custom->second;
+    }
+    const auto sid = kNumberOfStandardStrings + static_cast<int>(
+        strings_.size());
+    custom_.emplace(string, sid);
+    strings_.emplace_back(string);
+    return sid;
+  }
+
+  const std::vector<std::string>& strings() const { return strings_; }
+
+ private:
+  std::unordered_map<std::string, int> standard_;
+  std::unordered_map<std::string, int> custom_;
+  std::vector<std::string> strings_;
+};
+
+// Top DICT operators
+constexpr int kVersion = 0;
+constexpr int kNotice = 1;
+constexpr int kFullName = 2;
+constexpr int kFamilyName = 3;
+constexpr int kWeight = 4;
+constexpr int kFontBBox = 5;
+constexpr int kCharset = 15;
+constexpr int kCharStrings = 17;
+constexpr int kPrivate = 18;
+constexpr int kCopyright = 1200;
+constexpr int kIsFixedPitch = 1201;
+constexpr int kItalicAngle = 1202;
+constexpr int kUnderlinePosition = 1203;
+constexpr int kUnderlineThickness = 1204;
+constexpr int kFontMatrix = 1207;
+
+// Private DICT operators
+constexpr int kBlueValues = 6;
+constexpr int kOtherBlues = 7;
+constexpr int kFamilyBlues = 8;
+constexpr int kFamilyOtherBlues = 9;
+constexpr int kStdHW = 10;
+constexpr int kStdVW = 11;
+constexpr int kSubrs = 19;
+constexpr int kDefaultWidthX = 20;
+constexpr int kNominalWidthX = 21;
+constexpr int kBlueScale = 1209;
+constexpr int kBlueShift = 1210;
+constexpr int kBlueFuzz = 1211;
+constexpr int kStemSnapH = 1212;
+constexpr int kStemSnapV = 1213;
+constexpr int kForceBold = 1214;
+
+inline void setString(Dict *dict,
+                      Strings *strings,
+                      int op,
+                      const std::string& value) {
+  if (!value.empty()) {
+    dict->set(op, strings->sid(value));
+  }
+}
+
+template <class T>
+inline void setNumber(Dict *dict, int op, const ufo::Optional<T>& value) {
+  if (value.exists()) {
+    dict->set(op, static_cast<double>(*value));
+  }
+}
+
+inline void setDelta(Dict *dict, int op, const std::vector<double>& values) {
+  if (!values.empty()) {
+    dict->setDelta(op, values);
+  }
+}
+
+// The most frequent width is the default, which saves the width operand in
+// the most charstrings.
+double defaultWidth(const std::vector<Font::Glyph>& glyphs) {
+  std::map<double, std::size_t> counts;
+  for (const auto& glyph : glyphs) {
+    ++counts[glyph.charstring.width()];
+  }
+  double result{};
+  std::size_t max_count{};
+  for (const auto& pair : counts) {
+    if (pair.second > max_count) {
+      result = pair.first;
+      max_count = pair.second;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+// MARK: Glyphs
+
+void Font::add(const std::string& name,
+               const shota::Shape2d& shape,
+               double width) {
+  add(name, CharString(shape, width), shape.bounds(true), shape.empty());
+}
+
+void Font::add(const std::string& name,
+               const CharString& charstring,
+               const shota::Rect2d& bounds,
+               bool empty) {
+  glyphs_.push_back(Glyph{name, charstring, bounds, empty});
+}
+
+// MARK: Encoding
+
+std::string Font::encode() const {
+  // The first glyph must be .notdef.
+  std::vector<const Glyph *> glyphs;
+  glyphs.reserve(glyphs_.size() + 1);
+  for (const auto& glyph : glyphs_) {
+    if (glyph.name == ".notdef") {
+      glyphs.insert(std::begin(glyphs), &glyph);
+    } else {
+      glyphs.emplace_back(&glyph);
+    }
+  }
+  const Glyph notdef{".notdef", CharString(), shota::Rect2d(), true};
+  if (glyphs.empty() || glyphs.front()->name != ".notdef") {
+    glyphs.insert(std::begin(glyphs), &notdef);
+  }
+  assert(glyphs.size() <= 0xffff);
+
+  Strings strings;
+  Dict top;
+  if (font_info.version_major.exists()) {
+    char version[32];
+    std::snprintf(version, sizeof(version), "%d.%03u",
+                  *font_info.version_major,
+                  font_info.version_minor.exists() ?
+                      *font_info.version_minor : 0);
+    setString(&top, &strings, kVersion, version);
+  }
+  setString(&top, &strings, kNotice, font_info.trademark);
+  setString(&top, &strings, kCopyright, font_info.copyright);
+  setString(&top, &strings, kFullName, font_info.postscript_full_name);
+  setString(&top, &strings, kFamilyName, font_info.family_name);
+  setString(&top, &strings, kWeight, font_info.postscript_weight_name);
+  if (font_info.postscript_is_fixed_pitch.exists() &&
+      *font_info.postscript_is_fixed_pitch) {
+    top.set(kIsFixedPitch, 1.0);
+  }
+  setNumber(&top, kItalicAngle, font_info.italic_angle);
+  setNumber(&top, kUnderlinePosition, font_info.postscript_underline_position);
+  setNumber(&top, kUnderlineThickness,
+            font_info.postscript_underline_thickness);
+  if (font_info.units_per_em.exists() && *font_info.units_per_em != 1000.0) {
+    const auto scale = 1.0 / *font_info.units_per_em;
+    top.set(kFontMatrix, {scale, 0.0, 0.0, scale, 0.0, 0.0});
+  }
+  bool has_bounds{};
+  double min_x{}, min_y{}, max_x{}, max_y{};
+  for (const auto glyph : glyphs) {
+    if (glyph->empty) {
+      continue;
+    }
+    const auto& bounds = glyph->bounds;
+    if (!has_bounds) {
+      min_x = bounds.minX();
+      min_y = bounds.minY();
+      max_x = bounds.maxX();
+      max_y = bounds.maxY();
+      has_bounds = true;
+    } else {
+      min_x = std::min(min_x, bounds.minX());
+      min_y = std::min(min_y, bounds.minY());
+      max_x = std::max(max_x, bounds.maxX());
+      max_y = std::max(max_y, bounds.maxY());
+    }
+  }
+  top.set(kFontBBox, {std::floor(min_x), std::floor(min_y),
+                      std::ceil(max_x), std::ceil(max_y)});
+
+  // Private DICT
+  Dict private_dict;
+  setDelta(&private_dict, kBlueValues, font_info.postscript_blue_values);
+  setDelta(&private_dict, kOtherBlues, font_info.postscript_other_blues);
+  setDelta(&private_dict, kFamilyBlues, font_info.postscript_family_blues);
+  setDelta(&private_dict, kFamilyOtherBlues,
+           font_info.postscript_family_other_blues);
+  setNumber(&private_dict, kBlueScale, font_info.postscript_blue_scale);
+  setNumber(&private_dict, kBlueShift, font_info.postscript_blue_shift);
+  setNumber(&private_dict, kBlueFuzz, font_info.postscript_blue_fuzz);
+  if (!font_info.postscript_stem_snap_h.empty()) {
+    private_dict.set(kStdHW, font_info.postscript_stem_snap_h.front());
+  }
+  if (!font_info.postscript_stem_snap_v.empty()) {
+    private_dict.set(kStdVW, font_info.postscript_stem_snap_v.front());
+  }
+  setDelta(&private_dict, kStemSnapH, font_info.postscript_stem_snap_h);
+  setDelta(&private_dict, kStemSnapV, font_info.postscript_stem_snap_v);
+  if (font_info.postscript_force_bold.exists() &&
+      *font_info.postscript_force_bold) {
+    private_dict.set(kForceBold, 1.0);
+  }
+  const auto default_width = font_info.postscript_default_width_x.exists() ?
+      *font_info.postscript_default_width_x : defaultWidth(glyphs_);
+  const auto nominal_width = font_info.postscript_nominal_width_x.exists() ?
+      *font_info.postscript_nominal_width_x : default_width;
+  if (default_width != 0.0) {
+    private_dict.set(kDefaultWidthX, default_width);
+  }
+  if (nominal_width != 0.0) {
+    private_dict.set(kNominalWidthX, nominal_width);
+  }
+  std::string private_data;
+  if (!local_subrs.empty()) {
+    // Local subroutines follow the Private DICT, whose size doesn't depend
+    // on the offset because it is encoded in 5 bytes.
+    private_dict.setOffset(kSubrs, {0.0});
+    const auto size = private_dict.encode().size();
+    private_dict.setOffset(kSubrs, {static_cast<double>(size)});
+    private_data = private_dict.encode() + encodeIndex(local_subrs);
+  } else {
+    private_data = private_dict.encode();
+  }
+  const auto private_size = private_dict.encode().size();
+
+  // Charset and charstrings
+  std::string charset;
+  charset.push_back(0);  // Format 0
+  std::vector<std::string> charstrings;
+  charstrings.reserve(glyphs.size());
+  for (const auto glyph : glyphs) {
+    if (glyph != glyphs.front()) {
+      const auto sid = strings.sid(glyph->name);
+      charset.push_back(static_cast<char>((sid >> 8) & 0xff));
+      charset.push_back(static_cast<char>(sid & 0xff));
+    }
+    charstrings.emplace_back(glyph->charstring.encode(default_width,
+                                                      nominal_width));
+  }
+  const auto charstrings_index = encodeIndex(charstrings);
+
+  // The Top DICT is encoded once with placeholders to know its size, which
+  // doesn't change when the offsets are filled.
+  top.setOffset(kCharset, {0.0});
+  top.setOffset(kCharStrings, {0.0});
+  top.setOffset(kPrivate, {0.0, 0.0});
+  const std::string header("\x01\x00\x04\x04", 4);
+  const auto name_index = encodeIndex({font_info.postscript_font_name});
+  const auto string_index = encodeIndex(strings.strings());
+  const auto global_subrs_index = encodeIndex(global_subrs);
+  const auto top_index_size = encodeIndex({top.encode()}).size();
+  const auto charset_offset = (header.size() + name_index.size() +
+                               top_index_size + string_index.size() +
+                               global_subrs_index.size());
+  const auto charstrings_offset = charset_offset + charset.size();
+  const auto private_offset = charstrings_offset + charstrings_index.size();
+  top.setOffset(kCharset, {static_cast<double>(charset_offset)});
+  top.setOffset(kCharStrings, {static_cast<double>(charstrings_offset)});
+  top.setOffset(kPrivate, {static_cast<double>(private_size),
+                           static_cast<double>(private_offset)});
+  const auto top_index = encodeIndex({top.encode()});
+  assert(top_index.size() == top_index_size);
+
+  std::string result;
+  result.reserve(private_offset + private_data.size());
+  result += header;
+  result += name_index;
+  result += top_index;
+  result += string_index;
+  result += global_subrs_index;
+  result += charset;
+  result += charstrings_index;
+  result += private_data;
+  return result;
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,74 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_FONT_H_
+#define TOKEN_CFF_FONT_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/cff/charstring.h"
+#include "token/cff/dict.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace cff {
+
+namespace shota = shotamatsuda;
+
+// Builds a bare CFF table with a single font from the font info and the
+// charstrings of its glyphs, in the order they are added.
+class Font final {
+ public:
+  struct Glyph final {
+    std::string name;
+    CharString charstring;
+    shota::Rect2d bounds;
+    bool empty;
+  };
+
+ public:
+  Font() = default;
+  explicit Font(const ufo::FontInfo& font_info);
+
+  // Copy semantics
+  Font(const Font&) = default;
+  Font& operator=(const Font&) = default;
+
+  // Glyphs
+  std::size_t size() const { return glyphs_.size(); }
+  const std::vector<Glyph>& glyphs() const { return glyphs_; }
+  std::vector<Glyph>& glyphs() { return glyphs_; }
+  void add(const std::string& name,
+           const shota::Shape2d& shape,
+           double width);
+  void add(const std::string& name,
+           const CharString& charstring,
+           const shota::Rect2d& bounds,
+           bool empty);
+
+  // Encoding
+  std::string encode() const;
+
+ public:
+  ufo::FontInfo font_info;
+
+  // Subroutines called by the charstrings, which are encoded as they are.
+  std::vector<std::string> global_subrs;
+  std::vector<std::string> local_subrs;
+
+ private:
+  std::vector<Glyph> glyphs_;
+};
+
+// MARK: -
+
+inline Font::Font(const ufo::FontInfo& font_info) : font_info(font_info) {}
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_FONT_H_
@@ -0,0 +1,635 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/hinter.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/cff/charstring.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+struct Point final {
+  double x;
+  double y;
+};
+
+inline Point operator+(const Point& lhs, const Point& rhs) {
+  return Point{lhs.x + rhs.x, lhs.y + rhs.y};
+}
+
+struct Segment final {
+  Point from;
+  Point control1;
+  Point control2;
+  Point to;
+  bool curve;
+};
+
+struct Contour final {
+  Point start;
+  std::vector<Segment> segments;
+};
+
+// Reads the outline back from the operations of a charstring without hints.
+class Decoder final {
+ public:
+  explicit Decoder(const std::vector<Operation>& operations);
+
+  const std::vector<Contour>& contours() const { return contours_; }
+
+ private:
+  void move(double dx, double dy);
+  void line(double dx, double dy);
+  void curve(double dx1, double dy1, double dx2, double dy2,
+             double dx3, double dy3);
+
+ private:
+  Point current_{};
+  std::vector<Contour> contours_;
+};
+
+Decoder::Decoder(const std::vector<Operation>& operations) {
+  for (const auto& operation : operations) {
+    const auto& a = operation.operands;
+    const auto size = a.size();
+    switch (operation.op) {
+      case Operator::RMOVETO:
+        move(a[0], a[1]);
+        break;
+      case Operator::HMOVETO:
+        move(a[0], 0.0);
+        break;
+      case Operator::VMOVETO:
+        move(0.0, a[0]);
+        break;
+      case Operator::RLINETO:
+        for (std::size_t i{}; i + 1 < size; i += 2) {
+          line(a[i], a[i + 1]);
+        }
+        break;
+      case Operator::HLINETO:
+      case Operator::VLINETO: {
+        bool horizontal = (operation.op == Operator::HLINETO);
+        for (const auto d : a) {
+          horizontal ? line(d, 0.0) : line(0.0, d);
+          horizontal = !horizontal;
+        }
+        break;
+      }
+      case Operator::RRCURVETO:
+        for (std::size_t i{}; i + 5 < size; i += 6) {
+          curve(a[i], a[i + 1], a[i + 2], a[i + 3], a[i + 4], a[i + 5]);
+        }
+        break;
+      case Operator::RCURVELINE: {
+        std::size_t i{};
+        for (; i + 5 < size - 2; i += 6) {
+          curve(a[i], a[i + 1], a[i + 2], a[i + 3], a[i + 4], a[i + 5]);
+        }
+        line(a[i], a[i + 1]);
+        break;
+      }
+      case Operator::RLINECURVE: {
+        std::size_t i{};
+        for (; i + 1 < size - 6; i += 2) {
+          line(a[i], a[i + 1]);
+        }
+        curve(a[i], a[i + 1], a[i + 2], a[i + 3], a[i + 4], a[i + 5]);
+        break;
+      }
+      case Operator::HHCURVETO:
+      case Operator::VVCURVETO: {
+        const bool horizontal = (operation.op == Operator::HHCURVETO);
+        std::size_t i = size % 4;
+        double extra = i ? a[0] : 0.0;
+        for (; i + 3 < size; i += 4) {
+          if (horizontal) {
+            curve(a[i], extra, a[i + 1], a[i + 2], a[i + 3], 0.0);
+          } else {
+            curve(extra, a[i], a[i + 1], a[i + 2], 0.0, a[i + 3]);
+          }
+          extra = 0.0;
+        }
+        break;
+      }
+      case Operator::HVCURVETO:
+      case Operator::VHCURVETO: {
+        bool horizontal = (operation.op == Operator::HVCURVETO);
+        for (std::size_t i{}; i + 3 < size; i += 4) {
+          const auto last = (i + 5 == size) ? a[i + 4] : 0.0;
+          if (horizontal) {
+            curve(a[i], 0.0, a[i + 1], a[i + 2], last, a[i + 3]);
+          } else {
+            curve(0.0, a[i], a[i + 1], a[i + 2], a[i + 3], last);
+          }
+          horizontal = !horizontal;
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+}
+
+void Decoder::move(double dx, double dy) {
+  current_ = current_ + Point{dx, dy};
+  contours_.push_back(Contour{current_, {}});
+}
+
+void Decoder::line(double dx, double dy) {
+  assert(!contours_.empty());
+  const auto to = current_ + Point{dx, dy};
+  contours_.back().segments.push_back(Segment{current_, {}, {}, to, false});
+  current_ = to;
+}
+
+void Decoder::curve(double dx1, double dy1, double dx2, double dy2,
+                    double dx3, double dy3) {
+  assert(!contours_.empty());
+  const auto control1 = current_ + Point{dx1, dy1};
+  const auto control2 = control1 + Point{dx2, dy2};
+  const auto to = control2 + Point{dx3, dy3};
+  contours_.back().segments.push_back(
+      Segment{current_, control1, control2, to, true});
+  current_ = to;
+}
+
+// A straight part of the outline parallel to either axis, which is at the
+// position across the axis, spanning from min to max along it.
+struct Edge final {
+  double position;
+  double min;
+  double max;
+  int direction;
+  std::size_t contour;
+};
+
+// Finds edges of the segment, including extrema inside curves whose
+// tangents are parallel to the axis.
+void findEdges(const Segment& segment,
+               std::size_t contour,
+               std::vector<Edge> *horizontal,
+               std::vector<Edge> *vertical) {
+  const auto add = [contour](std::vector<Edge> *edges,
+                             double position,
+                             double from,
+                             double to) {
+    if (from != to) {
+      edges->push_back(Edge{position, std::min(from, to),
+                            std::max(from, to), from < to ? 1 : -1,
+                            contour});
+    }
+  };
+  const auto& p0 = segment.from;
+  const auto& p3 = segment.to;
+  if (!segment.curve) {
+    if (p0.y == p3.y) {
+      add(horizontal, p0.y, p0.x, p3.x);
+    } else if (p0.x == p3.x) {
+      add(vertical, p0.x, p0.y, p3.y);
+    }
+    return;
+  }
+  const auto& p1 = segment.control1;
+  const auto& p2 = segment.control2;
+  if (p0.y == p1.y) {
+    add(horizontal, p0.y, p0.x, p1.x);
+  }
+  if (p2.y == p3.y) {
+    add(horizontal, p3.y, p2.x, p3.x);
+  }
+  if (p0.x == p1.x) {
+    add(vertical, p0.x, p0.y, p1.y);
+  }
+  if (p2.x == p3.x) {
+    add(vertical, p3.x, p2.y, p3.y);
+  }
+  // Roots of the derivative of the cubic in each axis
+  const auto extrema = [](double a0, double a1, double a2, double a3) {
+    const auto a = -a0 + 3.0 * a1 - 3.0 * a2 + a3;
+    const auto b = 2.0 * (a0 - 2.0 * a1 + a2);
+    const auto c = a1 - a0;
+    std::vector<double> result;
+    if (std::abs(a) < 1e-9) {
+      if (std::abs(b) > 1e-9) {
+        result.emplace_back(-c / b);
+      }
+    } else {
+      const auto discriminant = b * b - 4.0 * a * c;
+      if (discriminant >= 0.0) {
+        const auto root = std::sqrt(discriminant);
+        result.emplace_back((-b - root) / (2.0 * a));
+        result.emplace_back((-b + root) / (2.0 * a));
+      }
+    }
+    result.erase(std::remove_if(std::begin(result), std::end(result),
+                                [](double t) { return t <= 0.0 || t >= 1.0; }),
+                 std::end(result));
+    return result;
+  };
+  const auto evaluate = [](double a0, double a1, double a2, double a3,
+                           double t) {
+    const auto s = 1.0 - t;
+    return (s * s * s * a0 + 3.0 * s * s * t * a1 +
+            3.0 * s * t * t * a2 + t * t * t * a3);
+  };
+  // Extrema are short edges around the point, directed along the curve.
+  for (const auto t : extrema(p0.y, p1.y, p2.y, p3.y)) {
+    const auto x = evaluate(p0.x, p1.x, p2.x, p3.x, t);
+    const auto y = std::round(evaluate(p0.y, p1.y, p2.y, p3.y, t));
+    const auto dx = evaluate(p0.x, p1.x, p2.x, p3.x, t + 1e-3) - x;
+    add(horizontal, y, x - (dx < 0.0 ? -0.5 : 0.5),
+        x + (dx < 0.0 ? -0.5 : 0.5));
+  }
+  for (const auto t : extrema(p0.x, p1.x, p2.x, p3.x)) {
+    const auto x = std::round(evaluate(p0.x, p1.x, p2.x, p3.x, t));
+    const auto y = evaluate(p0.y, p1.y, p2.y, p3.y, t);
+    const auto dy = evaluate(p0.y, p1.y, p2.y, p3.y, t + 1e-3) - y;
+    add(vertical, x, y - (dy < 0.0 ? -0.5 : 0.5),
+        y + (dy < 0.0 ? -0.5 : 0.5));
+  }
+}
+
+struct Stem final {
+  double bottom;
+  double top;
+  double priority;
+  std::set<std::size_t> contours;
+};
+
+inline bool operator<(const Stem& lhs, const Stem& rhs) {
+  return (lhs.bottom < rhs.bottom ||
+          (lhs.bottom == rhs.bottom && lhs.top < rhs.top));
+}
+
+inline bool overlaps(const Stem& lhs, const Stem& rhs) {
+  return lhs.bottom <= rhs.top && rhs.bottom <= lhs.top;
+}
+
+// Whether the operations have neither hints nor calls to subroutines.
+bool hintable(const std::vector<Operation>& operations) {
+  for (const auto& operation : operations) {
+    switch (operation.op) {
+      case Operator::HSTEM:
+      case Operator::VSTEM:
+      case Operator::HSTEMHM:
+      case Operator::VSTEMHM:
+      case Operator::HINTMASK:
+      case Operator::CALLSUBR:
+      case Operator::CALLGSUBR:
+        return false;
+      default:
+        break;
+    }
+  }
+  return !operations.empty();
+}
+
+Hints findHints(const Hinter& hinter, const std::vector<Contour>& contours) {
+  const auto stem_width = hinter.stem_width();
+  const auto tolerance = hinter.tolerance();
+  const auto& blue_zones = hinter.blue_zones();
+
+  // Orientation of the outline decides which edge of a stem comes first.
+  // The contour with the largest area is taken to be an outer one.
+  double orientation{};
+  std::vector<Edge> horizontal_edges;
+  std::vector<Edge> vertical_edges;
+  for (std::size_t index{}; index < contours.size(); ++index) {
+    const auto& contour = contours[index];
+    auto segments = contour.segments;
+    if (segments.empty()) {
+      continue;
+    }
+    const auto& last = segments.back().to;
+    if (last.x != contour.start.x || last.y != contour.start.y) {
+      segments.push_back(Segment{last, {}, {}, contour.start, false});
+    }
+    double area{};
+    for (const auto& segment : segments) {
+      area += segment.from.x * segment.to.y - segment.to.x * segment.from.y;
+      findEdges(segment, index, &horizontal_edges, &vertical_edges);
+    }
+    if (std::abs(area) > std::abs(orientation)) {
+      orientation = area;
+    }
+  }
+  const int sign = (orientation < 0.0) ? -1 : 1;
+
+  // Stems are pairs of edges that go in opposite directions, overlap each
+  // other, and are about the stem width apart. Counter-clockwise outlines go
+  // forward along the bottom of stems and backward along the left.
+  const auto zoned = [&blue_zones, tolerance](double position) {
+    for (std::size_t i{}; i + 1 < blue_zones.size(); i += 2) {
+      if (position >= blue_zones[i] - tolerance &&
+          position <= blue_zones[i + 1] + tolerance) {
+        return true;
+      }
+    }
+    return false;
+  };
+  const auto findStems = [stem_width, tolerance, &zoned](
+      const std::vector<Edge>& edges,
+      int direction,
+      bool zones) {
+    std::vector<Stem> stems;
+    for (const auto& low : edges) {
+      if (low.direction != direction) {
+        continue;
+      }
+      for (const auto& high : edges) {
+        const auto width = high.position - low.position;
+        const auto overlap = (std::min(low.max, high.max) -
+                              std::max(low.min, high.min));
+        if (high.direction == direction ||
+            std::abs(width - stem_width) > tolerance || overlap <= 0.0) {
+          continue;
+        }
+        auto priority = overlap;
+        if (zones && (zoned(low.position) || zoned(high.position))) {
+          priority += stem_width * 4.0;
+        }
+        Stem stem{low.position, high.position, priority,
+                  {low.contour, high.contour}};
+        const auto existing = std::find_if(
+            std::begin(stems), std::end(stems), [&stem](const Stem& other) {
+              return other.bottom == stem.bottom && other.top == stem.top;
+            });
+        if (existing == std::end(stems)) {
+          stems.emplace_back(std::move(stem));
+        } else {
+          existing->priority += overlap;
+          existing->contours.insert(std::begin(stem.contours),
+                                    std::end(stem.contours));
+        }
+      }
+    }
+    return stems;
+  };
+  auto hstems = findStems(horizontal_edges, sign, true);
+  auto vstems = findStems(vertical_edges, -sign, false);
+  if (hstems.empty() && vstems.empty()) {
+    return Hints{};
+  }
+
+  // Each contour takes the stems touching it in the order of priority, as
+  // long as they don't overlap ones already taken.
+  const auto select = [](const std::vector<Stem>& stems,
+                         const std::vector<std::size_t>& candidates) {
+    std::vector<std::size_t> result;
+    for (const auto candidate : candidates) {
+      const auto& stem = stems[candidate];
+      if (std::none_of(std::begin(result), std::end(result),
+                       [&stems, &stem](std::size_t index) {
+                         return overlaps(stems[index], stem);
+                       })) {
+        result.emplace_back(candidate);
+      }
+    }
+    return result;
+  };
+  const auto prioritize = [](std::vector<Stem> *stems, std::size_t limit) {
+    std::stable_sort(std::begin(*stems), std::end(*stems),
+                     [](const Stem& lhs, const Stem& rhs) {
+                       return lhs.priority > rhs.priority;
+                     });
+    if (stems->size() > limit) {
+      stems->resize(limit);
+    }
+  };
+  prioritize(&hstems, hinter.max_stems());
+  prioritize(&vstems, hinter.max_stems());
+  std::vector<std::vector<bool>> masks;
+  std::vector<bool> used(hstems.size() + vstems.size());
+  bool conflicting{};
+  for (std::size_t index{}; index < contours.size(); ++index) {
+    std::vector<bool> mask(used.size());
+    std::size_t offset{};
+    for (const auto stems : {&hstems, &vstems}) {
+      std::vector<std::size_t> candidates;
+      for (std::size_t i{}; i < stems->size(); ++i) {
+        if ((*stems)[i].contours.count(index)) {
+          candidates.emplace_back(i);
+        }
+      }
+      const auto selected = select(*stems, candidates);
+      conflicting |= selected.size() != candidates.size();
+      for (const auto i : selected) {
+        mask[offset + i] = used[offset + i] = true;
+      }
+      offset += stems->size();
+    }
+    masks.emplace_back(std::move(mask));
+  }
+
+  // Without overlaps, all of the stems apply to the whole glyph.
+  std::vector<Stem> all_stems[2] = {hstems, vstems};
+  std::vector<std::size_t> orders[2];
+  std::size_t offset{};
+  for (std::size_t axis{}; axis < 2; ++axis) {
+    for (std::size_t i{}; i < all_stems[axis].size(); ++i) {
+      if (used[offset + i]) {
+        orders[axis].emplace_back(offset + i);
+      }
+    }
+    offset += all_stems[axis].size();
+  }
+  std::vector<Stem> flat(hstems);
+  flat.insert(std::end(flat), std::begin(vstems), std::end(vstems));
+  for (auto& order : orders) {
+    std::sort(std::begin(order), std::end(order),
+              [&flat](std::size_t lhs, std::size_t rhs) {
+                return flat[lhs] < flat[rhs];
+              });
+  }
+  if (!conflicting) {
+    for (const auto& order : orders) {
+      for (std::size_t i = 1; i < order.size(); ++i) {
+        conflicting |= overlaps(flat[order[i - 1]], flat[order[i]]);
+      }
+    }
+  }
+
+  Hints result{};
+  result.masked = conflicting;
+  std::vector<Hints::Stem> *const stems[2] = {
+    &result.horizontal, &result.vertical
+  };
+  for (std::size_t axis{}; axis < 2; ++axis) {
+    for (const auto index : orders[axis]) {
+      stems[axis]->push_back(Hints::Stem{
+          flat[index].bottom, flat[index].top - flat[index].bottom});
+    }
+  }
+  if (!conflicting) {
+    Hints::Set set{0, contours.front().start.x, contours.front().start.y,
+                   {}, {}};
+    for (std::size_t i{}; i < orders[0].size(); ++i) {
+      set.horizontal.emplace_back(i);
+    }
+    for (std::size_t i{}; i < orders[1].size(); ++i) {
+      set.vertical.emplace_back(i);
+    }
+    result.sets.emplace_back(std::move(set));
+    return result;
+  }
+
+  // A set begins at each contour whose stems differ from the previous one,
+  // and a contour without stems keeps the previous set.
+  const Hints::Set *previous{};
+  for (std::size_t index{}; index < contours.size(); ++index) {
+    const auto& contour = contours[index];
+    Hints::Set set{index, contour.start.x, contour.start.y, {}, {}};
+    std::vector<std::size_t> *const members[2] = {
+      &set.horizontal, &set.vertical
+    };
+    for (std::size_t axis{}; axis < 2; ++axis) {
+      for (std::size_t i{}; i < orders[axis].size(); ++i) {
+        if (masks[index][orders[axis][i]]) {
+          members[axis]->emplace_back(i);
+        }
+      }
+    }
+    const bool empty = set.horizontal.empty() && set.vertical.empty();
+    if (previous && (empty || (set.horizontal == previous->horizontal &&
+                               set.vertical == previous->vertical))) {
+      continue;
+    }
+    result.sets.emplace_back(std::move(set));
+    previous = &result.sets.back();
+  }
+  return result;
+}
+
+}  // namespace
+
+Hinter::Hinter(const ufo::FontInfo& font_info) : Hinter() {
+  if (!font_info.postscript_stem_snap_h.empty()) {
+    stem_width_ = font_info.postscript_stem_snap_h.front();
+  } else if (!font_info.postscript_stem_snap_v.empty()) {
+    stem_width_ = font_info.postscript_stem_snap_v.front();
+  }
+  tolerance_ = std::max(1.0, std::round(stem_width_ * 0.05));
+  blue_zones_ = font_info.postscript_blue_values;
+  blue_zones_.insert(std::end(blue_zones_),
+                     std::begin(font_info.postscript_other_blues),
+                     std::end(font_info.postscript_other_blues));
+  if (blue_zones_.empty()) {
+    // Flat zones at the vertical metrics when no zones are given.
+    for (const auto& metric : {
+        font_info.descender, font_info.x_height,
+        font_info.cap_height, font_info.ascender}) {
+      if (metric.exists()) {
+        blue_zones_.emplace_back(*metric);
+        blue_zones_.emplace_back(*metric);
+      }
+    }
+    blue_zones_.emplace_back(0.0);
+    blue_zones_.emplace_back(0.0);
+  }
+}
+
+// MARK: Hinting
+
+void Hinter::operator()(CharString *charstring) const {
+  assert(charstring);
+  const auto& operations = charstring->operations();
+  if (stem_width_ <= 0.0 || !hintable(operations)) {
+    return;
+  }
+  const Decoder decoder(operations);
+  const auto& contours = decoder.contours();
+  const auto hints = findHints(*this, contours);
+  if (hints.empty()) {
+    return;
+  }
+
+  std::vector<Operation> result;
+  const Operator stem_operators[2][2] = {
+    {Operator::HSTEM, Operator::VSTEM},
+    {Operator::HSTEMHM, Operator::VSTEMHM}
+  };
+  const std::vector<Hints::Stem> *const stems[2] = {
+    &hints.horizontal, &hints.vertical
+  };
+  for (std::size_t axis{}; axis < 2; ++axis) {
+    if (stems[axis]->empty()) {
+      continue;
+    }
+    std::vector<double> operands;
+    double previous{};
+    for (const auto& stem : *stems[axis]) {
+      operands.emplace_back(stem.position - previous);
+      operands.emplace_back(stem.width);
+      previous = stem.position + stem.width;
+    }
+    result.emplace_back(stem_operators[hints.masked][axis], operands);
+  }
+
+  // Hint masks refer to the stems in the order they are declared.
+  const auto count = hints.horizontal.size() + hints.vertical.size();
+  auto set = std::begin(hints.sets);
+  Point current{};
+  for (std::size_t index{}; index < contours.size(); ++index) {
+    const auto& contour = contours[index];
+    if (hints.masked && set != std::end(hints.sets) &&
+        set->contour == index) {
+      std::string mask((count + 7) / 8, '\0');
+      for (const auto i : set->horizontal) {
+        mask[i / 8] |= static_cast<char>(0x80 >> (i % 8));
+      }
+      for (const auto i : set->vertical) {
+        const auto bit = hints.horizontal.size() + i;
+        mask[bit / 8] |= static_cast<char>(0x80 >> (bit % 8));
+      }
+      Operation operation(Operator::HINTMASK, {});
+      operation.mask = mask;
+      result.emplace_back(std::move(operation));
+      ++set;
+    }
+    result.emplace_back(Operator::RMOVETO, std::vector<double>{
+        contour.start.x - current.x, contour.start.y - current.y});
+    current = contour.start;
+    for (const auto& segment : contour.segments) {
+      const auto& to = segment.to;
+      if (segment.curve) {
+        const auto& control1 = segment.control1;
+        const auto& control2 = segment.control2;
+        result.emplace_back(Operator::RRCURVETO, std::vector<double>{
+            control1.x - current.x, control1.y - current.y,
+            control2.x - control1.x, control2.y - control1.y,
+            to.x - control2.x, to.y - control2.y});
+      } else {
+        result.emplace_back(Operator::RLINETO, std::vector<double>{
+            to.x - current.x, to.y - current.y});
+      }
+      current = to;
+    }
+  }
+  *charstring = CharString(result, charstring->width());
+}
+
+Hints Hinter::hints(const CharString& charstring) const {
+  const auto& operations = charstring.operations();
+  if (stem_width_ <= 0.0 || !hintable(operations)) {
+    return Hints{};
+  }
+  return findHints(*this, Decoder(operations).contours());
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,96 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_HINTER_H_
+#define TOKEN_CFF_HINTER_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "token/cff/charstring.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace cff {
+
+// The stems of a glyph, and the sets of them that apply from the beginning
+// of contours. All of the stems belong to a single set unless some of them
+// overlap, in which case hint masks switch between the sets.
+struct Hints final {
+  struct Stem final {
+    double position;
+    double width;
+  };
+
+  struct Set final {
+    // The contour the set applies from, and the start point of the contour
+    std::size_t contour;
+    double x;
+    double y;
+
+    // The indices of the stems in the set
+    std::vector<std::size_t> horizontal;
+    std::vector<std::size_t> vertical;
+  };
+
+  bool empty() const { return horizontal.empty() && vertical.empty(); }
+
+  // Stems in the order of their positions
+  std::vector<Stem> horizontal;
+  std::vector<Stem> vertical;
+  std::vector<Set> sets;
+  bool masked;
+};
+
+// Adds stem hints to charstrings of stroked glyphs. Every stem of a stroked
+// glyph is as wide as the stroke, so stems are pairs of opposite horizontal
+// or vertical edges that are the stem width apart. Stems with edges in the
+// blue zones take precedence, and hint masks switch between overlapping
+// stems at the beginning of each contour.
+class Hinter final {
+ public:
+  Hinter();
+  explicit Hinter(const ufo::FontInfo& font_info);
+
+  // Copy semantics
+  Hinter(const Hinter&) = default;
+  Hinter& operator=(const Hinter&) = default;
+
+  // Hinting
+  void operator()(CharString *charstring) const;
+
+  // Finds the hints without adding them, which are empty when the
+  // charstring is already hinted or has no stems.
+  Hints hints(const CharString& charstring) const;
+
+  // Parameters
+  double stem_width() const { return stem_width_; }
+  void set_stem_width(double value) { stem_width_ = value; }
+  double tolerance() const { return tolerance_; }
+  void set_tolerance(double value) { tolerance_ = value; }
+  // Pairs of bottom and top of the alignment zones.
+  const std::vector<double>& blue_zones() const { return blue_zones_; }
+  void set_blue_zones(const std::vector<double>& value);
+  std::size_t max_stems() const { return max_stems_; }
+  void set_max_stems(std::size_t value) { max_stems_ = value; }
+
+ private:
+  double stem_width_;
+  double tolerance_;
+  std::vector<double> blue_zones_;
+  std::size_t max_stems_;
+};
+
+// MARK: -
+
+inline Hinter::Hinter() : stem_width_(), tolerance_(1.0), max_stems_(23) {}
+
+inline void Hinter::set_blue_zones(const std::vector<double>& value) {
+  blue_zones_ = value;
+}
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_HINTER_H_
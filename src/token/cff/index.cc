@@ -0,0 +1,107 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/index.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace token {
+namespace cff {
+
+std::string encodeIndex(const std::vector<std::string>& objects) {
+  assert(objects.size() <= 0xffff);
+  std::string result;
+  const auto count = static_cast<std::uint16_t>(objects.size());
+  result.push_back(static_cast<char>(count >> 8));
+  result.push_back(static_cast<char>(count & 0xff));
+  if (objects.empty()) {
+    return result;
+  }
+  std::size_t size{};
+  for (const auto& object : objects) {
+    size += object.size();
+  }
+  // Offsets start from 1, and the last one points past the data.
+  const auto last = size + 1;
+  int offset_size = 1;
+  while (offset_size < 4 && last >> (offset_size * 8)) {
+    ++offset_size;
+  }
+  result.push_back(static_cast<char>(offset_size));
+  std::size_t offset = 1;
+  const auto write = [&result, offset_size](std::size_t value) {
+    for (int i = offset_size - 1; i >= 0; --i) {
+      result.push_back(static_cast<char>((value >> (i * 8)) & 0xff));
+    }
+  };
+  write(offset);
+  for (const auto& object : objects) {
+    offset += object.size();
+    write(offset);
+  }
+  result.reserve(result.size() + size);
+  for (const auto& object : objects) {
+    result += object;
+  }
+  return result;
+}
+
+bool decodeIndex(const std::string& data,
+                 std::size_t *position,
+                 std::vector<std::string> *objects) {
+  assert(position);
+  assert(objects);
+  const auto byte = [&data](std::size_t offset) {
+    return static_cast<std::uint8_t>(data[offset]);
+  };
+  auto current = *position;
+  if (current + 2 > data.size()) {
+    return false;
+  }
+  const std::size_t count = (byte(current) << 8) | byte(current + 1);
+  current += 2;
+  objects->clear();
+  if (!count) {
+    *position = current;
+    return true;
+  }
+  if (current + 1 > data.size()) {
+    return false;
+  }
+  const std::size_t offset_size = byte(current++);
+  if (offset_size < 1 || offset_size > 4 ||
+      current + (count + 1) * offset_size > data.size()) {
+    return false;
+  }
+  const auto read = [&byte, offset_size](std::size_t offset) {
+    std::size_t value{};
+    for (std::size_t i{}; i < offset_size; ++i) {
+      value = (value << 8) | byte(offset + i);
+    }
+    return value;
+  };
+  // Offsets are relative to the byte preceding the object data.
+  const auto base = current + (count + 1) * offset_size - 1;
+  std::size_t previous = read(current);
+  if (previous != 1) {
+    return false;
+  }
+  objects->reserve(count);
+  for (std::size_t i{}; i < count; ++i) {
+    const auto next = read(current + (i + 1) * offset_size);
+    if (next < previous || base + next > data.size()) {
+      return false;
+    }
+    objects->emplace_back(data, base + previous, next - previous);
+    previous = next;
+  }
+  *position = base + previous;
+  return true;
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,28 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_INDEX_H_
+#define TOKEN_CFF_INDEX_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace token {
+namespace cff {
+
+// Encodes the objects into an INDEX structure of CFF, choosing the smallest
+// size of offsets that can address the data.
+std::string encodeIndex(const std::vector<std::string>& objects);
+
+// Decodes the INDEX structure at the position in the data, and advances the
+// position past its end.
+bool decodeIndex(const std::string& data,
+                 std::size_t *position,
+                 std::vector<std::string> *objects);
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_INDEX_H_
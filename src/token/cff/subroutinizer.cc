@@ -0,0 +1,363 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/subroutinizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "token/cff/charstring.h"
+#include "token/cff/font.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+// The number added to the operand of subroutine calls, which depends on the
+// number of subroutines.
+inline int bias(std::size_t count) {
+  if (count < 1240) {
+    return 107;
+  } else if (count < 33900) {
+    return 1131;
+  }
+  return 32768;
+}
+
+inline std::size_t numberSize(int value) {
+  if (value >= -107 && value <= 107) {
+    return 1;
+  } else if (value >= -1131 && value <= 1131) {
+    return 2;
+  }
+  return 3;
+}
+
+// Operations that must stay in the charstrings: hints depend on the glyph,
+// and the first operation carries the width.
+inline bool movable(const Operation& operation) {
+  switch (operation.op) {
+    case Operator::HSTEM:
+    case Operator::VSTEM:
+    case Operator::HSTEMHM:
+    case Operator::VSTEMHM:
+    case Operator::HINTMASK:
+    case Operator::CNTRMASK:
+    case Operator::CALLSUBR:
+    case Operator::CALLGSUBR:
+    case Operator::RETURN:
+    case Operator::ENDCHAR:
+      return false;
+    default:
+      break;
+  }
+  return true;
+}
+
+// Sorts the suffixes of the text by doubling the length of their prefixes.
+std::vector<std::size_t> suffixArray(const std::vector<int>& text) {
+  const auto size = text.size();
+  std::vector<std::size_t> result(size);
+  std::iota(std::begin(result), std::end(result), 0);
+  if (size < 2) {
+    return result;
+  }
+  std::vector<int> rank(text);
+  std::vector<int> next(size);
+  for (std::size_t k = 1;; k <<= 1) {
+    const auto key = [&rank, k, size](std::size_t i) {
+      return std::make_pair(rank[i], i + k < size ? rank[i + k] : -1);
+    };
+    std::sort(std::begin(result), std::end(result),
+              [&key](std::size_t lhs, std::size_t rhs) {
+                return key(lhs) < key(rhs);
+              });
+    next[result[0]] = 0;
+    for (std::size_t i = 1; i < size; ++i) {
+      next[result[i]] = (next[result[i - 1]] +
+                         (key(result[i - 1]) < key(result[i]) ? 1 : 0));
+    }
+    rank.swap(next);
+    if (static_cast<std::size_t>(rank[result[size - 1]]) == size - 1) {
+      break;
+    }
+  }
+  return result;
+}
+
+// The lengths of the common prefixes of adjacent suffixes in the array,
+// computed in linear time.
+std::vector<std::size_t> longestCommonPrefixes(
+    const std::vector<int>& text,
+    const std::vector<std::size_t>& suffixes) {
+  const auto size = text.size();
+  std::vector<std::size_t> rank(size);
+  for (std::size_t i{}; i < size; ++i) {
+    rank[suffixes[i]] = i;
+  }
+  std::vector<std::size_t> result(size);
+  std::size_t length{};
+  for (std::size_t i{}; i < size; ++i) {
+    if (rank[i] == 0) {
+      length = 0;
+      continue;
+    }
+    const auto j = suffixes[rank[i] - 1];
+    while (i + length < size && j + length < size &&
+           text[i + length] == text[j + length]) {
+      ++length;
+    }
+    result[rank[i]] = length;
+    if (length) {
+      --length;
+    }
+  }
+  return result;
+}
+
+struct Candidate final {
+  std::size_t position;
+  std::size_t length;
+  std::size_t bytes;
+  std::vector<std::size_t> positions;
+  std::size_t usage;
+  long savings;
+};
+
+// Subroutines cost their return operator and an offset in the INDEX.
+inline long savings(const Candidate& candidate,
+                    std::size_t count,
+                    std::size_t call_size) {
+  const auto bytes = static_cast<long>(candidate.bytes);
+  return (static_cast<long>(count) * (bytes - static_cast<long>(call_size)) -
+          (bytes + 1 + 2));
+}
+
+}  // namespace
+
+// MARK: Subroutinizing
+
+void Subroutinizer::operator()(Font *font) const {
+  assert(font);
+  if (!font->global_subrs.empty() || !font->local_subrs.empty()) {
+    return;  // Calls to existing subroutines would be renumbered.
+  }
+  auto& glyphs = font->glyphs();
+
+  // Operations are tokenized by their encodings. Operations that can't move
+  // and the boundaries of glyphs get unique tokens, so that no repeat spans
+  // them.
+  std::unordered_map<std::string, int> tokens;
+  std::vector<std::string> encodings;
+  std::vector<int> text;
+  std::vector<std::size_t> begins;
+  for (const auto& glyph : glyphs) {
+    const auto& operations = glyph.charstring.operations();
+    begins.emplace_back(text.size());
+    for (std::size_t i{}; i < operations.size(); ++i) {
+      std::string encoding;
+      CharString::encodeOperation(operations[i], &encoding);
+      const auto token = static_cast<int>(encodings.size());
+      if (i && movable(operations[i])) {
+        const auto pair = tokens.emplace(encoding, token);
+        if (!pair.second) {
+          text.emplace_back(pair.first->second);
+          continue;
+        }
+      }
+      encodings.emplace_back(std::move(encoding));
+      text.emplace_back(token);
+    }
+    text.emplace_back(static_cast<int>(encodings.size()));
+    encodings.emplace_back();
+  }
+  begins.emplace_back(text.size());
+  std::vector<std::size_t> offsets(text.size() + 1);
+  for (std::size_t i{}; i < text.size(); ++i) {
+    offsets[i + 1] = offsets[i] + encodings[text[i]].size();
+  }
+
+  // Every interval of the suffix array whose common prefix is longer than
+  // its enclosing interval's is a repeat, which is taken at its longest.
+  const auto suffixes = suffixArray(text);
+  const auto prefixes = longestCommonPrefixes(text, suffixes);
+  std::vector<Candidate> candidates;
+  const auto report = [&](std::size_t length,
+                          std::size_t first,
+                          std::size_t last) {
+    std::vector<std::size_t> positions(std::begin(suffixes) + first,
+                                       std::begin(suffixes) + last + 1);
+    std::sort(std::begin(positions), std::end(positions));
+    std::size_t count{};
+    std::size_t end{};
+    for (const auto position : positions) {
+      if (!count || position >= end) {
+        ++count;
+        end = position + length;
+      }
+    }
+    const auto position = positions.front();
+    Candidate candidate{position, length,
+                        offsets[position + length] - offsets[position],
+                        std::move(positions), 0, 0};
+    candidate.savings = savings(candidate, count, 3);
+    if (count > 1 && candidate.savings > 0) {
+      candidates.emplace_back(std::move(candidate));
+    }
+  };
+  std::vector<std::pair<std::size_t, std::size_t>> stack{{0, 0}};
+  for (std::size_t i = 1; i <= text.size(); ++i) {
+    const auto prefix = (i < text.size()) ? prefixes[i] : 0;
+    auto first = i - 1;
+    while (stack.back().first > prefix) {
+      const auto top = stack.back();
+      stack.pop_back();
+      report(top.first, top.second, i - 1);
+      first = top.second;
+    }
+    if (stack.back().first < prefix) {
+      stack.emplace_back(prefix, first);
+    }
+  }
+  const auto compare = [&text](const Candidate& lhs, const Candidate& rhs) {
+    if (lhs.savings != rhs.savings) {
+      return lhs.savings > rhs.savings;
+    } else if (lhs.length != rhs.length) {
+      return lhs.length > rhs.length;
+    }
+    return std::lexicographical_compare(
+        std::begin(text) + lhs.position,
+        std::begin(text) + lhs.position + lhs.length,
+        std::begin(text) + rhs.position,
+        std::begin(text) + rhs.position + rhs.length);
+  };
+  std::sort(std::begin(candidates), std::end(candidates), compare);
+  if (candidates.size() > max_candidates_) {
+    candidates.resize(max_candidates_);
+  }
+
+  // Parses every glyph into the cheapest sequence of operations and calls,
+  // given the subroutines numbered in the order of the candidates.
+  std::vector<int> choices(text.size(), -1);
+  const auto parse = [&]() {
+    const auto bias = cff::bias(candidates.size());
+    std::vector<std::vector<int>> starts(text.size());
+    std::vector<std::size_t> call_sizes;
+    for (std::size_t i{}; i < candidates.size(); ++i) {
+      auto& candidate = candidates[i];
+      candidate.usage = 0;
+      for (const auto position : candidate.positions) {
+        starts[position].emplace_back(static_cast<int>(i));
+      }
+      call_sizes.emplace_back(numberSize(static_cast<int>(i) - bias) + 1);
+    }
+    std::vector<std::size_t> costs(text.size() + 1);
+    for (std::size_t glyph{}; glyph < glyphs.size(); ++glyph) {
+      const auto begin = begins[glyph];
+      const auto end = begins[glyph + 1];
+      costs[end] = 0;
+      for (auto i = end; i-- > begin;) {
+        costs[i] = encodings[text[i]].size() + costs[i + 1];
+        choices[i] = -1;
+        for (const auto index : starts[i]) {
+          const auto next = i + candidates[index].length;
+          if (next > end) {
+            continue;
+          }
+          const auto cost = call_sizes[index] + costs[next];
+          if (cost < costs[i]) {
+            costs[i] = cost;
+            choices[i] = index;
+          }
+        }
+      }
+      for (auto i = begin; i < end;) {
+        if (choices[i] < 0) {
+          ++i;
+        } else {
+          auto& candidate = candidates[choices[i]];
+          ++candidate.usage;
+          i += candidate.length;
+        }
+      }
+    }
+    for (std::size_t i{}; i < candidates.size(); ++i) {
+      auto& candidate = candidates[i];
+      candidate.savings = savings(candidate, candidate.usage, call_sizes[i]);
+    }
+  };
+
+  // Subroutines that aren't used enough to pay off are dropped, and the
+  // rest are numbered again so that the most saving ones are the cheapest
+  // to call.
+  for (std::size_t pass{}; pass < passes_; ++pass) {
+    parse();
+    candidates.erase(std::remove_if(
+        std::begin(candidates), std::end(candidates),
+        [](const Candidate& candidate) {
+          return candidate.usage < 2 || candidate.savings <= 0;
+        }), std::end(candidates));
+    std::stable_sort(std::begin(candidates), std::end(candidates),
+                     [](const Candidate& lhs, const Candidate& rhs) {
+                       return lhs.savings > rhs.savings;
+                     });
+    if (candidates.size() > max_subroutines_) {
+      candidates.resize(max_subroutines_);
+    }
+  }
+  for (;;) {
+    parse();
+    const auto unused = std::remove_if(
+        std::begin(candidates), std::end(candidates),
+        [](const Candidate& candidate) { return !candidate.usage; });
+    if (unused == std::end(candidates)) {
+      break;
+    }
+    candidates.erase(unused, std::end(candidates));
+  }
+  if (candidates.empty()) {
+    return;
+  }
+
+  // Replace the repeats with calls.
+  const auto bias = cff::bias(candidates.size());
+  auto& subrs = global_ ? font->global_subrs : font->local_subrs;
+  subrs.clear();
+  for (const auto& candidate : candidates) {
+    std::string subr;
+    subr.reserve(candidate.bytes + 1);
+    for (std::size_t i{}; i < candidate.length; ++i) {
+      subr += encodings[text[candidate.position + i]];
+    }
+    subr.push_back(static_cast<char>(Operator::RETURN));
+    subrs.emplace_back(std::move(subr));
+  }
+  const auto call = global_ ? Operator::CALLGSUBR : Operator::CALLSUBR;
+  for (std::size_t glyph{}; glyph < glyphs.size(); ++glyph) {
+    auto& operations = glyphs[glyph].charstring.operations();
+    std::vector<Operation> result;
+    const auto begin = begins[glyph];
+    for (auto i = begin; i < begin + operations.size();) {
+      if (choices[i] < 0) {
+        result.emplace_back(std::move(operations[i - begin]));
+        ++i;
+      } else {
+        result.emplace_back(call, std::vector<double>{
+            static_cast<double>(choices[i] - bias)});
+        i += candidates[choices[i]].length;
+      }
+    }
+    operations = std::move(result);
+  }
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,63 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_SUBROUTINIZER_H_
+#define TOKEN_CFF_SUBROUTINIZER_H_
+
+#include <cstddef>
+
+#include "token/cff/font.h"
+
+namespace token {
+namespace cff {
+
+// Moves sequences of operations repeated across charstrings into
+// subroutines. Repeats are found with a suffix array over the operations of
+// all the glyphs, and each charstring is then parsed into the cheapest
+// combination of operations and subroutine calls. The result depends only on
+// the charstrings and the parameters.
+class Subroutinizer final {
+ public:
+  Subroutinizer();
+
+  // Copy semantics
+  Subroutinizer(const Subroutinizer&) = default;
+  Subroutinizer& operator=(const Subroutinizer&) = default;
+
+  // Subroutinizing
+  void operator()(Font *font) const;
+
+  // Parameters
+  // The number of candidates considered while parsing charstrings, which
+  // trades the size of the result for time.
+  std::size_t max_candidates() const { return max_candidates_; }
+  void set_max_candidates(std::size_t value) { max_candidates_ = value; }
+  std::size_t max_subroutines() const { return max_subroutines_; }
+  void set_max_subroutines(std::size_t value) { max_subroutines_ = value; }
+  // The number of times charstrings are parsed again after dropping the
+  // subroutines that don't pay off.
+  std::size_t passes() const { return passes_; }
+  void set_passes(std::size_t value) { passes_ = value; }
+  bool global() const { return global_; }
+  void set_global(bool value) { global_ = value; }
+
+ private:
+  std::size_t max_candidates_;
+  std::size_t max_subroutines_;
+  std::size_t passes_;
+  bool global_;
+};
+
+// MARK: -
+
+inline Subroutinizer::Subroutinizer()
+    : max_candidates_(4096),
+      max_subroutines_(65535),
+      passes_(2),
+      global_(true) {}
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_SUBROUTINIZER_H_
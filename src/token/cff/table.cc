@@ -0,0 +1,103 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/cff/table.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "token/cff/dict.h"
+#include "token/cff/index.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+constexpr int kCharsetOperator = 15;
+constexpr int kEncodingOperator = 16;
+constexpr int kPrivateOperator = 18;
+constexpr int kFontMatrixOperator = 1207;
+constexpr int kROSOperator = 1230;
+
+}  // namespace
+
+// MARK: Encoding and decoding
+
+std::string Table::encode() const {
+  // Offsets in the top DICT are always encoded in 5 bytes, so its size
+  // doesn't change by relocating them.
+  const auto rest_offset = (header_.size() + names_.size() +
+                            encodeIndex({top.encode()}).size());
+  const auto delta = (static_cast<double>(rest_offset) -
+                      static_cast<double>(rest_offset_));
+  Dict dict = top;
+  for (const auto& entry : top.entries()) {
+    if (!entry.offset) {
+      continue;
+    }
+    auto operands = entry.operands;
+    if (entry.op == kPrivateOperator) {
+      if (operands.size() == 2) {
+        operands[1] += delta;  // The first operand is the size
+      }
+    } else if (operands.size() == 1) {
+      // Charsets and encodings less than these are predefined.
+      if ((entry.op != kCharsetOperator || operands[0] > 2) &&
+          (entry.op != kEncodingOperator || operands[0] > 1)) {
+        operands[0] += delta;
+      }
+    }
+    dict.setOffset(entry.op, operands);
+  }
+  std::string result;
+  result.reserve(rest_offset + rest_.size());
+  result += header_;
+  result += names_;
+  result += encodeIndex({dict.encode()});
+  result += rest_;
+  return result;
+}
+
+bool Table::decode(const std::string& data) {
+  if (data.size() < 4 || data[0] != 1) {
+    return false;  // Unknown major version
+  }
+  const auto header_size = static_cast<std::uint8_t>(data[2]);
+  if (header_size < 4 || header_size > data.size()) {
+    return false;
+  }
+  std::size_t position = header_size;
+  std::vector<std::string> objects;
+  if (!decodeIndex(data, &position, &objects) || objects.size() != 1) {
+    return false;
+  }
+  names_ = data.substr(header_size, position - header_size);
+  if (!decodeIndex(data, &position, &objects) || objects.size() != 1 ||
+      !top.decode(objects.front()) || top.get(kROSOperator)) {
+    return false;
+  }
+  header_ = data.substr(0, header_size);
+  rest_ = data.substr(position);
+  rest_offset_ = position;
+  return true;
+}
+
+// MARK: Attributes
+
+std::vector<double> Table::font_matrix() const {
+  const auto operands = top.get(kFontMatrixOperator);
+  if (!operands || operands->size() != 6) {
+    return {0.001, 0.0, 0.0, 0.001, 0.0, 0.0};
+  }
+  return *operands;
+}
+
+void Table::set_font_matrix(const std::vector<double>& value) {
+  top.set(kFontMatrixOperator, value);
+}
+
+}  // namespace cff
+}  // namespace token
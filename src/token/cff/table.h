@@ -0,0 +1,54 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_CFF_TABLE_H_
+#define TOKEN_CFF_TABLE_H_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "token/cff/dict.h"
+
+namespace token {
+namespace cff {
+
+// An existing CFF table with a single font, whose top DICT can be edited in
+// place. The rest of the table is kept as it is, and the offsets in the top
+// DICT are relocated when it is encoded again. CID-keyed fonts are not
+// supported.
+class Table final {
+ public:
+  Table();
+
+  // Copy semantics
+  Table(const Table&) = default;
+  Table& operator=(const Table&) = default;
+
+  // Encoding and decoding
+  std::string encode() const;
+  bool decode(const std::string& data);
+
+  // Attributes
+  std::vector<double> font_matrix() const;
+  void set_font_matrix(const std::vector<double>& value);
+
+ public:
+  Dict top;
+
+ private:
+  std::string header_;
+  std::string names_;
+  std::string rest_;
+  std::size_t rest_offset_;
+};
+
+// MARK: -
+
+inline Table::Table() : rest_offset_() {}
+
+}  // namespace cff
+}  // namespace token
+
+#endif  // TOKEN_CFF_TABLE_H_
@@ -0,0 +1,255 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/coverage_rasterizer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+
+namespace {
+
+// The maximum distance between curves and their flattened segments in
+// pixels, and the limit of segments for each curve.
+constexpr double kTolerance = 0.05;
+constexpr std::size_t kMaxSegments = 100;
+
+double distance(double x, double y) {
+  return std::sqrt(x * x + y * y);
+}
+
+// Returns the number of segments that keeps a curve within the tolerance,
+// where the deviation bounds the distance between the curve and its chord
+// multiplied by the square of the number of segments.
+std::size_t segments(double deviation) {
+  const auto count = std::ceil(std::sqrt(deviation / kTolerance));
+  return std::min(static_cast<std::size_t>(std::max(count, 1.0)),
+                  kMaxSegments);
+}
+
+}  // namespace
+
+void CoverageRasterizer::reset(int width, int height) {
+  assert(width >= 0);
+  assert(height >= 0);
+  width_ = width;
+  height_ = height;
+  // Coverage of the segments on the right edge spills over two extra
+  // columns, which are never resolved.
+  stride_ = width_ + 2;
+  accumulation_.assign(stride_ * height_, 0.f);
+  row_.resize(width_);
+  start_ = shota::Vec2d();
+  current_ = shota::Vec2d();
+}
+
+// MARK: Drawing
+
+void CoverageRasterizer::moveTo(const shota::Vec2d& point) {
+  close();
+  start_ = point;
+  current_ = point;
+}
+
+void CoverageRasterizer::lineTo(const shota::Vec2d& point) {
+  accumulate(current_, point);
+  current_ = point;
+}
+
+void CoverageRasterizer::quadraticTo(const shota::Vec2d& control,
+                                     const shota::Vec2d& point) {
+  conicTo(control, point, 1.0);
+}
+
+void CoverageRasterizer::conicTo(const shota::Vec2d& control,
+                                 const shota::Vec2d& point,
+                                 double weight) {
+  const auto from = current_;
+  // The weight pulls the curve toward the control point, which is bounded
+  // by that of the quadratic curve scaled by the weight.
+  const auto count = segments(
+      std::max(weight, 1.0) / 4.0 *
+      distance(from.x - 2.0 * control.x + point.x,
+               from.y - 2.0 * control.y + point.y));
+  for (std::size_t i = 1; i < count; ++i) {
+    const auto t = static_cast<double>(i) / count;
+    const auto u = 1.0 - t;
+    const auto a = u * u;
+    const auto b = 2.0 * weight * u * t;
+    const auto c = t * t;
+    const auto w = a + b + c;
+    lineTo(shota::Vec2d((a * from.x + b * control.x + c * point.x) / w,
+                        (a * from.y + b * control.y + c * point.y) / w));
+  }
+  lineTo(point);
+}
+
+void CoverageRasterizer::cubicTo(const shota::Vec2d& control1,
+                                 const shota::Vec2d& control2,
+                                 const shota::Vec2d& point) {
+  const auto from = current_;
+  const auto count = segments(3.0 / 4.0 * std::max(
+      distance(from.x - 2.0 * control1.x + control2.x,
+               from.y - 2.0 * control1.y + control2.y),
+      distance(control1.x - 2.0 * control2.x + point.x,
+               control1.y - 2.0 * control2.y + point.y)));
+  for (std::size_t i = 1; i < count; ++i) {
+    const auto t = static_cast<double>(i) / count;
+    const auto u = 1.0 - t;
+    const auto a = u * u * u;
+    const auto b = 3.0 * u * u * t;
+    const auto c = 3.0 * u * t * t;
+    const auto d = t * t * t;
+    lineTo(shota::Vec2d(
+        a * from.x + b * control1.x + c * control2.x + d * point.x,
+        a * from.y + b * control1.y + c * control2.y + d * point.y));
+  }
+  lineTo(point);
+}
+
+void CoverageRasterizer::close() {
+  if (current_ != start_) {
+    lineTo(start_);
+  }
+}
+
+void CoverageRasterizer::draw(const shota::Shape2d& shape,
+                              double scale,
+                              const shota::Vec2d& origin) {
+  const auto transform = [&scale, &origin](const shota::Vec2d& point) {
+    return shota::Vec2d(origin.x + point.x * scale,
+                        origin.y - point.y * scale);
+  };
+  for (const auto& command : shape) {
+    switch (command.type()) {
+      case shota::graphics::CommandType::MOVE:
+        moveTo(transform(command.point()));
+        break;
+      case shota::graphics::CommandType::LINE:
+        lineTo(transform(command.point()));
+        break;
+      case shota::graphics::CommandType::QUADRATIC:
+        quadraticTo(transform(command.control()),
+                    transform(command.point()));
+        break;
+      case shota::graphics::CommandType::CONIC:
+        conicTo(transform(command.control()),
+                transform(command.point()),
+                command.weight());
+        break;
+      case shota::graphics::CommandType::CUBIC:
+        cubicTo(transform(command.control1()),
+                transform(command.control2()),
+                transform(command.point()));
+        break;
+      case shota::graphics::CommandType::CLOSE:
+        close();
+        break;
+      default:
+        assert(false);
+        break;
+    }
+  }
+  close();
+}
+
+void CoverageRasterizer::accumulate(const shota::Vec2d& from,
+                                    const shota::Vec2d& to) {
+  if (from.y == to.y) {
+    return;  // Horizontal segments cover no area
+  }
+  // Walk down the scanlines the segment crosses, adding the area to the
+  // right of the segment in each row as the difference to the pixel on its
+  // left, so that a prefix sum of the row yields the coverage.
+  const float direction = from.y < to.y ? 1.f : -1.f;
+  const auto& top = from.y < to.y ? from : to;
+  const auto& bottom = from.y < to.y ? to : from;
+  const auto dxdy = (bottom.x - top.x) / (bottom.y - top.y);
+  auto x = top.x;
+  if (top.y < 0.0) {
+    x -= top.y * dxdy;
+  }
+  const auto first = static_cast<int>(std::max(std::floor(top.y), 0.0));
+  const auto last = static_cast<int>(std::min(
+      std::ceil(bottom.y), static_cast<double>(height_)));
+  const auto right = static_cast<double>(width_);
+  for (auto y = first; y < last; ++y) {
+    const auto dy = (std::min(y + 1.0, bottom.y) -
+                     std::max(static_cast<double>(y), top.y));
+    const auto next = x + dxdy * dy;
+    const auto area = static_cast<float>(dy) * direction;
+    // Segments beyond the left edge cover the entire rows, and those beyond
+    // the right edge cover nothing.
+    const auto x0 = std::min(std::max(std::min(x, next), 0.0), right);
+    const auto x1 = std::min(std::max(std::max(x, next), 0.0), right);
+    const auto x0_floor = std::floor(x0);
+    const auto x1_ceil = std::ceil(x1);
+    const auto i0 = static_cast<std::size_t>(x0_floor);
+    const auto i1 = static_cast<std::size_t>(x1_ceil);
+    const auto line = &accumulation_[y * stride_];
+    if (i1 <= i0 + 1) {
+      // The segment stays in a pixel of the row.
+      const auto middle = static_cast<float>(0.5 * (x0 + x1) - x0_floor);
+      line[i0] += area - area * middle;
+      line[i0 + 1] += area * middle;
+    } else {
+      const auto slope = static_cast<float>(1.0 / (x1 - x0));
+      const auto x0_fraction = static_cast<float>(x0 - x0_floor);
+      const auto x1_fraction = static_cast<float>(x1 - x1_ceil + 1.0);
+      const auto a0 = 0.5f * slope * (1.f - x0_fraction) * (1.f - x0_fraction);
+      const auto am = 0.5f * slope * x1_fraction * x1_fraction;
+      line[i0] += area * a0;
+      if (i1 == i0 + 2) {
+        line[i0 + 1] += area * (1.f - a0 - am);
+      } else {
+        const auto a1 = slope * (1.5f - x0_fraction);
+        line[i0 + 1] += area * (a1 - a0);
+        for (auto i = i0 + 2; i < i1 - 1; ++i) {
+          line[i] += area * slope;
+        }
+        const auto a2 = a1 + (i1 - i0 - 3) * slope;
+        line[i1 - 1] += area * (1.f - a2 - am);
+      }
+      line[i1] += area * am;
+    }
+    x = next;
+  }
+}
+
+// MARK: Resolving
+
+void CoverageRasterizer::resolve(std::uint8_t *mask, std::size_t stride) {
+  assert(mask || !width_ || !height_);
+  assert(stride >= static_cast<std::size_t>(width_));
+  close();
+  for (int y{}; y < height_; ++y) {
+    // The prefix sum carries from pixel to pixel, and is kept apart from the
+    // conversion so that the latter loop can be vectorized.
+    const auto line = &accumulation_[y * stride_];
+    float sum{};
+    for (int x{}; x < width_; ++x) {
+      sum += line[x];
+      row_[x] = sum;
+    }
+    const auto output = mask + y * stride;
+    for (int x{}; x < width_; ++x) {
+      const auto coverage = std::min(std::abs(row_[x]), 1.f);
+      output[x] = static_cast<std::uint8_t>(coverage * 255.f + 0.5f);
+    }
+  }
+}
+
+std::vector<std::uint8_t> CoverageRasterizer::resolve() {
+  std::vector<std::uint8_t> result(width_ * height_);
+  resolve(result.data(), width_);
+  return result;
+}
+
+}  // namespace token
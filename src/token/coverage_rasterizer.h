@@ -0,0 +1,92 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_COVERAGE_RASTERIZER_H_
+#define TOKEN_COVERAGE_RASTERIZER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+
+namespace shota = shotamatsuda;
+
+// An anti-aliasing rasterizer that accumulates the signed area each line
+// segment covers in the pixels of its scanlines, and resolves the sums of
+// the rows into an 8-bit coverage mask. Curves are flattened into line
+// segments within a fraction of a pixel. Contours are filled by the nonzero
+// winding rule, and the parts outside the mask are clipped. It depends on
+// nothing but the graphics library, so that masks can be rendered without a
+// window server.
+class CoverageRasterizer final {
+ public:
+  CoverageRasterizer();
+  CoverageRasterizer(int width, int height);
+
+  // Copy semantics
+  CoverageRasterizer(const CoverageRasterizer&) = default;
+  CoverageRasterizer& operator=(const CoverageRasterizer&) = default;
+
+  // Clears the accumulation and resizes the mask.
+  void reset(int width, int height);
+
+  // Drawing, in pixels whose y-axis points downward
+  void moveTo(const shota::Vec2d& point);
+  void lineTo(const shota::Vec2d& point);
+  void quadraticTo(const shota::Vec2d& control, const shota::Vec2d& point);
+  void conicTo(const shota::Vec2d& control,
+               const shota::Vec2d& point,
+               double weight);
+  void cubicTo(const shota::Vec2d& control1,
+               const shota::Vec2d& control2,
+               const shota::Vec2d& point);
+  void close();
+
+  // Draws the shape in units whose y-axis points upward, scaling it and
+  // placing its origin at the pixel of the given position.
+  void draw(const shota::Shape2d& shape,
+            double scale,
+            const shota::Vec2d& origin);
+
+  // Resolving
+  // Writes the coverage of the rows into the mask, whose rows are the stride
+  // apart. Open contours are closed implicitly.
+  void resolve(std::uint8_t *mask, std::size_t stride);
+  std::vector<std::uint8_t> resolve();
+
+  // Attributes
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+ private:
+  void accumulate(const shota::Vec2d& from, const shota::Vec2d& to);
+
+ private:
+  int width_;
+  int height_;
+  std::size_t stride_;
+  std::vector<float> accumulation_;
+  std::vector<float> row_;
+  shota::Vec2d start_;
+  shota::Vec2d current_;
+};
+
+// MARK: -
+
+inline CoverageRasterizer::CoverageRasterizer()
+    : width_(),
+      height_(),
+      stride_() {}
+
+inline CoverageRasterizer::CoverageRasterizer(int width, int height)
+    : CoverageRasterizer() {
+  reset(width, height);
+}
+
+}  // namespace token
+
+#endif  // TOKEN_COVERAGE_RASTERIZER_H_
@@ -0,0 +1,145 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/glyph_atlas.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <utility>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+
+namespace {
+
+// Masks are separated by a pixel so that sampling a region with
+// interpolation doesn't pick up its neighbors.
+constexpr int kPadding = 1;
+
+// Finds the corners of the bounds of the points and the control points of
+// the shape, which contain its curves regardless of how tight the bounds of
+// the shape are. Returns false when the shape has no area.
+bool findControlBounds(const shota::Shape2d& shape,
+                       shota::Vec2d *min,
+                       shota::Vec2d *max) {
+  assert(min);
+  assert(max);
+  *min = shota::Vec2d(std::numeric_limits<double>::max(),
+                      std::numeric_limits<double>::max());
+  *max = shota::Vec2d(std::numeric_limits<double>::lowest(),
+                      std::numeric_limits<double>::lowest());
+  const auto extend = [min, max](const shota::Vec2d& point) {
+    min->x = std::min(min->x, point.x);
+    min->y = std::min(min->y, point.y);
+    max->x = std::max(max->x, point.x);
+    max->y = std::max(max->y, point.y);
+  };
+  for (const auto& command : shape) {
+    switch (command.type()) {
+      case shota::graphics::CommandType::MOVE:
+      case shota::graphics::CommandType::LINE:
+        extend(command.point());
+        break;
+      case shota::graphics::CommandType::QUADRATIC:
+      case shota::graphics::CommandType::CONIC:
+        extend(command.control());
+        extend(command.point());
+        break;
+      case shota::graphics::CommandType::CUBIC:
+        extend(command.control1());
+        extend(command.control2());
+        extend(command.point());
+        break;
+      default:
+        break;
+    }
+  }
+  return min->x < max->x && min->y < max->y;
+}
+
+}  // namespace
+
+// MARK: Lookup
+
+const GlyphAtlas::Region * GlyphAtlas::find(const std::string& name,
+                                            double width,
+                                            double scale) const {
+  const auto region = regions_.find(Key{name, width, scale});
+  if (region == std::end(regions_)) {
+    return nullptr;
+  }
+  return &region->second;
+}
+
+const GlyphAtlas::Region * GlyphAtlas::insert(const std::string& name,
+                                              double width,
+                                              double scale,
+                                              const shota::Shape2d& shape) {
+  assert(scale > 0.0);
+  Key key{name, width, scale};
+  const auto existing = regions_.find(key);
+  if (existing != std::end(regions_)) {
+    return &existing->second;
+  }
+  Region region{};
+  shota::Vec2d min;
+  shota::Vec2d max;
+  if (findControlBounds(shape, &min, &max)) {
+    // Pixels are aligned to the origin of the glyph, and the y-axis is
+    // flipped so that the first row of the mask is the top.
+    region.left = static_cast<int>(std::floor(min.x * scale));
+    region.top = static_cast<int>(std::floor(-max.y * scale));
+    region.width = static_cast<int>(std::ceil(max.x * scale)) - region.left;
+    region.height = static_cast<int>(std::ceil(-min.y * scale)) - region.top;
+    if (region.width + kPadding > width_ ||
+        region.height + kPadding > height_) {
+      return nullptr;
+    }
+    if (!allocate(region.width, region.height, &region.x, &region.y)) {
+      clear();
+      allocate(region.width, region.height, &region.x, &region.y);
+    }
+    rasterizer_.reset(region.width, region.height);
+    rasterizer_.draw(shape, scale, shota::Vec2d(-region.left, -region.top));
+    rasterizer_.resolve(&data_[region.y * width_ + region.x], width_);
+  }
+  return &regions_.emplace(std::move(key), region).first->second;
+}
+
+void GlyphAtlas::clear() {
+  regions_.clear();
+  std::fill(std::begin(data_), std::end(data_), 0);
+  shelf_x_ = 0;
+  shelf_y_ = 0;
+  shelf_height_ = 0;
+  ++generation_;
+}
+
+// MARK: Packing
+
+bool GlyphAtlas::allocate(int width, int height, int *x, int *y) {
+  assert(x);
+  assert(y);
+  width += kPadding;
+  height += kPadding;
+  if (shelf_x_ + width > width_) {
+    shelf_x_ = 0;
+    shelf_y_ += shelf_height_;
+    shelf_height_ = 0;
+  }
+  if (shelf_x_ + width > width_ || shelf_y_ + height > height_) {
+    return false;
+  }
+  *x = shelf_x_;
+  *y = shelf_y_;
+  shelf_x_ += width;
+  shelf_height_ = std::max(shelf_height_, height);
+  return true;
+}
+
+}  // namespace token
@@ -0,0 +1,137 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_GLYPH_ATLAS_H_
+#define TOKEN_GLYPH_ATLAS_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/coverage_rasterizer.h"
+#include "token/hash.h"
+
+namespace token {
+
+namespace shota = shotamatsuda;
+
+// A cache of the coverage masks of stroked glyphs, which are packed into the
+// rows of a single 8-bit image so that drawing a glyph again only copies its
+// region. Masks are keyed by the name of a glyph, the stroke width and the
+// scale from units to pixels, and the atlas starts over when it runs out of
+// space. Regions are valid until the next insertion.
+class GlyphAtlas final {
+ public:
+  struct Region final {
+    // The rectangle in the atlas
+    int x;
+    int y;
+    int width;
+    int height;
+
+    // The offset of the top left pixel from the origin of the glyph, where
+    // the y-axis points downward
+    int left;
+    int top;
+
+    bool empty() const { return !width || !height; }
+  };
+
+ public:
+  GlyphAtlas();
+  GlyphAtlas(int width, int height);
+
+  // Copy semantics
+  GlyphAtlas(const GlyphAtlas&) = default;
+  GlyphAtlas& operator=(const GlyphAtlas&) = default;
+
+  // Lookup
+  const Region * find(const std::string& name,
+                      double width,
+                      double scale) const;
+
+  // Rasterizes the shape and stores its mask, or returns nullptr when the
+  // mask doesn't fit in the atlas.
+  const Region * insert(const std::string& name,
+                        double width,
+                        double scale,
+                        const shota::Shape2d& shape);
+
+  // Removes all the masks without releasing the image.
+  void clear();
+
+  // Attributes
+  bool empty() const { return regions_.empty(); }
+  std::size_t size() const { return regions_.size(); }
+  int width() const { return width_; }
+  int height() const { return height_; }
+
+  // Counts the times the atlas was cleared or started over, which
+  // invalidates the regions found before and anything made of their pixels.
+  std::size_t generation() const { return generation_; }
+
+  // The pixels of the atlas, whose rows are the width apart
+  const std::uint8_t * data() const { return data_.data(); }
+
+ private:
+  struct Key final {
+    std::string name;
+    double width;
+    double scale;
+
+    bool operator==(const Key& other) const;
+  };
+
+  struct KeyHash final {
+    std::size_t operator()(const Key& key) const;
+  };
+
+ private:
+  bool allocate(int width, int height, int *x, int *y);
+
+ private:
+  int width_;
+  int height_;
+  std::vector<std::uint8_t> data_;
+  std::unordered_map<Key, Region, KeyHash> regions_;
+  CoverageRasterizer rasterizer_;
+
+  // The shelf that masks are placed on from left to right, and a new shelf
+  // begins below the tallest mask of the current one.
+  int shelf_x_;
+  int shelf_y_;
+  int shelf_height_;
+  std::size_t generation_;
+};
+
+// MARK: -
+
+inline GlyphAtlas::GlyphAtlas() : GlyphAtlas(1024, 1024) {}
+
+inline GlyphAtlas::GlyphAtlas(int width, int height)
+    : width_(width),
+      height_(height),
+      data_(width * height),
+      shelf_x_(),
+      shelf_y_(),
+      shelf_height_(),
+      generation_() {}
+
+// MARK: Keys
+
+inline bool GlyphAtlas::Key::operator==(const Key& other) const {
+  return name == other.name && width == other.width && scale == other.scale;
+}
+
+inline std::size_t GlyphAtlas::KeyHash::operator()(const Key& key) const {
+  return static_cast<std::size_t>(
+      Hasher().update(key.name).update(key.width).update(key.scale).value());
+}
+
+}  // namespace token
+
+#endif  // TOKEN_GLYPH_ATLAS_H_
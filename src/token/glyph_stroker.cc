@@ -21,6 +21,7 @@
 #include "token/types.h"
 #include "token/ufo/font_info.h"
 #include "token/ufo/glif/advance.h"
+#include "token/ufo/glif/anchor.h"
 #include "token/ufo/glyph.h"
 
 namespace token {
@@ -218,6 +219,28 @@ std::pair<shota::Shape2d, ufo::glif::Advance> GlyphStroker::operator()(
   return std::make_pair(shape, glyph_advance);
 }
 
+std::vector<ufo::glif::Anchor> GlyphStroker::anchors(
+    const ufo::FontInfo& font_info,
+    const ufo::Glyph& glyph,
+    const GlyphOutline& outline,
+    const shota::Shape2d& shape) const {
+  // The outline is scaled and offset so that the left of the stroked shape
+  // stays at the left of the outline, and the bottom of the stroke is at the
+  // baseline.
+  const auto scale = (font_info.cap_height - width_) / font_info.cap_height;
+  shota::Vec2d offset(0.0, width_ / 2.0);
+  if (!outline.shape().empty() && !shape.empty()) {
+    offset.x = (shape.bounds(true).minX() + width_ / 2.0 -
+                outline.shape().bounds(true).minX() * scale);
+  }
+  auto result = glyph.anchors;
+  for (auto& anchor : result) {
+    anchor.x = anchor.x * scale + offset.x;
+    anchor.y = anchor.y * scale + offset.y;
+  }
+  return result;
+}
+
 shota::Shape2d GlyphStroker::stroke(const ufo::Glyph& glyph,
                                     const GlyphOutline& outline) const {
   GlyphStroker stroker(*this);
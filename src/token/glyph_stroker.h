@@ -6,11 +6,13 @@
 #define TOKEN_GLYPH_STROKER_H_
 
 #include <utility>
+#include <vector>
 
 #include "shotamatsuda/graphics.h"
 #include "token/types.h"
 #include "token/ufo/font_info.h"
 #include "token/ufo/glif/advance.h"
+#include "token/ufo/glif/anchor.h"
 #include "token/ufo/glyph.h"
 
 namespace token {
@@ -37,6 +39,14 @@ class GlyphStroker final {
       const ufo::Glyph& glyph,
       const GlyphOutline& outline) const;
 
+  // Moves the anchors of the glyph along with its outline, which is stroked
+  // into the given shape. The stroke extends the outline by half its width
+  // where the outline is leftmost.
+  std::vector<ufo::glif::Anchor> anchors(const ufo::FontInfo& font_info,
+                                         const ufo::Glyph& glyph,
+                                         const GlyphOutline& outline,
+                                         const shota::Shape2d& shape) const;
+
   // Parameters
   double width() const { return width_; }
   void set_width(double value) { width_ = value; }
@@ -0,0 +1,79 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_HASH_H_
+#define TOKEN_HASH_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace token {
+
+// Incremental 64-bit FNV-1a hash, which is used to detect changes in file
+// contents rather than for security.
+class Hasher final {
+ public:
+  Hasher();
+
+  // Copy semantics
+  Hasher(const Hasher&) = default;
+  Hasher& operator=(const Hasher&) = default;
+
+  // Updating
+  Hasher& update(const void *data, std::size_t size);
+  Hasher& update(const std::string& value);
+  template <class T>
+  Hasher& update(const T& value);
+
+  // Value
+  std::uint64_t value() const { return value_; }
+
+ private:
+  std::uint64_t value_;
+};
+
+std::uint64_t hash(const void *data, std::size_t size);
+std::uint64_t hash(const std::string& value);
+
+// MARK: -
+
+inline Hasher::Hasher() : value_(0xcbf29ce484222325) {}
+
+// MARK: Updating
+
+inline Hasher& Hasher::update(const void *data, std::size_t size) {
+  const auto bytes = static_cast<const unsigned char *>(data);
+  for (std::size_t i{}; i < size; ++i) {
+    value_ ^= bytes[i];
+    value_ *= 0x100000001b3;
+  }
+  return *this;
+}
+
+inline Hasher& Hasher::update(const std::string& value) {
+  // Include the size so that concatenated strings hash differently.
+  update(value.size());
+  return update(value.data(), value.size());
+}
+
+template <class T>
+inline Hasher& Hasher::update(const T& value) {
+  static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value,
+                "Only arithmetic values can be hashed by their bytes");
+  return update(&value, sizeof(value));
+}
+
+inline std::uint64_t hash(const void *data, std::size_t size) {
+  return Hasher().update(data, size).value();
+}
+
+inline std::uint64_t hash(const std::string& value) {
+  return hash(value.data(), value.size());
+}
+
+}  // namespace token
+
+#endif  // TOKEN_HASH_H_
@@ -0,0 +1,57 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cstddef>
+#include <string>
+
+namespace token {
+
+// MARK: Opening and closing
+
+bool MappedFile::open(const std::string& path) {
+  close();
+  const auto descriptor = ::open(path.c_str(), O_RDONLY);
+  if (descriptor < 0) {
+    return false;
+  }
+  struct stat status {};
+  if (::fstat(descriptor, &status) || !S_ISREG(status.st_mode)) {
+    ::close(descriptor);
+    return false;
+  }
+  const auto size = static_cast<std::size_t>(status.st_size);
+  if (size) {
+    const auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE,
+                             descriptor, 0);
+    if (data == MAP_FAILED) {
+      ::close(descriptor);
+      return false;
+    }
+    // Small files are read entirely right after being mapped.
+    ::madvise(data, size, MADV_WILLNEED);
+    data_ = static_cast<const char *>(data);
+  }
+  // The mapping remains valid after closing the descriptor.
+  ::close(descriptor);
+  size_ = size;
+  open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+  if (data_) {
+    ::munmap(const_cast<char *>(data_), size_);
+  }
+  data_ = nullptr;
+  size_ = 0;
+  open_ = false;
+}
+
+}  // namespace token
@@ -0,0 +1,79 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_MAPPED_FILE_H_
+#define TOKEN_MAPPED_FILE_H_
+
+#include <cstddef>
+#include <string>
+#include <utility>
+
+namespace token {
+
+// Read-only memory mapping of a whole file.
+class MappedFile final {
+ public:
+  MappedFile();
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  // Disallow copy semantics
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Move semantics
+  MappedFile(MappedFile&& other);
+  MappedFile& operator=(MappedFile&& other);
+
+  // Opening and closing
+  bool open(const std::string& path);
+  void close();
+
+  // Attributes
+  bool is_open() const { return open_; }
+  const char * data() const { return data_; }
+  std::size_t size() const { return size_; }
+  bool empty() const { return !size_; }
+
+ private:
+  const char *data_;
+  std::size_t size_;
+  bool open_;
+};
+
+// MARK: -
+
+inline MappedFile::MappedFile() : data_(), size_(), open_() {}
+
+inline MappedFile::MappedFile(const std::string& path) : MappedFile() {
+  open(path);
+}
+
+inline MappedFile::~MappedFile() {
+  close();
+}
+
+// MARK: Move semantics
+
+inline MappedFile::MappedFile(MappedFile&& other)
+    : data_(other.data_),
+      size_(other.size_),
+      open_(other.open_) {
+  other.data_ = nullptr;
+  other.size_ = 0;
+  other.open_ = false;
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (&other != this) {
+    std::swap(data_, other.data_);
+    std::swap(size_, other.size_);
+    std::swap(open_, other.open_);
+  }
+  return *this;
+}
+
+}  // namespace token
+
+#endif  // TOKEN_MAPPED_FILE_H_
@@ -0,0 +1,360 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/outline_validator.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+
+namespace {
+
+using Polygon = std::vector<shota::Vec2d>;
+
+struct Segment final {
+  shota::Vec2d a;
+  shota::Vec2d b;
+  std::size_t polygon;
+  std::size_t index;
+};
+
+bool near(const shota::Vec2d& a, const shota::Vec2d& b, double tolerance) {
+  return (std::abs(a.x - b.x) <= tolerance &&
+          std::abs(a.y - b.y) <= tolerance);
+}
+
+double cross(const shota::Vec2d& origin,
+             const shota::Vec2d& a,
+             const shota::Vec2d& b) {
+  return ((a.x - origin.x) * (b.y - origin.y) -
+          (a.y - origin.y) * (b.x - origin.x));
+}
+
+bool opposite(double a, double b) {
+  return (a > 0.0 && b < 0.0) || (a < 0.0 && b > 0.0);
+}
+
+// Whether the segments cross each other or overlap along a line. Segments
+// that only touch are not considered to overlap.
+bool intersects(const Segment& s, const Segment& t) {
+  const auto d1 = cross(t.a, t.b, s.a);
+  const auto d2 = cross(t.a, t.b, s.b);
+  const auto d3 = cross(s.a, s.b, t.a);
+  const auto d4 = cross(s.a, s.b, t.b);
+  if (opposite(d1, d2) && opposite(d3, d4)) {
+    return true;
+  }
+  if (d1 || d2 || d3 || d4) {
+    return false;
+  }
+  // Collinear segments are projected onto their longer axis.
+  const bool horizontal = (std::abs(s.b.x - s.a.x) >=
+                           std::abs(s.b.y - s.a.y));
+  const auto s_min = horizontal ? std::min(s.a.x, s.b.x)
+                                : std::min(s.a.y, s.b.y);
+  const auto s_max = horizontal ? std::max(s.a.x, s.b.x)
+                                : std::max(s.a.y, s.b.y);
+  const auto t_min = horizontal ? std::min(t.a.x, t.b.x)
+                                : std::min(t.a.y, t.b.y);
+  const auto t_max = horizontal ? std::max(t.a.x, t.b.x)
+                                : std::max(t.a.y, t.b.y);
+  return std::min(s_max, t_max) > std::max(s_min, t_min);
+}
+
+// Flattens a closed path into the vertices of a polygon, whose last edge
+// returns to the first vertex implicitly.
+Polygon flatten(const shota::Path2d& path, std::size_t curve_segments) {
+  Polygon polygon;
+  for (const auto& command : path) {
+    const auto from = polygon.empty() ? command.point() : polygon.back();
+    switch (command.type()) {
+      case shota::graphics::CommandType::MOVE:
+      case shota::graphics::CommandType::LINE:
+        polygon.emplace_back(command.point());
+        break;
+      case shota::graphics::CommandType::QUADRATIC:
+      case shota::graphics::CommandType::CONIC: {
+        const auto& control = command.control();
+        const auto& to = command.point();
+        const auto weight = (command.type() ==
+                             shota::graphics::CommandType::CONIC ?
+                             command.weight() : 1.0);
+        for (std::size_t i = 1; i <= curve_segments; ++i) {
+          const auto t = static_cast<double>(i) / curve_segments;
+          const auto u = 1.0 - t;
+          const auto a = u * u;
+          const auto b = 2.0 * weight * u * t;
+          const auto c = t * t;
+          const auto w = a + b + c;
+          polygon.emplace_back((a * from.x + b * control.x + c * to.x) / w,
+                               (a * from.y + b * control.y + c * to.y) / w);
+        }
+        break;
+      }
+      case shota::graphics::CommandType::CUBIC: {
+        const auto& control1 = command.control1();
+        const auto& control2 = command.control2();
+        const auto& to = command.point();
+        for (std::size_t i = 1; i <= curve_segments; ++i) {
+          const auto t = static_cast<double>(i) / curve_segments;
+          const auto u = 1.0 - t;
+          const auto a = u * u * u;
+          const auto b = 3.0 * u * u * t;
+          const auto c = 3.0 * u * t * t;
+          const auto d = t * t * t;
+          polygon.emplace_back(
+              a * from.x + b * control1.x + c * control2.x + d * to.x,
+              a * from.y + b * control1.y + c * control2.y + d * to.y);
+        }
+        break;
+      }
+      case shota::graphics::CommandType::CLOSE:
+        break;
+      default:
+        assert(false);
+        break;
+    }
+  }
+  if (polygon.size() > 1 && polygon.front() == polygon.back()) {
+    polygon.pop_back();
+  }
+  return polygon;
+}
+
+// Even-odd test of whether the point is inside the polygon.
+bool contains(const Polygon& polygon, const shota::Vec2d& point) {
+  bool inside{};
+  for (std::size_t i{}, j = polygon.size() - 1; i < polygon.size(); j = i++) {
+    const auto& a = polygon[i];
+    const auto& b = polygon[j];
+    if ((a.y > point.y) != (b.y > point.y) &&
+        point.x < (b.x - a.x) * (point.y - a.y) / (b.y - a.y) + a.x) {
+      inside = !inside;
+    }
+  }
+  return inside;
+}
+
+}  // namespace
+
+// MARK: Validation
+
+OutlineValidator::Result OutlineValidator::operator()(
+    shota::Shape2d *shape) const {
+  assert(shape);
+  Result result{};
+  for (auto& path : shape->paths()) {
+    result.duplicate_points += removeDuplicatePoints(&path);
+  }
+  result.overlaps = countOverlaps(*shape);
+  if (!result.overlaps) {
+    result.reversed_paths = fixDirections(shape);
+  }
+  return result;
+}
+
+std::size_t OutlineValidator::removeDuplicatePoints(
+    shota::Path2d *path) const {
+  assert(path);
+  // A segment that doesn't move from the current point is removed along
+  // with its end point, unless it's a curve that forms a loop.
+  shota::Path2d result;
+  shota::Vec2d current;
+  std::size_t count{};
+  for (const auto& command : *path) {
+    const auto& point = command.point();
+    switch (command.type()) {
+      case shota::graphics::CommandType::MOVE:
+        result.moveTo(point.x, point.y);
+        current = point;
+        break;
+      case shota::graphics::CommandType::LINE:
+        if (near(point, current, tolerance_)) {
+          ++count;
+        } else {
+          result.lineTo(point.x, point.y);
+          current = point;
+        }
+        break;
+      case shota::graphics::CommandType::QUADRATIC:
+        if (near(point, current, tolerance_) &&
+            near(command.control(), current, tolerance_)) {
+          ++count;
+        } else {
+          result.quadraticTo(command.control().x, command.control().y,
+                             point.x, point.y);
+          current = point;
+        }
+        break;
+      case shota::graphics::CommandType::CONIC:
+        if (near(point, current, tolerance_) &&
+            near(command.control(), current, tolerance_)) {
+          ++count;
+        } else {
+          result.conicTo(command.control().x, command.control().y,
+                         point.x, point.y, command.weight());
+          current = point;
+        }
+        break;
+      case shota::graphics::CommandType::CUBIC:
+        if (near(point, current, tolerance_) &&
+            near(command.control1(), current, tolerance_) &&
+            near(command.control2(), current, tolerance_)) {
+          ++count;
+        } else {
+          result.cubicTo(command.control1().x, command.control1().y,
+                         command.control2().x, command.control2().y,
+                         point.x, point.y);
+          current = point;
+        }
+        break;
+      case shota::graphics::CommandType::CLOSE:
+        result.close();
+        break;
+      default:
+        assert(false);
+        break;
+    }
+  }
+  if (count) {
+    *path = result;
+  }
+  return count;
+}
+
+std::size_t OutlineValidator::countOverlaps(
+    const shota::Shape2d& shape) const {
+  std::vector<Polygon> polygons;
+  std::vector<Segment> segments;
+  for (const auto& path : shape.paths()) {
+    if (!path.closed()) {
+      continue;
+    }
+    polygons.emplace_back(flatten(path, curve_segments_));
+    const auto& polygon = polygons.back();
+    for (std::size_t i{}; polygon.size() > 2 && i < polygon.size(); ++i) {
+      segments.push_back(Segment{
+          polygon[i], polygon[(i + 1) % polygon.size()],
+          polygons.size() - 1, i});
+    }
+  }
+  if (segments.size() < 2) {
+    return 0;
+  }
+
+  // The segments are indexed by a uniform grid over their bounds, so that
+  // only the segments sharing a cell are tested against each other.
+  auto min_x = segments.front().a.x;
+  auto min_y = segments.front().a.y;
+  auto max_x = min_x;
+  auto max_y = min_y;
+  for (const auto& segment : segments) {
+    for (const auto& point : {segment.a, segment.b}) {
+      min_x = std::min(min_x, point.x);
+      min_y = std::min(min_y, point.y);
+      max_x = std::max(max_x, point.x);
+      max_y = std::max(max_y, point.y);
+    }
+  }
+  const auto size = static_cast<std::size_t>(
+      std::ceil(std::sqrt(static_cast<double>(segments.size()))));
+  const auto cell_width = std::max((max_x - min_x) / size, tolerance_);
+  const auto cell_height = std::max((max_y - min_y) / size, tolerance_);
+  const auto column = [&](double x) {
+    return std::min(static_cast<std::size_t>((x - min_x) / cell_width),
+                    size - 1);
+  };
+  const auto row = [&](double y) {
+    return std::min(static_cast<std::size_t>((y - min_y) / cell_height),
+                    size - 1);
+  };
+  std::vector<std::vector<std::size_t>> cells(size * size);
+  for (std::size_t i{}; i < segments.size(); ++i) {
+    const auto& segment = segments[i];
+    const auto first_column = column(std::min(segment.a.x, segment.b.x));
+    const auto last_column = column(std::max(segment.a.x, segment.b.x));
+    const auto first_row = row(std::min(segment.a.y, segment.b.y));
+    const auto last_row = row(std::max(segment.a.y, segment.b.y));
+    for (auto y = first_row; y <= last_row; ++y) {
+      for (auto x = first_column; x <= last_column; ++x) {
+        cells[y * size + x].emplace_back(i);
+      }
+    }
+  }
+  std::size_t count{};
+  for (std::size_t cell{}; cell < cells.size(); ++cell) {
+    const auto& indices = cells[cell];
+    for (auto i = std::begin(indices); i != std::end(indices); ++i) {
+      for (auto j = std::next(i); j != std::end(indices); ++j) {
+        const auto& s = segments[*i];
+        const auto& t = segments[*j];
+        // Consecutive segments of a polygon share their end points.
+        if (s.polygon == t.polygon) {
+          const auto last = polygons[s.polygon].size() - 1;
+          const auto distance = std::max(s.index, t.index) -
+                                std::min(s.index, t.index);
+          if (distance == 1 || distance == last) {
+            continue;
+          }
+        }
+        // A pair sharing multiple cells is only tested in the cell that
+        // contains the corner of the intersection of their bounds.
+        const auto x = std::max(std::min(s.a.x, s.b.x),
+                                std::min(t.a.x, t.b.x));
+        const auto y = std::max(std::min(s.a.y, s.b.y),
+                                std::min(t.a.y, t.b.y));
+        if (row(y) * size + column(x) != cell) {
+          continue;
+        }
+        if (intersects(s, t)) {
+          ++count;
+        }
+      }
+    }
+  }
+  return count;
+}
+
+std::size_t OutlineValidator::fixDirections(shota::Shape2d *shape) const {
+  assert(shape);
+  std::vector<shota::Path2d *> paths;
+  std::vector<Polygon> polygons;
+  for (auto& path : shape->paths()) {
+    if (path.closed() &&
+        path.direction() != shota::PathDirection::UNDEFINED) {
+      paths.emplace_back(&path);
+      polygons.emplace_back(flatten(path, curve_segments_));
+    }
+  }
+  // Without overlaps, a path is inside another when any of its points is,
+  // and paths at odd depths are holes.
+  std::size_t count{};
+  for (std::size_t i{}; i < paths.size(); ++i) {
+    if (polygons[i].empty()) {
+      continue;
+    }
+    std::size_t depth{};
+    for (std::size_t j{}; j < paths.size(); ++j) {
+      if (i != j && polygons[j].size() > 2 &&
+          contains(polygons[j], polygons[i].front())) {
+        ++depth;
+      }
+    }
+    const auto direction = (depth % 2 ?
+                            shota::PathDirection::COUNTER_CLOCKWISE :
+                            shota::PathDirection::CLOCKWISE);
+    if (paths[i]->direction() != direction) {
+      paths[i]->reverse();
+      ++count;
+    }
+  }
+  return count;
+}
+
+}  // namespace token
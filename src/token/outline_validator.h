@@ -0,0 +1,71 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_OUTLINE_VALIDATOR_H_
+#define TOKEN_OUTLINE_VALIDATOR_H_
+
+#include <cstddef>
+
+#include "shotamatsuda/graphics.h"
+
+namespace token {
+
+namespace shota = shotamatsuda;
+
+// Checks the closed paths of a shape for the problems checkOutlinesUFO of
+// AFDKO reports, which are duplicate points, wrong directions and overlaps.
+// Duplicate points are removed and the paths of wrong directions are
+// reversed in place, so that outer paths run clockwise and the paths inside
+// them alternate. Overlaps can't be removed here, and the directions are
+// left as they are when there're overlaps. A validator holds no state other
+// than its parameters, and can validate shapes on multiple threads.
+class OutlineValidator final {
+ public:
+  struct Result final {
+    std::size_t duplicate_points;
+    std::size_t reversed_paths;
+    std::size_t overlaps;
+
+    // Whether the shape was changed, and whether it has no problems left.
+    bool fixed() const { return duplicate_points || reversed_paths; }
+    bool clean() const { return !overlaps; }
+  };
+
+ public:
+  OutlineValidator();
+
+  // Copy semantics
+  OutlineValidator(const OutlineValidator&) = default;
+  OutlineValidator& operator=(const OutlineValidator&) = default;
+
+  // Validation
+  Result operator()(shota::Shape2d *shape) const;
+
+  // Parameters
+  // Points closer than the tolerance are duplicates.
+  double tolerance() const { return tolerance_; }
+  void set_tolerance(double value) { tolerance_ = value; }
+  // Curves are flattened into this number of segments to find overlaps.
+  std::size_t curve_segments() const { return curve_segments_; }
+  void set_curve_segments(std::size_t value) { curve_segments_ = value; }
+
+ private:
+  std::size_t removeDuplicatePoints(shota::Path2d *path) const;
+  std::size_t countOverlaps(const shota::Shape2d& shape) const;
+  std::size_t fixDirections(shota::Shape2d *shape) const;
+
+ private:
+  double tolerance_;
+  std::size_t curve_segments_;
+};
+
+// MARK: -
+
+inline OutlineValidator::OutlineValidator()
+    : tolerance_(0.001),
+      curve_segments_(8) {}
+
+}  // namespace token
+
+#endif  // TOKEN_OUTLINE_VALIDATOR_H_
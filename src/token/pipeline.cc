@@ -0,0 +1,95 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/pipeline.h"
+
+#include <cassert>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "token/thread_pool.h"
+
+namespace token {
+
+// MARK: Stages
+
+std::size_t Pipeline::add(const std::string& name,
+                          const Function& function,
+                          const std::vector<std::size_t>& dependencies) {
+  const auto index = stages_.size();
+  for (const auto dependency : dependencies) {
+    assert(dependency < index);
+    stages_[dependency].dependents.emplace_back(index);
+  }
+  stages_.push_back(Stage{name, function, {}, dependencies.size()});
+  return index;
+}
+
+// MARK: Running
+
+bool Pipeline::run(ThreadPool *pool) {
+  assert(pool);
+  failed_stage_.clear();
+  error_.clear();
+  std::mutex mutex;
+  std::condition_variable condition;
+  std::vector<std::size_t> remaining;
+  for (const auto& stage : stages_) {
+    remaining.emplace_back(stage.dependencies);
+  }
+  std::size_t running{};
+  std::size_t completed{};
+  bool failed{};
+
+  // This is called with the mutex locked.
+  std::function<void(std::size_t)> schedule;
+  schedule = [&](std::size_t index) {
+    ++running;
+    pool->enqueue([&, index] {
+      const auto& stage = stages_[index];
+      bool result{};
+      std::string error;
+      try {
+        result = stage.function();
+      } catch (const std::exception& e) {
+        error = e.what();
+      }
+      std::lock_guard<std::mutex> lock(mutex);
+      --running;
+      if (result) {
+        ++completed;
+        if (progress_handler_) {
+          progress_handler_(stage.name, completed, stages_.size());
+        }
+        if (!failed) {
+          for (const auto dependent : stage.dependents) {
+            if (!--remaining[dependent]) {
+              schedule(dependent);
+            }
+          }
+        }
+      } else if (!failed) {
+        failed = true;
+        failed_stage_ = stage.name;
+        error_ = error;
+      }
+      condition.notify_all();
+    });
+  };
+
+  std::unique_lock<std::mutex> lock(mutex);
+  for (std::size_t index{}; index < stages_.size(); ++index) {
+    if (!remaining[index]) {
+      schedule(index);
+    }
+  }
+  condition.wait(lock, [&running] { return !running; });
+  return !failed && completed == stages_.size();
+}
+
+}  // namespace token
@@ -0,0 +1,85 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_PIPELINE_H_
+#define TOKEN_PIPELINE_H_
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "token/thread_pool.h"
+
+namespace token {
+
+// Stages of a build that depend on each other. Each stage runs on a thread
+// pool as soon as all of the stages it depends on have completed, and a
+// stage fails by returning false or by throwing an exception. Stages that
+// haven't started when a stage fails never run.
+class Pipeline final {
+ public:
+  using Function = std::function<bool()>;
+  using ProgressHandler = std::function<void(const std::string& stage,
+                                             std::size_t completed,
+                                             std::size_t total)>;
+
+ public:
+  Pipeline() = default;
+
+  // Copy semantics
+  Pipeline(const Pipeline&) = default;
+  Pipeline& operator=(const Pipeline&) = default;
+
+  // Stages
+  std::size_t size() const { return stages_.size(); }
+  bool empty() const { return stages_.empty(); }
+
+  // Adds a stage that runs after the stages of the indices, which must have
+  // been added before it so that the stages never form a cycle. Returns the
+  // index of the stage.
+  std::size_t add(const std::string& name,
+                  const Function& function,
+                  const std::vector<std::size_t>& dependencies = {});
+
+  // Runs the stages and blocks until they all complete or one of them
+  // fails. This must not be called from a thread of the pool.
+  bool run(ThreadPool *pool);
+
+  // Results of the last run
+  const std::string& failed_stage() const { return failed_stage_; }
+  const std::string& error() const { return error_; }
+
+  // Parameters
+  // The handler is called on the threads of the pool every time a stage
+  // completes, while no other stage can complete.
+  const ProgressHandler& progress_handler() const { return progress_handler_; }
+  void set_progress_handler(const ProgressHandler& value);
+
+ private:
+  struct Stage final {
+    std::string name;
+    Function function;
+    std::vector<std::size_t> dependents;
+    std::size_t dependencies;
+  };
+
+ private:
+  std::vector<Stage> stages_;
+  ProgressHandler progress_handler_;
+  std::string failed_stage_;
+  std::string error_;
+};
+
+// MARK: -
+
+// MARK: Parameters
+
+inline void Pipeline::set_progress_handler(const ProgressHandler& value) {
+  progress_handler_ = value;
+}
+
+}  // namespace token
+
+#endif  // TOKEN_PIPELINE_H_
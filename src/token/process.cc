@@ -0,0 +1,227 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/process.h"
+
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+extern char **environ;
+
+namespace token {
+
+namespace {
+
+// The longest time to sleep before checking for processes that exited
+// without closing their pipes.
+constexpr std::chrono::milliseconds kPollInterval(50);
+
+bool createPipe(int descriptors[2]) {
+  if (::pipe(descriptors)) {
+    return false;
+  }
+  // Neither end may leak into processes spawned by other threads, or the
+  // read end would never see the end of file.
+  for (int i{}; i < 2; ++i) {
+    ::fcntl(descriptors[i], F_SETFD, FD_CLOEXEC);
+  }
+  ::fcntl(descriptors[0], F_SETFL,
+          ::fcntl(descriptors[0], F_GETFL) | O_NONBLOCK);
+  return true;
+}
+
+void closePipe(int descriptors[2]) {
+  ::close(descriptors[0]);
+  ::close(descriptors[1]);
+}
+
+}  // namespace
+
+// MARK: Launching and waiting
+
+bool Process::launch() {
+  if (running()) {
+    return false;
+  }
+  timed_out_ = false;
+  exit_status_ = -1;
+  output_.clear();
+  error_.clear();
+  close();
+
+  int output_pipe[2];
+  int error_pipe[2];
+  if (!createPipe(output_pipe)) {
+    return false;
+  }
+  if (!createPipe(error_pipe)) {
+    closePipe(output_pipe);
+    return false;
+  }
+  posix_spawn_file_actions_t actions;
+  ::posix_spawn_file_actions_init(&actions);
+  ::posix_spawn_file_actions_adddup2(&actions, output_pipe[1], STDOUT_FILENO);
+  ::posix_spawn_file_actions_adddup2(&actions, error_pipe[1], STDERR_FILENO);
+
+  std::vector<char *> arguments{const_cast<char *>(path_.c_str())};
+  for (const auto& argument : arguments_) {
+    arguments.emplace_back(const_cast<char *>(argument.c_str()));
+  }
+  arguments.emplace_back(nullptr);
+  std::vector<char *> environment;
+  for (const auto& variable : environment_) {
+    environment.emplace_back(const_cast<char *>(variable.c_str()));
+  }
+  environment.emplace_back(nullptr);
+
+  pid_t pid{};
+  const auto result = ::posix_spawn(
+      &pid, path_.c_str(), &actions, nullptr, arguments.data(),
+      environment_.empty() ? environ : environment.data());
+  ::posix_spawn_file_actions_destroy(&actions);
+  ::close(output_pipe[1]);
+  ::close(error_pipe[1]);
+  if (result) {
+    ::close(output_pipe[0]);
+    ::close(error_pipe[0]);
+    return false;
+  }
+  pid_ = pid;
+  output_descriptor_ = output_pipe[0];
+  error_descriptor_ = error_pipe[0];
+  deadline_ = std::chrono::steady_clock::now() + timeout_;
+  return true;
+}
+
+bool Process::wait(const std::vector<Process *>& processes) {
+  std::vector<pollfd> descriptors;
+  for (;;) {
+    const auto now = std::chrono::steady_clock::now();
+    auto interval = kPollInterval;
+    descriptors.clear();
+    for (const auto process : processes) {
+      assert(process);
+      if (!process->running()) {
+        continue;
+      }
+      if (process->timeout_.count() && now >= process->deadline_) {
+        process->timed_out_ = true;
+      }
+      if (process->timed_out_) {
+        process->kill();
+        continue;
+      }
+      if (process->timeout_.count()) {
+        interval = std::min(interval,
+            std::chrono::duration_cast<std::chrono::milliseconds>(
+                process->deadline_ - now) + std::chrono::milliseconds(1));
+      }
+      for (const auto descriptor : {process->output_descriptor_,
+                                    process->error_descriptor_}) {
+        if (descriptor >= 0) {
+          descriptors.push_back(pollfd{descriptor, POLLIN, 0});
+        }
+      }
+    }
+    if (std::none_of(std::begin(processes), std::end(processes),
+                     [](const Process *process) {
+                       return process->running();
+                     })) {
+      break;
+    }
+    if (::poll(descriptors.data(), descriptors.size(),
+               static_cast<int>(interval.count())) < 0 && errno != EINTR) {
+      break;
+    }
+    for (const auto process : processes) {
+      if (!process->running()) {
+        continue;
+      }
+      process->read(&process->output_descriptor_, &process->output_);
+      process->read(&process->error_descriptor_, &process->error_);
+      process->reap(false);
+      if (!process->running()) {
+        // Descendants may still hold the pipes after the process exited, so
+        // only what has been written so far is read.
+        process->read(&process->output_descriptor_, &process->output_);
+        process->read(&process->error_descriptor_, &process->error_);
+        process->close();
+      }
+    }
+  }
+  return std::all_of(std::begin(processes), std::end(processes),
+                     [](const Process *process) {
+                       return process->succeeded();
+                     });
+}
+
+bool Process::succeeded() const {
+  return !running() && !timed_out_ && !exit_status_;
+}
+
+void Process::read(int *descriptor, std::string *buffer) {
+  assert(descriptor);
+  assert(buffer);
+  char data[4096];
+  while (*descriptor >= 0) {
+    const auto size = ::read(*descriptor, data, sizeof(data));
+    if (size > 0) {
+      buffer->append(data, static_cast<std::size_t>(size));
+    } else if (size < 0 && errno == EINTR) {
+      continue;
+    } else if (size < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+      break;
+    } else {
+      ::close(*descriptor);
+      *descriptor = -1;
+    }
+  }
+}
+
+void Process::reap(bool block) {
+  int status{};
+  pid_t result;
+  do {
+    result = ::waitpid(pid_, &status, block ? 0 : WNOHANG);
+  } while (result < 0 && errno == EINTR);
+  if (result == pid_) {
+    if (WIFEXITED(status)) {
+      exit_status_ = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+      exit_status_ = 128 + WTERMSIG(status);
+    }
+    pid_ = 0;
+  } else if (result < 0) {
+    pid_ = 0;  // Reaped elsewhere
+  }
+}
+
+void Process::kill() {
+  ::kill(pid_, SIGKILL);
+  reap(true);
+  close();
+}
+
+void Process::close() {
+  for (const auto descriptor : {&output_descriptor_, &error_descriptor_}) {
+    if (*descriptor >= 0) {
+      ::close(*descriptor);
+      *descriptor = -1;
+    }
+  }
+}
+
+}  // namespace token
@@ -0,0 +1,130 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_PROCESS_H_
+#define TOKEN_PROCESS_H_
+
+#include <sys/types.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace token {
+
+// A child process spawned directly with an explicit argument vector and
+// environment, without going through a shell. The standard output and error
+// of the process are captured while waiting for it.
+class Process final {
+ public:
+  Process();
+  explicit Process(const std::string& path,
+                   const std::vector<std::string>& arguments = {});
+  ~Process();
+
+  // Disallow copy semantics
+  Process(const Process&) = delete;
+  Process& operator=(const Process&) = delete;
+
+  // Launching and waiting
+  bool launch();
+  bool wait();
+  bool run();
+
+  // Waits for all the processes at once, and returns whether all of them
+  // exited successfully.
+  static bool wait(const std::vector<Process *>& processes);
+
+  // Parameters
+  const std::string& path() const { return path_; }
+  void set_path(const std::string& value) { path_ = value; }
+  const std::vector<std::string>& arguments() const { return arguments_; }
+  void set_arguments(const std::vector<std::string>& value);
+
+  // Variables in the form of NAME=value. The process inherits the
+  // environment of the current process when there's none.
+  const std::vector<std::string>& environment() const { return environment_; }
+  void set_environment(const std::vector<std::string>& value);
+
+  // The process is killed when it doesn't exit within the timeout. Zero
+  // means no timeout.
+  std::chrono::milliseconds timeout() const { return timeout_; }
+  void set_timeout(std::chrono::milliseconds value) { timeout_ = value; }
+
+  // Results
+  bool running() const { return pid_ > 0; }
+  bool timed_out() const { return timed_out_; }
+  int exit_status() const { return exit_status_; }
+  const std::string& output() const { return output_; }
+  const std::string& error() const { return error_; }
+
+ private:
+  bool succeeded() const;
+  void read(int *descriptor, std::string *buffer);
+  void reap(bool block);
+  void kill();
+  void close();
+
+ private:
+  std::string path_;
+  std::vector<std::string> arguments_;
+  std::vector<std::string> environment_;
+  std::chrono::milliseconds timeout_;
+  std::chrono::steady_clock::time_point deadline_;
+  pid_t pid_;
+  int output_descriptor_;
+  int error_descriptor_;
+  bool timed_out_;
+  int exit_status_;
+  std::string output_;
+  std::string error_;
+};
+
+// MARK: -
+
+inline Process::Process()
+    : timeout_(),
+      pid_(),
+      output_descriptor_(-1),
+      error_descriptor_(-1),
+      timed_out_(),
+      exit_status_(-1) {}
+
+inline Process::Process(const std::string& path,
+                        const std::vector<std::string>& arguments)
+    : Process() {
+  path_ = path;
+  arguments_ = arguments;
+}
+
+inline Process::~Process() {
+  if (running()) {
+    kill();
+  }
+  close();
+}
+
+// MARK: Launching and waiting
+
+inline bool Process::wait() {
+  return wait({this});
+}
+
+inline bool Process::run() {
+  return launch() && wait();
+}
+
+// MARK: Parameters
+
+inline void Process::set_arguments(const std::vector<std::string>& value) {
+  arguments_ = value;
+}
+
+inline void Process::set_environment(const std::vector<std::string>& value) {
+  environment_ = value;
+}
+
+}  // namespace token
+
+#endif  // TOKEN_PROCESS_H_
@@ -0,0 +1,18 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_H_
+#define TOKEN_SFNT_H_
+
+#include "token/sfnt/builder.h"
+#include "token/sfnt/font.h"
+#include "token/sfnt/head.h"
+#include "token/sfnt/kerning_compiler.h"
+#include "token/sfnt/layout.h"
+#include "token/sfnt/mark_compiler.h"
+#include "token/sfnt/reader.h"
+#include "token/sfnt/woff_encoder.h"
+#include "token/sfnt/writer.h"
+
+#endif  // TOKEN_SFNT_H_
@@ -0,0 +1,699 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/builder.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ctime>
+#include <iterator>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/font.h"
+#include "token/sfnt/head.h"
+#include "token/sfnt/writer.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+template <class T, class U>
+inline T value(const ufo::Optional<T>& optional, const U& fallback) {
+  return optional.exists() ? *optional : static_cast<T>(fallback);
+}
+
+// Packs the bit numbers within [offset, offset + 32) into a bit field.
+inline std::uint32_t bits(const std::vector<unsigned int>& values,
+                          unsigned int offset = 0) {
+  std::uint32_t result{};
+  for (const auto value : values) {
+    if (value >= offset && value < offset + 32) {
+      result |= 1u << (value - offset);
+    }
+  }
+  return result;
+}
+
+// Converts "YYYY/MM/DD HH:MM:SS" into seconds since 1904, or the current time
+// when the date isn't given.
+std::int64_t longDateTime(const std::string& date) {
+  constexpr std::int64_t kEpochOffset = 2082844800;
+  int year, month, day, hour, minute, second;
+  if (std::sscanf(date.c_str(), "%d/%d/%d %d:%d:%d",
+                  &year, &month, &day, &hour, &minute, &second) != 6) {
+    return std::time(nullptr) + kEpochOffset;
+  }
+  // Days from the civil date, without depending on the time zone.
+  year -= month <= 2;
+  const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+  const std::int64_t year_of_era = year - era * 400;
+  const std::int64_t day_of_year =
+      (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+  const std::int64_t day_of_era = (year_of_era * 365 + year_of_era / 4 -
+                                   year_of_era / 100 + day_of_year);
+  const std::int64_t days = era * 146097 + day_of_era - 719468;
+  return (days * 86400 + hour * 3600 + minute * 60 + second +
+          kEpochOffset);
+}
+
+// Converts UTF-8 into UTF-16 in big endian, replacing malformed sequences.
+std::string utf16(const std::string& utf8) {
+  Writer writer;
+  for (std::size_t i{}; i < utf8.size();) {
+    const auto lead = static_cast<std::uint8_t>(utf8[i]);
+    std::uint32_t code{};
+    std::size_t length{};
+    if (lead < 0x80) {
+      code = lead;
+      length = 1;
+    } else if ((lead & 0xe0) == 0xc0) {
+      code = lead & 0x1f;
+      length = 2;
+    } else if ((lead & 0xf0) == 0xe0) {
+      code = lead & 0x0f;
+      length = 3;
+    } else if ((lead & 0xf8) == 0xf0) {
+      code = lead & 0x07;
+      length = 4;
+    }
+    bool valid = length && i + length <= utf8.size();
+    for (std::size_t j = 1; valid && j < length; ++j) {
+      const auto trail = static_cast<std::uint8_t>(utf8[i + j]);
+      valid = (trail & 0xc0) == 0x80;
+      code = (code << 6) | (trail & 0x3f);
+    }
+    if (!valid || code > 0x10ffff) {
+      code = 0xfffd;
+      length = 1;
+    }
+    if (code >= 0x10000) {
+      code -= 0x10000;
+      writer.uint16(static_cast<std::uint16_t>(0xd800 + (code >> 10)));
+      writer.uint16(static_cast<std::uint16_t>(0xdc00 + (code & 0x3ff)));
+    } else {
+      writer.uint16(static_cast<std::uint16_t>(code));
+    }
+    i += length;
+  }
+  return writer.release();
+}
+
+// Capitalizes the style map style name, e.g. "bold italic" to "Bold Italic".
+std::string subfamilyName(const std::string& style_map_style_name) {
+  if (style_map_style_name.empty()) {
+    return "Regular";
+  }
+  auto result = style_map_style_name;
+  bool capital = true;
+  for (auto& c : result) {
+    if (capital && c >= 'a' && c <= 'z') {
+      c = static_cast<char>(c - 'a' + 'A');
+    }
+    capital = (c == ' ');
+  }
+  return result;
+}
+
+// Unicode ranges of OS/2 that are assigned when the font info doesn't
+// specify them, which are the ones Latin fonts usually cover.
+struct UnicodeRange final {
+  unsigned int bit;
+  std::uint32_t first;
+  std::uint32_t last;
+};
+
+const UnicodeRange kUnicodeRanges[] = {
+  {0, 0x0000, 0x007f},  // Basic Latin
+  {1, 0x0080, 0x00ff},  // Latin-1 Supplement
+  {2, 0x0100, 0x017f},  // Latin Extended-A
+  {3, 0x0180, 0x024f},  // Latin Extended-B
+  {5, 0x02b0, 0x02ff},  // Spacing Modifier Letters
+  {6, 0x0300, 0x036f},  // Combining Diacritical Marks
+  {7, 0x0370, 0x03ff},  // Greek and Coptic
+  {9, 0x0400, 0x04ff},  // Cyrillic
+  {29, 0x1e00, 0x1eff},  // Latin Extended Additional
+  {31, 0x2000, 0x206f},  // General Punctuation
+  {33, 0x20a0, 0x20cf},  // Currency Symbols
+  {37, 0x2100, 0x214f},  // Letterlike Symbols
+  {38, 0x2200, 0x22ff},  // Mathematical Operators
+  {57, 0x10000, 0x10ffff},  // Non-Plane 0
+  {60, 0xe000, 0xf8ff},  // Private Use Area
+  {62, 0xfb00, 0xfb4f},  // Alphabetic Presentation Forms
+};
+
+}  // namespace
+
+// MARK: Tables
+
+std::string Builder::head() const {
+  const auto metrics = this->metrics();
+  const auto created = longDateTime(font_info.open_type_head_created);
+  const auto& style = font_info.style_map_style_name;
+  std::uint16_t mac_style{};
+  if (style == "bold" || style == "bold italic") {
+    mac_style |= 1 << 0;
+  }
+  if (style == "italic" || style == "bold italic") {
+    mac_style |= 1 << 1;
+  }
+  Head head;
+  head.font_revision = (value(font_info.version_major, 0) +
+                        value(font_info.version_minor, 0) / 1000.0);
+  head.flags = font_info.open_type_head_flags.empty() ?
+      0x3 : bits(font_info.open_type_head_flags);
+  head.units_per_em = static_cast<std::uint16_t>(std::round(unitsPerEm()));
+  head.created = created;
+  head.modified = created;
+  head.x_min = static_cast<std::int16_t>(std::round(metrics.x_min));
+  head.y_min = static_cast<std::int16_t>(std::round(metrics.y_min));
+  head.x_max = static_cast<std::int16_t>(std::round(metrics.x_max));
+  head.y_max = static_cast<std::int16_t>(std::round(metrics.y_max));
+  head.mac_style = mac_style;
+  head.lowest_rec_ppem = static_cast<std::uint16_t>(
+      value(font_info.open_type_head_lowest_rec_ppem, 6));
+  return head.encode();
+}
+
+std::string Builder::hhea() const {
+  const auto metrics = this->metrics();
+  const auto upem = unitsPerEm();
+  const auto ascender = value(font_info.ascender, upem * 0.8);
+  const auto descender = value(font_info.descender, -upem * 0.2);
+  const auto line_gap = std::max(std::round(upem * 1.2) -
+                                 ascender + descender, 0.0);
+  Writer writer;
+  writer.uint32(0x00010000);
+  writer.fword(value(font_info.open_type_hhea_ascender, ascender));
+  writer.fword(value(font_info.open_type_hhea_descender, descender));
+  writer.fword(value(font_info.open_type_hhea_line_gap, line_gap));
+  writer.ufword(metrics.advance_max);
+  writer.fword(metrics.lsb_min);
+  writer.fword(metrics.rsb_min);
+  writer.fword(metrics.extent_max);
+  writer.int16(value(font_info.open_type_hhea_caret_slope_rise, 1));
+  writer.int16(value(font_info.open_type_hhea_caret_slope_run, 0));
+  writer.int16(value(font_info.open_type_hhea_caret_offset, 0));
+  for (int i{}; i < 4; ++i) {
+    writer.int16(0);  // Reserved
+  }
+  writer.int16(0);  // metricDataFormat
+  writer.uint16(static_cast<std::uint16_t>(metrics.number_of_hmetrics));
+  return writer.release();
+}
+
+std::string Builder::hmtx() const {
+  const auto glyphs = ordered();
+  const auto metrics = this->metrics();
+  Writer writer;
+  for (std::size_t i{}; i < glyphs.size(); ++i) {
+    const auto& glyph = *glyphs[i];
+    const auto lsb = glyph.empty ? 0.0 : std::floor(glyph.bounds.minX());
+    if (i < metrics.number_of_hmetrics) {
+      writer.ufword(glyph.advance);
+    }
+    writer.fword(lsb);
+  }
+  return writer.release();
+}
+
+std::string Builder::maxp() const {
+  // Version 0.5 is for fonts with CFF outlines.
+  Writer writer;
+  writer.uint32(0x00005000);
+  writer.uint16(static_cast<std::uint16_t>(ordered().size()));
+  return writer.release();
+}
+
+std::string Builder::os2() const {
+  const auto glyphs = ordered();
+  const auto metrics = this->metrics();
+  const auto upem = unitsPerEm();
+  const auto ascender = value(font_info.ascender, upem * 0.8);
+  const auto descender = value(font_info.descender, -upem * 0.2);
+  const auto line_gap = std::max(std::round(upem * 1.2) -
+                                 ascender + descender, 0.0);
+  const auto x_height = value(font_info.x_height, upem * 0.5);
+
+  // Average of the advances of the glyphs that have non-zero widths.
+  double advance_sum{};
+  std::size_t advance_count{};
+  std::uint32_t first_char = 0xffff;
+  std::uint32_t last_char{};
+  std::vector<unsigned int> unicode_ranges;
+  for (const auto glyph : glyphs) {
+    if (glyph->advance > 0.0) {
+      advance_sum += std::round(glyph->advance);
+      ++advance_count;
+    }
+    for (const auto unicode : glyph->unicodes) {
+      first_char = std::min(first_char, unicode);
+      last_char = std::max(last_char, unicode);
+      for (const auto& range : kUnicodeRanges) {
+        if (unicode >= range.first && unicode <= range.last) {
+          unicode_ranges.emplace_back(range.bit);
+        }
+      }
+    }
+  }
+  if (first_char > last_char) {
+    first_char = last_char = 0;
+  }
+  if (!font_info.open_type_os2_unicode_ranges.empty()) {
+    unicode_ranges = font_info.open_type_os2_unicode_ranges;
+  }
+  auto code_page_ranges = font_info.open_type_os2_code_page_ranges;
+  if (code_page_ranges.empty() && bits(unicode_ranges) & 0x3) {
+    code_page_ranges.emplace_back(0);  // Latin 1
+  }
+
+  const auto& style = font_info.style_map_style_name;
+  auto selection = bits(font_info.open_type_os2_selection) & 0x380;
+  if (style == "italic" || style == "bold italic") {
+    selection |= 1 << 0;
+  }
+  if (style == "bold" || style == "bold italic") {
+    selection |= 1 << 5;
+  }
+  if (style.empty() || style == "regular") {
+    selection |= 1 << 6;
+  }
+  const auto& family_class = font_info.open_type_os2_family_class;
+  const auto& panose = font_info.open_type_os2_panose;
+  auto vendor_id = font_info.open_type_os2_vendor_id.substr(0, 4);
+  if (vendor_id.empty()) {
+    vendor_id = "NONE";
+  }
+
+  Writer writer;
+  writer.uint16(4);  // version
+  writer.fword(advance_count ? advance_sum / advance_count : 0.0);
+  writer.uint16(value(font_info.open_type_os2_weight_class, 400));
+  writer.uint16(value(font_info.open_type_os2_width_class, 5));
+  writer.uint16(bits(font_info.open_type_os2_type));
+  writer.fword(value(font_info.open_type_os2_subscript_x_size,
+                     upem * 0.65));
+  writer.fword(value(font_info.open_type_os2_subscript_y_size,
+                     upem * 0.6));
+  writer.fword(value(font_info.open_type_os2_subscript_x_offset, 0));
+  writer.fword(value(font_info.open_type_os2_subscript_y_offset,
+                     upem * 0.075));
+  writer.fword(value(font_info.open_type_os2_superscript_x_size,
+                     upem * 0.65));
+  writer.fword(value(font_info.open_type_os2_superscript_y_size,
+                     upem * 0.6));
+  writer.fword(value(font_info.open_type_os2_superscript_x_offset, 0));
+  writer.fword(value(font_info.open_type_os2_superscript_y_offset,
+                     upem * 0.35));
+  writer.fword(value(font_info.open_type_os2_strikeout_size,
+      value(font_info.postscript_underline_thickness, upem * 0.05)));
+  writer.fword(value(font_info.open_type_os2_strikeout_position,
+                     x_height * 0.6));
+  writer.int16(static_cast<std::int16_t>(family_class.size() == 2 ?
+      (family_class[0] << 8) | family_class[1] : 0));
+  for (std::size_t i{}; i < 10; ++i) {
+    writer.uint8(static_cast<std::uint8_t>(
+        i < panose.size() ? panose[i] : 0));
+  }
+  for (unsigned int offset{}; offset < 128; offset += 32) {
+    writer.uint32(bits(unicode_ranges, offset));
+  }
+  writer.tag(vendor_id);
+  writer.uint16(static_cast<std::uint16_t>(selection));
+  writer.uint16(static_cast<std::uint16_t>(std::min(first_char, 0xffffu)));
+  writer.uint16(static_cast<std::uint16_t>(std::min(last_char, 0xffffu)));
+  writer.fword(value(font_info.open_type_os2_typo_ascender, ascender));
+  writer.fword(value(font_info.open_type_os2_typo_descender, descender));
+  writer.fword(value(font_info.open_type_os2_typo_line_gap, line_gap));
+  writer.ufword(value(font_info.open_type_os2_win_ascent,
+                      std::max(metrics.y_max, 0.0)));
+  writer.ufword(value(font_info.open_type_os2_win_descent,
+                      std::max(-metrics.y_min, 0.0)));
+  writer.uint32(bits(code_page_ranges));
+  writer.uint32(bits(code_page_ranges, 32));
+  writer.fword(x_height);
+  writer.fword(value(font_info.cap_height, upem * 0.7));
+  writer.uint16(0);  // usDefaultChar
+  writer.uint16(' ');  // usBreakChar
+  writer.uint16(0);  // usMaxContext
+  return writer.release();
+}
+
+std::string Builder::name() const {
+  const auto& info = font_info;
+  const auto family_name = info.style_map_family_name.empty() ?
+      info.family_name : info.style_map_family_name;
+  const auto subfamily_name = subfamilyName(info.style_map_style_name);
+  auto postscript_name = info.postscript_font_name;
+  if (postscript_name.empty()) {
+    postscript_name = info.family_name + "-" + info.style_name;
+    postscript_name.erase(std::remove(std::begin(postscript_name),
+                                      std::end(postscript_name), ' '),
+                          std::end(postscript_name));
+  }
+  char version[64];
+  std::snprintf(version, sizeof(version), "%d.%03u",
+                value(info.version_major, 0), value(info.version_minor, 0));
+  auto version_name = info.open_type_name_version;
+  if (version_name.empty()) {
+    version_name = std::string("Version ") + version;
+  }
+  auto unique_id = info.open_type_name_unique_id;
+  if (unique_id.empty()) {
+    const auto& vendor_id = info.open_type_os2_vendor_id;
+    unique_id = (std::string(version) + ";" +
+                 (vendor_id.empty() ? "NONE" : vendor_id) + ";" +
+                 postscript_name);
+  }
+  auto full_name = info.postscript_full_name;
+  if (full_name.empty()) {
+    full_name = info.family_name + " " + info.style_name;
+  }
+  auto preferred_family_name = info.open_type_name_preferred_family_name;
+  if (preferred_family_name.empty() && info.family_name != family_name) {
+    preferred_family_name = info.family_name;
+  }
+  auto preferred_subfamily_name =
+      info.open_type_name_preferred_subfamily_name;
+  if (preferred_subfamily_name.empty() &&
+      !info.style_name.empty() && info.style_name != subfamily_name) {
+    preferred_subfamily_name = info.style_name;
+  }
+
+  // Records are keyed by platform, encoding, language and name identifiers,
+  // which is the order the table requires.
+  using Key = std::tuple<unsigned int, unsigned int,
+                         unsigned int, unsigned int>;
+  std::map<Key, std::string> records;
+  const auto set = [&records](unsigned int id, const std::string& string) {
+    if (!string.empty()) {
+      records[Key(3, 1, 0x409, id)] = utf16(string);
+    }
+  };
+  set(0, info.copyright);
+  set(1, family_name);
+  set(2, subfamily_name);
+  set(3, unique_id);
+  set(4, full_name);
+  set(5, version_name);
+  set(6, postscript_name);
+  set(7, info.trademark);
+  set(8, info.open_type_name_manufacturer);
+  set(9, info.open_type_name_designer);
+  set(10, info.open_type_name_description);
+  set(11, info.open_type_name_manufacturer_url);
+  set(12, info.open_type_name_designer_url);
+  set(13, info.open_type_name_license);
+  set(14, info.open_type_name_license_url);
+  set(16, preferred_family_name);
+  set(17, preferred_subfamily_name);
+  set(18, info.open_type_name_compatible_full_name);
+  set(19, info.open_type_name_sample_text);
+  set(21, info.open_type_name_wws_family_name);
+  set(22, info.open_type_name_wws_subfamily_name);
+  for (const auto& record : info.open_type_name_records) {
+    const Key key(record.platform_id, record.encoding_id,
+                  record.language_id, record.name_id);
+    if (record.platform_id == 0 || record.platform_id == 3) {
+      records[key] = utf16(record.string);
+    } else {
+      records[key] = record.string;
+    }
+  }
+
+  // Identical strings share their storage.
+  Writer storage;
+  std::map<std::string, std::size_t> offsets;
+  Writer writer;
+  writer.uint16(0);  // format
+  writer.uint16(static_cast<std::uint16_t>(records.size()));
+  writer.uint16(static_cast<std::uint16_t>(6 + 12 * records.size()));
+  for (const auto& record : records) {
+    auto offset = offsets.find(record.second);
+    if (offset == std::end(offsets)) {
+      offset = offsets.emplace(record.second, storage.size()).first;
+      storage.bytes(record.second);
+    }
+    writer.uint16(static_cast<std::uint16_t>(std::get<0>(record.first)));
+    writer.uint16(static_cast<std::uint16_t>(std::get<1>(record.first)));
+    writer.uint16(static_cast<std::uint16_t>(std::get<2>(record.first)));
+    writer.uint16(static_cast<std::uint16_t>(std::get<3>(record.first)));
+    writer.uint16(static_cast<std::uint16_t>(record.second.size()));
+    writer.uint16(static_cast<std::uint16_t>(offset->second));
+  }
+  writer.bytes(storage.data());
+  return writer.release();
+}
+
+std::string Builder::cmap() const {
+  // Code points map to the first glyph that has them.
+  const auto glyphs = ordered();
+  std::map<std::uint32_t, std::uint16_t> mapping;
+  for (std::size_t index{}; index < glyphs.size(); ++index) {
+    for (const auto unicode : glyphs[index]->unicodes) {
+      if (unicode <= 0x10ffff && unicode != 0xffff) {
+        mapping.emplace(unicode, static_cast<std::uint16_t>(index));
+      }
+    }
+  }
+
+  // Runs of consecutive code points mapped to consecutive glyphs.
+  struct Segment final {
+    std::uint32_t first;
+    std::uint32_t last;
+    std::uint16_t glyph;
+  };
+  const auto append = [](std::vector<Segment> *segments,
+                          std::uint32_t code,
+                          std::uint16_t glyph) {
+    if (!segments->empty()) {
+      auto& back = segments->back();
+      if (back.last + 1 == code && back.glyph + (code - back.first) == glyph) {
+        back.last = code;
+        return;
+      }
+    }
+    segments->push_back(Segment{code, code, glyph});
+  };
+  std::vector<Segment> bmp_segments;
+  std::vector<Segment> segments;
+  for (const auto& pair : mapping) {
+    if (pair.first <= 0xffff) {
+      append(&bmp_segments, pair.first, pair.second);
+    }
+    append(&segments, pair.first, pair.second);
+  }
+  const bool has_full = !mapping.empty() && mapping.rbegin()->first > 0xffff;
+
+  // Format 4 for the basic multilingual plane
+  Writer format4;
+  {
+    bmp_segments.push_back(Segment{0xffff, 0xffff, 0});
+    const auto count = bmp_segments.size();
+    std::uint16_t entry_selector{};
+    while ((2u << entry_selector) <= count) {
+      ++entry_selector;
+    }
+    const auto search_range = static_cast<std::uint16_t>(
+        2u << entry_selector);
+    const auto length = 16 + 8 * count;
+    assert(length <= 0xffff);
+    format4.uint16(4);
+    format4.uint16(static_cast<std::uint16_t>(length));
+    format4.uint16(0);  // language
+    format4.uint16(static_cast<std::uint16_t>(count * 2));
+    format4.uint16(search_range);
+    format4.uint16(entry_selector);
+    format4.uint16(static_cast<std::uint16_t>(count * 2 - search_range));
+    for (const auto& segment : bmp_segments) {
+      format4.uint16(static_cast<std::uint16_t>(segment.last));
+    }
+    format4.uint16(0);  // reservedPad
+    for (const auto& segment : bmp_segments) {
+      format4.uint16(static_cast<std::uint16_t>(segment.first));
+    }
+    for (const auto& segment : bmp_segments) {
+      const auto delta = (segment.first == 0xffff) ?
+          1u : static_cast<std::uint32_t>(segment.glyph) - segment.first;
+      format4.uint16(static_cast<std::uint16_t>(delta & 0xffff));
+    }
+    for (std::size_t i{}; i < count; ++i) {
+      format4.uint16(0);  // idRangeOffset
+    }
+  }
+
+  // Format 12 for the full repertoire when it goes beyond the plane
+  Writer format12;
+  if (has_full) {
+    format12.uint16(12);
+    format12.uint16(0);  // reserved
+    format12.uint32(static_cast<std::uint32_t>(16 + 12 * segments.size()));
+    format12.uint32(0);  // language
+    format12.uint32(static_cast<std::uint32_t>(segments.size()));
+    for (const auto& segment : segments) {
+      format12.uint32(segment.first);
+      format12.uint32(segment.last);
+      format12.uint32(segment.glyph);
+    }
+  }
+
+  // Unicode and Windows platforms share the subtables.
+  const std::uint32_t records = has_full ? 4 : 2;
+  const auto format4_offset = 4 + 8 * records;
+  const auto format12_offset = format4_offset + format4.size();
+  Writer writer;
+  writer.uint16(0);  // version
+  writer.uint16(static_cast<std::uint16_t>(records));
+  writer.uint16(0);
+  writer.uint16(3);
+  writer.uint32(format4_offset);
+  if (has_full) {
+    writer.uint16(0);
+    writer.uint16(4);
+    writer.uint32(static_cast<std::uint32_t>(format12_offset));
+  }
+  writer.uint16(3);
+  writer.uint16(1);
+  writer.uint32(format4_offset);
+  if (has_full) {
+    writer.uint16(3);
+    writer.uint16(10);
+    writer.uint32(static_cast<std::uint32_t>(format12_offset));
+  }
+  writer.bytes(format4.data());
+  writer.bytes(format12.data());
+  return writer.release();
+}
+
+std::string Builder::post() const {
+  // Version 3.0 has no glyph names, which CFF already contains.
+  const auto upem = unitsPerEm();
+  Writer writer;
+  writer.uint32(0x00030000);
+  writer.fixed(value(font_info.italic_angle, 0.0));
+  writer.fword(value(font_info.postscript_underline_position, -upem * 0.075));
+  writer.fword(value(font_info.postscript_underline_thickness, upem * 0.05));
+  writer.uint32(value(font_info.postscript_is_fixed_pitch, false) ? 1 : 0);
+  for (int i{}; i < 4; ++i) {
+    writer.uint32(0);  // Memory usage
+  }
+  return writer.release();
+}
+
+std::string Builder::gasp() const {
+  const auto& records = font_info.open_type_gasp_range_records;
+  if (records.empty()) {
+    return std::string();
+  }
+  Writer writer;
+  writer.uint16(1);  // version
+  writer.uint16(static_cast<std::uint16_t>(records.size()));
+  for (const auto& record : records) {
+    writer.uint16(static_cast<std::uint16_t>(record.range_max_ppem));
+    writer.uint16(static_cast<std::uint16_t>(
+        bits(record.range_gasp_behavior)));
+  }
+  return writer.release();
+}
+
+Font Builder::build(const std::string& cff) const {
+  Font font;
+  font.set("CFF ", cff);
+  font.set("head", head());
+  font.set("hhea", hhea());
+  font.set("hmtx", hmtx());
+  font.set("maxp", maxp());
+  font.set("OS/2", os2());
+  font.set("name", name());
+  font.set("cmap", cmap());
+  font.set("post", post());
+  const auto gasp = this->gasp();
+  if (!gasp.empty()) {
+    font.set("gasp", gasp);
+  }
+  return font;
+}
+
+// MARK: Glyphs
+
+std::vector<std::string> Builder::glyphOrder() const {
+  std::vector<std::string> result;
+  for (const auto glyph : ordered()) {
+    result.emplace_back(glyph->name);
+  }
+  return result;
+}
+
+std::vector<const Builder::Glyph *> Builder::ordered() const {
+  std::vector<const Glyph *> result;
+  result.reserve(glyphs_.size() + 1);
+  for (const auto& glyph : glyphs_) {
+    if (glyph.name == ".notdef") {
+      result.insert(std::begin(result), &glyph);
+    } else {
+      result.emplace_back(&glyph);
+    }
+  }
+  if (result.empty() || result.front()->name != ".notdef") {
+    result.insert(std::begin(result), &notdef_);
+  }
+  assert(result.size() <= 0xffff);
+  return result;
+}
+
+Builder::Metrics Builder::metrics() const {
+  const auto glyphs = ordered();
+  Metrics result{};
+  bool has_bounds{};
+  for (const auto glyph : glyphs) {
+    const auto advance = std::round(glyph->advance);
+    result.advance_max = std::max(result.advance_max, advance);
+    if (glyph->empty) {
+      continue;
+    }
+    const auto x_min = std::floor(glyph->bounds.minX());
+    const auto y_min = std::floor(glyph->bounds.minY());
+    const auto x_max = std::ceil(glyph->bounds.maxX());
+    const auto y_max = std::ceil(glyph->bounds.maxY());
+    if (!has_bounds) {
+      result.x_min = result.lsb_min = x_min;
+      result.y_min = y_min;
+      result.x_max = result.extent_max = x_max;
+      result.y_max = y_max;
+      result.rsb_min = advance - x_max;
+      has_bounds = true;
+    } else {
+      result.x_min = std::min(result.x_min, x_min);
+      result.y_min = std::min(result.y_min, y_min);
+      result.x_max = std::max(result.x_max, x_max);
+      result.y_max = std::max(result.y_max, y_max);
+      result.lsb_min = std::min(result.lsb_min, x_min);
+      result.rsb_min = std::min(result.rsb_min, advance - x_max);
+      result.extent_max = std::max(result.extent_max, x_max);
+    }
+  }
+  // Trailing glyphs with the same advance share the last horizontal metric.
+  auto count = glyphs.size();
+  while (count > 1 && std::round(glyphs[count - 1]->advance) ==
+                      std::round(glyphs[count - 2]->advance)) {
+    --count;
+  }
+  result.number_of_hmetrics = count;
+  return result;
+}
+
+double Builder::unitsPerEm() const {
+  return value(font_info.units_per_em, 1000.0);
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,102 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_BUILDER_H_
+#define TOKEN_SFNT_BUILDER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/sfnt/font.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace sfnt {
+
+namespace shota = shotamatsuda;
+
+// Builds the tables shared by every OpenType font from the font info and the
+// metrics of the glyphs, in place of the feature files makeotf reads. Glyphs
+// are ordered as in cff::Font, which moves .notdef to the first or inserts
+// an empty one.
+class Builder final {
+ public:
+  struct Glyph final {
+    std::string name;
+    std::vector<std::uint32_t> unicodes;
+    double advance;
+    shota::Rect2d bounds;
+    bool empty;
+  };
+
+ public:
+  Builder() = default;
+  explicit Builder(const ufo::FontInfo& font_info);
+
+  // Copy semantics
+  Builder(const Builder&) = default;
+  Builder& operator=(const Builder&) = default;
+
+  // Glyphs
+  std::size_t size() const { return glyphs_.size(); }
+  const std::vector<Glyph>& glyphs() const { return glyphs_; }
+  void add(const Glyph& glyph);
+  // Names of the glyphs in the order of their IDs.
+  std::vector<std::string> glyphOrder() const;
+
+  // Tables
+  std::string head() const;
+  std::string hhea() const;
+  std::string hmtx() const;
+  std::string maxp() const;
+  std::string os2() const;
+  std::string name() const;
+  std::string cmap() const;
+  std::string post() const;
+  std::string gasp() const;
+
+  // Creates a font with all the tables above and the given CFF table.
+  Font build(const std::string& cff) const;
+
+ public:
+  ufo::FontInfo font_info;
+
+ private:
+  struct Metrics final {
+    double x_min;
+    double y_min;
+    double x_max;
+    double y_max;
+    double advance_max;
+    double lsb_min;
+    double rsb_min;
+    double extent_max;
+    std::size_t number_of_hmetrics;
+  };
+
+  std::vector<const Glyph *> ordered() const;
+  Metrics metrics() const;
+  double unitsPerEm() const;
+
+ private:
+  std::vector<Glyph> glyphs_;
+  Glyph notdef_{".notdef", {}, 0.0, shota::Rect2d(), true};
+};
+
+// MARK: -
+
+inline Builder::Builder(const ufo::FontInfo& font_info)
+    : font_info(font_info) {}
+
+inline void Builder::add(const Glyph& glyph) {
+  glyphs_.emplace_back(glyph);
+}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_BUILDER_H_
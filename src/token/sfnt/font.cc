@@ -0,0 +1,149 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/font.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <utility>
+
+#include "token/mapped_file.h"
+#include "token/sfnt/reader.h"
+#include "token/sfnt/writer.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::size_t kHeaderSize = 12;
+constexpr std::size_t kTableRecordSize = 16;
+constexpr std::size_t kCheckSumAdjustmentOffset = 8;
+constexpr std::uint32_t kCheckSumMagic = 0xb1b0afba;
+
+}  // namespace
+
+// MARK: Opening and saving
+
+bool Font::open(const std::string& path) {
+  const MappedFile file(path);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return decode(file.data(), file.size());
+}
+
+bool Font::save(const std::string& path) const {
+  std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+  if (!stream.good()) {
+    return false;
+  }
+  const auto data = encode();
+  stream.write(data.data(), data.size());
+  return stream.good();
+}
+
+// MARK: Encoding and decoding
+
+std::string Font::encode() const {
+  const auto count = static_cast<std::uint16_t>(tables_.size());
+  std::uint16_t entry_selector{};
+  while ((2u << entry_selector) <= count) {
+    ++entry_selector;
+  }
+  const auto search_range = static_cast<std::uint16_t>(
+      (1u << entry_selector) * kTableRecordSize);
+
+  Writer writer;
+  writer.uint32(has("CFF ") ? 0x4f54544f : 0x00010000);  // 'OTTO'
+  writer.uint16(count);
+  writer.uint16(search_range);
+  writer.uint16(entry_selector);
+  writer.uint16(count * kTableRecordSize - search_range);
+
+  // The checksum of head is calculated with its adjustment zeroed, which is
+  // filled after the checksum of the whole font is known.
+  std::string head;
+  if (has("head")) {
+    head = get("head");
+    assert(head.size() >= kCheckSumAdjustmentOffset + 4);
+    head.replace(kCheckSumAdjustmentOffset, 4, 4, '\0');
+  }
+  std::size_t offset = kHeaderSize + count * kTableRecordSize;
+  std::size_t head_offset{};
+  for (const auto& table : tables_) {
+    const auto& data = (table.first == "head") ? head : table.second;
+    if (table.first == "head") {
+      head_offset = offset;
+    }
+    writer.tag(table.first);
+    writer.uint32(checksum(data));
+    writer.uint32(static_cast<std::uint32_t>(offset));
+    writer.uint32(static_cast<std::uint32_t>(data.size()));
+    offset += (data.size() + 3) & ~static_cast<std::size_t>(3);
+  }
+  for (const auto& table : tables_) {
+    writer.bytes((table.first == "head") ? head : table.second);
+    writer.pad(4);
+  }
+  auto result = writer.release();
+  assert(result.size() == offset);
+  if (has("head")) {
+    const auto adjustment = kCheckSumMagic - checksum(result);
+    for (int i{}; i < 4; ++i) {
+      result[head_offset + kCheckSumAdjustmentOffset + i] =
+          static_cast<char>((adjustment >> ((3 - i) * 8)) & 0xff);
+    }
+  }
+  return result;
+}
+
+bool Font::decode(const char *data, std::size_t size) {
+  assert(data || !size);
+  Reader reader(data, size);
+  const auto version = reader.uint32();
+  if (version != 0x00010000 &&
+      version != 0x4f54544f &&  // 'OTTO'
+      version != 0x74727565) {  // 'true'
+    return false;
+  }
+  const auto count = reader.uint16();
+  reader.skip(6);
+  Tables tables;
+  for (std::uint16_t i{}; i < count; ++i) {
+    const auto tag = reader.tag();
+    reader.skip(4);  // Checksum
+    const std::size_t offset = reader.uint32();
+    const std::size_t length = reader.uint32();
+    if (!reader.good() || offset > size || length > size - offset) {
+      return false;
+    }
+    tables[tag].assign(data + offset, length);
+  }
+  if (!reader.good()) {
+    return false;
+  }
+  tables_ = std::move(tables);
+  return true;
+}
+
+std::uint32_t Font::checksum(const char *data, std::size_t size) {
+  std::uint32_t result{};
+  for (std::size_t i{}; i < size; i += 4) {
+    std::uint32_t value{};
+    for (std::size_t j{}; j < 4; ++j) {
+      value <<= 8;
+      if (i + j < size) {
+        value |= static_cast<std::uint8_t>(data[i + j]);
+      }
+    }
+    result += value;
+  }
+  return result;
+}
+
+}  // namespace sfnt
+}  // namespace token
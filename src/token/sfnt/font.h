@@ -0,0 +1,108 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_FONT_H_
+#define TOKEN_SFNT_FONT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <string>
+
+namespace token {
+namespace sfnt {
+
+// A collection of sfnt tables keyed by their tags, which are written in the
+// order of the tags with their checksums and 4-byte alignment. Decoding a
+// font only reads its table directory, and tables are parsed when they are
+// edited.
+class Font final {
+ public:
+  using Tables = std::map<std::string, std::string>;
+
+ public:
+  Font() = default;
+
+  // Copy semantics
+  Font(const Font&) = default;
+  Font& operator=(const Font&) = default;
+
+  // Tables
+  const Tables& tables() const { return tables_; }
+  bool has(const std::string& tag) const;
+  const std::string& get(const std::string& tag) const;
+  void set(const std::string& tag, const std::string& data);
+  void erase(const std::string& tag);
+
+  // Editing
+  // Decodes the table into the given type, which has decode() and encode(),
+  // passes it to the editor, and encodes it back.
+  template <class Table, class Editor>
+  bool edit(const std::string& tag, Editor editor);
+
+  // Opening and saving
+  bool open(const std::string& path);
+  bool save(const std::string& path) const;
+
+  // Encoding and decoding
+  std::string encode() const;
+  bool decode(const char *data, std::size_t size);
+  bool decode(const std::string& data);
+
+  // Checksum of the data padded with zeros to a multiple of 4 bytes.
+  static std::uint32_t checksum(const char *data, std::size_t size);
+  static std::uint32_t checksum(const std::string& data);
+
+ private:
+  Tables tables_;
+};
+
+// MARK: -
+
+inline bool Font::has(const std::string& tag) const {
+  return tables_.find(tag) != std::end(tables_);
+}
+
+inline const std::string& Font::get(const std::string& tag) const {
+  return tables_.at(tag);
+}
+
+inline void Font::set(const std::string& tag, const std::string& data) {
+  tables_[tag] = data;
+}
+
+inline void Font::erase(const std::string& tag) {
+  tables_.erase(tag);
+}
+
+inline bool Font::decode(const std::string& data) {
+  return decode(data.data(), data.size());
+}
+
+// MARK: Editing
+
+template <class Table, class Editor>
+inline bool Font::edit(const std::string& tag, Editor editor) {
+  const auto itr = tables_.find(tag);
+  if (itr == std::end(tables_)) {
+    return false;
+  }
+  Table table;
+  if (!table.decode(itr->second)) {
+    return false;
+  }
+  editor(&table);
+  itr->second = table.encode();
+  return true;
+}
+
+inline std::uint32_t Font::checksum(const std::string& data) {
+  return checksum(data.data(), data.size());
+}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_FONT_H_
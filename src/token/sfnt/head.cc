@@ -0,0 +1,73 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/head.h"
+
+#include <cstdint>
+#include <string>
+
+#include "token/sfnt/reader.h"
+#include "token/sfnt/writer.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::uint32_t kMagicNumber = 0x5f0f3cf5;
+
+}  // namespace
+
+// MARK: Encoding and decoding
+
+std::string Head::encode() const {
+  Writer writer;
+  writer.uint32(0x00010000);
+  writer.fixed(font_revision);
+  writer.uint32(checksum_adjustment);
+  writer.uint32(kMagicNumber);
+  writer.uint16(flags);
+  writer.uint16(units_per_em);
+  writer.int64(created);
+  writer.int64(modified);
+  writer.int16(x_min);
+  writer.int16(y_min);
+  writer.int16(x_max);
+  writer.int16(y_max);
+  writer.uint16(mac_style);
+  writer.uint16(lowest_rec_ppem);
+  writer.int16(font_direction_hint);
+  writer.int16(index_to_loc_format);
+  writer.int16(glyph_data_format);
+  return writer.release();
+}
+
+bool Head::decode(const std::string& data) {
+  Reader reader(data);
+  if (reader.uint16() != 1) {
+    return false;  // Unknown major version
+  }
+  reader.skip(2);
+  font_revision = reader.fixed();
+  checksum_adjustment = reader.uint32();
+  if (reader.uint32() != kMagicNumber) {
+    return false;
+  }
+  flags = reader.uint16();
+  units_per_em = reader.uint16();
+  created = reader.int64();
+  modified = reader.int64();
+  x_min = reader.int16();
+  y_min = reader.int16();
+  x_max = reader.int16();
+  y_max = reader.int16();
+  mac_style = reader.uint16();
+  lowest_rec_ppem = reader.uint16();
+  font_direction_hint = reader.int16();
+  index_to_loc_format = reader.int16();
+  glyph_data_format = reader.int16();
+  return reader.good();
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,68 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_HEAD_H_
+#define TOKEN_SFNT_HEAD_H_
+
+#include <cstdint>
+#include <string>
+
+namespace token {
+namespace sfnt {
+
+// The fields of the head table, which is decoded as a whole and encoded in
+// version 1.0.
+class Head final {
+ public:
+  Head();
+
+  // Copy semantics
+  Head(const Head&) = default;
+  Head& operator=(const Head&) = default;
+
+  // Encoding and decoding
+  std::string encode() const;
+  bool decode(const std::string& data);
+
+ public:
+  double font_revision;
+  std::uint32_t checksum_adjustment;
+  std::uint16_t flags;
+  std::uint16_t units_per_em;
+  std::int64_t created;
+  std::int64_t modified;
+  std::int16_t x_min;
+  std::int16_t y_min;
+  std::int16_t x_max;
+  std::int16_t y_max;
+  std::uint16_t mac_style;
+  std::uint16_t lowest_rec_ppem;
+  std::int16_t font_direction_hint;
+  std::int16_t index_to_loc_format;
+  std::int16_t glyph_data_format;
+};
+
+// MARK: -
+
+inline Head::Head()
+    : font_revision(),
+      checksum_adjustment(),
+      flags(),
+      units_per_em(1000),
+      created(),
+      modified(),
+      x_min(),
+      y_min(),
+      x_max(),
+      y_max(),
+      mac_style(),
+      lowest_rec_ppem(),
+      font_direction_hint(2),
+      index_to_loc_format(),
+      glyph_data_format() {}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_HEAD_H_
@@ -0,0 +1,391 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/kerning_compiler.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/layout.h"
+#include "token/sfnt/writer.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::uint16_t kPairPositioning = 2;
+constexpr std::uint16_t kXAdvance = 0x0004;
+
+}  // namespace
+
+// MARK: Compiling
+
+Lookup KerningCompiler::lookup(
+    const std::vector<std::string>& glyph_order) const {
+  const auto pairs = resolve(glyph_order);
+  Lookup result{kPairPositioning, 0, {}};
+
+  // Glyph pairs come first, because a subtable of class pairs applies to
+  // every pair whose first glyph it covers.
+  for (const auto& firsts : partitionGlyphPairs(pairs)) {
+    Writer writer;
+    writer.uint16(1);
+    writer.uint16(0);  // Coverage, which is written last
+    writer.uint16(kXAdvance);
+    writer.uint16(0);
+    writer.uint16(static_cast<std::uint16_t>(firsts.size()));
+    std::size_t offset = 10 + 2 * firsts.size();
+    for (const auto first : firsts) {
+      writer.uint16(static_cast<std::uint16_t>(offset));
+      offset += 2 + 4 * pairs.glyphs.at(first).size();
+    }
+    for (const auto first : firsts) {
+      const auto& seconds = pairs.glyphs.at(first);
+      writer.uint16(static_cast<std::uint16_t>(seconds.size()));
+      for (const auto& second : seconds) {
+        writer.uint16(second.first);
+        writer.int16(second.second);
+      }
+    }
+    assert(offset == writer.size() && offset <= 0xffff);
+    auto subtable = writer.release();
+    subtable[2] = static_cast<char>((offset >> 8) & 0xff);
+    subtable[3] = static_cast<char>(offset & 0xff);
+    subtable += encodeCoverage(firsts);
+    result.subtables.emplace_back(std::move(subtable));
+  }
+
+  for (const auto& firsts : partitionClassPairs(pairs)) {
+    // The largest of the first classes becomes class 0, which needs no
+    // entries in the class definition.
+    std::size_t largest{};
+    for (std::size_t i{}; i < firsts.size(); ++i) {
+      if (pairs.first_classes[firsts[i]].glyphs.size() >
+          pairs.first_classes[firsts[largest]].glyphs.size()) {
+        largest = i;
+      }
+    }
+    std::vector<std::size_t> rows{firsts[largest]};
+    for (std::size_t i{}; i < firsts.size(); ++i) {
+      if (i != largest) {
+        rows.emplace_back(firsts[i]);
+      }
+    }
+    std::vector<std::uint16_t> coverage;
+    std::map<std::uint16_t, std::uint16_t> first_classes;
+    std::set<std::size_t> seconds;
+    for (std::size_t row{}; row < rows.size(); ++row) {
+      for (const auto glyph : pairs.first_classes[rows[row]].glyphs) {
+        coverage.emplace_back(glyph);
+        first_classes[glyph] = static_cast<std::uint16_t>(row);
+      }
+      for (const auto& pair : pairs.classes.at(rows[row])) {
+        seconds.emplace(pair.first);
+      }
+    }
+    std::sort(std::begin(coverage), std::end(coverage));
+    std::map<std::size_t, std::uint16_t> columns;
+    std::map<std::uint16_t, std::uint16_t> second_classes;
+    for (const auto second : seconds) {
+      const auto column = static_cast<std::uint16_t>(columns.size() + 1);
+      columns[second] = column;
+      for (const auto glyph : pairs.second_classes[second].glyphs) {
+        second_classes[glyph] = column;
+      }
+    }
+
+    Writer writer;
+    const auto records = 2 * rows.size() * (columns.size() + 1);
+    const auto coverage_data = encodeCoverage(coverage);
+    const auto first_data = encodeClassDef(first_classes);
+    const auto second_data = encodeClassDef(second_classes);
+    const auto coverage_offset = 16 + records;
+    const auto first_offset = coverage_offset + coverage_data.size();
+    const auto second_offset = first_offset + first_data.size();
+    assert(second_offset <= 0xffff);
+    writer.uint16(2);
+    writer.uint16(static_cast<std::uint16_t>(coverage_offset));
+    writer.uint16(kXAdvance);
+    writer.uint16(0);
+    writer.uint16(static_cast<std::uint16_t>(first_offset));
+    writer.uint16(static_cast<std::uint16_t>(second_offset));
+    writer.uint16(static_cast<std::uint16_t>(rows.size()));
+    writer.uint16(static_cast<std::uint16_t>(columns.size() + 1));
+    for (const auto row : rows) {
+      const auto& values = pairs.classes.at(row);
+      writer.int16(0);
+      for (const auto& column : columns) {
+        const auto value = values.find(column.first);
+        writer.int16(value != std::end(values) ? value->second : 0);
+      }
+    }
+    writer.bytes(coverage_data);
+    writer.bytes(first_data);
+    writer.bytes(second_data);
+    result.subtables.emplace_back(writer.release());
+  }
+  return result;
+}
+
+std::string KerningCompiler::features(
+    const std::vector<std::string>& glyph_order) const {
+  const auto pairs = resolve(glyph_order);
+  std::ostringstream stream;
+  std::set<std::string> used;
+  std::map<std::size_t, std::string> first_names;
+  std::map<std::size_t, std::string> second_names;
+  for (const auto& pair : pairs.classes) {
+    first_names.emplace(pair.first, std::string());
+    for (const auto& value : pair.second) {
+      second_names.emplace(value.first, std::string());
+    }
+  }
+  const auto define = [&](const Class& group, std::string *name) {
+    *name = "@" + glyphClassName(group.name, &used);
+    stream << *name << " = [";
+    for (std::size_t i{}; i < group.glyphs.size(); ++i) {
+      stream << (i ? " " : "") << glyph_order[group.glyphs[i]];
+    }
+    stream << "];" << std::endl;
+  };
+  for (auto& pair : first_names) {
+    define(pairs.first_classes[pair.first], &pair.second);
+  }
+  for (auto& pair : second_names) {
+    define(pairs.second_classes[pair.first], &pair.second);
+  }
+
+  // Makeotf places glyph pairs in their own subtables before class pairs,
+  // and subtable breaks only apply to class pairs.
+  for (const auto& first : pairs.glyphs) {
+    for (const auto& second : first.second) {
+      stream << "pos " << glyph_order[first.first] << " "
+             << glyph_order[second.first] << " " << second.second << ";"
+             << std::endl;
+    }
+  }
+  bool subtable{};
+  for (const auto& firsts : partitionClassPairs(pairs)) {
+    if (subtable) {
+      stream << "subtable;" << std::endl;
+    }
+    subtable = true;
+    for (const auto first : firsts) {
+      for (const auto& second : pairs.classes.at(first)) {
+        stream << "pos " << first_names.at(first) << " "
+               << second_names.at(second.first) << " " << second.second
+               << ";" << std::endl;
+      }
+    }
+  }
+  return stream.str();
+}
+
+// MARK: Pairs
+
+KerningCompiler::Pairs KerningCompiler::resolve(
+    const std::vector<std::string>& glyph_order) const {
+  assert(glyph_order.size() <= 0xffff);
+  std::unordered_map<std::string, std::uint16_t> ids;
+  for (std::size_t i{}; i < glyph_order.size(); ++i) {
+    ids.emplace(glyph_order[i], static_cast<std::uint16_t>(i));
+  }
+  const auto members = [this, &ids](const std::string& name) {
+    std::vector<std::uint16_t> result;
+    for (const auto& member : *groups.find(name)) {
+      const auto id = ids.find(member);
+      if (id != std::end(ids)) {
+        result.emplace_back(id->second);
+      }
+    }
+    std::sort(std::begin(result), std::end(result));
+    result.erase(std::unique(std::begin(result), std::end(result)),
+                 std::end(result));
+    return result;
+  };
+
+  // Classes of each side in the order of their names, without the glyphs
+  // that already belong to another class of the same side.
+  std::set<std::string> first_groups;
+  std::set<std::string> second_groups;
+  for (const auto& first : kerning) {
+    if (groups.find(first.first)) {
+      first_groups.emplace(first.first);
+    }
+    for (const auto& second : first.second) {
+      if (groups.find(second.first)) {
+        second_groups.emplace(second.first);
+      }
+    }
+  }
+  Pairs pairs;
+  std::map<std::string, std::size_t> first_indices;
+  std::map<std::string, std::size_t> second_indices;
+  const auto classify = [&members](
+      const std::set<std::string>& names,
+      std::vector<Class> *classes,
+      std::map<std::string, std::size_t> *indices) {
+    std::set<std::uint16_t> assigned;
+    for (const auto& name : names) {
+      Class group{name, {}};
+      for (const auto glyph : members(name)) {
+        if (assigned.emplace(glyph).second) {
+          group.glyphs.emplace_back(glyph);
+        }
+      }
+      if (!group.glyphs.empty()) {
+        indices->emplace(name, classes->size());
+        classes->emplace_back(std::move(group));
+      }
+    }
+  };
+  classify(first_groups, &pairs.first_classes, &first_indices);
+  classify(second_groups, &pairs.second_classes, &second_indices);
+
+  // Pairs of lower precedence don't replace the pairs that already exist.
+  enum class Kind { GLYPHS, GLYPH_GROUP, GROUP_GLYPH, GROUPS };
+  for (const auto kind : {Kind::GLYPHS, Kind::GLYPH_GROUP,
+                          Kind::GROUP_GLYPH, Kind::GROUPS}) {
+    for (const auto& first : kerning) {
+      const auto first_group = first_groups.count(first.first) != 0;
+      for (const auto& second : first.second) {
+        const auto second_group = second_groups.count(second.first) != 0;
+        const auto value = static_cast<std::int16_t>(
+            std::round(second.second));
+        if (kind == Kind::GROUPS) {
+          if (!first_group || !second_group || !value) {
+            continue;
+          }
+          const auto first_index = first_indices.find(first.first);
+          const auto second_index = second_indices.find(second.first);
+          if (first_index != std::end(first_indices) &&
+              second_index != std::end(second_indices)) {
+            pairs.classes[first_index->second][second_index->second] = value;
+          }
+          continue;
+        }
+        if ((kind == Kind::GLYPHS && (first_group || second_group)) ||
+            (kind == Kind::GLYPH_GROUP && (first_group || !second_group)) ||
+            (kind == Kind::GROUP_GLYPH && (!first_group || second_group))) {
+          continue;
+        }
+        std::vector<std::uint16_t> firsts;
+        std::vector<std::uint16_t> seconds;
+        if (first_group) {
+          firsts = members(first.first);
+        } else if (ids.count(first.first)) {
+          firsts.emplace_back(ids.at(first.first));
+        }
+        if (second_group) {
+          seconds = members(second.first);
+        } else if (ids.count(second.first)) {
+          seconds.emplace_back(ids.at(second.first));
+        }
+        for (const auto glyph : firsts) {
+          for (const auto other : seconds) {
+            pairs.glyphs[glyph].emplace(other, value);
+          }
+        }
+      }
+    }
+  }
+  return pairs;
+}
+
+std::vector<std::vector<std::uint16_t>> KerningCompiler::partitionGlyphPairs(
+    const Pairs& pairs) const {
+  // The format 1 subtable has a 10-byte header and an offset, a coverage
+  // entry and a pair set for each first glyph.
+  std::vector<std::vector<std::uint16_t>> result;
+  std::vector<std::uint16_t> firsts;
+  std::size_t size{};
+  for (const auto& pair : pairs.glyphs) {
+    const auto increase = 2 + 2 + 2 + 4 * pair.second.size();
+    if (!firsts.empty() && size + increase > max_subtable_size_) {
+      result.emplace_back(std::move(firsts));
+      firsts.clear();
+    }
+    if (firsts.empty()) {
+      size = 10 + 4;
+    }
+    firsts.emplace_back(pair.first);
+    size += increase;
+  }
+  if (!firsts.empty()) {
+    result.emplace_back(std::move(firsts));
+  }
+  return result;
+}
+
+std::vector<std::vector<std::size_t>> KerningCompiler::partitionClassPairs(
+    const Pairs& pairs) const {
+  // The format 2 subtable has a 16-byte header and a value for each pair of
+  // the classes, followed by the coverage and the class definitions, whose
+  // sizes are at most 2 bytes for each glyph of the coverage and 6 bytes for
+  // each glyph of the class definitions plus their headers.
+  const auto bound = [](std::size_t rows,
+                        std::size_t columns,
+                        std::size_t first_glyphs,
+                        std::size_t second_glyphs) {
+    return (16 + 2 * rows * (columns + 1) +
+            4 + 2 * first_glyphs +
+            4 + 6 * first_glyphs +
+            4 + 6 * second_glyphs);
+  };
+  std::vector<std::vector<std::size_t>> result;
+  std::vector<std::size_t> firsts;
+  std::set<std::size_t> seconds;
+  std::size_t first_glyphs{};
+  std::size_t second_glyphs{};
+  for (const auto& pair : pairs.classes) {
+    auto next_seconds = seconds;
+    auto next_second_glyphs = second_glyphs;
+    for (const auto& value : pair.second) {
+      if (next_seconds.emplace(value.first).second) {
+        next_second_glyphs += pairs.second_classes[value.first].glyphs.size();
+      }
+    }
+    const auto glyphs = pairs.first_classes[pair.first].glyphs.size();
+    if (!firsts.empty() &&
+        bound(firsts.size() + 1, next_seconds.size(),
+              first_glyphs + glyphs, next_second_glyphs) >
+        max_subtable_size_) {
+      result.emplace_back(std::move(firsts));
+      firsts.clear();
+      seconds.clear();
+      first_glyphs = 0;
+      second_glyphs = 0;
+      next_seconds.clear();
+      next_second_glyphs = 0;
+      for (const auto& value : pair.second) {
+        next_seconds.emplace(value.first);
+        next_second_glyphs += pairs.second_classes[value.first].glyphs.size();
+      }
+    }
+    firsts.emplace_back(pair.first);
+    seconds = std::move(next_seconds);
+    first_glyphs += glyphs;
+    second_glyphs = next_second_glyphs;
+  }
+  if (!firsts.empty()) {
+    result.emplace_back(std::move(firsts));
+  }
+  return result;
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,89 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_KERNING_COMPILER_H_
+#define TOKEN_SFNT_KERNING_COMPILER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/layout.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace sfnt {
+
+// Compiles the kerning of a UFO into a pair positioning lookup of GPOS, or
+// into the equivalent feature file. Pairs of groups become class pairs, and
+// pairs with a glyph on either side become glyph pairs that take precedence
+// over them, in the order of glyph and glyph, glyph and group, and group and
+// glyph. Both UFO 3 groups and the @MMK_L_ and @MMK_R_ groups of UFO 2 are
+// recognized. A glyph in more than one group of the same side belongs to the
+// first of them by name. The result depends only on the kerning, the groups
+// and the glyph order.
+class KerningCompiler final {
+ public:
+  KerningCompiler();
+  KerningCompiler(const ufo::Kerning& kerning, const ufo::Groups& groups);
+
+  // Copy semantics
+  KerningCompiler(const KerningCompiler&) = default;
+  KerningCompiler& operator=(const KerningCompiler&) = default;
+
+  // Compiling
+  Lookup lookup(const std::vector<std::string>& glyph_order) const;
+  std::string features(const std::vector<std::string>& glyph_order) const;
+
+  // Parameters
+  // The upper bound of the size of each subtable, beyond which pairs are
+  // split into another subtable. Offsets in subtables are 16-bit.
+  std::size_t max_subtable_size() const { return max_subtable_size_; }
+  void set_max_subtable_size(std::size_t value) { max_subtable_size_ = value; }
+
+ public:
+  ufo::Kerning kerning;
+  ufo::Groups groups;
+
+ private:
+  struct Class final {
+    std::string name;
+    std::vector<std::uint16_t> glyphs;
+  };
+
+  struct Pairs final {
+    std::map<std::uint16_t, std::map<std::uint16_t, std::int16_t>> glyphs;
+    std::vector<Class> first_classes;
+    std::vector<Class> second_classes;
+    std::map<std::size_t, std::map<std::size_t, std::int16_t>> classes;
+  };
+
+  Pairs resolve(const std::vector<std::string>& glyph_order) const;
+  std::vector<std::vector<std::uint16_t>> partitionGlyphPairs(
+      const Pairs& pairs) const;
+  std::vector<std::vector<std::size_t>> partitionClassPairs(
+      const Pairs& pairs) const;
+
+ private:
+  std::size_t max_subtable_size_;
+};
+
+// MARK: -
+
+inline KerningCompiler::KerningCompiler() : max_subtable_size_(0xffff) {}
+
+inline KerningCompiler::KerningCompiler(const ufo::Kerning& kerning,
+                                        const ufo::Groups& groups)
+    : kerning(kerning),
+      groups(groups),
+      max_subtable_size_(0xffff) {}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_KERNING_COMPILER_H_
@@ -0,0 +1,287 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/layout.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cctype>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/writer.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::uint16_t kExtensionPositioning = 9;
+constexpr std::size_t kHeaderSize = 10;
+constexpr std::size_t kMaxOffset = 0xffff;
+constexpr std::size_t kMaxClassNameSize = 63;
+
+// Layout features apply to these scripts, which share a single script table.
+const char * const kScripts[] = {"DFLT", "latn"};
+
+}  // namespace
+
+// MARK: Common tables
+
+std::string encodeCoverage(const std::vector<std::uint16_t>& glyphs) {
+  assert(std::is_sorted(std::begin(glyphs), std::end(glyphs)));
+  std::vector<std::pair<std::uint16_t, std::uint16_t>> ranges;
+  for (const auto glyph : glyphs) {
+    if (ranges.empty() || ranges.back().second + 1 != glyph) {
+      ranges.emplace_back(glyph, glyph);
+    } else {
+      ranges.back().second = glyph;
+    }
+  }
+  Writer writer;
+  if (2 * glyphs.size() <= 6 * ranges.size()) {
+    writer.uint16(1);
+    writer.uint16(static_cast<std::uint16_t>(glyphs.size()));
+    for (const auto glyph : glyphs) {
+      writer.uint16(glyph);
+    }
+  } else {
+    writer.uint16(2);
+    writer.uint16(static_cast<std::uint16_t>(ranges.size()));
+    std::uint16_t index{};
+    for (const auto& range : ranges) {
+      writer.uint16(range.first);
+      writer.uint16(range.second);
+      writer.uint16(index);
+      index += range.second - range.first + 1;
+    }
+  }
+  return writer.release();
+}
+
+std::string encodeClassDef(
+    const std::map<std::uint16_t, std::uint16_t>& classes) {
+  struct Range final {
+    std::uint16_t first;
+    std::uint16_t last;
+    std::uint16_t value;
+  };
+  std::vector<Range> ranges;
+  for (const auto& pair : classes) {
+    if (!pair.second) {
+      continue;
+    }
+    if (ranges.empty() ||
+        ranges.back().last + 1 != pair.first ||
+        ranges.back().value != pair.second) {
+      ranges.push_back({pair.first, pair.first, pair.second});
+    } else {
+      ranges.back().last = pair.first;
+    }
+  }
+  Writer writer;
+  if (ranges.empty()) {
+    writer.uint16(2);
+    writer.uint16(0);
+    return writer.release();
+  }
+  const std::size_t first = ranges.front().first;
+  const std::size_t count = ranges.back().last - first + 1;
+  if (6 + 2 * count <= 4 + 6 * ranges.size()) {
+    writer.uint16(1);
+    writer.uint16(static_cast<std::uint16_t>(first));
+    writer.uint16(static_cast<std::uint16_t>(count));
+    std::vector<std::uint16_t> values(count);
+    for (const auto& range : ranges) {
+      std::fill(std::begin(values) + (range.first - first),
+                std::begin(values) + (range.last - first + 1),
+                range.value);
+    }
+    for (const auto value : values) {
+      writer.uint16(value);
+    }
+  } else {
+    writer.uint16(2);
+    writer.uint16(static_cast<std::uint16_t>(ranges.size()));
+    for (const auto& range : ranges) {
+      writer.uint16(range.first);
+      writer.uint16(range.last);
+      writer.uint16(range.value);
+    }
+  }
+  return writer.release();
+}
+
+// MARK: Feature files
+
+std::string glyphClassName(const std::string& name,
+                           std::set<std::string> *used) {
+  assert(used);
+  std::string result;
+  for (const auto c : name) {
+    if (std::isalnum(static_cast<unsigned char>(c)) || c == '.' || c == '_') {
+      result.push_back(c);
+    } else if (c != '@' || !result.empty()) {
+      result.push_back('_');
+    }
+  }
+  if (result.empty() || std::isdigit(static_cast<unsigned char>(result[0])) ||
+      result[0] == '.') {
+    result.insert(std::begin(result), '_');
+  }
+  result.resize(std::min(result.size(), kMaxClassNameSize));
+  const auto base = result;
+  for (std::size_t i = 1; !used->emplace(result).second; ++i) {
+    const auto suffix = "_" + std::to_string(i);
+    result = base.substr(0, kMaxClassNameSize - suffix.size()) + suffix;
+  }
+  return result;
+}
+
+// MARK: Lookups
+
+void Positioning::add(const std::string& feature, const Lookup& lookup) {
+  assert(feature.size() == 4);
+  assert(lookups_.size() < 0xffff);
+  features_[feature].emplace_back(
+      static_cast<std::uint16_t>(lookups_.size()));
+  lookups_.emplace_back(lookup);
+}
+
+// MARK: Encoding
+
+std::string Positioning::encode() const {
+  // Every script has only the default language system, which has all the
+  // features.
+  Writer scripts;
+  const auto script_count = std::extent<decltype(kScripts)>::value;
+  const auto script_offset = 2 + 6 * script_count;
+  scripts.uint16(static_cast<std::uint16_t>(script_count));
+  for (const auto script : kScripts) {
+    scripts.tag(script);
+    scripts.uint16(static_cast<std::uint16_t>(script_offset));
+  }
+  scripts.uint16(4);  // Default language system
+  scripts.uint16(0);
+  scripts.uint16(0);  // Reserved
+  scripts.uint16(0xffff);  // No required feature
+  scripts.uint16(static_cast<std::uint16_t>(features_.size()));
+  for (std::size_t i{}; i < features_.size(); ++i) {
+    scripts.uint16(static_cast<std::uint16_t>(i));
+  }
+
+  Writer features;
+  features.uint16(static_cast<std::uint16_t>(features_.size()));
+  std::size_t feature_offset = 2 + 6 * features_.size();
+  for (const auto& feature : features_) {
+    features.tag(feature.first);
+    features.uint16(static_cast<std::uint16_t>(feature_offset));
+    feature_offset += 4 + 2 * feature.second.size();
+  }
+  for (const auto& feature : features_) {
+    features.uint16(0);  // No feature parameters
+    features.uint16(static_cast<std::uint16_t>(feature.second.size()));
+    for (const auto index : feature.second) {
+      features.uint16(index);
+    }
+  }
+
+  std::string lookups;
+  if (!encodeLookups(false, &lookups) && !encodeLookups(true, &lookups)) {
+    assert(false);
+  }
+  const auto feature_list = kHeaderSize + scripts.size();
+  const auto lookup_list = feature_list + features.size();
+  assert(lookup_list <= kMaxOffset);
+  Writer writer;
+  writer.uint32(0x00010000);
+  writer.uint16(static_cast<std::uint16_t>(kHeaderSize));
+  writer.uint16(static_cast<std::uint16_t>(feature_list));
+  writer.uint16(static_cast<std::uint16_t>(lookup_list));
+  writer.bytes(scripts.data());
+  writer.bytes(features.data());
+  writer.bytes(lookups);
+  return writer.release();
+}
+
+bool Positioning::encodeLookups(bool extension, std::string *result) const {
+  assert(result);
+  Writer writer;
+  writer.uint16(static_cast<std::uint16_t>(lookups_.size()));
+  std::size_t offset = 2 + 2 * lookups_.size();
+  if (!extension) {
+    // Each lookup is followed by its subtables.
+    for (const auto& lookup : lookups_) {
+      if (offset > kMaxOffset) {
+        return false;
+      }
+      writer.uint16(static_cast<std::uint16_t>(offset));
+      offset += 6 + 2 * lookup.subtables.size();
+      for (const auto& subtable : lookup.subtables) {
+        offset += subtable.size();
+      }
+    }
+    for (const auto& lookup : lookups_) {
+      writer.uint16(lookup.type);
+      writer.uint16(lookup.flag);
+      writer.uint16(static_cast<std::uint16_t>(lookup.subtables.size()));
+      std::size_t subtable_offset = 6 + 2 * lookup.subtables.size();
+      for (const auto& subtable : lookup.subtables) {
+        if (subtable_offset > kMaxOffset) {
+          return false;
+        }
+        writer.uint16(static_cast<std::uint16_t>(subtable_offset));
+        subtable_offset += subtable.size();
+      }
+      for (const auto& subtable : lookup.subtables) {
+        writer.bytes(subtable);
+      }
+    }
+    *result = writer.release();
+    return true;
+  }
+
+  // Each lookup is followed by its extension subtables, and the subtables
+  // they point to with 32-bit offsets are placed after all the lookups.
+  for (const auto& lookup : lookups_) {
+    if (offset > kMaxOffset) {
+      return false;
+    }
+    writer.uint16(static_cast<std::uint16_t>(offset));
+    offset += 6 + 10 * lookup.subtables.size();
+  }
+  std::size_t subtable_position = offset;
+  for (const auto& lookup : lookups_) {
+    writer.uint16(kExtensionPositioning);
+    writer.uint16(lookup.flag);
+    writer.uint16(static_cast<std::uint16_t>(lookup.subtables.size()));
+    for (std::size_t i{}; i < lookup.subtables.size(); ++i) {
+      writer.uint16(static_cast<std::uint16_t>(
+          6 + 2 * lookup.subtables.size() + 8 * i));
+    }
+    for (const auto& subtable : lookup.subtables) {
+      writer.uint16(1);
+      writer.uint16(lookup.type);
+      writer.uint32(static_cast<std::uint32_t>(
+          subtable_position - writer.size() + 4));
+      subtable_position += subtable.size();
+    }
+  }
+  for (const auto& lookup : lookups_) {
+    for (const auto& subtable : lookup.subtables) {
+      writer.bytes(subtable);
+    }
+  }
+  *result = writer.release();
+  return true;
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,71 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_LAYOUT_H_
+#define TOKEN_SFNT_LAYOUT_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace token {
+namespace sfnt {
+
+// A lookup of the OpenType layout tables with its encoded subtables, which
+// are applied in order. Mark filtering sets are not supported.
+struct Lookup final {
+  std::uint16_t type;
+  std::uint16_t flag;
+  std::vector<std::string> subtables;
+};
+
+// Encodes the sorted glyph IDs into a coverage table, choosing the smaller of
+// the list and the range formats.
+std::string encodeCoverage(const std::vector<std::uint16_t>& glyphs);
+
+// Encodes the classes of glyphs into a class definition table, choosing the
+// smaller of the array and the range formats. Glyphs of class 0 are omitted.
+std::string encodeClassDef(
+    const std::map<std::uint16_t, std::uint16_t>& classes);
+
+// Makes a glyph class name of feature files from the given name, which can
+// contain characters that aren't allowed there, and which is unique among the
+// names already used.
+std::string glyphClassName(const std::string& name,
+                           std::set<std::string> *used);
+
+// Builds a GPOS table from lookups registered to features, which apply to
+// the default language system of every script. Lookups are wrapped in
+// extension lookups when their offsets don't fit in 16 bits.
+class Positioning final {
+ public:
+  Positioning() = default;
+
+  // Copy semantics
+  Positioning(const Positioning&) = default;
+  Positioning& operator=(const Positioning&) = default;
+
+  // Lookups
+  bool empty() const { return lookups_.empty(); }
+  const std::vector<Lookup>& lookups() const { return lookups_; }
+  void add(const std::string& feature, const Lookup& lookup);
+
+  // Encoding
+  std::string encode() const;
+
+ private:
+  bool encodeLookups(bool extension, std::string *result) const;
+
+ private:
+  std::vector<Lookup> lookups_;
+  std::map<std::string, std::vector<std::uint16_t>> features_;
+};
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_LAYOUT_H_
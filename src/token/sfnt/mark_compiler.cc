@@ -0,0 +1,239 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/mark_compiler.h"
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "token/sfnt/layout.h"
+#include "token/sfnt/writer.h"
+#include "token/ufo/glif/anchor.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::uint16_t kMarkToBasePositioning = 4;
+constexpr std::uint16_t kMarkToMarkPositioning = 6;
+constexpr std::uint16_t kBaseGlyph = 1;
+constexpr std::uint16_t kMarkGlyph = 3;
+
+}  // namespace
+
+// MARK: Compiling
+
+Lookup MarkCompiler::markToBase(
+    const std::vector<std::string>& glyph_order) const {
+  const auto classes = resolve(glyph_order);
+  return compile(kMarkToBasePositioning, classes.marks, classes.bases);
+}
+
+Lookup MarkCompiler::markToMark(
+    const std::vector<std::string>& glyph_order) const {
+  const auto classes = resolve(glyph_order);
+  return compile(kMarkToMarkPositioning, classes.marks, classes.mark_bases);
+}
+
+std::string MarkCompiler::definitions(
+    const std::vector<std::string>& glyph_order) const {
+  const auto classes = resolve(glyph_order);
+  if (classes.marks.empty()) {
+    return std::string();
+  }
+  std::map<std::uint16_t, std::uint16_t> glyph_classes;
+  for (const auto glyph : classes.base_glyphs) {
+    glyph_classes[glyph] = kBaseGlyph;
+  }
+  for (const auto glyph : classes.mark_glyphs) {
+    glyph_classes[glyph] = kMarkGlyph;
+  }
+  Writer writer;
+  writer.uint32(0x00010000);
+  writer.uint16(12);  // Glyph class definition
+  writer.uint16(0);  // Attachment points
+  writer.uint16(0);  // Ligature carets
+  writer.uint16(0);  // Mark attachment classes
+  writer.bytes(encodeClassDef(glyph_classes));
+  return writer.release();
+}
+
+std::string MarkCompiler::features(
+    const std::vector<std::string>& glyph_order) const {
+  const auto classes = resolve(glyph_order);
+  std::ostringstream stream;
+  std::set<std::string> used_classes;
+  std::set<std::string> used_lookups;
+  std::map<std::string, std::string> names;
+  for (const auto& marks : classes.marks) {
+    if (!classes.bases.count(marks.first) &&
+        !classes.mark_bases.count(marks.first)) {
+      continue;
+    }
+    const auto name = "@" + glyphClassName("MC_" + marks.first,
+                                           &used_classes);
+    names.emplace(marks.first, name);
+    for (const auto& mark : marks.second) {
+      stream << "markClass " << glyph_order[mark.first] << " <anchor "
+             << mark.second.first << " " << mark.second.second << "> "
+             << name << ";" << std::endl;
+    }
+  }
+  const auto feature = [&](const std::string& tag,
+                           const std::string& kind,
+                           const std::map<std::string, Points>& bases) {
+    bool empty = true;
+    for (const auto& base : bases) {
+      const auto name = names.find(base.first);
+      if (name == std::end(names)) {
+        continue;
+      }
+      if (empty) {
+        stream << "feature " << tag << " {" << std::endl;
+        empty = false;
+      }
+      const auto label = glyphClassName(tag + "_" + base.first,
+                                        &used_lookups);
+      stream << "lookup " << label << " {" << std::endl;
+      for (const auto& glyph : base.second) {
+        stream << "pos " << kind << " " << glyph_order[glyph.first]
+               << " <anchor " << glyph.second.first << " "
+               << glyph.second.second << "> mark " << name->second << ";"
+               << std::endl;
+      }
+      stream << "} " << label << ";" << std::endl;
+    }
+    if (!empty) {
+      stream << "} " << tag << ";" << std::endl;
+    }
+  };
+  feature("mark", "base", classes.bases);
+  feature("mkmk", "mark", classes.mark_bases);
+  return stream.str();
+}
+
+// MARK: Classes
+
+MarkCompiler::Classes MarkCompiler::resolve(
+    const std::vector<std::string>& glyph_order) const {
+  assert(glyph_order.size() <= 0xffff);
+  std::unordered_map<std::string, std::uint16_t> ids;
+  for (std::size_t i{}; i < glyph_order.size(); ++i) {
+    ids.emplace(glyph_order[i], static_cast<std::uint16_t>(i));
+  }
+  Classes classes;
+  for (const auto& pair : anchors_) {
+    const auto id = ids.find(pair.first);
+    if (id == std::end(ids)) {
+      continue;
+    }
+    bool mark{};
+    for (const auto& anchor : pair.second) {
+      if (anchor.name.size() > 1 && anchor.name.front() == '_') {
+        mark = true;
+      }
+    }
+    // Only the first of the anchors with the same name is used.
+    std::set<std::string> names;
+    for (const auto& anchor : pair.second) {
+      if (anchor.name.empty() || !names.emplace(anchor.name).second) {
+        continue;
+      }
+      const Point point(static_cast<std::int16_t>(std::round(anchor.x)),
+                        static_cast<std::int16_t>(std::round(anchor.y)));
+      if (anchor.name.front() == '_') {
+        if (anchor.name.size() > 1) {
+          classes.marks[anchor.name.substr(1)][id->second] = point;
+        }
+      } else if (mark) {
+        classes.mark_bases[anchor.name][id->second] = point;
+      } else {
+        classes.bases[anchor.name][id->second] = point;
+      }
+    }
+    if (mark) {
+      classes.mark_glyphs.emplace(id->second);
+    } else {
+      classes.base_glyphs.emplace(id->second);
+    }
+  }
+  return classes;
+}
+
+Lookup MarkCompiler::compile(std::uint16_t type,
+                             const std::map<std::string, Points>& marks,
+                             const std::map<std::string, Points>& bases) {
+  // Both mark-to-base and mark-to-mark subtables consist of the marks and
+  // their anchors followed by the bases and their anchors.
+  Lookup result{type, 0, {}};
+  for (const auto& pair : marks) {
+    const auto found = bases.find(pair.first);
+    if (found == std::end(bases)) {
+      continue;
+    }
+    const auto& mark_points = pair.second;
+    const auto& base_points = found->second;
+    std::vector<std::uint16_t> mark_glyphs;
+    for (const auto& mark : mark_points) {
+      mark_glyphs.emplace_back(mark.first);
+    }
+    std::vector<std::uint16_t> base_glyphs;
+    for (const auto& base : base_points) {
+      base_glyphs.emplace_back(base.first);
+    }
+    const auto mark_coverage = encodeCoverage(mark_glyphs);
+    const auto base_coverage = encodeCoverage(base_glyphs);
+    const std::size_t mark_array = 12;
+    const auto base_array = mark_array + 2 + 10 * mark_points.size();
+    const auto mark_coverage_offset = base_array + 2 + 8 * base_points.size();
+    const auto base_coverage_offset = (mark_coverage_offset +
+                                       mark_coverage.size());
+    assert(base_coverage_offset <= 0xffff);
+
+    Writer writer;
+    writer.uint16(1);
+    writer.uint16(static_cast<std::uint16_t>(mark_coverage_offset));
+    writer.uint16(static_cast<std::uint16_t>(base_coverage_offset));
+    writer.uint16(1);  // Mark classes
+    writer.uint16(static_cast<std::uint16_t>(mark_array));
+    writer.uint16(static_cast<std::uint16_t>(base_array));
+    writer.uint16(static_cast<std::uint16_t>(mark_points.size()));
+    std::size_t anchor = 2 + 4 * mark_points.size();
+    for (std::size_t i{}; i < mark_points.size(); ++i, anchor += 6) {
+      writer.uint16(0);
+      writer.uint16(static_cast<std::uint16_t>(anchor));
+    }
+    for (const auto& mark : mark_points) {
+      writer.uint16(1);
+      writer.int16(mark.second.first);
+      writer.int16(mark.second.second);
+    }
+    writer.uint16(static_cast<std::uint16_t>(base_points.size()));
+    anchor = 2 + 2 * base_points.size();
+    for (std::size_t i{}; i < base_points.size(); ++i, anchor += 6) {
+      writer.uint16(static_cast<std::uint16_t>(anchor));
+    }
+    for (const auto& base : base_points) {
+      writer.uint16(1);
+      writer.int16(base.second.first);
+      writer.int16(base.second.second);
+    }
+    writer.bytes(mark_coverage);
+    writer.bytes(base_coverage);
+    result.subtables.emplace_back(writer.release());
+  }
+  return result;
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,81 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_MARK_COMPILER_H_
+#define TOKEN_SFNT_MARK_COMPILER_H_
+
+#include <cstdint>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/layout.h"
+#include "token/ufo/glif/anchor.h"
+
+namespace token {
+namespace sfnt {
+
+// Compiles the anchors of glyphs into mark-to-base and mark-to-mark
+// positioning lookups of GPOS, or into the equivalent feature file. An
+// anchor named with a leading underscore makes its glyph a mark of the class
+// named after the rest, which attaches to the anchors of that name on the
+// other glyphs. Each mark class has its own subtable, or its own lookup in
+// feature files.
+class MarkCompiler final {
+ public:
+  MarkCompiler() = default;
+
+  // Copy semantics
+  MarkCompiler(const MarkCompiler&) = default;
+  MarkCompiler& operator=(const MarkCompiler&) = default;
+
+  // Anchors
+  bool empty() const { return anchors_.empty(); }
+  void add(const std::string& glyph,
+           const std::vector<ufo::glif::Anchor>& anchors);
+
+  // Compiling
+  Lookup markToBase(const std::vector<std::string>& glyph_order) const;
+  Lookup markToMark(const std::vector<std::string>& glyph_order) const;
+  // A GDEF table that classifies the glyphs with anchors into bases and
+  // marks, which mark-to-base attachment skips.
+  std::string definitions(const std::vector<std::string>& glyph_order) const;
+  std::string features(const std::vector<std::string>& glyph_order) const;
+
+ private:
+  using Point = std::pair<std::int16_t, std::int16_t>;
+  using Points = std::map<std::uint16_t, Point>;
+
+  struct Classes final {
+    std::map<std::string, Points> marks;
+    std::map<std::string, Points> bases;
+    std::map<std::string, Points> mark_bases;
+    std::set<std::uint16_t> mark_glyphs;
+    std::set<std::uint16_t> base_glyphs;
+  };
+
+  Classes resolve(const std::vector<std::string>& glyph_order) const;
+  static Lookup compile(std::uint16_t type,
+                        const std::map<std::string, Points>& marks,
+                        const std::map<std::string, Points>& bases);
+
+ private:
+  std::map<std::string, std::vector<ufo::glif::Anchor>> anchors_;
+};
+
+// MARK: -
+
+inline void MarkCompiler::add(const std::string& glyph,
+                              const std::vector<ufo::glif::Anchor>& anchors) {
+  if (!anchors.empty()) {
+    anchors_[glyph] = anchors;
+  }
+}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_MARK_COMPILER_H_
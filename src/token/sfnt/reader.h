@@ -0,0 +1,137 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_READER_H_
+#define TOKEN_SFNT_READER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace token {
+namespace sfnt {
+
+// Reads big-endian values from a buffer in the layout of sfnt tables. Reading
+// past the end of the buffer yields zeros and makes the reader fail.
+class Reader final {
+ public:
+  Reader(const char *data, std::size_t size);
+  explicit Reader(const std::string& data);
+
+  // Disallow copy semantics
+  Reader(const Reader&) = delete;
+  Reader& operator=(const Reader&) = delete;
+
+  // Reading
+  std::uint8_t uint8();
+  std::uint16_t uint16();
+  std::int16_t int16();
+  std::uint32_t uint32();
+  std::int32_t int32();
+  std::int64_t int64();
+  double fixed();
+  std::string tag();
+  std::string bytes(std::size_t size);
+  void skip(std::size_t size);
+  void seek(std::size_t position);
+
+  // Attributes
+  bool good() const { return good_; }
+  std::size_t position() const { return position_; }
+  std::size_t size() const { return size_; }
+
+ private:
+  bool require(std::size_t size);
+
+ private:
+  const char *data_;
+  std::size_t size_;
+  std::size_t position_;
+  bool good_;
+};
+
+// MARK: -
+
+inline Reader::Reader(const char *data, std::size_t size)
+    : data_(data),
+      size_(size),
+      position_(),
+      good_(true) {}
+
+inline Reader::Reader(const std::string& data)
+    : Reader(data.data(), data.size()) {}
+
+inline bool Reader::require(std::size_t size) {
+  if (!good_ || size > size_ - position_) {
+    good_ = false;
+    return false;
+  }
+  return true;
+}
+
+inline std::uint8_t Reader::uint8() {
+  if (!require(1)) {
+    return 0;
+  }
+  return static_cast<std::uint8_t>(data_[position_++]);
+}
+
+inline std::uint16_t Reader::uint16() {
+  const std::uint16_t high = uint8();
+  return static_cast<std::uint16_t>((high << 8) | uint8());
+}
+
+inline std::int16_t Reader::int16() {
+  return static_cast<std::int16_t>(uint16());
+}
+
+inline std::uint32_t Reader::uint32() {
+  const std::uint32_t high = uint16();
+  return (high << 16) | uint16();
+}
+
+inline std::int32_t Reader::int32() {
+  return static_cast<std::int32_t>(uint32());
+}
+
+inline std::int64_t Reader::int64() {
+  const std::uint64_t high = uint32();
+  return static_cast<std::int64_t>((high << 32) | uint32());
+}
+
+inline double Reader::fixed() {
+  return int32() / 65536.0;
+}
+
+inline std::string Reader::tag() {
+  return bytes(4);
+}
+
+inline std::string Reader::bytes(std::size_t size) {
+  if (!require(size)) {
+    return std::string();
+  }
+  std::string result(data_ + position_, size);
+  position_ += size;
+  return result;
+}
+
+inline void Reader::skip(std::size_t size) {
+  if (require(size)) {
+    position_ += size;
+  }
+}
+
+inline void Reader::seek(std::size_t position) {
+  if (position > size_) {
+    good_ = false;
+  } else {
+    position_ = position;
+  }
+}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_READER_H_
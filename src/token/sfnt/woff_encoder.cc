@@ -0,0 +1,209 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/sfnt/woff_encoder.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "token/sfnt/font.h"
+#include "token/sfnt/writer.h"
+#include "token/thread_pool.h"
+#include "token/ufo/font_info.h"
+#include "token/ufo/xml_writer.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+constexpr std::uint32_t kSignature = 0x774f4646;  // 'wOFF'
+constexpr std::size_t kHeaderSize = 44;
+constexpr std::size_t kTableRecordSize = 20;
+constexpr std::size_t kSfntHeaderSize = 12;
+constexpr std::size_t kSfntTableRecordSize = 16;
+constexpr std::size_t kCheckSumAdjustmentOffset = 8;
+
+std::size_t align(std::size_t size) {
+  return (size + 3) & ~static_cast<std::size_t>(3);
+}
+
+}  // namespace
+
+WOFFEncoder::WOFFEncoder(const ufo::FontInfo& font_info) : WOFFEncoder() {
+  if (font_info.woff_major_version.exists()) {
+    major_version_ = static_cast<std::uint16_t>(
+        *font_info.woff_major_version);
+  } else if (font_info.version_major.exists()) {
+    major_version_ = static_cast<std::uint16_t>(*font_info.version_major);
+  }
+  if (font_info.woff_minor_version.exists()) {
+    minor_version_ = static_cast<std::uint16_t>(
+        *font_info.woff_minor_version);
+  } else if (font_info.version_minor.exists()) {
+    minor_version_ = static_cast<std::uint16_t>(*font_info.version_minor);
+  }
+  metadata_ = metadata(font_info);
+}
+
+// MARK: Encoding
+
+std::string WOFFEncoder::encode(const Font& font, ThreadPool *pool) const {
+  // The head table must have the checksum adjustment of the font that
+  // decoders reconstruct, which is the same as the one encoded here because
+  // both place the tables in the order of their tags.
+  Font source;
+  if (!source.decode(font.encode())) {
+    return std::string();
+  }
+  const auto& tables = source.tables();
+  std::vector<std::string> compressed;
+  compressed.reserve(tables.size());
+  if (pool) {
+    std::vector<std::future<std::string>> futures;
+    futures.reserve(tables.size());
+    for (const auto& table : tables) {
+      futures.emplace_back(pool->enqueue([this, &table] {
+        return compress(table.second);
+      }));
+    }
+    for (auto& future : futures) {
+      compressed.emplace_back(future.get());
+    }
+  } else {
+    for (const auto& table : tables) {
+      compressed.emplace_back(compress(table.second));
+    }
+  }
+  const auto metadata = metadata_.empty() ? std::string()
+                                          : compress(metadata_);
+
+  std::size_t offset = kHeaderSize + tables.size() * kTableRecordSize;
+  std::size_t sfnt_size = (kSfntHeaderSize +
+                           tables.size() * kSfntTableRecordSize);
+  std::vector<std::size_t> offsets;
+  auto data = std::begin(compressed);
+  for (const auto& table : tables) {
+    offsets.emplace_back(offset);
+    offset += align(std::min(data->size(), table.second.size()));
+    sfnt_size += align(table.second.size());
+    ++data;
+  }
+  const auto metadata_offset = metadata.empty() ? 0 : offset;
+  offset += metadata.size();
+  if (!private_data_.empty()) {
+    offset = align(offset);
+  }
+  const auto private_offset = private_data_.empty() ? 0 : offset;
+  offset += private_data_.size();
+
+  Writer writer;
+  writer.uint32(kSignature);
+  writer.uint32(source.has("CFF ") ? 0x4f54544f : 0x00010000);  // 'OTTO'
+  writer.uint32(static_cast<std::uint32_t>(offset));
+  writer.uint16(static_cast<std::uint16_t>(tables.size()));
+  writer.uint16(0);  // Reserved
+  writer.uint32(static_cast<std::uint32_t>(sfnt_size));
+  writer.uint16(major_version_);
+  writer.uint16(minor_version_);
+  writer.uint32(static_cast<std::uint32_t>(metadata_offset));
+  writer.uint32(static_cast<std::uint32_t>(metadata.size()));
+  writer.uint32(static_cast<std::uint32_t>(metadata_.size()));
+  writer.uint32(static_cast<std::uint32_t>(private_offset));
+  writer.uint32(static_cast<std::uint32_t>(private_data_.size()));
+  data = std::begin(compressed);
+  auto table_offset = std::begin(offsets);
+  for (const auto& table : tables) {
+    // The checksum of head is calculated with its adjustment zeroed.
+    auto checksum = Font::checksum(table.second);
+    if (table.first == "head" &&
+        table.second.size() >= kCheckSumAdjustmentOffset + 4) {
+      checksum -= Font::checksum(
+          table.second.data() + kCheckSumAdjustmentOffset, 4);
+    }
+    writer.tag(table.first);
+    writer.uint32(static_cast<std::uint32_t>(*table_offset++));
+    writer.uint32(static_cast<std::uint32_t>(
+        std::min(data->size(), table.second.size())));
+    writer.uint32(static_cast<std::uint32_t>(table.second.size()));
+    writer.uint32(checksum);
+    ++data;
+  }
+  data = std::begin(compressed);
+  for (const auto& table : tables) {
+    // Tables that don't get smaller are stored as they are.
+    writer.bytes(data->size() < table.second.size() ? *data : table.second);
+    writer.pad(4);
+    ++data;
+  }
+  writer.bytes(metadata);
+  if (!private_data_.empty()) {
+    writer.pad(4);
+    writer.bytes(private_data_);
+  }
+  auto result = writer.release();
+  assert(result.size() == offset);
+  return result;
+}
+
+std::string WOFFEncoder::compress(const std::string& data) const {
+  auto size = ::compressBound(static_cast<uLong>(data.size()));
+  std::string result(size, '\0');
+  if (::compress2(reinterpret_cast<Bytef *>(&result[0]), &size,
+                  reinterpret_cast<const Bytef *>(data.data()),
+                  static_cast<uLong>(data.size()),
+                  compression_level_) != Z_OK) {
+    return data;
+  }
+  result.resize(size);
+  return result;
+}
+
+// MARK: Metadata
+
+std::string WOFFEncoder::metadata(const ufo::FontInfo& font_info) {
+  if (!font_info.woff_metadata_unique_id.exists() &&
+      !font_info.woff_metadata_vendor.exists() &&
+      !font_info.woff_metadata_credits.exists() &&
+      !font_info.woff_metadata_description.exists() &&
+      !font_info.woff_metadata_license.exists() &&
+      !font_info.woff_metadata_copyright.exists() &&
+      !font_info.woff_metadata_trademark.exists() &&
+      !font_info.woff_metadata_licensee.exists() &&
+      font_info.woff_metadata_extensions.empty()) {
+    return std::string();
+  }
+  std::ostringstream stream;
+  ufo::xml::Writer writer(&stream);
+  writer.declaration();
+  writer.open("metadata");
+  writer.attribute("version", "1.0");
+  ufo::xml::writeChild(&writer, "uniqueid",
+                       font_info.woff_metadata_unique_id);
+  ufo::xml::writeChild(&writer, "vendor", font_info.woff_metadata_vendor);
+  ufo::xml::writeChild(&writer, "credits", font_info.woff_metadata_credits);
+  ufo::xml::writeChild(&writer, "description",
+                       font_info.woff_metadata_description);
+  ufo::xml::writeChild(&writer, "license", font_info.woff_metadata_license);
+  ufo::xml::writeChild(&writer, "copyright",
+                       font_info.woff_metadata_copyright);
+  ufo::xml::writeChild(&writer, "trademark",
+                       font_info.woff_metadata_trademark);
+  ufo::xml::writeChild(&writer, "licensee",
+                       font_info.woff_metadata_licensee);
+  ufo::xml::writeChildren(&writer, "extension",
+                          font_info.woff_metadata_extensions);
+  writer.close();
+  return stream.str();
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,71 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_WOFF_ENCODER_H_
+#define TOKEN_SFNT_WOFF_ENCODER_H_
+
+#include <cstdint>
+#include <string>
+
+#include "token/sfnt/font.h"
+#include "token/thread_pool.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace sfnt {
+
+// Encodes fonts into WOFF 1.0, where each table is compressed with zlib
+// unless that doesn't make it smaller. Tables are compressed in parallel
+// when a thread pool is given. The metadata block is the XML document of
+// the WOFF metadata in the font info, and is omitted when there's none.
+class WOFFEncoder final {
+ public:
+  WOFFEncoder();
+  explicit WOFFEncoder(const ufo::FontInfo& font_info);
+
+  // Copy semantics
+  WOFFEncoder(const WOFFEncoder&) = default;
+  WOFFEncoder& operator=(const WOFFEncoder&) = default;
+
+  // Encoding
+  std::string encode(const Font& font, ThreadPool *pool = nullptr) const;
+
+  // Metadata
+  static std::string metadata(const ufo::FontInfo& font_info);
+
+  // Parameters
+  std::uint16_t major_version() const { return major_version_; }
+  void set_major_version(std::uint16_t value) { major_version_ = value; }
+  std::uint16_t minor_version() const { return minor_version_; }
+  void set_minor_version(std::uint16_t value) { minor_version_ = value; }
+  const std::string& metadata() const { return metadata_; }
+  void set_metadata(const std::string& value) { metadata_ = value; }
+  const std::string& private_data() const { return private_data_; }
+  void set_private_data(const std::string& value) { private_data_ = value; }
+  // The level of zlib between 1 and 9.
+  int compression_level() const { return compression_level_; }
+  void set_compression_level(int value) { compression_level_ = value; }
+
+ private:
+  std::string compress(const std::string& data) const;
+
+ private:
+  std::uint16_t major_version_;
+  std::uint16_t minor_version_;
+  std::string metadata_;
+  std::string private_data_;
+  int compression_level_;
+};
+
+// MARK: -
+
+inline WOFFEncoder::WOFFEncoder()
+    : major_version_(),
+      minor_version_(),
+      compression_level_(9) {}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_WOFF_ENCODER_H_
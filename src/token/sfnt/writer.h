@@ -0,0 +1,110 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SFNT_WRITER_H_
+#define TOKEN_SFNT_WRITER_H_
+
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace token {
+namespace sfnt {
+
+// Appends big-endian values to a buffer in the layout of sfnt tables.
+class Writer final {
+ public:
+  Writer() = default;
+
+  // Disallow copy semantics
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  // Writing
+  void uint8(std::uint8_t value);
+  void uint16(std::uint16_t value);
+  void int16(std::int16_t value);
+  void uint32(std::uint32_t value);
+  void int32(std::int32_t value);
+  void int64(std::int64_t value);
+  void fword(double value);
+  void ufword(double value);
+  void fixed(double value);
+  void tag(const std::string& value);
+  void bytes(const std::string& value);
+  void pad(std::size_t alignment);
+
+  // Attributes
+  std::size_t size() const { return data_.size(); }
+  const std::string& data() const { return data_; }
+  std::string release() { return std::move(data_); }
+
+ private:
+  std::string data_;
+};
+
+// MARK: -
+
+inline void Writer::uint8(std::uint8_t value) {
+  data_.push_back(static_cast<char>(value));
+}
+
+inline void Writer::uint16(std::uint16_t value) {
+  data_.push_back(static_cast<char>((value >> 8) & 0xff));
+  data_.push_back(static_cast<char>(value & 0xff));
+}
+
+inline void Writer::int16(std::int16_t value) {
+  uint16(static_cast<std::uint16_t>(value));
+}
+
+inline void Writer::uint32(std::uint32_t value) {
+  uint16(static_cast<std::uint16_t>(value >> 16));
+  uint16(static_cast<std::uint16_t>(value & 0xffff));
+}
+
+inline void Writer::int32(std::int32_t value) {
+  uint32(static_cast<std::uint32_t>(value));
+}
+
+inline void Writer::int64(std::int64_t value) {
+  const auto bits = static_cast<std::uint64_t>(value);
+  uint32(static_cast<std::uint32_t>(bits >> 32));
+  uint32(static_cast<std::uint32_t>(bits & 0xffffffff));
+}
+
+inline void Writer::fword(double value) {
+  int16(static_cast<std::int16_t>(std::round(value)));
+}
+
+inline void Writer::ufword(double value) {
+  uint16(static_cast<std::uint16_t>(std::round(value)));
+}
+
+inline void Writer::fixed(double value) {
+  int32(static_cast<std::int32_t>(std::round(value * 65536.0)));
+}
+
+inline void Writer::tag(const std::string& value) {
+  assert(value.size() <= 4);
+  data_ += value;
+  data_.append(4 - value.size(), ' ');
+}
+
+inline void Writer::bytes(const std::string& value) {
+  data_ += value;
+}
+
+inline void Writer::pad(std::size_t alignment) {
+  assert(alignment);
+  data_.append((alignment - data_.size() % alignment) % alignment, '\0');
+}
+
+}  // namespace sfnt
+}  // namespace token
+
+#endif  // TOKEN_SFNT_WRITER_H_
@@ -0,0 +1,975 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/snapshot.h"
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <exception>
+#include <fstream>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "shotamatsuda/graphics.h"
+#include "token/glyph_outline.h"
+#include "token/hash.h"
+#include "token/mapped_file.h"
+#include "token/types.h"
+#include "token/ufo/font_info.h"
+#include "token/ufo/glif.h"
+#include "token/ufo/glyph.h"
+#include "token/ufo/glyphs.h"
+#include "token/ufo/optional.h"
+#include "token/ufo/woff.h"
+
+namespace token {
+
+namespace {
+
+// Bump the version whenever the layout below changes, so that snapshots
+// written by older builds are rebuilt rather than misread.
+constexpr char kMagic[8] = {'T', 'K', 'N', 'S', 'N', 'A', 'P', '\0'};
+constexpr std::uint32_t kVersion = 4;
+
+// Values are written in the byte order of the host, which is checked by the
+// byte order mark in the header.
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+
+// Every source takes at least the length of its path, its time, size and
+// hash, which bounds the count of sources by the bytes left in the snapshot.
+constexpr std::size_t kMinSourceSize =
+    sizeof(std::uint32_t) + sizeof(std::int64_t) + sizeof(std::uint64_t) * 2;
+
+class Writer final {
+ public:
+  static constexpr bool kWriting = true;
+
+  template <class T>
+  void write(const T& value) {
+    static_assert(std::is_arithmetic<T>::value, "");
+    data_.append(reinterpret_cast<const char *>(&value), sizeof(value));
+  }
+
+  void write(const std::string& value) {
+    write(static_cast<std::uint32_t>(value.size()));
+    data_.append(value);
+  }
+
+  template <class T>
+  void writeEnum(T value) {
+    write(static_cast<std::uint8_t>(value));
+  }
+
+  // Optional values are preceded by whether they exist, vectors by their
+  // sizes, and records are written by their lists of fields.
+  template <class... Args>
+  void fields(const Args&... values) {
+    (void)std::initializer_list<int>{(field(values), 0)...};
+  }
+
+  const std::string& data() const { return data_; }
+
+ private:
+  template <
+    class T,
+    std::enable_if_t<std::is_arithmetic<T>::value> * = nullptr
+  >
+  void field(const T& value) {
+    write(value);
+  }
+
+  void field(const std::string& value) {
+    write(value);
+  }
+
+  template <class T>
+  void field(const ufo::Optional<T>& value) {
+    write(static_cast<std::uint8_t>(value.exists()));
+    if (value.exists()) {
+      field(*value);
+    }
+  }
+
+  template <class T>
+  void field(const std::vector<T>& values) {
+    write(static_cast<std::uint32_t>(values.size()));
+    for (const auto& value : values) {
+      field(value);
+    }
+  }
+
+  template <class T, std::enable_if_t<std::is_class<T>::value> * = nullptr>
+  void field(const T& value) {
+    transfer(this, value);
+  }
+
+ private:
+  std::string data_;
+};
+
+// Every read is bounds-checked, and the reader stays failed once it has run
+// past the end, so that a truncated snapshot is rejected as a whole.
+class Reader final {
+ public:
+  static constexpr bool kWriting = false;
+
+  Reader(const char *data, std::size_t size)
+      : data_(data),
+        size_(size),
+        offset_(),
+        good_(true) {}
+
+  bool good() const { return good_; }
+  std::size_t remaining() const { return size_ - offset_; }
+
+  template <class T>
+  T read() {
+    static_assert(std::is_arithmetic<T>::value, "");
+    T value{};
+    if (consume(sizeof(value))) {
+      std::memcpy(&value, data_ + offset_ - sizeof(value), sizeof(value));
+    }
+    return value;
+  }
+
+  std::string readString() {
+    const auto size = read<std::uint32_t>();
+    if (!consume(size)) {
+      return std::string();
+    }
+    return std::string(data_ + offset_ - size, size);
+  }
+
+  template <class T>
+  T readEnum() {
+    return static_cast<T>(read<std::uint8_t>());
+  }
+
+  bool readBytes(void *data, std::size_t size) {
+    if (!consume(size)) {
+      return false;
+    }
+    std::memcpy(data, data_ + offset_ - size, size);
+    return true;
+  }
+
+  // Reads the fields in the order the writer wrote them.
+  template <class... Args>
+  void fields(Args&... values) {
+    (void)std::initializer_list<int>{(field(values), 0)...};
+  }
+
+ private:
+  template <
+    class T,
+    std::enable_if_t<std::is_arithmetic<T>::value> * = nullptr
+  >
+  void field(T& value) {
+    value = read<T>();
+  }
+
+  void field(std::string& value) {
+    value = readString();
+  }
+
+  template <class T>
+  void field(ufo::Optional<T>& value) {
+    if (read<std::uint8_t>()) {
+      T result{};
+      field(result);
+      value = std::move(result);
+    }
+  }
+
+  template <class T>
+  void field(std::vector<T>& values) {
+    const auto count = read<std::uint32_t>();
+    for (std::uint32_t i{}; i < count && good_; ++i) {
+      values.emplace_back();
+      field(values.back());
+    }
+  }
+
+  template <class T, std::enable_if_t<std::is_class<T>::value> * = nullptr>
+  void field(T& value) {
+    transfer(this, value);
+  }
+
+  bool consume(std::size_t size) {
+    if (!good_ || size > size_ - offset_) {
+      good_ = false;
+      return false;
+    }
+    offset_ += size;
+    return true;
+  }
+
+ private:
+  const char *data_;
+  std::size_t size_;
+  std::size_t offset_;
+  bool good_;
+};
+
+// MARK: Fields
+
+// The lists of fields shared by the writer and the reader, which take the
+// values as const when writing.
+template <class Archive, class T>
+using Field = std::conditional_t<Archive::kWriting, const T, T>;
+
+template <class Archive>
+void transfer(Archive *archive, Field<Archive, ufo::GASPRangeRecord>& record) {
+  archive->fields(record.range_max_ppem, record.range_gasp_behavior);
+}
+
+template <class Archive>
+void transfer(Archive *archive, Field<Archive, ufo::NameRecord>& record) {
+  archive->fields(record.name_id, record.platform_id, record.encoding_id,
+                  record.language_id, record.string);
+}
+
+template <class Archive>
+void transfer(Archive *archive, Field<Archive, ufo::Guideline>& guideline) {
+  archive->fields(guideline.x, guideline.y, guideline.angle, guideline.name,
+                  guideline.color, guideline.identifier);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::glif::HintSet>& hint_set) {
+  archive->fields(hint_set.point_tag, hint_set.stems);
+}
+
+// WOFF metadata
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Text>& text) {
+  archive->fields(text.text, text.language, text.dir, text.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::UniqueID>& unique_id) {
+  archive->fields(unique_id.identifier);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Vendor>& vendor) {
+  archive->fields(vendor.name, vendor.url, vendor.dir, vendor.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Credit>& credit) {
+  archive->fields(credit.name, credit.url, credit.dir, credit.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Credits>& credits) {
+  archive->fields(credits.credits);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Description>& description) {
+  archive->fields(description.url, description.text);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::License>& license) {
+  archive->fields(license.url, license.identifier, license.text);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Copyright>& copyright) {
+  archive->fields(copyright.text);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Trademark>& trademark) {
+  archive->fields(trademark.text);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Licensee>& licensee) {
+  archive->fields(licensee.name, licensee.dir, licensee.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::ExtensionName>& name) {
+  archive->fields(name.text, name.language, name.dir, name.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::ExtensionValue>& value) {
+  archive->fields(value.text, value.language, value.dir, value.klass);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::ExtensionItem>& item) {
+  archive->fields(item.identifier, item.names, item.values);
+}
+
+template <class Archive>
+void transfer(Archive *archive,
+              Field<Archive, ufo::woff::metadata::Extension>& extension) {
+  archive->fields(extension.identifier, extension.names, extension.items);
+}
+
+// Font info
+
+template <class Archive>
+void transfer(Archive *archive, Field<Archive, ufo::FontInfo>& font_info) {
+  // Identification Information
+  archive->fields(font_info.family_name, font_info.style_name,
+                  font_info.style_map_family_name,
+                  font_info.style_map_style_name, font_info.version_major,
+                  font_info.version_minor, font_info.year);
+  // Legal Information
+  archive->fields(font_info.copyright, font_info.trademark);
+  // Dimension Information
+  archive->fields(font_info.units_per_em, font_info.descender,
+                  font_info.x_height, font_info.cap_height, font_info.ascender,
+                  font_info.italic_angle);
+  // Miscellaneous Information
+  archive->fields(font_info.note);
+  // OpenType gasp Table Fields
+  archive->fields(font_info.open_type_gasp_range_records);
+  // OpenType head Table Fields
+  archive->fields(font_info.open_type_head_created,
+                  font_info.open_type_head_lowest_rec_ppem,
+                  font_info.open_type_head_flags);
+  // OpenType hhea Table Fields
+  archive->fields(font_info.open_type_hhea_ascender,
+                  font_info.open_type_hhea_descender,
+                  font_info.open_type_hhea_line_gap,
+                  font_info.open_type_hhea_caret_slope_rise,
+                  font_info.open_type_hhea_caret_slope_run,
+                  font_info.open_type_hhea_caret_offset);
+  // OpenType Name Table Fields
+  archive->fields(font_info.open_type_name_designer,
+                  font_info.open_type_name_designer_url,
+                  font_info.open_type_name_manufacturer,
+                  font_info.open_type_name_manufacturer_url,
+                  font_info.open_type_name_license,
+                  font_info.open_type_name_license_url,
+                  font_info.open_type_name_version,
+                  font_info.open_type_name_unique_id,
+                  font_info.open_type_name_description,
+                  font_info.open_type_name_preferred_family_name,
+                  font_info.open_type_name_preferred_subfamily_name,
+                  font_info.open_type_name_compatible_full_name,
+                  font_info.open_type_name_sample_text,
+                  font_info.open_type_name_wws_family_name,
+                  font_info.open_type_name_wws_subfamily_name,
+                  font_info.open_type_name_records);
+  // OpenType OS/2 Table Fields
+  archive->fields(font_info.open_type_os2_width_class,
+                  font_info.open_type_os2_weight_class,
+                  font_info.open_type_os2_selection,
+                  font_info.open_type_os2_vendor_id,
+                  font_info.open_type_os2_panose,
+                  font_info.open_type_os2_family_class,
+                  font_info.open_type_os2_unicode_ranges,
+                  font_info.open_type_os2_code_page_ranges,
+                  font_info.open_type_os2_typo_ascender,
+                  font_info.open_type_os2_typo_descender,
+                  font_info.open_type_os2_typo_line_gap,
+                  font_info.open_type_os2_win_ascent,
+                  font_info.open_type_os2_win_descent,
+                  font_info.open_type_os2_type,
+                  font_info.open_type_os2_subscript_x_size,
+                  font_info.open_type_os2_subscript_y_size,
+                  font_info.open_type_os2_subscript_x_offset,
+                  font_info.open_type_os2_subscript_y_offset,
+                  font_info.open_type_os2_superscript_x_size,
+                  font_info.open_type_os2_superscript_y_size,
+                  font_info.open_type_os2_superscript_x_offset,
+                  font_info.open_type_os2_superscript_y_offset,
+                  font_info.open_type_os2_strikeout_size,
+                  font_info.open_type_os2_strikeout_position);
+  // OpenType vhea Table Fields
+  archive->fields(font_info.open_type_vhea_vert_typo_ascender,
+                  font_info.open_type_vhea_vert_typo_descender,
+                  font_info.open_type_vhea_vert_typo_line_gap,
+                  font_info.open_type_vhea_caret_slope_rise,
+                  font_info.open_type_vhea_caret_slope_run,
+                  font_info.open_type_vhea_caret_offset);
+  // PostScript Specific Data
+  archive->fields(font_info.postscript_font_name,
+                  font_info.postscript_full_name,
+                  font_info.postscript_slant_angle,
+                  font_info.postscript_unique_id,
+                  font_info.postscript_underline_thickness,
+                  font_info.postscript_underline_position,
+                  font_info.postscript_is_fixed_pitch,
+                  font_info.postscript_blue_values,
+                  font_info.postscript_other_blues,
+                  font_info.postscript_family_blues,
+                  font_info.postscript_family_other_blues,
+                  font_info.postscript_stem_snap_h,
+                  font_info.postscript_stem_snap_v,
+                  font_info.postscript_blue_fuzz,
+                  font_info.postscript_blue_shift,
+                  font_info.postscript_blue_scale,
+                  font_info.postscript_force_bold,
+                  font_info.postscript_default_width_x,
+                  font_info.postscript_nominal_width_x,
+                  font_info.postscript_weight_name,
+                  font_info.postscript_default_character,
+                  font_info.postscript_windows_character_set);
+  // Macintosh FOND Resource Data
+  archive->fields(font_info.macintosh_fond_family_id,
+                  font_info.macintosh_fond_name);
+  // WOFF Data
+  archive->fields(font_info.woff_major_version, font_info.woff_minor_version,
+                  font_info.woff_metadata_unique_id,
+                  font_info.woff_metadata_vendor,
+                  font_info.woff_metadata_credits,
+                  font_info.woff_metadata_description,
+                  font_info.woff_metadata_license,
+                  font_info.woff_metadata_copyright,
+                  font_info.woff_metadata_trademark,
+                  font_info.woff_metadata_licensee,
+                  font_info.woff_metadata_extensions);
+  // Guidelines
+  archive->fields(font_info.guidelines);
+}
+
+void writeFontInfo(Writer *writer, const ufo::FontInfo& font_info) {
+  transfer(writer, font_info);
+}
+
+bool readFontInfo(Reader *reader, ufo::FontInfo *font_info) {
+  transfer(reader, *font_info);
+  return reader->good();
+}
+
+// MARK: Glyph
+
+void writeGlyph(Writer *writer, const ufo::Glyph& glyph) {
+  writer->write(glyph.name);
+  writer->write(static_cast<std::uint8_t>(glyph.advance.exists()));
+  if (glyph.advance.exists()) {
+    writer->write(glyph.advance->width);
+    writer->write(glyph.advance->height);
+  }
+  writer->write(static_cast<std::uint32_t>(glyph.unicodes.size()));
+  for (const auto& unicode : glyph.unicodes) {
+    writer->write(unicode.hex);
+  }
+  writer->write(static_cast<std::uint8_t>(glyph.image.exists()));
+  if (glyph.image.exists()) {
+    const auto& image = *glyph.image;
+    writer->write(image.file_name);
+    writer->write(image.x_scale);
+    writer->write(image.xy_scale);
+    writer->write(image.yx_scale);
+    writer->write(image.y_scale);
+    writer->write(image.x_offset);
+    writer->write(image.y_offset);
+    writer->write(image.color);
+  }
+  writer->write(static_cast<std::uint32_t>(glyph.guidelines.size()));
+  for (const auto& guideline : glyph.guidelines) {
+    writer->write(guideline.x);
+    writer->write(guideline.y);
+    writer->write(guideline.angle);
+    writer->write(guideline.name);
+    writer->write(guideline.color);
+    writer->write(guideline.identifier);
+  }
+  writer->write(static_cast<std::uint32_t>(glyph.anchors.size()));
+  for (const auto& anchor : glyph.anchors) {
+    writer->write(anchor.x);
+    writer->write(anchor.y);
+    writer->write(anchor.name);
+    writer->write(anchor.color);
+    writer->write(anchor.identifier);
+  }
+  writer->write(static_cast<std::uint8_t>(glyph.outline.exists()));
+  if (glyph.outline.exists()) {
+    const auto& outline = *glyph.outline;
+    writer->write(static_cast<std::uint32_t>(outline.components.size()));
+    for (const auto& component : outline.components) {
+      writer->write(component.base);
+      writer->write(component.x_scale);
+      writer->write(component.xy_scale);
+      writer->write(component.yx_scale);
+      writer->write(component.y_scale);
+      writer->write(component.x_offset);
+      writer->write(component.y_offset);
+      writer->write(component.identifier);
+    }
+    writer->write(static_cast<std::uint32_t>(outline.contours.size()));
+    for (const auto& contour : outline.contours) {
+      writer->write(contour.identifier);
+      writer->write(static_cast<std::uint32_t>(contour.points.size()));
+      for (const auto& point : contour.points) {
+        writer->write(point.x);
+        writer->write(point.y);
+        writer->writeEnum(point.type);
+        writer->write(static_cast<std::uint8_t>(point.smooth));
+        writer->write(point.name);
+        writer->write(point.identifier);
+      }
+    }
+  }
+  writer->write(static_cast<std::uint8_t>(glyph.lib.exists()));
+  if (glyph.lib.exists()) {
+    const auto& lib = *glyph.lib;
+    writer->write(static_cast<std::uint32_t>(lib.number_of_contours));
+    writer->write(static_cast<std::uint32_t>(lib.number_of_holes));
+    writer->write(static_cast<std::uint32_t>(std::distance(
+        std::begin(lib.contour_styles), std::end(lib.contour_styles))));
+    for (const auto& style : lib.contour_styles) {
+      writer->write(style.first);
+      writer->writeEnum(style.second.cap);
+      writer->writeEnum(style.second.join);
+      writer->writeEnum(style.second.align);
+      writer->write(static_cast<std::uint8_t>(style.second.filled));
+    }
+    writer->fields(lib.hint_sets);
+  }
+}
+
+bool readGlyph(Reader *reader, ufo::Glyph *glyph) {
+  glyph->name = reader->readString();
+  if (reader->read<std::uint8_t>()) {
+    glyph->advance.emplace();
+    glyph->advance->width = reader->read<double>();
+    glyph->advance->height = reader->read<double>();
+  }
+  auto count = reader->read<std::uint32_t>();
+  for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+    glyph->unicodes.emplace_back();
+    glyph->unicodes.back().hex = reader->readString();
+  }
+  if (reader->read<std::uint8_t>()) {
+    glyph->image.emplace();
+    auto& image = *glyph->image;
+    image.file_name = reader->readString();
+    image.x_scale = reader->read<double>();
+    image.xy_scale = reader->read<double>();
+    image.yx_scale = reader->read<double>();
+    image.y_scale = reader->read<double>();
+    image.x_offset = reader->read<double>();
+    image.y_offset = reader->read<double>();
+    image.color = reader->readString();
+  }
+  count = reader->read<std::uint32_t>();
+  for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+    glyph->guidelines.emplace_back();
+    auto& guideline = glyph->guidelines.back();
+    guideline.x = reader->read<double>();
+    guideline.y = reader->read<double>();
+    guideline.angle = reader->read<double>();
+    guideline.name = reader->readString();
+    guideline.color = reader->readString();
+    guideline.identifier = reader->readString();
+  }
+  count = reader->read<std::uint32_t>();
+  for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+    glyph->anchors.emplace_back();
+    auto& anchor = glyph->anchors.back();
+    anchor.x = reader->read<double>();
+    anchor.y = reader->read<double>();
+    anchor.name = reader->readString();
+    anchor.color = reader->readString();
+    anchor.identifier = reader->readString();
+  }
+  if (reader->read<std::uint8_t>()) {
+    glyph->outline.emplace();
+    auto& outline = *glyph->outline;
+    count = reader->read<std::uint32_t>();
+    for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+      outline.components.emplace_back();
+      auto& component = outline.components.back();
+      component.base = reader->readString();
+      component.x_scale = reader->read<double>();
+      component.xy_scale = reader->read<double>();
+      component.yx_scale = reader->read<double>();
+      component.y_scale = reader->read<double>();
+      component.x_offset = reader->read<double>();
+      component.y_offset = reader->read<double>();
+      component.identifier = reader->readString();
+    }
+    count = reader->read<std::uint32_t>();
+    for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+      outline.contours.emplace_back();
+      auto& contour = outline.contours.back();
+      contour.identifier = reader->readString();
+      const auto size = reader->read<std::uint32_t>();
+      for (std::uint32_t j{}; j < size && reader->good(); ++j) {
+        contour.points.emplace_back();
+        auto& point = contour.points.back();
+        point.x = reader->read<double>();
+        point.y = reader->read<double>();
+        point.type = reader->readEnum<ufo::glif::Point::Type>();
+        point.smooth = reader->read<std::uint8_t>();
+        point.name = reader->readString();
+        point.identifier = reader->readString();
+      }
+    }
+  }
+  if (reader->read<std::uint8_t>()) {
+    glyph->lib.emplace();
+    auto& lib = *glyph->lib;
+    lib.number_of_contours = reader->read<std::uint32_t>();
+    lib.number_of_holes = reader->read<std::uint32_t>();
+    count = reader->read<std::uint32_t>();
+    for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+      const auto name = reader->readString();
+      ufo::glif::ContourStyle style;
+      style.cap = reader->readEnum<Cap>();
+      style.join = reader->readEnum<Join>();
+      style.align = reader->readEnum<Align>();
+      style.filled = reader->read<std::uint8_t>();
+      lib.contour_styles.set(name, style);
+    }
+    reader->fields(lib.hint_sets);
+  }
+  return reader->good();
+}
+
+// MARK: Glyph outline
+
+template <class T>
+void writeStyles(Writer *writer,
+                 const std::unordered_map<std::size_t, T>& styles) {
+  writer->write(static_cast<std::uint32_t>(styles.size()));
+  for (const auto& style : styles) {
+    writer->write(static_cast<std::uint32_t>(style.first));
+    writer->writeEnum(style.second);
+  }
+}
+
+template <class T>
+void readStyles(Reader *reader, std::unordered_map<std::size_t, T> *styles) {
+  const auto count = reader->read<std::uint32_t>();
+  for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+    const auto index = reader->read<std::uint32_t>();
+    styles->emplace(index, reader->readEnum<T>());
+  }
+}
+
+void writeOutline(Writer *writer, const GlyphOutline& outline) {
+  std::uint32_t count{};
+  for (const auto& path : outline.shape().paths()) {
+    count += static_cast<std::uint32_t>(path.size());
+  }
+  writer->write(count);
+  for (const auto& path : outline.shape().paths()) {
+    for (const auto& command : path) {
+      writer->writeEnum(command.type());
+      switch (command.type()) {
+        case shota::graphics::CommandType::MOVE:
+        case shota::graphics::CommandType::LINE:
+          writer->write(command.point().x);
+          writer->write(command.point().y);
+          break;
+        case shota::graphics::CommandType::QUADRATIC:
+          writer->write(command.control().x);
+          writer->write(command.control().y);
+          writer->write(command.point().x);
+          writer->write(command.point().y);
+          break;
+        case shota::graphics::CommandType::CONIC:
+          writer->write(command.control().x);
+          writer->write(command.control().y);
+          writer->write(command.point().x);
+          writer->write(command.point().y);
+          writer->write(command.weight());
+          break;
+        case shota::graphics::CommandType::CUBIC:
+          writer->write(command.control1().x);
+          writer->write(command.control1().y);
+          writer->write(command.control2().x);
+          writer->write(command.control2().y);
+          writer->write(command.point().x);
+          writer->write(command.point().y);
+          break;
+        case shota::graphics::CommandType::CLOSE:
+          break;
+        default:
+          assert(false);
+          break;
+      }
+    }
+  }
+  writeStyles(writer, outline.caps_);
+  writeStyles(writer, outline.joins_);
+  writeStyles(writer, outline.aligns_);
+  writeStyles(writer, outline.filleds_);
+}
+
+bool readOutline(Reader *reader, GlyphOutline *outline) {
+  auto& shape = outline->shape();
+  const auto count = reader->read<std::uint32_t>();
+  for (std::uint32_t i{}; i < count && reader->good(); ++i) {
+    double values[7]{};
+    const auto type = reader->readEnum<shota::graphics::CommandType>();
+    switch (type) {
+      case shota::graphics::CommandType::MOVE:
+        reader->readBytes(values, sizeof(*values) * 2);
+        shape.moveTo(values[0], values[1]);
+        break;
+      case shota::graphics::CommandType::LINE:
+        reader->readBytes(values, sizeof(*values) * 2);
+        shape.lineTo(values[0], values[1]);
+        break;
+      case shota::graphics::CommandType::QUADRATIC:
+        reader->readBytes(values, sizeof(*values) * 4);
+        shape.quadraticTo(values[0], values[1], values[2], values[3]);
+        break;
+      case shota::graphics::CommandType::CONIC:
+        reader->readBytes(values, sizeof(*values) * 5);
+        shape.conicTo(values[0], values[1], values[2], values[3], values[4]);
+        break;
+      case shota::graphics::CommandType::CUBIC:
+        reader->readBytes(values, sizeof(*values) * 6);
+        shape.cubicTo(values[0], values[1], values[2], values[3],
+                      values[4], values[5]);
+        break;
+      case shota::graphics::CommandType::CLOSE:
+        shape.close();
+        break;
+      default:
+        return false;
+    }
+  }
+  readStyles(reader, &outline->caps_);
+  readStyles(reader, &outline->joins_);
+  readStyles(reader, &outline->aligns_);
+  readStyles(reader, &outline->filleds_);
+  return reader->good();
+}
+
+// MARK: Sources
+
+std::int64_t modificationTime(const boost::filesystem::path& path) {
+  boost::system::error_code error;
+  const auto time = boost::filesystem::last_write_time(path, error);
+  if (error) {
+    return -1;
+  }
+  return static_cast<std::int64_t>(time);
+}
+
+std::uint64_t hashContents(const boost::filesystem::path& path) {
+  const MappedFile file(path.string());
+  return hash(file.data(), file.size());
+}
+
+}  // namespace
+
+// MARK: Opening and saving
+
+bool Snapshot::open(const std::string& path, const std::string& ufo_path) {
+  const MappedFile file(path);
+  if (!file.is_open()) {
+    return false;
+  }
+  Reader reader(file.data(), file.size());
+  char magic[sizeof(kMagic)]{};
+  reader.readBytes(magic, sizeof(magic));
+  if (std::memcmp(magic, kMagic, sizeof(kMagic)) ||
+      reader.read<std::uint32_t>() != kVersion ||
+      reader.read<std::uint32_t>() != kByteOrderMark) {
+    return false;
+  }
+
+  // Validate the sources first, before decoding anything else.
+  const auto source_count = reader.read<std::uint32_t>();
+  if (!reader.good() || source_count > reader.remaining() / kMinSourceSize) {
+    return false;
+  }
+  std::vector<Source> sources(source_count);
+  for (auto& source : sources) {
+    source.path = reader.readString();
+    source.time = reader.read<std::int64_t>();
+    source.size = reader.read<std::uint64_t>();
+    source.hash = reader.read<std::uint64_t>();
+  }
+  if (!reader.good() || !validate(ufo_path, sources)) {
+    return false;
+  }
+
+  ufo::FontInfo font_info;
+  if (!readFontInfo(&reader, &font_info)) {
+    return false;
+  }
+  const auto count = reader.read<std::uint32_t>();
+  std::vector<std::pair<std::string, std::string>> contents;
+  std::vector<std::unique_ptr<ufo::Glyph>> loaded;
+  Outlines outlines;
+  for (std::uint32_t i{}; i < count && reader.good(); ++i) {
+    auto name = reader.readString();
+    auto filename = reader.readString();
+    loaded.emplace_back();
+    if (reader.read<std::uint8_t>()) {
+      loaded.back() = std::make_unique<ufo::Glyph>();
+      if (!readGlyph(&reader, loaded.back().get())) {
+        return false;
+      }
+    }
+    if (reader.read<std::uint8_t>()) {
+      GlyphOutline outline;
+      if (!readOutline(&reader, &outline)) {
+        return false;
+      }
+      outlines.emplace(name, std::move(outline));
+    }
+    contents.emplace_back(std::move(name), std::move(filename));
+  }
+  if (!reader.good()) {
+    return false;
+  }
+  const auto directory = boost::filesystem::path(ufo_path) / "glyphs";
+  this->font_info = std::move(font_info);
+  glyphs.assign(directory.string(), contents);
+  for (std::size_t id{}; id < contents.size(); ++id) {
+    if (loaded[id]) {
+      glyphs.set(contents[id].first, *loaded[id]);
+    }
+  }
+  this->outlines = std::move(outlines);
+  return true;
+}
+
+bool Snapshot::save(const std::string& path,
+                    const std::string& ufo_path) const {
+  const boost::filesystem::path root(ufo_path);
+  Writer writer;
+  for (const auto byte : kMagic) {
+    writer.write(byte);
+  }
+  writer.write(kVersion);
+  writer.write(kByteOrderMark);
+
+  const auto paths = sources(glyphs);
+  writer.write(static_cast<std::uint32_t>(paths.size()));
+  for (const auto& source : paths) {
+    const auto file = root / source;
+    const auto time = modificationTime(file);
+    boost::system::error_code error;
+    const auto size = boost::filesystem::file_size(file, error);
+    writer.write(source);
+    writer.write(time);
+    writer.write(static_cast<std::uint64_t>(error ? 0 : size));
+    writer.write(time < 0 ? std::uint64_t() : hashContents(file));
+  }
+
+  writeFontInfo(&writer, font_info);
+  writer.write(static_cast<std::uint32_t>(glyphs.size()));
+  for (std::size_t id{}; id < glyphs.size(); ++id) {
+    const auto& name = glyphs.name(id);
+    writer.write(name);
+    writer.write(glyphs.filename(id));
+    const auto glyph = glyphs.find(id);
+    writer.write(static_cast<std::uint8_t>(glyph != nullptr));
+    if (!glyph) {
+      writer.write(std::uint8_t());
+      continue;
+    }
+    writeGlyph(&writer, *glyph);
+    const auto itr = outlines.find(name);
+    if (itr != std::end(outlines)) {
+      writer.write(std::uint8_t(1));
+      writeOutline(&writer, itr->second);
+      continue;
+    }
+    try {
+      const GlyphOutline outline(*glyph);
+      writer.write(std::uint8_t(1));
+      writeOutline(&writer, outline);
+    } catch (const std::exception&) {
+      // Glyphs that cannot be outlined are built again when they are used.
+      writer.write(std::uint8_t());
+    }
+  }
+
+  // Write to a temporary file and move it into place, so that a concurrent
+  // reader never sees a partially written snapshot.
+  const auto temporary = path + ".tmp";
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    if (!stream.good()) {
+      return false;
+    }
+    stream.write(writer.data().data(), writer.data().size());
+    if (!stream.good()) {
+      return false;
+    }
+  }
+  boost::system::error_code error;
+  boost::filesystem::rename(temporary, path, error);
+  if (error) {
+    boost::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+// MARK: Sources
+
+std::vector<std::string> Snapshot::sources(const ufo::Glyphs& glyphs) {
+  std::vector<std::string> result;
+  result.reserve(glyphs.size() + 2);
+  result.emplace_back("fontinfo.plist");
+  result.emplace_back("glyphs/contents.plist");
+  for (std::size_t id{}; id < glyphs.size(); ++id) {
+    result.emplace_back("glyphs/" + glyphs.filename(id));
+  }
+  return result;
+}
+
+bool Snapshot::validate(const std::string& ufo_path,
+                        const std::vector<Source>& sources) {
+  const boost::filesystem::path root(ufo_path);
+  for (const auto& source : sources) {
+    const auto file = root / source.path;
+    const auto time = modificationTime(file);
+    if ((time < 0) != (source.time < 0)) {
+      return false;  // Created or removed since the snapshot
+    }
+    if (time < 0) {
+      continue;
+    }
+    boost::system::error_code error;
+    const auto size = boost::filesystem::file_size(file, error);
+    if (error || size != source.size) {
+      return false;
+    }
+    // A file that was only touched still has the same contents, which is
+    // checked by its hash only when its modification time has changed.
+    if (time != source.time && hashContents(file) != source.hash) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace token
@@ -0,0 +1,58 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_SNAPSHOT_H_
+#define TOKEN_SNAPSHOT_H_
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "token/glyph_outline.h"
+#include "token/ufo/font_info.h"
+#include "token/ufo/glyphs.h"
+
+namespace token {
+
+// A compiled binary image of a UFO, containing its font info, all of its
+// glyphs and their outlines. A snapshot records the modification time, size
+// and content hash of every source file it was built from, and refuses to
+// open once any of them has changed, so that warm starts don't parse XML.
+class Snapshot final {
+ public:
+  using Outlines = std::unordered_map<std::string, GlyphOutline>;
+
+ public:
+  Snapshot() = default;
+
+  // Copy semantics
+  Snapshot(const Snapshot&) = default;
+  Snapshot& operator=(const Snapshot&) = default;
+
+  // Opening and saving
+  bool open(const std::string& path, const std::string& ufo_path);
+  bool save(const std::string& path, const std::string& ufo_path) const;
+
+ private:
+  struct Source final {
+    std::string path;
+    std::int64_t time;
+    std::uint64_t size;
+    std::uint64_t hash;
+  };
+
+  static std::vector<std::string> sources(const ufo::Glyphs& glyphs);
+  static bool validate(const std::string& ufo_path,
+                       const std::vector<Source>& sources);
+
+ public:
+  ufo::FontInfo font_info;
+  ufo::Glyphs glyphs;
+  Outlines outlines;
+};
+
+}  // namespace token
+
+#endif  // TOKEN_SNAPSHOT_H_
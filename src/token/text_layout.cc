@@ -0,0 +1,146 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/text_layout.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/ufo/glyph_index.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+
+TextLayout::TextLayout(const ufo::Kerning& kerning, const ufo::Groups& groups)
+    : kerning_(kerning),
+      max_runs_(64),
+      time_(),
+      width_() {
+  // The groups each glyph belongs to on either side, in the order of their
+  // names. Only the groups in the kerning take part in it.
+  for (const auto& first : kerning_) {
+    const auto members = groups.find(first.first);
+    if (members) {
+      for (const auto& member : *members) {
+        first_groups_[member].emplace_back(first.first);
+      }
+    }
+  }
+  std::set<std::string> seconds;
+  for (const auto& first : kerning_) {
+    for (const auto& second : first.second) {
+      seconds.emplace(second.first);
+    }
+  }
+  for (const auto& second : seconds) {
+    const auto members = groups.find(second);
+    if (members) {
+      for (const auto& member : *members) {
+        second_groups_[member].emplace_back(second);
+      }
+    }
+  }
+}
+
+// MARK: Layout
+
+const TextLayout::Run& TextLayout::operator()(
+    const std::vector<std::string>& names,
+    double width,
+    const AdvanceFunction& advance) {
+  if (width != width_) {
+    runs_.clear();
+    width_ = width;
+  }
+  const auto cached = runs_.find(names);
+  if (cached != std::end(runs_)) {
+    cached->second.time = ++time_;
+    return cached->second.run;
+  }
+  Run run{{}, 0.0};
+  run.glyphs.reserve(names.size());
+  for (std::size_t i{}; i < names.size(); ++i) {
+    Glyph glyph{names[i], run.width, advance(names[i]), 0.0};
+    if (i + 1 < names.size()) {
+      glyph.kerning = kerning(names[i], names[i + 1]);
+    }
+    run.width += glyph.advance + glyph.kerning;
+    run.glyphs.emplace_back(std::move(glyph));
+  }
+  auto& result = runs_[names];
+  result = CachedRun{std::move(run), ++time_};
+  trim();
+  return result.run;
+}
+
+const TextLayout::Run& TextLayout::operator()(
+    const std::string& text,
+    const ufo::GlyphIndex& index,
+    double width,
+    const AdvanceFunction& advance) {
+  std::vector<std::string> names;
+  for (const auto id : index.find(text)) {
+    names.emplace_back(index[id].name);
+  }
+  return (*this)(names, width, advance);
+}
+
+void TextLayout::trim() {
+  // The run laid out last is kept, which the caller has a reference to.
+  while (runs_.size() > std::max<std::size_t>(max_runs_, 1)) {
+    runs_.erase(std::min_element(
+        std::begin(runs_), std::end(runs_),
+        [](const auto& lhs, const auto& rhs) {
+          return lhs.second.time < rhs.second.time;
+        }));
+  }
+}
+
+// MARK: Kerning
+
+double TextLayout::kerning(const std::string& first,
+                           const std::string& second) const {
+  // Values are rounded as they are in the compiled lookup.
+  auto value = kerning_.find(first, second);
+  if (value) {
+    return std::round(*value);
+  }
+  const auto first_groups = first_groups_.find(first);
+  const auto second_groups = second_groups_.find(second);
+  if (second_groups != std::end(second_groups_)) {
+    for (const auto& group : second_groups->second) {
+      value = kerning_.find(first, group);
+      if (value) {
+        return std::round(*value);
+      }
+    }
+  }
+  if (first_groups != std::end(first_groups_)) {
+    for (const auto& group : first_groups->second) {
+      value = kerning_.find(group, second);
+      if (value) {
+        return std::round(*value);
+      }
+    }
+  }
+  // A glyph in more than one group of the same side belongs to the class of
+  // the first of them.
+  if (first_groups != std::end(first_groups_) &&
+      second_groups != std::end(second_groups_)) {
+    value = kerning_.find(first_groups->second.front(),
+                          second_groups->second.front());
+    if (value) {
+      return std::round(*value);
+    }
+  }
+  return 0.0;
+}
+
+}  // namespace token
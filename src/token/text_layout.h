@@ -0,0 +1,111 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_TEXT_LAYOUT_H_
+#define TOKEN_TEXT_LAYOUT_H_
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "token/ufo/glyph_index.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+
+// Positions the glyphs of a line along the baseline by their advances and
+// the kerning between them. Pairs are resolved in the same precedence as the
+// lookup KerningCompiler compiles, which is glyph and glyph, glyph and group,
+// group and glyph, and then the classes of both glyphs, so that lines match
+// the fonts. The most recently laid out runs are cached until they are laid
+// out for another width, because advances change only with the width of
+// strokes.
+class TextLayout final {
+ public:
+  struct Glyph final {
+    std::string name;
+    double position;
+    double advance;
+    double kerning;  // Between this glyph and the next
+  };
+
+  struct Run final {
+    std::vector<Glyph> glyphs;
+    double width;
+  };
+
+  using AdvanceFunction = std::function<double(const std::string& name)>;
+
+ public:
+  TextLayout();
+  TextLayout(const ufo::Kerning& kerning, const ufo::Groups& groups);
+
+  // Copy semantics
+  TextLayout(const TextLayout&) = default;
+  TextLayout& operator=(const TextLayout&) = default;
+
+  // Layout
+  // Returns the run of the glyphs of the names, or of the characters in the
+  // UTF-8 text. Advances are only requested for the runs not cached for the
+  // width, and the runs remain valid until the width changes or as many
+  // other runs as the maximum are laid out.
+  const Run& operator()(const std::vector<std::string>& names,
+                        double width,
+                        const AdvanceFunction& advance);
+  const Run& operator()(const std::string& text,
+                        const ufo::GlyphIndex& index,
+                        double width,
+                        const AdvanceFunction& advance);
+  void clear();
+
+  // Kerning
+  double kerning(const std::string& first, const std::string& second) const;
+
+  // Parameters
+  // The number of runs cached, beyond which the least recently laid out runs
+  // are discarded. Every line laid out while typing is another run.
+  std::size_t max_runs() const { return max_runs_; }
+  void set_max_runs(std::size_t value);
+
+ private:
+  using Memberships = std::unordered_map<std::string,
+                                         std::vector<std::string>>;
+
+  struct CachedRun final {
+    Run run;
+    std::size_t time;
+  };
+
+  void trim();
+
+ private:
+  ufo::Kerning kerning_;
+  Memberships first_groups_;
+  Memberships second_groups_;
+  std::map<std::vector<std::string>, CachedRun> runs_;
+  std::size_t max_runs_;
+  std::size_t time_;
+  double width_;
+};
+
+// MARK: -
+
+inline TextLayout::TextLayout() : max_runs_(64), time_(), width_() {}
+
+inline void TextLayout::clear() {
+  runs_.clear();
+}
+
+inline void TextLayout::set_max_runs(std::size_t value) {
+  max_runs_ = value;
+  trim();
+}
+
+}  // namespace token
+
+#endif  // TOKEN_TEXT_LAYOUT_H_
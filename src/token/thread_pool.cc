@@ -0,0 +1,52 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/thread_pool.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace token {
+
+ThreadPool::ThreadPool(std::size_t size) : stopped_() {
+  size = std::max<std::size_t>(size, 1);
+  threads_.reserve(size);
+  for (std::size_t i{}; i < size; ++i) {
+    threads_.emplace_back(&ThreadPool::run, this);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  condition_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void ThreadPool::run() {
+  for (;;) {
+    std::function<void()> task;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      condition_.wait(lock, [this] {
+        return stopped_ || !tasks_.empty();
+      });
+      if (tasks_.empty()) {
+        return;  // Stopped and there's no remaining task
+      }
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+    task();
+  }
+}
+
+}  // namespace token
@@ -0,0 +1,72 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_THREAD_POOL_H_
+#define TOKEN_THREAD_POOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace token {
+
+class ThreadPool final {
+ public:
+  explicit ThreadPool(std::size_t size = std::thread::hardware_concurrency());
+  ~ThreadPool();
+
+  // Disallow copy semantics
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  // Attributes
+  std::size_t size() const { return threads_.size(); }
+
+  // Tasks
+  template <class Function>
+  std::future<std::result_of_t<Function()>> enqueue(Function&& function);
+
+ private:
+  void run();
+
+ private:
+  std::vector<std::thread> threads_;
+  std::deque<std::function<void()>> tasks_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  bool stopped_;
+};
+
+// MARK: -
+
+// MARK: Tasks
+
+template <class Function>
+inline std::future<std::result_of_t<Function()>> ThreadPool::enqueue(
+    Function&& function) {
+  using Result = std::result_of_t<Function()>;
+  // std::function requires copyable targets, whereas packaged tasks are
+  // move-only.
+  const auto task = std::make_shared<std::packaged_task<Result()>>(
+      std::forward<Function>(function));
+  auto future = task->get_future();
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    tasks_.emplace_back([task] { (*task)(); });
+  }
+  condition_.notify_one();
+  return future;
+}
+
+}  // namespace token
+
+#endif  // TOKEN_THREAD_POOL_H_
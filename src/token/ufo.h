@@ -8,10 +8,19 @@
 #include "token/ufo/font_info.h"
 #include "token/ufo/glif.h"
 #include "token/ufo/glyph.h"
+#include "token/ufo/glyph_index.h"
 #include "token/ufo/glyph_iterator.h"
 #include "token/ufo/glyphs.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+#include "token/ufo/loader.h"
 #include "token/ufo/optional.h"
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/saver.h"
+#include "token/ufo/subset.h"
 #include "token/ufo/woff.h"
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 #endif  // TOKEN_UFO_H_
@@ -9,21 +9,202 @@ extern "C" {
 
 }  // extern "C"
 
+#include <cstddef>
 #include <cstdlib>
 #include <fstream>
 #include <istream>
+#include <iterator>
 #include <ostream>
 #include <string>
+#include <tuple>
 
 #include <boost/filesystem/path.hpp>
 
+#include "token/mapped_file.h"
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff.h"
 
 namespace token {
 namespace ufo {
 
+namespace {
+
+// The keys of fontinfo.plist, which are resolved at compile time.
+constexpr auto kBindings = std::make_tuple(
+    // Identification Information
+    plist::bind("familyName", &FontInfo::family_name),
+    plist::bind("styleName", &FontInfo::style_name),
+    plist::bind("styleMapFamilyName", &FontInfo::style_map_family_name),
+    plist::bind("styleMapStyleName", &FontInfo::style_map_style_name),
+    plist::bind("versionMajor", &FontInfo::version_major),
+    plist::bind("versionMinor", &FontInfo::version_minor),
+    plist::bind("year", &FontInfo::year),
+    // Legal Information
+    plist::bind("copyright", &FontInfo::copyright),
+    plist::bind("trademark", &FontInfo::trademark),
+    // Dimension Information
+    plist::bind("unitsPerEm", &FontInfo::units_per_em),
+    plist::bind("descender", &FontInfo::descender),
+    plist::bind("xHeight", &FontInfo::x_height),
+    plist::bind("capHeight", &FontInfo::cap_height),
+    plist::bind("ascender", &FontInfo::ascender),
+    plist::bind("italicAngle", &FontInfo::italic_angle),
+    // Miscellaneous Information
+    plist::bind("note", &FontInfo::note),
+    // OpenType gasp Table Fields
+    plist::bind("openTypeGaspRangeRecords",
+                &FontInfo::open_type_gasp_range_records),
+    // OpenType head Table Fields
+    plist::bind("openTypeHeadCreated", &FontInfo::open_type_head_created),
+    plist::bind("openTypeHeadLowestRecPPEM",
+                &FontInfo::open_type_head_lowest_rec_ppem),
+    plist::bind("openTypeHeadFlags", &FontInfo::open_type_head_flags),
+    // OpenType hhea Table Fields
+    plist::bind("openTypeHheaAscender", &FontInfo::open_type_hhea_ascender),
+    plist::bind("openTypeHheaDescender", &FontInfo::open_type_hhea_descender),
+    plist::bind("openTypeHheaLineGap", &FontInfo::open_type_hhea_line_gap),
+    plist::bind("openTypeHheaCaretSlopeRise",
+                &FontInfo::open_type_hhea_caret_slope_rise),
+    plist::bind("openTypeHheaCaretSlopeRun",
+                &FontInfo::open_type_hhea_caret_slope_run),
+    plist::bind("openTypeHheaCaretOffset",
+                &FontInfo::open_type_hhea_caret_offset),
+    // OpenType Name Table Fields
+    plist::bind("openTypeNameDesigner", &FontInfo::open_type_name_designer),
+    plist::bind("openTypeNameDesignerURL",
+                &FontInfo::open_type_name_designer_url),
+    plist::bind("openTypeNameManufacturer",
+                &FontInfo::open_type_name_manufacturer),
+    plist::bind("openTypeNameManufacturerURL",
+                &FontInfo::open_type_name_manufacturer_url),
+    plist::bind("openTypeNameLicense", &FontInfo::open_type_name_license),
+    plist::bind("openTypeNameLicenseURL",
+                &FontInfo::open_type_name_license_url),
+    plist::bind("openTypeNameVersion", &FontInfo::open_type_name_version),
+    plist::bind("openTypeNameUniqueID", &FontInfo::open_type_name_unique_id),
+    plist::bind("openTypeNameDescription",
+                &FontInfo::open_type_name_description),
+    plist::bind("openTypeNamePreferredFamilyName",
+                &FontInfo::open_type_name_preferred_family_name),
+    plist::bind("openTypeNamePreferredSubfamilyName",
+                &FontInfo::open_type_name_preferred_subfamily_name),
+    plist::bind("openTypeNameCompatibleFullName",
+                &FontInfo::open_type_name_compatible_full_name),
+    plist::bind("openTypeNameSampleText",
+                &FontInfo::open_type_name_sample_text),
+    plist::bind("openTypeNameWWSFamilyName",
+                &FontInfo::open_type_name_wws_family_name),
+    plist::bind("openTypeNameWWSSubfamilyName",
+                &FontInfo::open_type_name_wws_subfamily_name),
+    plist::bind("openTypeNameRecords", &FontInfo::open_type_name_records),
+    // OpenType OS/2 Table Fields
+    plist::bind("openTypeOS2WidthClass", &FontInfo::open_type_os2_width_class),
+    plist::bind("openTypeOS2WeightClass",
+                &FontInfo::open_type_os2_weight_class),
+    plist::bind("openTypeOS2Selection", &FontInfo::open_type_os2_selection),
+    plist::bind("openTypeOS2VendorID", &FontInfo::open_type_os2_vendor_id),
+    plist::bind("openTypeOS2Panose", &FontInfo::open_type_os2_panose),
+    plist::bind("openTypeOS2FamilyClass",
+                &FontInfo::open_type_os2_family_class),
+    plist::bind("openTypeOS2UnicodeRanges",
+                &FontInfo::open_type_os2_unicode_ranges),
+    plist::bind("openTypeOS2CodePageRanges",
+                &FontInfo::open_type_os2_code_page_ranges),
+    plist::bind("openTypeOS2TypoAscender",
+                &FontInfo::open_type_os2_typo_ascender),
+    plist::bind("openTypeOS2TypoDescender",
+                &FontInfo::open_type_os2_typo_descender),
+    plist::bind("openTypeOS2TypoLineGap",
+                &FontInfo::open_type_os2_typo_line_gap),
+    plist::bind("openTypeOS2WinAscent", &FontInfo::open_type_os2_win_ascent),
+    plist::bind("openTypeOS2WinDescent", &FontInfo::open_type_os2_win_descent),
+    plist::bind("openTypeOS2Type", &FontInfo::open_type_os2_type),
+    plist::bind("openTypeOS2SubscriptXSize",
+                &FontInfo::open_type_os2_subscript_x_size),
+    plist::bind("openTypeOS2SubscriptYSize",
+                &FontInfo::open_type_os2_subscript_y_size),
+    plist::bind("openTypeOS2SubscriptXOffset",
+                &FontInfo::open_type_os2_subscript_x_offset),
+    plist::bind("openTypeOS2SubscriptYOffset",
+                &FontInfo::open_type_os2_subscript_y_offset),
+    plist::bind("openTypeOS2SuperscriptXSize",
+                &FontInfo::open_type_os2_superscript_x_size),
+    plist::bind("openTypeOS2SuperscriptYSize",
+                &FontInfo::open_type_os2_superscript_y_size),
+    plist::bind("openTypeOS2SuperscriptXOffset",
+                &FontInfo::open_type_os2_superscript_x_offset),
+    plist::bind("openTypeOS2SuperscriptYOffset",
+                &FontInfo::open_type_os2_superscript_y_offset),
+    plist::bind("openTypeOS2StrikeoutSize",
+                &FontInfo::open_type_os2_strikeout_size),
+    plist::bind("openTypeOS2StrikeoutPosition",
+                &FontInfo::open_type_os2_strikeout_position),
+    // OpenType vhea Table Fields
+    plist::bind("openTypeVheaVertTypoAscender",
+                &FontInfo::open_type_vhea_vert_typo_ascender),
+    plist::bind("openTypeVheaVertTypoDescender",
+                &FontInfo::open_type_vhea_vert_typo_descender),
+    plist::bind("openTypeVheaVertTypoLineGap",
+                &FontInfo::open_type_vhea_vert_typo_line_gap),
+    plist::bind("openTypeVheaCaretSlopeRise",
+                &FontInfo::open_type_vhea_caret_slope_rise),
+    plist::bind("openTypeVheaCaretSlopeRun",
+                &FontInfo::open_type_vhea_caret_slope_run),
+    plist::bind("openTypeVheaCaretOffset",
+                &FontInfo::open_type_vhea_caret_offset),
+    // PostScript Specific Data
+    plist::bind("postscriptFontName", &FontInfo::postscript_font_name),
+    plist::bind("postscriptFullName", &FontInfo::postscript_full_name),
+    plist::bind("postscriptSlantAngle", &FontInfo::postscript_slant_angle),
+    plist::bind("postscriptUniqueID", &FontInfo::postscript_unique_id),
+    plist::bind("postscriptUnderlineThickness",
+                &FontInfo::postscript_underline_thickness),
+    plist::bind("postscriptUnderlinePosition",
+                &FontInfo::postscript_underline_position),
+    plist::bind("postscriptIsFixedPitch", &FontInfo::postscript_is_fixed_pitch),
+    plist::bind("postscriptBlueValues", &FontInfo::postscript_blue_values),
+    plist::bind("postscriptOtherBlues", &FontInfo::postscript_other_blues),
+    plist::bind("postscriptFamilyBlues", &FontInfo::postscript_family_blues),
+    plist::bind("postscriptFamilyOtherBlues",
+                &FontInfo::postscript_family_other_blues),
+    plist::bind("postscriptStemSnapH", &FontInfo::postscript_stem_snap_h),
+    plist::bind("postscriptStemSnapV", &FontInfo::postscript_stem_snap_v),
+    plist::bind("postscriptBlueFuzz", &FontInfo::postscript_blue_fuzz),
+    plist::bind("postscriptBlueShift", &FontInfo::postscript_blue_shift),
+    plist::bind("postscriptBlueScale", &FontInfo::postscript_blue_scale),
+    plist::bind("postscriptForceBold", &FontInfo::postscript_force_bold),
+    plist::bind("postscriptDefaultWidthX",
+                &FontInfo::postscript_default_width_x),
+    plist::bind("postscriptNominalWidthX",
+                &FontInfo::postscript_nominal_width_x),
+    plist::bind("postscriptWeightName", &FontInfo::postscript_weight_name),
+    plist::bind("postscriptDefaultCharacter",
+                &FontInfo::postscript_default_character),
+    plist::bind("postscriptWindowsCharacterSet",
+                &FontInfo::postscript_windows_character_set),
+    // Macintosh FOND Resource Data
+    plist::bind("macintoshFONDFamilyID", &FontInfo::macintosh_fond_family_id),
+    plist::bind("macintoshFONDName", &FontInfo::macintosh_fond_name),
+    // WOFF Data
+    plist::bind("woffMajorVersion", &FontInfo::woff_major_version),
+    plist::bind("woffMinorVersion", &FontInfo::woff_minor_version),
+    plist::bind("woffMetadataUniqueID", &FontInfo::woff_metadata_unique_id),
+    plist::bind("woffMetadataVendor", &FontInfo::woff_metadata_vendor),
+    plist::bind("woffMetadataCredits", &FontInfo::woff_metadata_credits),
+    plist::bind("woffMetadataDescription",
+                &FontInfo::woff_metadata_description),
+    plist::bind("woffMetadataLicense", &FontInfo::woff_metadata_license),
+    plist::bind("woffMetadataCopyright", &FontInfo::woff_metadata_copyright),
+    plist::bind("woffMetadataTrademark", &FontInfo::woff_metadata_trademark),
+    plist::bind("woffMetadataLicensee", &FontInfo::woff_metadata_licensee),
+    plist::bind("woffMetadataExtensions", &FontInfo::woff_metadata_extensions),
+    // Guidelines
+    plist::bind("guidelines", &FontInfo::guidelines));
+
+}  // namespace
+
 // MARK: Opening and saving
 
 bool FontInfo::open(const std::string& path) {
@@ -32,34 +213,36 @@ bool FontInfo::open(const std::string& path) {
   if (node.leaf().extension() == ".ufo") {
     font_info = (node / "fontinfo.plist").string();
   }
-  std::ifstream stream(font_info);
-  const auto result = open(stream);
-  stream.close();
-  return result;
+  const MappedFile file(font_info);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return open(file.data(), file.size());
 }
 
 bool FontInfo::open(std::istream& stream) {
   if (!stream.good()) {
     return false;
   }
-  PropertyList plist(stream);
-  readIdentificationInformation(plist);
-  readLegalInformation(plist);
-  readDimensionInformation(plist);
-  readMiscellaneousInformation(plist);
-  readOpenTypeGASPTableFields(plist);
-  readOpenTypeHEADTableFields(plist);
-  readOpenTypeHHEATableFields(plist);
-  readOpenTypeNameTableFields(plist);
-  readOpenTypeOS2TableFields(plist);
-  readOpenTypeVHEATableFields(plist);
-  readPostScriptSpecificData(plist);
-  readMacintoshFONDResourceData(plist);
-  readWOFFData(plist);
-  readGuidelines(plist);
+  const std::istreambuf_iterator<char> first(stream);
+  const std::string contents(first, std::istreambuf_iterator<char>());
+  return open(contents.data(), contents.size());
+}
+
+bool FontInfo::open(const char *data, std::size_t size) {
+  const plist::Document document(data, size);
+  const auto root = document.root();
+  if (root.type() != plist::Value::Type::DICTIONARY) {
+    return false;
+  }
+  read(root);
   return true;
 }
 
+void FontInfo::read(const plist::Value& value) {
+  plist::read(value, kBindings, this);
+}
+
 bool FontInfo::save(const std::string& path) const {
   const boost::filesystem::path node(path);
   std::string font_info = path;
@@ -76,6 +259,13 @@ bool FontInfo::save(std::ostream& stream) const {
   if (!stream.good()) {
     return false;
   }
+  plist().save(stream);
+  return true;
+}
+
+// MARK: Property list
+
+PropertyList FontInfo::plist() const {
   PropertyList plist;
   writeIdentificationInformation(plist);
   writeLegalInformation(plist);
@@ -91,251 +281,7 @@ bool FontInfo::save(std::ostream& stream) const {
   writeMacintoshFONDResourceData(plist);
   writeWOFFData(plist);
   writeGuidelines(plist);
-  plist.save(stream);
-  return true;
-}
-
-// MARK: Reading from property list
-
-void FontInfo::readIdentificationInformation(const PropertyList& plist) {
-  plist::readString(plist, "familyName", &family_name);
-  plist::readString(plist, "styleName", &style_name);
-  plist::readString(plist, "styleMapFamilyName", &style_map_family_name);
-  plist::readString(plist, "styleMapStyleName", &style_map_style_name);
-  plist::readNumber(plist, "versionMajor", &version_major);
-  plist::readNumber(plist, "versionMinor", &version_minor);
-  plist::readNumber(plist, "year", &year);
-}
-
-void FontInfo::readLegalInformation(const PropertyList& plist) {
-  plist::readString(plist, "copyright", &copyright);
-  plist::readString(plist, "trademark", &trademark);
-}
-
-void FontInfo::readDimensionInformation(const PropertyList& plist) {
-  plist::readNumber(plist, "unitsPerEm", &units_per_em);
-  plist::readNumber(plist, "descender", &descender);
-  plist::readNumber(plist, "xHeight", &x_height);
-  plist::readNumber(plist, "capHeight", &cap_height);
-  plist::readNumber(plist, "ascender", &ascender);
-  plist::readNumber(plist, "italicAngle", &italic_angle);
-}
-
-void FontInfo::readMiscellaneousInformation(const PropertyList& plist) {
-  plist::readString(plist, "note", &note);
-}
-
-void FontInfo::readOpenTypeGASPTableFields(const PropertyList& plist) {
-  plist::readVector(plist, "openTypeGaspRangeRecords",
-                    &open_type_gasp_range_records);
-}
-
-void FontInfo::readOpenTypeHEADTableFields(const PropertyList& plist) {
-  plist::readString(plist, "openTypeHeadCreated",
-                    &open_type_head_created);
-  plist::readNumber(plist, "openTypeHeadLowestRecPPEM",
-                    &open_type_head_lowest_rec_ppem);
-  plist::readVector(plist, "openTypeHeadFlags",
-                    &open_type_head_flags);
-}
-
-void FontInfo::readOpenTypeHHEATableFields(const PropertyList& plist) {
-  plist::readNumber(plist, "openTypeHheaAscender",
-                    &open_type_hhea_ascender);
-  plist::readNumber(plist, "openTypeHheaDescender",
-                    &open_type_hhea_descender);
-  plist::readNumber(plist, "openTypeHheaLineGap",
-                    &open_type_hhea_line_gap);
-  plist::readNumber(plist, "openTypeHheaCaretSlopeRise",
-                    &open_type_hhea_caret_slope_rise);
-  plist::readNumber(plist, "openTypeHheaCaretSlopeRun",
-                    &open_type_hhea_caret_slope_run);
-  plist::readNumber(plist, "openTypeHheaCaretOffset",
-                    &open_type_hhea_caret_offset);
-}
-
-void FontInfo::readOpenTypeNameTableFields(const PropertyList& plist) {
-  plist::readString(plist, "openTypeNameDesigner",
-                    &open_type_name_designer);
-  plist::readString(plist, "openTypeNameDesignerURL",
-                    &open_type_name_designer_url);
-  plist::readString(plist, "openTypeNameManufacturer",
-                    &open_type_name_manufacturer);
-  plist::readString(plist, "openTypeNameManufacturerURL",
-                    &open_type_name_manufacturer_url);
-  plist::readString(plist, "openTypeNameLicense",
-                    &open_type_name_license);
-  plist::readString(plist, "openTypeNameLicenseURL",
-                    &open_type_name_license_url);
-  plist::readString(plist, "openTypeNameVersion",
-                    &open_type_name_version);
-  plist::readString(plist, "openTypeNameUniqueID",
-                    &open_type_name_unique_id);
-  plist::readString(plist, "openTypeNameDescription",
-                    &open_type_name_description);
-  plist::readString(plist, "openTypeNamePreferredFamilyName",
-                    &open_type_name_preferred_family_name);
-  plist::readString(plist, "openTypeNamePreferredSubfamilyName",
-                    &open_type_name_preferred_subfamily_name);
-  plist::readString(plist, "openTypeNameCompatibleFullName",
-                    &open_type_name_compatible_full_name);
-  plist::readString(plist, "openTypeNameSampleText",
-                    &open_type_name_sample_text);
-  plist::readString(plist, "openTypeNameWWSFamilyName",
-                    &open_type_name_wws_family_name);
-  plist::readString(plist, "openTypeNameWWSSubfamilyName",
-                    &open_type_name_wws_subfamily_name);
-  plist::readVector(plist, "openTypeNameRecords",
-                    &open_type_name_records);
-}
-
-void FontInfo::readOpenTypeOS2TableFields(const PropertyList& plist) {
-  plist::readNumber(plist, "openTypeOS2WidthClass",
-                    &open_type_os2_width_class);
-  plist::readNumber(plist, "openTypeOS2WeightClass",
-                    &open_type_os2_weight_class);
-  plist::readVector(plist, "openTypeOS2Selection",
-                    &open_type_os2_selection);
-  plist::readString(plist, "openTypeOS2VendorID",
-                    &open_type_os2_vendor_id);
-  plist::readVector(plist, "openTypeOS2Panose",
-                    &open_type_os2_panose);
-  plist::readVector(plist, "openTypeOS2FamilyClass",
-                    &open_type_os2_family_class);
-  plist::readVector(plist, "openTypeOS2UnicodeRanges",
-                    &open_type_os2_unicode_ranges);
-  plist::readVector(plist, "openTypeOS2CodePageRanges",
-                    &open_type_os2_code_page_ranges);
-  plist::readNumber(plist, "openTypeOS2TypoAscender",
-                    &open_type_os2_typo_ascender);
-  plist::readNumber(plist, "openTypeOS2TypoDescender",
-                    &open_type_os2_typo_descender);
-  plist::readNumber(plist, "openTypeOS2TypoLineGap",
-                    &open_type_os2_typo_line_gap);
-  plist::readNumber(plist, "openTypeOS2WinAscent",
-                    &open_type_os2_win_ascent);
-  plist::readNumber(plist, "openTypeOS2WinDescent",
-                    &open_type_os2_win_descent);
-  plist::readVector(plist, "openTypeOS2Type",
-                    &open_type_os2_type);
-  plist::readNumber(plist, "openTypeOS2SubscriptXSize",
-                    &open_type_os2_subscript_x_size);
-  plist::readNumber(plist, "openTypeOS2SubscriptYSize",
-                    &open_type_os2_subscript_y_size);
-  plist::readNumber(plist, "openTypeOS2SubscriptXOffset",
-                    &open_type_os2_subscript_x_offset);
-  plist::readNumber(plist, "openTypeOS2SubscriptYOffset",
-                    &open_type_os2_subscript_y_offset);
-  plist::readNumber(plist, "openTypeOS2SuperscriptXSize",
-                    &open_type_os2_superscript_x_size);
-  plist::readNumber(plist, "openTypeOS2SuperscriptYSize",
-                    &open_type_os2_superscript_y_size);
-  plist::readNumber(plist, "openTypeOS2SuperscriptXOffset",
-                    &open_type_os2_superscript_x_offset);
-  plist::readNumber(plist, "openTypeOS2SuperscriptYOffset",
-                    &open_type_os2_superscript_y_offset);
-  plist::readNumber(plist, "openTypeOS2StrikeoutSize",
-                    &open_type_os2_strikeout_size);
-  plist::readNumber(plist, "openTypeOS2StrikeoutPosition",
-                    &open_type_os2_strikeout_position);
-}
-
-void FontInfo::readOpenTypeVHEATableFields(const PropertyList& plist) {
-  plist::readNumber(plist, "openTypeVheaVertTypoAscender",
-                    &open_type_vhea_vert_typo_ascender);
-  plist::readNumber(plist, "openTypeVheaVertTypoDescender",
-                    &open_type_vhea_vert_typo_descender);
-  plist::readNumber(plist, "openTypeVheaVertTypoLineGap",
-                    &open_type_vhea_vert_typo_line_gap);
-  plist::readNumber(plist, "openTypeVheaCaretSlopeRise",
-                    &open_type_vhea_caret_slope_rise);
-  plist::readNumber(plist, "openTypeVheaCaretSlopeRun",
-                    &open_type_vhea_caret_slope_run);
-  plist::readNumber(plist, "openTypeVheaCaretOffset",
-                    &open_type_vhea_caret_offset);
-}
-
-void FontInfo::readPostScriptSpecificData(const PropertyList& plist) {
-  plist::readString(plist, "postscriptFontName",
-                    &postscript_font_name);
-  plist::readString(plist, "postscriptFullName",
-                    &postscript_full_name);
-  plist::readNumber(plist, "postscriptSlantAngle",
-                    &postscript_slant_angle);
-  plist::readNumber(plist, "postscriptUniqueID",
-                    &postscript_unique_id);
-  plist::readNumber(plist, "postscriptUnderlineThickness",
-                    &postscript_underline_thickness);
-  plist::readNumber(plist, "postscriptUnderlinePosition",
-                    &postscript_underline_position);
-  plist::readBoolean(plist, "postscriptIsFixedPitch",
-                     &postscript_is_fixed_pitch);
-  plist::readVector(plist, "postscriptBlueValues",
-                    &postscript_blue_values);
-  plist::readVector(plist, "postscriptOtherBlues",
-                    &postscript_other_blues);
-  plist::readVector(plist, "postscriptFamilyBlues",
-                    &postscript_family_blues);
-  plist::readVector(plist, "postscriptFamilyOtherBlues",
-                    &postscript_family_other_blues);
-  plist::readVector(plist, "postscriptStemSnapH",
-                    &postscript_stem_snap_h);
-  plist::readVector(plist, "postscriptStemSnapV",
-                    &postscript_stem_snap_v);
-  plist::readNumber(plist, "postscriptBlueFuzz",
-                    &postscript_blue_fuzz);
-  plist::readNumber(plist, "postscriptBlueShift",
-                    &postscript_blue_shift);
-  plist::readNumber(plist, "postscriptBlueScale",
-                    &postscript_blue_scale);
-  plist::readBoolean(plist, "postscriptForceBold",
-                     &postscript_force_bold);
-  plist::readNumber(plist, "postscriptDefaultWidthX",
-                    &postscript_default_width_x);
-  plist::readNumber(plist, "postscriptNominalWidthX",
-                    &postscript_nominal_width_x);
-  plist::readString(plist, "postscriptWeightName",
-                    &postscript_weight_name);
-  plist::readString(plist, "postscriptDefaultCharacter",
-                    &postscript_default_character);
-  plist::readNumber(plist, "postscriptWindowsCharacterSet",
-                    &postscript_windows_character_set);
-}
-
-void FontInfo::readMacintoshFONDResourceData(const PropertyList& plist) {
-  plist::readNumber(plist, "macintoshFONDFamilyID",
-                    &macintosh_fond_family_id);
-  plist::readString(plist, "macintoshFONDName",
-                    &macintosh_fond_name);
-}
-
-void FontInfo::readWOFFData(const PropertyList& plist) {
-  plist::readNumber(plist, "woffMajorVersion",
-                    &woff_major_version);
-  plist::readNumber(plist, "woffMinorVersion",
-                    &woff_minor_version);
-  plist::readObject(plist, "woffMetadataUniqueID",
-                    &woff_metadata_unique_id);
-  plist::readObject(plist, "woffMetadataVendor",
-                    &woff_metadata_vendor);
-  plist::readObject(plist, "woffMetadataCredits",
-                    &woff_metadata_credits);
-  plist::readObject(plist, "woffMetadataDescription",
-                    &woff_metadata_description);
-  plist::readObject(plist, "woffMetadataLicense",
-                    &woff_metadata_license);
-  plist::readObject(plist, "woffMetadataCopyright",
-                    &woff_metadata_copyright);
-  plist::readObject(plist, "woffMetadataTrademark",
-                    &woff_metadata_trademark);
-  plist::readObject(plist, "woffMetadataLicensee",
-                    &woff_metadata_licensee);
-  plist::readVector(plist, "woffMetadataExtensions",
-                    &woff_metadata_extensions);
-}
-
-void FontInfo::readGuidelines(const PropertyList& plist) {
-  plist::readVector(plist, "guidelines", &guidelines);
+  return plist;
 }
 
 // MARK: Writing to property list
@@ -5,6 +5,7 @@
 #ifndef TOKEN_UFO_FONT_INFO_H_
 #define TOKEN_UFO_FONT_INFO_H_
 
+#include <cstddef>
 #include <istream>
 #include <map>
 #include <ostream>
@@ -15,6 +16,7 @@
 #include "token/ufo/guideline.h"
 #include "token/ufo/name_record.h"
 #include "token/ufo/optional.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff.h"
 
@@ -34,25 +36,16 @@ class FontInfo final {
   // Opening and saving
   bool open(const std::string& path);
   bool open(std::istream& stream);
+  bool open(const char *data, std::size_t size);
   bool save(const std::string& path) const;
   bool save(std::ostream& stream) const;
 
+  // Property list
+  explicit FontInfo(const plist::Value& value);
+  PropertyList plist() const;
+
  private:
-  // Reading from property list
-  void readIdentificationInformation(const PropertyList& plist);
-  void readLegalInformation(const PropertyList& plist);
-  void readDimensionInformation(const PropertyList& plist);
-  void readMiscellaneousInformation(const PropertyList& plist);
-  void readOpenTypeGASPTableFields(const PropertyList& plist);
-  void readOpenTypeHEADTableFields(const PropertyList& plist);
-  void readOpenTypeHHEATableFields(const PropertyList& plist);
-  void readOpenTypeNameTableFields(const PropertyList& plist);
-  void readOpenTypeOS2TableFields(const PropertyList& plist);
-  void readOpenTypeVHEATableFields(const PropertyList& plist);
-  void readPostScriptSpecificData(const PropertyList& plist);
-  void readMacintoshFONDResourceData(const PropertyList& plist);
-  void readWOFFData(const PropertyList& plist);
-  void readGuidelines(const PropertyList& plist);
+  void read(const plist::Value& value);
 
   // Writing to property list
   void writeIdentificationInformation(const PropertyList& plist) const;
@@ -218,6 +211,10 @@ inline FontInfo::FontInfo(std::istream& stream) {
   open(stream);
 }
 
+inline FontInfo::FontInfo(const plist::Value& value) {
+  read(value);
+}
+
 }  // namespace ufo
 }  // namespace token
 
@@ -3,18 +3,28 @@
 
 #include "token/ufo/gasp_range_record.h"
 
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
 namespace ufo {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("rangeMaxPPEM", &GASPRangeRecord::range_max_ppem),
+    plist::bind("rangeGaspBehavior", &GASPRangeRecord::range_gasp_behavior));
+
+}  // namespace
+
 // MARK: Property list
 
-GASPRangeRecord::GASPRangeRecord(const PropertyList& plist)
+GASPRangeRecord::GASPRangeRecord(const plist::Value& value)
     : GASPRangeRecord() {
-  plist::readNumber(plist, "rangeMaxPPEM", &range_max_ppem);
-  plist::readVector(plist, "rangeGaspBehavior", &range_gasp_behavior);
+  plist::read(value, kBindings, this);
 }
 
 PropertyList GASPRangeRecord::plist() const {
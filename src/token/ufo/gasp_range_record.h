@@ -7,6 +7,7 @@
 
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
@@ -21,7 +22,7 @@ class GASPRangeRecord final {
   GASPRangeRecord& operator=(const GASPRangeRecord&) = default;
 
   // Property list
-  explicit GASPRangeRecord(const PropertyList& plist);
+  explicit GASPRangeRecord(const plist::Value& value);
   PropertyList plist() const;
 
  public:
@@ -12,6 +12,7 @@
 #include "token/ufo/glif/contour_style.h"
 #include "token/ufo/glif/contour_styles.h"
 #include "token/ufo/glif/guideline.h"
+#include "token/ufo/glif/hint_set.h"
 #include "token/ufo/glif/image.h"
 #include "token/ufo/glif/lib.h"
 #include "token/ufo/glif/outline.h"
@@ -5,9 +5,11 @@
 #ifndef TOKEN_UFO_GLIF_ADVANCE_H_
 #define TOKEN_UFO_GLIF_ADVANCE_H_
 
-#include <boost/property_tree/ptree.hpp>
+#include <cassert>
 
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -22,9 +24,11 @@ class Advance final {
   Advance(const Advance&) = default;
   Advance& operator=(const Advance&) = default;
 
-  // Property tree
-  explicit Advance(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Advance(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   double width;
@@ -53,18 +57,19 @@ inline bool operator!=(const Advance& lhs, const Advance& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Advance::Advance(const boost::property_tree::ptree& tree) : Advance() {
-  xml::readAttribute(tree, "width", &width);
-  xml::readAttribute(tree, "height", &height);
+inline Advance::Advance(const xml::Element& element) : Advance() {
+  xml::readAttribute(element, "width", &width);
+  xml::readAttribute(element, "height", &height);
 }
 
-inline boost::property_tree::ptree Advance::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "width", width, 0.0);
-  xml::writeAttribute(&tree, "height", height, 0.0);
-  return tree;
+// MARK: XML writer
+
+inline void Advance::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("width", width, 0.0);
+  writer->attribute("height", height, 0.0);
 }
 
 }  // namespace glif
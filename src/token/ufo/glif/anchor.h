@@ -5,11 +5,12 @@
 #ifndef TOKEN_UFO_GLIF_ANCHOR_H_
 #define TOKEN_UFO_GLIF_ANCHOR_H_
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -28,9 +29,11 @@ class Anchor final {
   Anchor(const Anchor&) = default;
   Anchor& operator=(const Anchor&) = default;
 
-  // Property tree
-  explicit Anchor(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Anchor(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   double x;
@@ -71,24 +74,25 @@ inline bool operator!=(const Anchor& lhs, const Anchor& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Anchor::Anchor(const boost::property_tree::ptree& tree) {
-  xml::readAttribute(tree, "x", &x);
-  xml::readAttribute(tree, "y", &y);
-  xml::readAttribute(tree, "name", &name);
-  xml::readAttribute(tree, "color", &color);
-  xml::readAttribute(tree, "identifier", &identifier);
+inline Anchor::Anchor(const xml::Element& element) {
+  xml::readAttribute(element, "x", &x);
+  xml::readAttribute(element, "y", &y);
+  xml::readAttribute(element, "name", &name);
+  xml::readAttribute(element, "color", &color);
+  xml::readAttribute(element, "identifier", &identifier);
 }
 
-inline boost::property_tree::ptree Anchor::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "x", x);
-  xml::writeAttribute(&tree, "y", y);
-  xml::writeAttribute(&tree, "name", name, "");
-  xml::writeAttribute(&tree, "color", color, "");
-  xml::writeAttribute(&tree, "identifier", identifier, "");
-  return tree;
+// MARK: XML writer
+
+inline void Anchor::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("x", x);
+  writer->attribute("y", y);
+  writer->attribute("name", name, "");
+  writer->attribute("color", color, "");
+  writer->attribute("identifier", identifier, "");
 }
 
 }  // namespace glif
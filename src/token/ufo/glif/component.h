@@ -5,11 +5,12 @@
 #ifndef TOKEN_UFO_GLIF_COMPONENT_H_
 #define TOKEN_UFO_GLIF_COMPONENT_H_
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -31,9 +32,11 @@ class Component final {
   Component(const Component&) = default;
   Component& operator=(const Component&) = default;
 
-  // Property tree
-  explicit Component(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Component(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   std::string base;
@@ -94,31 +97,31 @@ inline bool operator!=(const Component& lhs, const Component& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
-
-inline Component::Component(const boost::property_tree::ptree& tree)
-    : Component() {
-  xml::readAttribute(tree, "base", &base);
-  xml::readAttribute(tree, "xScale", &x_scale);
-  xml::readAttribute(tree, "xyScale", &xy_scale);
-  xml::readAttribute(tree, "yxScale", &yx_scale);
-  xml::readAttribute(tree, "yScale", &y_scale);
-  xml::readAttribute(tree, "xOffset", &x_offset);
-  xml::readAttribute(tree, "yOffset", &y_offset);
-  xml::readAttribute(tree, "identifier", &identifier);
+// MARK: XML reader
+
+inline Component::Component(const xml::Element& element) : Component() {
+  xml::readAttribute(element, "base", &base);
+  xml::readAttribute(element, "xScale", &x_scale);
+  xml::readAttribute(element, "xyScale", &xy_scale);
+  xml::readAttribute(element, "yxScale", &yx_scale);
+  xml::readAttribute(element, "yScale", &y_scale);
+  xml::readAttribute(element, "xOffset", &x_offset);
+  xml::readAttribute(element, "yOffset", &y_offset);
+  xml::readAttribute(element, "identifier", &identifier);
 }
 
-inline boost::property_tree::ptree Component::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "base", base);
-  xml::writeAttribute(&tree, "xScale", x_scale, 1.0);
-  xml::writeAttribute(&tree, "xyScale", xy_scale, 0.0);
-  xml::writeAttribute(&tree, "yxScale", yx_scale, 0.0);
-  xml::writeAttribute(&tree, "yScale", y_scale, 1.0);
-  xml::writeAttribute(&tree, "xOffset", x_offset, 0.0);
-  xml::writeAttribute(&tree, "yOffset", y_offset, 0.0);
-  xml::writeAttribute(&tree, "identifier", identifier, "");
-  return tree;
+// MARK: XML writer
+
+inline void Component::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("base", base);
+  writer->attribute("xScale", x_scale, 1.0);
+  writer->attribute("xyScale", xy_scale, 0.0);
+  writer->attribute("yxScale", yx_scale, 0.0);
+  writer->attribute("yScale", y_scale, 1.0);
+  writer->attribute("xOffset", x_offset, 0.0);
+  writer->attribute("yOffset", y_offset, 0.0);
+  writer->attribute("identifier", identifier, "");
 }
 
 }  // namespace glif
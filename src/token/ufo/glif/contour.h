@@ -5,13 +5,14 @@
 #ifndef TOKEN_UFO_GLIF_CONTOUR_H_
 #define TOKEN_UFO_GLIF_CONTOUR_H_
 
+#include <cassert>
 #include <string>
 #include <vector>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/glif/point.h"
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -27,9 +28,11 @@ class Contour final {
   Contour(const Contour&) = default;
   Contour& operator=(const Contour&) = default;
 
-  // Property tree
-  explicit Contour(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Contour(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   std::string identifier;
@@ -57,18 +60,19 @@ inline bool operator!=(const Contour& lhs, const Contour& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Contour::Contour(const boost::property_tree::ptree& tree) {
-  xml::readAttribute(tree, "identifier", &identifier);
-  xml::readChildren(tree, "point", &points);
+inline Contour::Contour(const xml::Element& element) {
+  xml::readAttribute(element, "identifier", &identifier);
+  xml::readChildren(element, "point", &points);
 }
 
-inline boost::property_tree::ptree Contour::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "identifier", identifier, "");
-  xml::writeChildren(&tree, "point", points);
-  return tree;
+// MARK: XML writer
+
+inline void Contour::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("identifier", identifier, "");
+  xml::writeChildren(writer, "point", points);
 }
 
 }  // namespace glif
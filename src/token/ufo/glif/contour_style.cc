@@ -3,13 +3,14 @@
 
 #include "token/ufo/glif/contour_style.h"
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/types.h"
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -96,17 +97,11 @@ inline std::string convertAlign(Align value) {
 
 // MARK: Property list
 
-ContourStyle::ContourStyle(const PropertyList& plist) {
-  std::string value;
-  plist::readString(plist, "cap", &value);
-  cap = convertCap(value);
-  value = std::string();
-  plist::readString(plist, "join", &value);
-  join = convertJoin(value);
-  value = std::string();
-  plist::readString(plist, "align", &value);
-  align = convertAlign(value);
-  plist::readBoolean(plist, "filled", &filled);
+ContourStyle::ContourStyle(const plist::Value& value) : ContourStyle() {
+  cap = convertCap(value["cap"].string());
+  join = convertJoin(value["join"].string());
+  align = convertAlign(value["align"].string());
+  plist::read(value["filled"], &filled);
 }
 
 PropertyList ContourStyle::plist() const {
@@ -120,25 +115,26 @@ PropertyList ContourStyle::plist() const {
   return plist;
 }
 
-boost::property_tree::ptree ContourStyle::ptree() const {
-  boost::property_tree::ptree tree;
+// MARK: XML writer
+
+void ContourStyle::write(xml::Writer *writer) const {
+  assert(writer);
   if (cap != Cap::UNDEFINED) {
-    tree.add("key", "cap");
-    tree.add("string", convertCap(cap));
+    writer->element("key", "cap");
+    writer->element("string", convertCap(cap));
   }
   if (join != Join::UNDEFINED) {
-    tree.add("key", "join");
-    tree.add("string", convertJoin(join));
+    writer->element("key", "join");
+    writer->element("string", convertJoin(join));
   }
   if (align != Align::UNDEFINED) {
-    tree.add("key", "align");
-    tree.add("string", convertAlign(align));
+    writer->element("key", "align");
+    writer->element("string", convertAlign(align));
   }
   if (filled) {
-    tree.add("key", "filled");
-    tree.add("true", "");
+    writer->element("key", "filled");
+    writer->element("true");
   }
-  return tree;
 }
 
 }  // namespace glif
@@ -7,10 +7,10 @@
 
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/types.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -25,11 +25,11 @@ class ContourStyle final {
   ContourStyle& operator=(const ContourStyle&) = default;
 
   // Property list
-  explicit ContourStyle(const PropertyList& plist);
+  explicit ContourStyle(const plist::Value& value);
   PropertyList plist() const;
 
-  // Property tree
-  boost::property_tree::ptree ptree() const;
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   Cap cap;
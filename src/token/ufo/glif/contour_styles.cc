@@ -3,18 +3,12 @@
 
 #include "token/ufo/glif/contour_styles.h"
 
-extern "C" {
-
-#include <plist/plist.h>
-
-}  // extern "C"
-
 #include <cassert>
-#include <cstdint>
-#include <cstdlib>
 
 #include "token/ufo/glif/contour_style.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -22,20 +16,13 @@ namespace glif {
 
 // MARK: Property list
 
-ContourStyles::ContourStyles(const PropertyList& plist) {
-  plist_dict_iter itr{};
-  plist_dict_new_iter(plist, &itr);
-  const auto size = plist_dict_get_size(plist);
-  for (std::uint32_t i{}; i < size; ++i) {
-    char *key{};
-    plist_t item{};
-    plist_dict_next_item(plist, itr, &key, &item);
-    assert(key);
-    assert(plist_get_node_type(item) == PLIST_DICT);
-    styles_.emplace(key, ContourStyle(PropertyList(item, false)));
-    std::free(key);
-  }
-  std::free(itr);
+ContourStyles::ContourStyles(const plist::Value& value) {
+  value.forEachEntry([this](const plist::Value& key,
+                            const plist::Value& value) {
+    if (value.type() == plist::Value::Type::DICTIONARY) {
+      styles_.emplace(key.string(), ContourStyle(value));
+    }
+  });
 }
 
 PropertyList ContourStyles::plist() const {
@@ -43,15 +30,16 @@ PropertyList ContourStyles::plist() const {
   return plist;
 }
 
-// MARK: Property tree
+// MARK: XML writer
 
-boost::property_tree::ptree ContourStyles::ptree() const {
-  boost::property_tree::ptree tree;
+void ContourStyles::write(xml::Writer *writer) const {
+  assert(writer);
   for (const auto& pair : styles_) {
-    tree.add("key", pair.first);
-    tree.add_child("dict", pair.second.ptree());
+    writer->element("key", pair.first);
+    writer->open("dict");
+    pair.second.write(writer);
+    writer->close();
   }
-  return tree;
 }
 
 }  // namespace glif
@@ -9,16 +9,19 @@
 #include <string>
 #include <unordered_map>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/glif/contour_style.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace glif {
 
 class ContourStyles final {
+ public:
+  using Map = std::unordered_map<std::string, ContourStyle>;
+
  public:
   ContourStyles() = default;
 
@@ -27,23 +30,28 @@ class ContourStyles final {
   ContourStyles& operator=(const ContourStyles&) = default;
 
   // Property list
-  explicit ContourStyles(const PropertyList& plist);
+  explicit ContourStyles(const plist::Value& value);
   PropertyList plist() const;
 
-  // Property tree
-  boost::property_tree::ptree ptree() const;
+  // XML writer
+  void write(xml::Writer *writer) const;
 
   // Modifiers
   bool empty() const;
   const ContourStyle * find(const std::string& name) const;
   ContourStyle * find(const std::string& name);
+  void set(const std::string& name, const ContourStyle& style);
+
+  // Iterator
+  Map::const_iterator begin() const { return std::begin(styles_); }
+  Map::const_iterator end() const { return std::end(styles_); }
 
   // Comparison
   friend bool operator==(const ContourStyles& lhs, const ContourStyles& rhs);
   friend bool operator!=(const ContourStyles& lhs, const ContourStyles& rhs);
 
  private:
-  std::unordered_map<std::string, ContourStyle> styles_;
+  Map styles_;
 };
 
 // MARK: -
@@ -80,6 +88,11 @@ inline ContourStyle * ContourStyles::find(const std::string& name) {
   return &itr->second;
 }
 
+inline void ContourStyles::set(const std::string& name,
+                               const ContourStyle& style) {
+  styles_[name] = style;
+}
+
 }  // namespace glif
 }  // namespace ufo
 }  // namespace token
@@ -5,11 +5,12 @@
 #ifndef TOKEN_UFO_GLIF_GUIDELINE_H_
 #define TOKEN_UFO_GLIF_GUIDELINE_H_
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -29,9 +30,11 @@ class Guideline final {
   Guideline(const Guideline&) = default;
   Guideline& operator=(const Guideline&) = default;
 
-  // Property tree
-  explicit Guideline(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Guideline(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   double x;
@@ -76,26 +79,27 @@ inline bool operator!=(const Guideline& lhs, const Guideline& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Guideline::Guideline(const boost::property_tree::ptree& tree) {
-  xml::readAttribute(tree, "x", &x);
-  xml::readAttribute(tree, "y", &y);
-  xml::readAttribute(tree, "angle", &angle);
-  xml::readAttribute(tree, "name", &name);
-  xml::readAttribute(tree, "color", &color);
-  xml::readAttribute(tree, "identifier", &identifier);
+inline Guideline::Guideline(const xml::Element& element) {
+  xml::readAttribute(element, "x", &x);
+  xml::readAttribute(element, "y", &y);
+  xml::readAttribute(element, "angle", &angle);
+  xml::readAttribute(element, "name", &name);
+  xml::readAttribute(element, "color", &color);
+  xml::readAttribute(element, "identifier", &identifier);
 }
 
-inline boost::property_tree::ptree Guideline::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "x", x);
-  xml::writeAttribute(&tree, "y", y);
-  xml::writeAttribute(&tree, "angle", angle);
-  xml::writeAttribute(&tree, "name", name, "");
-  xml::writeAttribute(&tree, "color", color, "");
-  xml::writeAttribute(&tree, "identifier", identifier, "");
-  return tree;
+// MARK: XML writer
+
+inline void Guideline::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("x", x);
+  writer->attribute("y", y);
+  writer->attribute("angle", angle);
+  writer->attribute("name", name, "");
+  writer->attribute("color", color, "");
+  writer->attribute("identifier", identifier, "");
 }
 
 }  // namespace glif
@@ -0,0 +1,91 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_GLIF_HINT_SET_H_
+#define TOKEN_UFO_GLIF_HINT_SET_H_
+
+#include <cassert>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/xml_writer.h"
+
+namespace token {
+namespace ufo {
+namespace glif {
+
+// A set of stems in the hint data that autohint writes into the lib of
+// glyphs, and makeotf reads. The set applies from the point named by the tag,
+// and each of the stems is "hstem" or "vstem" followed by its position and
+// width.
+class HintSet final {
+ public:
+  HintSet() = default;
+  HintSet(const std::string& point_tag, const std::vector<std::string>& stems);
+
+  // Copy semantics
+  HintSet(const HintSet&) = default;
+  HintSet& operator=(const HintSet&) = default;
+
+  // Property list reader
+  explicit HintSet(const plist::Value& value);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
+
+ public:
+  std::string point_tag;
+  std::vector<std::string> stems;
+};
+
+// Comparison
+bool operator==(const HintSet& lhs, const HintSet& rhs);
+bool operator!=(const HintSet& lhs, const HintSet& rhs);
+
+// MARK: -
+
+inline HintSet::HintSet(const std::string& point_tag,
+                        const std::vector<std::string>& stems)
+    : point_tag(point_tag),
+      stems(stems) {}
+
+// MARK: Comparison
+
+inline bool operator==(const HintSet& lhs, const HintSet& rhs) {
+  return lhs.point_tag == rhs.point_tag && lhs.stems == rhs.stems;
+}
+
+inline bool operator!=(const HintSet& lhs, const HintSet& rhs) {
+  return !(lhs == rhs);
+}
+
+// MARK: Property list reader
+
+inline HintSet::HintSet(const plist::Value& value) : HintSet() {
+  plist::read(value, std::make_tuple(
+      plist::bind("pointTag", &HintSet::point_tag),
+      plist::bind("stems", &HintSet::stems)), this);
+}
+
+// MARK: XML writer
+
+inline void HintSet::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->element("key", "pointTag");
+  writer->element("string", point_tag);
+  writer->element("key", "stems");
+  writer->open("array");
+  for (const auto& stem : stems) {
+    writer->element("string", stem);
+  }
+  writer->close();
+}
+
+}  // namespace glif
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_GLIF_HINT_SET_H_
@@ -5,11 +5,12 @@
 #ifndef TOKEN_UFO_GLIF_IMAGE_H_
 #define TOKEN_UFO_GLIF_IMAGE_H_
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -31,9 +32,11 @@ class Image final {
   Image(const Image&) = default;
   Image& operator=(const Image&) = default;
 
-  // Property tree
-  explicit Image(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Image(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   std::string file_name;
@@ -94,30 +97,31 @@ inline bool operator!=(const Image& lhs, const Image& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
-
-inline Image::Image(const boost::property_tree::ptree& tree) : Image() {
-  xml::readAttribute(tree, "fileName", &file_name);
-  xml::readAttribute(tree, "xScale", &x_scale);
-  xml::readAttribute(tree, "xyScale", &xy_scale);
-  xml::readAttribute(tree, "yxScale", &yx_scale);
-  xml::readAttribute(tree, "yScale", &y_scale);
-  xml::readAttribute(tree, "xOffset", &x_offset);
-  xml::readAttribute(tree, "yOffset", &y_offset);
-  xml::readAttribute(tree, "color", &color);
+// MARK: XML reader
+
+inline Image::Image(const xml::Element& element) : Image() {
+  xml::readAttribute(element, "fileName", &file_name);
+  xml::readAttribute(element, "xScale", &x_scale);
+  xml::readAttribute(element, "xyScale", &xy_scale);
+  xml::readAttribute(element, "yxScale", &yx_scale);
+  xml::readAttribute(element, "yScale", &y_scale);
+  xml::readAttribute(element, "xOffset", &x_offset);
+  xml::readAttribute(element, "yOffset", &y_offset);
+  xml::readAttribute(element, "color", &color);
 }
 
-inline boost::property_tree::ptree Image::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "fileName", file_name);
-  xml::writeAttribute(&tree, "xScale", x_scale, 1.0);
-  xml::writeAttribute(&tree, "xyScale", xy_scale, 0.0);
-  xml::writeAttribute(&tree, "yxScale", yx_scale, 0.0);
-  xml::writeAttribute(&tree, "yScale", y_scale, 1.0);
-  xml::writeAttribute(&tree, "xOffset", x_offset, 0.0);
-  xml::writeAttribute(&tree, "yOffset", y_offset, 0.0);
-  xml::writeAttribute(&tree, "color", color, "");
-  return tree;
+// MARK: XML writer
+
+inline void Image::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("fileName", file_name);
+  writer->attribute("xScale", x_scale, 1.0);
+  writer->attribute("xyScale", xy_scale, 0.0);
+  writer->attribute("yxScale", yx_scale, 0.0);
+  writer->attribute("yScale", y_scale, 1.0);
+  writer->attribute("xOffset", x_offset, 0.0);
+  writer->attribute("yOffset", y_offset, 0.0);
+  writer->attribute("color", color, "");
 }
 
 }  // namespace glif
@@ -3,73 +3,72 @@
 
 #include "token/ufo/glif/lib.h"
 
-#include <string>
-#include <sstream>
-
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
+#include <cassert>
+#include <tuple>
+#include <vector>
 
 #include "token/ufo/glif/contour_styles.h"
-#include "token/ufo/plist.h"
-#include "token/ufo/property_list.h"
+#include "token/ufo/glif/hint_set.h"
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace glif {
 
-// MARK: Property tree
+namespace {
 
-Lib::Lib(const boost::property_tree::ptree& tree) : Lib() {
-  auto plist = convertToPropertyList(tree);
-  plist::readNumber(plist, "com.shotamatsuda.token.numberOfContours",
-                    &number_of_contours);
-  plist::readNumber(plist, "com.shotamatsuda.token.numberOfHoles",
-                    &number_of_holes);
-  plist::readObject(plist, "com.shotamatsuda.token.contourStyles",
-                    &contour_styles);
-}
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("com.shotamatsuda.token.numberOfContours",
+                &Lib::number_of_contours),
+    plist::bind("com.shotamatsuda.token.numberOfHoles",
+                &Lib::number_of_holes),
+    plist::bind("com.shotamatsuda.token.contourStyles",
+                &Lib::contour_styles));
 
-boost::property_tree::ptree Lib::ptree() const {
-  boost::property_tree::ptree dict;
-  dict.add("key", "com.shotamatsuda.token.numberOfContours");
-  dict.add("integer", number_of_contours);
-  dict.add("key", "com.shotamatsuda.token.numberOfHoles");
-  dict.add("integer", number_of_holes);
-  if (!contour_styles.empty()) {
-    dict.add("key", "com.shotamatsuda.token.contourStyles");
-    dict.add_child("dict", contour_styles.ptree());
-  }
-  boost::property_tree::ptree tree;
-  tree.add_child("dict", dict);
-  return tree;
-}
+}  // namespace
 
-PropertyList Lib::convertToPropertyList(
-    const boost::property_tree::ptree& tree) {
-  std::ostringstream stream;
-  boost::property_tree::xml_parser::write_xml(stream, tree);
-  auto contents = stream.str();
+// MARK: XML reader
 
-  // Erase the xml declaration
-  contents.erase(0, contents.find("\n") + 1);
+Lib::Lib(const xml::Element& element) : Lib() {
+  // The dictionary is read in place instead of being converted into a
+  // property list of libplist.
+  const plist::Value dictionary(element.firstChild("dict"));
+  plist::read(dictionary, kBindings, this);
+  plist::read(dictionary["com.adobe.type.autohint"]["hintSetList"],
+              &hint_sets);
+}
+
+// MARK: XML writer
 
-  // WORKAROUND: Erase all of the xml escape sequences
-  const std::string line_feed = "&#10;";
-  const auto line_feed_size = line_feed.size();
-  for (auto i = contents.find(line_feed_size);
-       i != std::string::npos;
-       i = contents.find(line_feed_size)) {
-    contents.erase(i, line_feed_size);
+void Lib::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->open("dict");
+  writer->element("key", "com.shotamatsuda.token.numberOfContours");
+  writer->element("integer", number_of_contours);
+  writer->element("key", "com.shotamatsuda.token.numberOfHoles");
+  writer->element("integer", number_of_holes);
+  if (!contour_styles.empty()) {
+    writer->element("key", "com.shotamatsuda.token.contourStyles");
+    writer->open("dict");
+    contour_styles.write(writer);
+    writer->close();
+  }
+  if (!hint_sets.empty()) {
+    writer->element("key", "com.adobe.type.autohint");
+    writer->open("dict");
+    writer->element("key", "hintSetList");
+    writer->open("array");
+    for (const auto& hint_set : hint_sets) {
+      writer->open("dict");
+      hint_set.write(writer);
+      writer->close();
+    }
+    writer->close();
+    writer->close();
   }
-  const std::string plist_contents =
-      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
-      "<!DOCTYPE plist PUBLIC \"-//Apple Computer//DTD PLIST 1.0//EN\" "
-      "\"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">"
-      "<plist version=\"1.0\">" + contents + "</plist>";
-  plist_t node{};
-  plist_from_xml(plist_contents.c_str(), plist_contents.size(), &node);
-  assert(plist_get_node_type(node) == PLIST_DICT);
-  return PropertyList(node);
+  writer->close();
 }
 
 }  // namespace glif
@@ -5,11 +5,13 @@
 #ifndef TOKEN_UFO_GLIF_LIB_H_
 #define TOKEN_UFO_GLIF_LIB_H_
 
-#include <boost/property_tree/ptree.hpp>
+#include <vector>
 
 #include "token/ufo/glif/contour_styles.h"
-#include "token/ufo/property_list.h"
+#include "token/ufo/glif/hint_set.h"
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -20,24 +22,24 @@ class Lib final {
   Lib();
   Lib(unsigned int number_of_contours,
       unsigned int number_of_holes,
-      const ContourStyles& contour_styles);
+      const ContourStyles& contour_styles,
+      const std::vector<HintSet>& hint_sets = {});
 
   // Copy semantics
   Lib(const Lib&) = default;
   Lib& operator=(const Lib&) = default;
 
-  // Property tree
-  explicit Lib(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Lib(const xml::Element& element);
 
- private:
-  static PropertyList convertToPropertyList(
-      const boost::property_tree::ptree& tree);
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   unsigned int number_of_contours;
   unsigned int number_of_holes;
   ContourStyles contour_styles;
+  std::vector<HintSet> hint_sets;
 };
 
 // Comparison
@@ -50,17 +52,20 @@ inline Lib::Lib() : number_of_contours(), number_of_holes() {}
 
 inline Lib::Lib(unsigned int number_of_contours,
                 unsigned int number_of_holes,
-                const ContourStyles& contour_styles)
+                const ContourStyles& contour_styles,
+                const std::vector<HintSet>& hint_sets)
     : number_of_contours(number_of_contours),
       number_of_holes(number_of_holes),
-      contour_styles(contour_styles) {}
+      contour_styles(contour_styles),
+      hint_sets(hint_sets) {}
 
 // MARK: Comparison
 
 inline bool operator==(const Lib& lhs, const Lib& rhs) {
   return (lhs.number_of_contours == rhs.number_of_contours &&
           lhs.number_of_holes == rhs.number_of_holes &&
-          lhs.contour_styles == rhs.contour_styles);
+          lhs.contour_styles == rhs.contour_styles &&
+          lhs.hint_sets == rhs.hint_sets);
 }
 
 inline bool operator!=(const Lib& lhs, const Lib& rhs) {
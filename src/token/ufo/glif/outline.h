@@ -5,13 +5,14 @@
 #ifndef TOKEN_UFO_GLIF_OUTLINE_H_
 #define TOKEN_UFO_GLIF_OUTLINE_H_
 
+#include <cassert>
 #include <vector>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/glif/component.h"
 #include "token/ufo/glif/contour.h"
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -27,9 +28,11 @@ class Outline final {
   Outline(const Outline&) = default;
   Outline& operator=(const Outline&) = default;
 
-  // Property tree
-  explicit Outline(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Outline(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   std::vector<Component> components;
@@ -57,18 +60,19 @@ inline bool operator!=(const Outline& lhs, const Outline& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Outline::Outline(const boost::property_tree::ptree& tree) {
-  xml::readChildren(tree, "component", &components);
-  xml::readChildren(tree, "contour", &contours);
+inline Outline::Outline(const xml::Element& element) {
+  xml::readChildren(element, "component", &components);
+  xml::readChildren(element, "contour", &contours);
 }
 
-inline boost::property_tree::ptree Outline::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeChildren(&tree, "component", components);
-  xml::writeChildren(&tree, "contour", contours);
-  return tree;
+// MARK: XML writer
+
+inline void Outline::write(xml::Writer *writer) const {
+  assert(writer);
+  xml::writeChildren(writer, "component", components);
+  xml::writeChildren(writer, "contour", contours);
 }
 
 }  // namespace glif
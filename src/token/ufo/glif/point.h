@@ -8,9 +8,9 @@
 #include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -42,9 +42,11 @@ class Point final {
   // Mutator
   void reset();
 
-  // Property tree
-  explicit Point(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Point(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   double x;
@@ -91,13 +93,13 @@ inline bool operator!=(const Point& lhs, const Point& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Point::Point(const boost::property_tree::ptree& tree) : Point() {
-  xml::readAttribute(tree, "x", &x);
-  xml::readAttribute(tree, "y", &y);
+inline Point::Point(const xml::Element& element) : Point() {
+  xml::readAttribute(element, "x", &x);
+  xml::readAttribute(element, "y", &y);
   std::string type_string;
-  xml::readAttribute(tree, "type", &type_string);
+  xml::readAttribute(element, "type", &type_string);
   if (type_string == "move") {
     type = Type::MOVE;
   } else if (type_string == "line") {
@@ -110,34 +112,35 @@ inline Point::Point(const boost::property_tree::ptree& tree) : Point() {
     type = Type::QCURVE;
   }
   std::string smooth_string;
-  xml::readAttribute(tree, "smooth", &smooth_string);
+  xml::readAttribute(element, "smooth", &smooth_string);
   if (smooth_string == "yes") {
     smooth = true;
   }
-  xml::readAttribute(tree, "name", &name);
-  xml::readAttribute(tree, "identifier", &identifier);
+  xml::readAttribute(element, "name", &name);
+  xml::readAttribute(element, "identifier", &identifier);
 }
 
-inline boost::property_tree::ptree Point::ptree() const {
-  std::string type;
-  switch (this->type) {
-    case Type::MOVE: type = "move"; break;
-    case Type::LINE: type = "line"; break;
-    case Type::OFFCURVE: type = "offcurve"; break;
-    case Type::CURVE: type = "curve"; break;
-    case Type::QCURVE: type = "qcurve"; break;
+// MARK: XML writer
+
+inline void Point::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("x", x);
+  writer->attribute("y", y);
+  switch (type) {
+    case Type::MOVE: writer->attribute("type", "move"); break;
+    case Type::LINE: writer->attribute("type", "line"); break;
+    case Type::OFFCURVE: break;  // Default
+    case Type::CURVE: writer->attribute("type", "curve"); break;
+    case Type::QCURVE: writer->attribute("type", "qcurve"); break;
     default:
       assert(false);
       break;
   }
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "x", x);
-  xml::writeAttribute(&tree, "y", y);
-  xml::writeAttribute(&tree, "type", type, "offcurve");
-  xml::writeAttribute(&tree, "smooth", smooth ? "yes" : "no", "no");
-  xml::writeAttribute(&tree, "name", name, "");
-  xml::writeAttribute(&tree, "identifier", identifier, "");
-  return tree;
+  if (smooth) {
+    writer->attribute("smooth", "yes");
+  }
+  writer->attribute("name", name, "");
+  writer->attribute("identifier", identifier, "");
 }
 
 }  // namespace glif
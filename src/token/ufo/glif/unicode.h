@@ -5,11 +5,12 @@
 #ifndef TOKEN_UFO_GLIF_UNICODE_H_
 #define TOKEN_UFO_GLIF_UNICODE_H_
 
+#include <cassert>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -24,9 +25,11 @@ class Unicode final {
   Unicode(const Unicode&) = default;
   Unicode& operator=(const Unicode&) = default;
 
-  // Property tree
-  explicit Unicode(const boost::property_tree::ptree& tree);
-  boost::property_tree::ptree ptree() const;
+  // XML reader
+  explicit Unicode(const xml::Element& element);
+
+  // XML writer
+  void write(xml::Writer *writer) const;
 
  public:
   std::string hex;
@@ -50,16 +53,17 @@ inline bool operator!=(const Unicode& lhs, const Unicode& rhs) {
   return !(lhs == rhs);
 }
 
-// MARK: Property tree
+// MARK: XML reader
 
-inline Unicode::Unicode(const boost::property_tree::ptree& tree) {
-  xml::readAttribute(tree, "hex", &hex);
+inline Unicode::Unicode(const xml::Element& element) {
+  xml::readAttribute(element, "hex", &hex);
 }
 
-inline boost::property_tree::ptree Unicode::ptree() const {
-  boost::property_tree::ptree tree;
-  xml::writeAttribute(&tree, "hex", hex);
-  return tree;
+// MARK: XML writer
+
+inline void Unicode::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("hex", hex);
 }
 
 }  // namespace glif
@@ -3,15 +3,17 @@
 
 #include "token/ufo/glyph.h"
 
+#include <cstddef>
 #include <fstream>
 #include <istream>
+#include <iterator>
 #include <ostream>
 #include <string>
 
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
-
+#include "token/mapped_file.h"
 #include "token/ufo/xml.h"
+#include "token/ufo/xml_reader.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -19,19 +21,30 @@ namespace ufo {
 // MARK: Opening and saving
 
 bool Glyph::open(const std::string& path) {
-  std::ifstream stream(path);
-  const auto result = open(stream);
-  stream.close();
-  return result;
+  const MappedFile file(path);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return open(file.data(), file.size());
 }
 
 bool Glyph::open(std::istream& stream) {
   if (!stream.good()) {
     return false;
   }
-  boost::property_tree::ptree tree;
-  boost::property_tree::xml_parser::read_xml(stream, tree);
-  const auto& glyph = tree.get_child("glyph");
+  const std::istreambuf_iterator<char> first(stream);
+  const std::string contents(first, std::istreambuf_iterator<char>());
+  return open(contents.data(), contents.size());
+}
+
+bool Glyph::open(const char *data, std::size_t size) {
+  // Elements refer to the contents in place instead of being copied into a
+  // property tree.
+  const xml::Document document(data, size);
+  const auto glyph = document.root();
+  if (!glyph || glyph.name() != "glyph") {
+    return false;
+  }
   xml::readAttribute(glyph, "name", &name);
   xml::readChild(glyph, "advance", &advance);
   xml::readChildren(glyph, "unicode", &unicodes);
@@ -54,21 +67,21 @@ bool Glyph::save(std::ostream& stream) const {
   if (!stream.good()) {
     return false;
   }
-  boost::property_tree::ptree glyph;
-  xml::writeAttribute(&glyph, "name", name);
-  xml::writeAttribute(&glyph, "format", 2);
-  xml::writeChild(&glyph, "advance", advance);
-  xml::writeChildren(&glyph, "unicode", unicodes);
-  xml::writeChild(&glyph, "image", image);
-  xml::writeChildren(&glyph, "guideline", guidelines);
-  xml::writeChildren(&glyph, "anchor", anchors);
-  xml::writeChild(&glyph, "outline", outline);
-  xml::writeChild(&glyph, "lib", lib);
-  boost::property_tree::ptree tree;
-  tree.add_child("glyph", glyph);
-  boost::property_tree::xml_writer_settings<std::string> settings(' ', 2);
-  boost::property_tree::xml_parser::write_xml(stream, tree, settings);
-  return true;
+  // Stream the elements directly instead of building a property tree.
+  xml::Writer writer(&stream);
+  writer.declaration();
+  writer.open("glyph");
+  writer.attribute("name", name);
+  writer.attribute("format", 2);
+  xml::writeChild(&writer, "advance", advance);
+  xml::writeChildren(&writer, "unicode", unicodes);
+  xml::writeChild(&writer, "image", image);
+  xml::writeChildren(&writer, "guideline", guidelines);
+  xml::writeChildren(&writer, "anchor", anchors);
+  xml::writeChild(&writer, "outline", outline);
+  xml::writeChild(&writer, "lib", lib);
+  writer.close();
+  return stream.good();
 }
 
 }  // namespace ufo
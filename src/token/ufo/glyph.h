@@ -5,13 +5,12 @@
 #ifndef TOKEN_UFO_GLYPH_H_
 #define TOKEN_UFO_GLYPH_H_
 
+#include <cstddef>
 #include <istream>
 #include <ostream>
 #include <string>
 #include <vector>
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "token/ufo/glif.h"
 
 namespace token {
@@ -29,6 +28,7 @@ class Glyph final {
   // Opening and saving
   bool open(const std::string& path);
   bool open(std::istream& stream);
+  bool open(const char *data, std::size_t size);
   bool save(const std::string& path) const;
   bool save(std::ostream& stream) const;
 
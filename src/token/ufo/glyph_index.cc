@@ -0,0 +1,268 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/glyph_index.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem/path.hpp>
+
+#include "token/mapped_file.h"
+#include "token/thread_pool.h"
+#include "token/ufo/glyph.h"
+#include "token/ufo/glyphs.h"
+
+namespace token {
+namespace ufo {
+
+namespace {
+
+bool startsWith(const char *first, const char *last, const char *prefix) {
+  const auto size = std::strlen(prefix);
+  return (static_cast<std::size_t>(last - first) >= size &&
+          std::equal(prefix, prefix + size, first));
+}
+
+// Returns the position after the token, or the end when there's none.
+const char * skipPast(const char *first, const char *last, const char *token) {
+  const auto result = std::search(first, last, token,
+                                  token + std::strlen(token));
+  return result == last ? last : result + std::strlen(token);
+}
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+// Returns the position of the end of the tag that begins at the first,
+// skipping the characters in quoted attribute values.
+const char * findTagEnd(const char *first, const char *last) {
+  char quote{};
+  for (; first != last; ++first) {
+    if (quote) {
+      if (*first == quote) {
+        quote = '\0';
+      }
+    } else if (*first == '"' || *first == '\'') {
+      quote = *first;
+    } else if (*first == '>') {
+      break;
+    }
+  }
+  return first;
+}
+
+// Calls the function with the name and the value of each attribute in the
+// tag between the first and the last, which begins with the element name.
+template <class Function>
+void readAttributes(const char *first, const char *last, Function function) {
+  while (first != last && !isSpace(*first)) {
+    ++first;
+  }
+  while (first != last) {
+    while (first != last && (isSpace(*first) || *first == '/')) {
+      ++first;
+    }
+    const auto name = first;
+    while (first != last && *first != '=' && !isSpace(*first)) {
+      ++first;
+    }
+    const std::string key(name, first);
+    first = std::find_if(first, last, [](char c) {
+      return c == '"' || c == '\'';
+    });
+    if (first == last) {
+      break;
+    }
+    const auto quote = *first++;
+    const auto value = first;
+    first = std::find(first, last, quote);
+    function(key, std::string(value, first));
+    if (first != last) {
+      ++first;
+    }
+  }
+}
+
+}  // namespace
+
+// MARK: Opening
+
+bool GlyphIndex::open(const Glyphs& glyphs, ThreadPool *pool) {
+  entries_.clear();
+  code_points_.clear();
+  entries_.resize(glyphs.size());
+  bool result = true;
+  if (pool && pool->size() > 1) {
+    // Glyphs are read in contiguous ranges so that there are as many tasks
+    // as threads.
+    const auto count = (glyphs.size() + pool->size() - 1) / pool->size();
+    std::vector<std::future<bool>> futures;
+    for (std::size_t first{}; first < glyphs.size(); first += count) {
+      const auto last = std::min(first + count, glyphs.size());
+      futures.emplace_back(pool->enqueue([this, &glyphs, first, last] {
+        bool result = true;
+        for (auto id = first; id < last; ++id) {
+          result = read(glyphs, id) && result;
+        }
+        return result;
+      }));
+    }
+    for (auto& future : futures) {
+      result = future.get() && result;
+    }
+  } else {
+    for (std::size_t id{}; id < glyphs.size(); ++id) {
+      result = read(glyphs, id) && result;
+    }
+  }
+  for (std::size_t id{}; id < entries_.size(); ++id) {
+    for (const auto code_point : entries_[id].unicodes) {
+      code_points_.emplace(code_point, id);
+    }
+  }
+  return result;
+}
+
+bool GlyphIndex::read(const Glyphs& glyphs, std::size_t id) {
+  auto& entry = entries_[id];
+  entry.name = glyphs.name(id);
+  const auto glyph = glyphs.loaded(id);
+  if (glyph) {
+    for (const auto& unicode : glyph->unicodes) {
+      entry.unicodes.emplace_back(static_cast<std::uint32_t>(
+          std::strtoul(unicode.hex.c_str(), nullptr, 16)));
+    }
+    if (glyph->advance.exists()) {
+      entry.advance = *glyph->advance;
+    }
+    return true;
+  }
+  const auto path = (boost::filesystem::path(glyphs.directory()) /
+                     glyphs.filename(id));
+  const MappedFile file(path.string());
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return scan(file.data(), file.size(), &entry);
+}
+
+// MARK: Entries
+
+std::vector<std::size_t> GlyphIndex::find(const std::string& text) const {
+  std::vector<std::size_t> result;
+  for (const auto code_point : decode(text)) {
+    const auto id = find(code_point);
+    if (id != Glyphs::npos) {
+      result.emplace_back(id);
+    }
+  }
+  return result;
+}
+
+// MARK: Scanning
+
+bool GlyphIndex::scan(const char *data, std::size_t size, Entry *entry) {
+  assert(data);
+  assert(entry);
+  const auto last = data + size;
+  bool found{};
+  for (auto first = std::find(data, last, '<'); first != last;
+       first = std::find(first, last, '<')) {
+    ++first;
+    if (startsWith(first, last, "?")) {
+      first = skipPast(first, last, "?>");
+      continue;
+    } else if (startsWith(first, last, "!--")) {
+      first = skipPast(first, last, "-->");
+      continue;
+    } else if (startsWith(first, last, "!")) {
+      first = skipPast(first, last, ">");
+      continue;
+    } else if (startsWith(first, last, "/glyph")) {
+      return found;
+    }
+    const auto end = findTagEnd(first, last);
+    if (end == last) {
+      break;
+    }
+    const auto name_end = std::find_if(first, end, [](char c) {
+      return isSpace(c) || c == '/';
+    });
+    const std::string name(first, name_end);
+    const bool empty = end[-1] == '/';
+    if (name == "glyph") {
+      found = true;
+    } else if (name == "unicode") {
+      readAttributes(first, end, [entry](const std::string& key,
+                                         const std::string& value) {
+        if (key == "hex") {
+          entry->unicodes.emplace_back(static_cast<std::uint32_t>(
+              std::strtoul(value.c_str(), nullptr, 16)));
+        }
+      });
+    } else if (name == "advance") {
+      readAttributes(first, end, [entry](const std::string& key,
+                                         const std::string& value) {
+        if (key == "width") {
+          entry->advance.width = std::strtod(value.c_str(), nullptr);
+        } else if (key == "height") {
+          entry->advance.height = std::strtod(value.c_str(), nullptr);
+        }
+      });
+    } else if (!empty && (name == "outline" || name == "lib")) {
+      // Neither contains an element of its own name.
+      first = skipPast(end, last, ("</" + name).c_str());
+      continue;
+    }
+    first = end + 1;
+  }
+  return found;
+}
+
+std::vector<std::uint32_t> GlyphIndex::decode(const std::string& text) {
+  std::vector<std::uint32_t> result;
+  for (std::size_t i{}; i < text.size();) {
+    const auto lead = static_cast<std::uint8_t>(text[i++]);
+    std::size_t count{};
+    std::uint32_t code_point{};
+    if (lead < 0x80) {
+      code_point = lead;
+    } else if ((lead & 0xe0) == 0xc0) {
+      code_point = lead & 0x1f;
+      count = 1;
+    } else if ((lead & 0xf0) == 0xe0) {
+      code_point = lead & 0x0f;
+      count = 2;
+    } else if ((lead & 0xf8) == 0xf0) {
+      code_point = lead & 0x07;
+      count = 3;
+    } else {
+      continue;
+    }
+    bool valid = true;
+    for (; count; --count) {
+      if (i >= text.size() ||
+          (static_cast<std::uint8_t>(text[i]) & 0xc0) != 0x80) {
+        valid = false;
+        break;
+      }
+      code_point = (code_point << 6) | (text[i++] & 0x3f);
+    }
+    if (valid) {
+      result.emplace_back(code_point);
+    }
+  }
+  return result;
+}
+
+}  // namespace ufo
+}  // namespace token
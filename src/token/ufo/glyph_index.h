@@ -0,0 +1,101 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_GLYPH_INDEX_H_
+#define TOKEN_UFO_GLYPH_INDEX_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "token/thread_pool.h"
+#include "token/ufo/glif/advance.h"
+#include "token/ufo/glyphs.h"
+
+namespace token {
+namespace ufo {
+
+// The names, unicodes and advances of glyphs, without their outlines. Names
+// come from the contents of the glyphs, and the rest from a scan of each
+// glyph file that skips the outline and lib elements instead of parsing
+// them. Glyphs that have been loaded are not read again.
+class GlyphIndex final {
+ public:
+  struct Entry final {
+    std::string name;
+    std::vector<std::uint32_t> unicodes;
+    glif::Advance advance;
+  };
+
+  using ConstIterator = std::vector<Entry>::const_iterator;
+
+ public:
+  GlyphIndex() = default;
+  explicit GlyphIndex(const Glyphs& glyphs, ThreadPool *pool = nullptr);
+
+  // Copy semantics
+  GlyphIndex(const GlyphIndex&) = default;
+  GlyphIndex& operator=(const GlyphIndex&) = default;
+
+  // Opening
+  bool open(const Glyphs& glyphs, ThreadPool *pool = nullptr);
+
+  // Attributes
+  std::size_t size() const { return entries_.size(); }
+  bool empty() const { return entries_.empty(); }
+
+  // Entries, whose indexes are the glyph IDs
+  const Entry& operator[](std::size_t id) const;
+  // The ID of the first glyph mapped to the code point, or Glyphs::npos.
+  std::size_t find(std::uint32_t code_point) const;
+  // The IDs of the glyphs of the characters in the UTF-8 text in order,
+  // skipping the characters without glyphs.
+  std::vector<std::size_t> find(const std::string& text) const;
+
+  // Iterator
+  ConstIterator begin() const { return std::begin(entries_); }
+  ConstIterator end() const { return std::end(entries_); }
+
+  // Scanning
+  static bool scan(const char *data, std::size_t size, Entry *entry);
+  // Decodes the code points of the UTF-8 text, skipping malformed sequences.
+  static std::vector<std::uint32_t> decode(const std::string& text);
+
+ private:
+  bool read(const Glyphs& glyphs, std::size_t id);
+
+ private:
+  std::vector<Entry> entries_;
+  std::unordered_map<std::uint32_t, std::size_t> code_points_;
+};
+
+// MARK: -
+
+inline GlyphIndex::GlyphIndex(const Glyphs& glyphs, ThreadPool *pool) {
+  open(glyphs, pool);
+}
+
+// MARK: Entries
+
+inline const GlyphIndex::Entry& GlyphIndex::operator[](std::size_t id) const {
+  assert(id < entries_.size());
+  return entries_[id];
+}
+
+inline std::size_t GlyphIndex::find(std::uint32_t code_point) const {
+  const auto itr = code_points_.find(code_point);
+  if (itr == std::end(code_points_)) {
+    return Glyphs::npos;
+  }
+  return itr->second;
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_GLYPH_INDEX_H_
@@ -6,6 +6,7 @@
 #define TOKEN_UFO_GLYPH_ITERATOR_H_
 
 #include <cassert>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <utility>
@@ -22,15 +23,10 @@ class GlyphIterator final : public std::iterator<std::forward_iterator_tag, T> {
     std::is_const<T>::value,
     const Glyphs, Glyphs
   >::type;
-  using Iterator = typename std::conditional<
-    std::is_const<T>::value,
-    typename decltype(std::declval<Glyphs>().contents_)::const_iterator,
-    typename decltype(std::declval<Glyphs>().contents_)::iterator
-  >::type;
 
  public:
   GlyphIterator();
-  GlyphIterator(Glyphs *glyphs, Iterator iterator);
+  GlyphIterator(Glyphs *glyphs, std::size_t id);
 
   // Copy semantics
   GlyphIterator(const GlyphIterator&) = default;
@@ -52,25 +48,25 @@ class GlyphIterator final : public std::iterator<std::forward_iterator_tag, T> {
 
  private:
   Glyphs *glyphs_;
-  Iterator iterator_;
+  std::size_t id_;
 };
 
 // MARK: -
 
 template <class T>
-inline GlyphIterator<T>::GlyphIterator() : glyphs_(), iterator_() {}
+inline GlyphIterator<T>::GlyphIterator() : glyphs_(), id_() {}
 
 template <class T>
-inline GlyphIterator<T>::GlyphIterator(Glyphs *glyphs, Iterator iterator)
+inline GlyphIterator<T>::GlyphIterator(Glyphs *glyphs, std::size_t id)
     : glyphs_(glyphs),
-      iterator_(iterator) {}
+      id_(id) {}
 
 // MARK: Comparison
 
 template <class T>
 inline bool operator==(const GlyphIterator<T>& lhs,
                        const GlyphIterator<T>& rhs) {
-  return lhs.glyphs_ == rhs.glyphs_ && lhs.iterator_ == rhs.iterator_;
+  return lhs.glyphs_ == rhs.glyphs_ && lhs.id_ == rhs.id_;
 }
 
 template <class T>
@@ -83,14 +79,14 @@ inline bool operator!=(const GlyphIterator<T>& lhs,
 
 template <class T>
 inline T& GlyphIterator<T>::operator*() const {
-  const auto ptr = glyphs_->find(iterator_->first);
+  const auto ptr = glyphs_->find(id_);
   assert(ptr);
   return *ptr;
 }
 
 template <class T>
 inline GlyphIterator<T>& GlyphIterator<T>::operator++() {
-  ++iterator_;
+  ++id_;
   return *this;
 }
 
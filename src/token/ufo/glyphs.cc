@@ -3,30 +3,57 @@
 
 #include "token/ufo/glyphs.h"
 
-extern "C" {
-
-#include <plist/plist.h>
-
-}  // extern "C"
-
-#include <algorithm>
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <iterator>
 #include <fstream>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <boost/filesystem/path.hpp>
-#include <boost/property_tree/ptree.hpp>
-#include <boost/property_tree/xml_parser.hpp>
 
+#include "token/mapped_file.h"
 #include "token/ufo/glyph.h"
+#include "token/ufo/plist_reader.h"
 
 namespace token {
 namespace ufo {
 
+constexpr std::size_t Glyphs::npos;
+
+// MARK: Copy semantics
+
+Glyphs::Glyphs(const Glyphs& other)
+    : path_(other.path_),
+      contents_(other.contents_),
+      ids_(other.ids_) {
+  slots_.reserve(other.slots_.size());
+  for (const auto& other_slot : other.slots_) {
+    slots_.emplace_back(std::make_unique<Slot>());
+    const auto glyph = other_slot->glyph.load(std::memory_order_acquire);
+    if (glyph) {
+      auto& slot = *slots_.back();
+      std::call_once(slot.once, [&slot, glyph] {
+        slot.storage = std::make_unique<Glyph>(*glyph);
+        slot.glyph.store(slot.storage.get(), std::memory_order_release);
+      });
+    }
+  }
+}
+
+Glyphs& Glyphs::operator=(const Glyphs& other) {
+  if (&other != this) {
+    Glyphs copy(other);
+    *this = std::move(copy);
+  }
+  return *this;
+}
+
 // MARK: Opening
 
 bool Glyphs::open(const std::string& path) {
@@ -37,95 +64,106 @@ bool Glyphs::open(const std::string& path) {
     glyphs = (node / "glyphs").string();
     contents = (node / "glyphs" / "contents.plist").string();
   }
-  std::ifstream stream(contents);
-  const auto result = open(stream);
-  stream.close();
+  const MappedFile file(contents);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
   path_ = glyphs;
-  return result;
+  return open(file.data(), file.size());
 }
 
 bool Glyphs::open(std::istream& stream) {
   if (!stream.good()) {
     return false;
   }
-  PropertyList plist(stream);
-  plist_dict_iter itr{};
-  plist_dict_new_iter(plist, &itr);
-  const auto size = plist_dict_get_size(plist);
-  for (std::uint32_t i{}; i < size; ++i) {
-    char *key{};
-    plist_t item{};
-    plist_dict_next_item(plist, itr, &key, &item);
-    assert(key);
-    assert(plist_get_node_type(item) == PLIST_STRING);
-    char *value{};
-    plist_get_string_val(item, &value);
-    contents_.emplace_back(key, value);
-    std::free(key);
-    std::free(value);
+  const std::istreambuf_iterator<char> first(stream);
+  const std::string contents(first, std::istreambuf_iterator<char>());
+  return open(contents.data(), contents.size());
+}
+
+bool Glyphs::open(const char *data, std::size_t size) {
+  const plist::Document document(data, size);
+  const auto root = document.root();
+  if (root.type() != plist::Value::Type::DICTIONARY) {
+    return false;
   }
-  std::free(itr);
+  read(root);
   return true;
 }
 
+void Glyphs::assign(
+    const std::string& directory,
+    const std::vector<std::pair<std::string, std::string>>& contents) {
+  path_ = directory;
+  contents_.clear();
+  ids_.clear();
+  slots_.clear();
+  contents_.reserve(contents.size());
+  ids_.reserve(contents.size());
+  for (const auto& content : contents) {
+    if (ids_.emplace(content.first, contents_.size()).second) {
+      contents_.emplace_back(content);
+    }
+  }
+  slots_.reserve(contents_.size());
+  for (std::size_t id{}; id < contents_.size(); ++id) {
+    slots_.emplace_back(std::make_unique<Slot>());
+  }
+}
+
+void Glyphs::read(const plist::Value& value) {
+  std::vector<std::pair<std::string, std::string>> contents;
+  value.forEachEntry([&contents](const plist::Value& key,
+                                 const plist::Value& value) {
+    contents.emplace_back(key.string(), value.string());
+  });
+  assign(path_, contents);
+}
+
 // MARK: Glyphs
 
 std::string Glyphs::filename(const std::string& name) const {
-  const auto value = std::find_if(
-      std::begin(contents_), std::end(contents_),
-      [&name](const auto& pair) {
-        return pair.first == name;
-      });
-  if (value == std::end(contents_)) {
+  const auto id = this->id(name);
+  if (id == npos) {
     return std::string();
   }
-  return value->second;
+  return contents_[id].second;
 }
 
-const Glyph * Glyphs::find(const std::string& name) const {
-  const auto itr = std::find_if(
-      std::begin(glyphs_), std::end(glyphs_),
-      [&name](const auto& pair) {
-        return pair.first == name;
-      });
-  if (itr != std::end(glyphs_)) {
-    return &itr->second;
+void Glyphs::set(const std::string& name, const Glyph& glyph) {
+  const auto id = this->id(name);
+  if (id == npos) {
+    return;  // Setting a new glyph is not supported
   }
-  const auto filename = this->filename(name);
-  if (filename.empty()) {
-    return nullptr;
+  auto& slot = *slots_[id];
+  bool stored{};
+  std::call_once(slot.once, [&slot, &glyph, &stored] {
+    slot.storage = std::make_unique<Glyph>(glyph);
+    slot.glyph.store(slot.storage.get(), std::memory_order_release);
+    stored = true;
+  });
+  if (stored) {
+    return;
   }
-  const auto path = boost::filesystem::path(path_) / filename;
-  Glyph glyph;
-  if (!glyph.open(path.string())) {
-    return nullptr;
+  if (slot.storage) {
+    *slot.storage = glyph;  // Keep pointers to the glyph valid
+  } else {
+    slot.storage = std::make_unique<Glyph>(glyph);
+    slot.glyph.store(slot.storage.get(), std::memory_order_release);
   }
-  glyphs_.emplace_back(name, std::move(glyph));
-  return &glyphs_.back().second;
 }
 
-Glyph * Glyphs::find(const std::string& name) {
-  return const_cast<Glyph *>(const_cast<const Glyphs *>(this)->find(name));
-}
-
-void Glyphs::set(const std::string& name, const Glyph& glyph) {
-  const auto content_itr = std::find_if(
-      std::begin(contents_), std::end(contents_),
-      [&name](const auto& pair) {
-        return pair.first == name;
-      });
-  if (content_itr == std::end(contents_)) {
-    return;  // Setting a new glyph is not supported
-  }
-  const auto glyph_itr = std::find_if(
-      std::begin(glyphs_), std::end(glyphs_),
-      [&name](const auto& pair) {
-        return pair.first == name;
-      });
-  if (glyph_itr != std::end(glyphs_)) {
-    glyph_itr->second = glyph;
-  } else {
-    glyphs_.emplace_back(name, glyph);
+// MARK: Loading
+
+void Glyphs::load(std::size_t id) const {
+  // This is called once per slot, and a glyph that failed to open stays
+  // unavailable rather than being parsed again.
+  auto& slot = *slots_[id];
+  const auto path = boost::filesystem::path(path_) / contents_[id].second;
+  auto glyph = std::make_unique<Glyph>();
+  if (glyph->open(path.string())) {
+    slot.storage = std::move(glyph);
+    slot.glyph.store(slot.storage.get(), std::memory_order_release);
   }
 }
 
@@ -5,34 +5,45 @@
 #ifndef TOKEN_UFO_GLYPHS_H_
 #define TOKEN_UFO_GLYPHS_H_
 
+#include <atomic>
+#include <cassert>
+#include <cstddef>
 #include <fstream>
+#include <limits>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <iterator>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
 #include "token/ufo/glyph.h"
 #include "token/ufo/glyph_iterator.h"
+#include "token/ufo/plist_reader.h"
 
 namespace token {
 namespace ufo {
 
+// Glyphs are loaded lazily on first access and every glyph file is parsed
+// exactly once. Finding glyphs is safe to call from multiple threads, and
+// reading a glyph that has been loaded takes no lock. Opening, assigning and
+// setting glyphs must not race with other accesses.
 class Glyphs final {
  public:
   using Iterator = GlyphIterator<Glyph>;
   using ConstIterator = GlyphIterator<const Glyph>;
 
- private:
-  template <class T>
-  friend class GlyphIterator;
+  // Glyph ID that is returned when a glyph is not found
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
 
  public:
   Glyphs() = default;
   explicit Glyphs(const std::string& path);
 
   // Copy semantics
-  Glyphs(const Glyphs&) = default;
-  Glyphs& operator=(const Glyphs&) = default;
+  Glyphs(const Glyphs& other);
+  Glyphs& operator=(const Glyphs& other);
 
   // Move semantics
   Glyphs(Glyphs&& other) = default;
@@ -40,12 +51,28 @@ class Glyphs final {
 
   // Opening
   bool open(const std::string& path);
+  void assign(const std::string& directory,
+              const std::vector<std::pair<std::string, std::string>>& contents);
+
+  // Attributes
+  const std::string& directory() const { return path_; }
+  std::size_t size() const { return contents_.size(); }
+  bool empty() const { return contents_.empty(); }
+
+  // Glyph IDs, which are the indexes of glyphs in the contents
+  std::size_t id(const std::string& name) const;
+  const std::string& name(std::size_t id) const;
 
   // Glyphs
   std::string filename(const std::string& name) const;
+  const std::string& filename(std::size_t id) const;
   const Glyph * find(const std::string& name) const;
   Glyph * find(const std::string& name);
+  const Glyph * find(std::size_t id) const;
+  Glyph * find(std::size_t id);
   void set(const std::string& name, const Glyph& glyph);
+  // The glyph if it has been loaded, without loading it.
+  const Glyph * loaded(std::size_t id) const;
 
   // Iterator
   Iterator begin();
@@ -53,13 +80,35 @@ class Glyphs final {
   Iterator end();
   ConstIterator end() const;
 
+ private:
+  class Slot final {
+   public:
+    Slot() : glyph(nullptr) {}
+
+    // Disallow copy semantics
+    Slot(const Slot&) = delete;
+    Slot& operator=(const Slot&) = delete;
+
+   public:
+    std::once_flag once;
+    std::atomic<Glyph *> glyph;
+    std::unique_ptr<Glyph> storage;
+  };
+
  private:
   bool open(std::istream& stream);
+  bool open(const char *data, std::size_t size);
+  void read(const plist::Value& value);
+  void load(std::size_t id) const;
 
  private:
   std::string path_;
   std::vector<std::pair<std::string, std::string>> contents_;
-  mutable std::vector<std::pair<std::string, Glyph>> glyphs_;
+  std::unordered_map<std::string, std::size_t> ids_;
+
+  // Glyphs are allocated individually so that pointers to them remain valid
+  // while the other glyphs are being loaded.
+  std::vector<std::unique_ptr<Slot>> slots_;
 };
 
 // MARK: -
@@ -68,22 +117,76 @@ inline Glyphs::Glyphs(const std::string& path) {
   open(path);
 }
 
+// MARK: Glyph IDs
+
+inline std::size_t Glyphs::id(const std::string& name) const {
+  const auto itr = ids_.find(name);
+  if (itr == std::end(ids_)) {
+    return npos;
+  }
+  return itr->second;
+}
+
+inline const std::string& Glyphs::name(std::size_t id) const {
+  assert(id < contents_.size());
+  return contents_[id].first;
+}
+
+// MARK: Glyphs
+
+inline const std::string& Glyphs::filename(std::size_t id) const {
+  assert(id < contents_.size());
+  return contents_[id].second;
+}
+
+inline const Glyph * Glyphs::find(const std::string& name) const {
+  const auto id = this->id(name);
+  if (id == npos) {
+    return nullptr;
+  }
+  return find(id);
+}
+
+inline Glyph * Glyphs::find(const std::string& name) {
+  return const_cast<Glyph *>(const_cast<const Glyphs *>(this)->find(name));
+}
+
+inline const Glyph * Glyphs::find(std::size_t id) const {
+  assert(id < slots_.size());
+  auto& slot = *slots_[id];
+  const auto glyph = slot.glyph.load(std::memory_order_acquire);
+  if (glyph) {
+    return glyph;
+  }
+  std::call_once(slot.once, &Glyphs::load, this, id);
+  return slot.glyph.load(std::memory_order_acquire);
+}
+
+inline Glyph * Glyphs::find(std::size_t id) {
+  return const_cast<Glyph *>(const_cast<const Glyphs *>(this)->find(id));
+}
+
+inline const Glyph * Glyphs::loaded(std::size_t id) const {
+  assert(id < slots_.size());
+  return slots_[id]->glyph.load(std::memory_order_acquire);
+}
+
 // MARK: Iterator
 
 inline typename Glyphs::Iterator Glyphs::begin() {
-  return Iterator(this, std::begin(contents_));
+  return Iterator(this, 0);
 }
 
 inline typename Glyphs::ConstIterator Glyphs::begin() const {
-  return ConstIterator(this, std::begin(contents_));
+  return ConstIterator(this, 0);
 }
 
 inline typename Glyphs::Iterator Glyphs::end() {
-  return Iterator(this, std::end(contents_));
+  return Iterator(this, contents_.size());
 }
 
 inline typename Glyphs::ConstIterator Glyphs::end() const {
-  return ConstIterator(this, std::end(contents_));
+  return ConstIterator(this, contents_.size());
 }
 
 }  // namespace ufo
@@ -0,0 +1,104 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/groups.h"
+
+extern "C" {
+
+#include <plist/plist.h>
+
+}  // extern "C"
+
+#include <cassert>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+#include "token/mapped_file.h"
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/property_list.h"
+
+namespace token {
+namespace ufo {
+
+// MARK: Opening and saving
+
+bool Groups::open(const std::string& path) {
+  const boost::filesystem::path node(path);
+  std::string groups = path;
+  if (node.leaf().extension() == ".ufo") {
+    groups = (node / "groups.plist").string();
+  }
+  const MappedFile file(groups);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return open(file.data(), file.size());
+}
+
+bool Groups::open(std::istream& stream) {
+  if (!stream.good()) {
+    return false;
+  }
+  const std::istreambuf_iterator<char> first(stream);
+  const std::string contents(first, std::istreambuf_iterator<char>());
+  return open(contents.data(), contents.size());
+}
+
+bool Groups::open(const char *data, std::size_t size) {
+  const plist::Document document(data, size);
+  const auto root = document.root();
+  if (root.type() != plist::Value::Type::DICTIONARY) {
+    return false;
+  }
+  read(root);
+  return true;
+}
+
+bool Groups::save(const std::string& path) const {
+  const boost::filesystem::path node(path);
+  std::string groups = path;
+  if (node.leaf().extension() == ".ufo") {
+    groups = (node / "groups.plist").string();
+  }
+  std::ofstream stream(groups);
+  const auto result = save(stream);
+  stream.close();
+  return result;
+}
+
+bool Groups::save(std::ostream& stream) const {
+  if (!stream.good()) {
+    return false;
+  }
+  PropertyList plist;
+  for (const auto& group : groups_) {
+    const auto node = plist_new_array();
+    for (const auto& member : group.second) {
+      plist_array_append_item(node, plist_new_string(member.c_str()));
+    }
+    plist_dict_set_item(plist, group.first.c_str(), node);
+  }
+  plist.save(stream);
+  return true;
+}
+
+// MARK: Reading from property list
+
+void Groups::read(const plist::Value& value) {
+  groups_.clear();
+  value.forEachEntry([this](const plist::Value& key,
+                            const plist::Value& value) {
+    auto& members = groups_[key.string()];
+    plist::read(value, &members);
+  });
+}
+
+}  // namespace ufo
+}  // namespace token
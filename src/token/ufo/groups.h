@@ -0,0 +1,101 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_GROUPS_H_
+#define TOKEN_UFO_GROUPS_H_
+
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/property_list.h"
+
+namespace token {
+namespace ufo {
+
+class Groups final {
+ public:
+  using Members = std::vector<std::string>;
+  using Map = std::map<std::string, Members>;
+
+ public:
+  Groups() = default;
+  explicit Groups(const std::string& path);
+
+  // Copy semantics
+  Groups(const Groups&) = default;
+  Groups& operator=(const Groups&) = default;
+
+  // Opening and saving
+  bool open(const std::string& path);
+  bool open(std::istream& stream);
+  bool open(const char *data, std::size_t size);
+  bool save(const std::string& path) const;
+  bool save(std::ostream& stream) const;
+
+  // Groups
+  bool empty() const { return groups_.empty(); }
+  std::size_t size() const { return groups_.size(); }
+  const Members * find(const std::string& name) const;
+  void set(const std::string& name, const Members& members);
+  void erase(const std::string& name);
+
+  // Iterator
+  Map::const_iterator begin() const { return std::begin(groups_); }
+  Map::const_iterator end() const { return std::end(groups_); }
+
+  // Comparison
+  friend bool operator==(const Groups& lhs, const Groups& rhs);
+  friend bool operator!=(const Groups& lhs, const Groups& rhs);
+
+ private:
+  void read(const plist::Value& value);
+
+ private:
+  Map groups_;
+};
+
+// MARK: -
+
+inline Groups::Groups(const std::string& path) {
+  open(path);
+}
+
+// MARK: Comparison
+
+inline bool operator==(const Groups& lhs, const Groups& rhs) {
+  return lhs.groups_ == rhs.groups_;
+}
+
+inline bool operator!=(const Groups& lhs, const Groups& rhs) {
+  return !(lhs == rhs);
+}
+
+// MARK: Groups
+
+inline const Groups::Members * Groups::find(const std::string& name) const {
+  const auto itr = groups_.find(name);
+  if (itr == std::end(groups_)) {
+    return nullptr;
+  }
+  return &itr->second;
+}
+
+inline void Groups::set(const std::string& name, const Members& members) {
+  groups_[name] = members;
+}
+
+inline void Groups::erase(const std::string& name) {
+  groups_.erase(name);
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_GROUPS_H_
@@ -3,21 +3,31 @@
 
 #include "token/ufo/guideline.h"
 
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
 namespace ufo {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("x", &Guideline::x),
+    plist::bind("y", &Guideline::y),
+    plist::bind("angle", &Guideline::angle),
+    plist::bind("name", &Guideline::name),
+    plist::bind("color", &Guideline::color),
+    plist::bind("identifier", &Guideline::identifier));
+
+}  // namespace
+
 // MARK: Property list
 
-Guideline::Guideline(const PropertyList& plist) {
-  plist::readNumber(plist, "x", &x);
-  plist::readNumber(plist, "y", &y);
-  plist::readNumber(plist, "angle", &angle);
-  plist::readString(plist, "name", &name);
-  plist::readString(plist, "color", &color);
-  plist::readString(plist, "identifier", &identifier);
+Guideline::Guideline(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Guideline::plist() const {
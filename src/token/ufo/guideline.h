@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
@@ -27,7 +28,7 @@ class Guideline final {
   Guideline& operator=(const Guideline&) = default;
 
   // Property list
-  explicit Guideline(const PropertyList& plist);
+  explicit Guideline(const plist::Value& value);
   PropertyList plist() const;
 
  public:
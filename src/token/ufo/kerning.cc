@@ -0,0 +1,114 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/kerning.h"
+
+extern "C" {
+
+#include <plist/plist.h>
+
+}  // extern "C"
+
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <string>
+
+#include <boost/filesystem/path.hpp>
+
+#include "token/mapped_file.h"
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/property_list.h"
+
+namespace token {
+namespace ufo {
+
+// MARK: Opening and saving
+
+bool Kerning::open(const std::string& path) {
+  const boost::filesystem::path node(path);
+  std::string kerning = path;
+  if (node.leaf().extension() == ".ufo") {
+    kerning = (node / "kerning.plist").string();
+  }
+  const MappedFile file(kerning);
+  if (!file.is_open() || file.empty()) {
+    return false;
+  }
+  return open(file.data(), file.size());
+}
+
+bool Kerning::open(std::istream& stream) {
+  if (!stream.good()) {
+    return false;
+  }
+  const std::istreambuf_iterator<char> first(stream);
+  const std::string contents(first, std::istreambuf_iterator<char>());
+  return open(contents.data(), contents.size());
+}
+
+bool Kerning::open(const char *data, std::size_t size) {
+  const plist::Document document(data, size);
+  const auto root = document.root();
+  if (root.type() != plist::Value::Type::DICTIONARY) {
+    return false;
+  }
+  read(root);
+  return true;
+}
+
+bool Kerning::save(const std::string& path) const {
+  const boost::filesystem::path node(path);
+  std::string kerning = path;
+  if (node.leaf().extension() == ".ufo") {
+    kerning = (node / "kerning.plist").string();
+  }
+  std::ofstream stream(kerning);
+  const auto result = save(stream);
+  stream.close();
+  return result;
+}
+
+bool Kerning::save(std::ostream& stream) const {
+  if (!stream.good()) {
+    return false;
+  }
+  PropertyList plist;
+  for (const auto& first : kerning_) {
+    const auto node = plist_new_dict();
+    for (const auto& second : first.second) {
+      plist_t value{};
+      if (std::trunc(second.second) == second.second) {
+        value = plist_new_uint(static_cast<std::int64_t>(second.second));
+      } else {
+        value = plist_new_real(second.second);
+      }
+      plist_dict_set_item(node, second.first.c_str(), value);
+    }
+    plist_dict_set_item(plist, first.first.c_str(), node);
+  }
+  plist.save(stream);
+  return true;
+}
+
+// MARK: Reading from property list
+
+void Kerning::read(const plist::Value& value) {
+  kerning_.clear();
+  value.forEachEntry([this](const plist::Value& first,
+                            const plist::Value& value) {
+    auto& pairs = kerning_[first.string()];
+    value.forEachEntry([&pairs](const plist::Value& second,
+                                const plist::Value& value) {
+      plist::read(value, &pairs[second.string()]);
+    });
+  });
+}
+
+}  // namespace ufo
+}  // namespace token
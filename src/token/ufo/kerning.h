@@ -0,0 +1,131 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_KERNING_H_
+#define TOKEN_UFO_KERNING_H_
+
+#include <cstddef>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <ostream>
+#include <string>
+
+#include "token/ufo/plist_reader.h"
+#include "token/ufo/property_list.h"
+
+namespace token {
+namespace ufo {
+
+// Kerning pairs keyed by the first and the second member, either of which
+// can be a glyph name or a group name.
+class Kerning final {
+ public:
+  using Pairs = std::map<std::string, double>;
+  using Map = std::map<std::string, Pairs>;
+
+ public:
+  Kerning() = default;
+  explicit Kerning(const std::string& path);
+
+  // Copy semantics
+  Kerning(const Kerning&) = default;
+  Kerning& operator=(const Kerning&) = default;
+
+  // Opening and saving
+  bool open(const std::string& path);
+  bool open(std::istream& stream);
+  bool open(const char *data, std::size_t size);
+  bool save(const std::string& path) const;
+  bool save(std::ostream& stream) const;
+
+  // Pairs
+  bool empty() const { return kerning_.empty(); }
+  std::size_t size() const { return kerning_.size(); }
+  const double * find(const std::string& first,
+                      const std::string& second) const;
+  const Pairs * find(const std::string& first) const;
+  void set(const std::string& first, const std::string& second, double value);
+  void erase(const std::string& first, const std::string& second);
+  void erase(const std::string& first);
+
+  // Iterator
+  Map::const_iterator begin() const { return std::begin(kerning_); }
+  Map::const_iterator end() const { return std::end(kerning_); }
+
+  // Comparison
+  friend bool operator==(const Kerning& lhs, const Kerning& rhs);
+  friend bool operator!=(const Kerning& lhs, const Kerning& rhs);
+
+ private:
+  void read(const plist::Value& value);
+
+ private:
+  Map kerning_;
+};
+
+// MARK: -
+
+inline Kerning::Kerning(const std::string& path) {
+  open(path);
+}
+
+// MARK: Comparison
+
+inline bool operator==(const Kerning& lhs, const Kerning& rhs) {
+  return lhs.kerning_ == rhs.kerning_;
+}
+
+inline bool operator!=(const Kerning& lhs, const Kerning& rhs) {
+  return !(lhs == rhs);
+}
+
+// MARK: Pairs
+
+inline const double * Kerning::find(const std::string& first,
+                                    const std::string& second) const {
+  const auto pairs = find(first);
+  if (!pairs) {
+    return nullptr;
+  }
+  const auto itr = pairs->find(second);
+  if (itr == std::end(*pairs)) {
+    return nullptr;
+  }
+  return &itr->second;
+}
+
+inline const Kerning::Pairs * Kerning::find(const std::string& first) const {
+  const auto itr = kerning_.find(first);
+  if (itr == std::end(kerning_)) {
+    return nullptr;
+  }
+  return &itr->second;
+}
+
+inline void Kerning::set(const std::string& first,
+                         const std::string& second,
+                         double value) {
+  kerning_[first][second] = value;
+}
+
+inline void Kerning::erase(const std::string& first,
+                           const std::string& second) {
+  const auto itr = kerning_.find(first);
+  if (itr != std::end(kerning_)) {
+    itr->second.erase(second);
+    if (itr->second.empty()) {
+      kerning_.erase(itr);
+    }
+  }
+}
+
+inline void Kerning::erase(const std::string& first) {
+  kerning_.erase(first);
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_KERNING_H_
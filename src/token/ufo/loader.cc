@@ -0,0 +1,73 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/loader.h"
+
+#include <cassert>
+#include <cstddef>
+#include <future>
+#include <string>
+
+#include "token/thread_pool.h"
+#include "token/ufo/font_info.h"
+#include "token/ufo/glyph.h"
+#include "token/ufo/glyphs.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace ufo {
+
+Loader::Loader(const std::string& path, ThreadPool *pool) {
+  assert(pool);
+  // The number of glyphs needs to be known before scheduling them.
+  glyphs_.open(path);
+  font_info_future_ = pool->enqueue([this, path]() -> const FontInfo * {
+    font_info_.open(path);
+    return &font_info_;
+  }).share();
+  kerning_future_ = pool->enqueue([this, path]() -> const Kerning * {
+    kerning_.open(path);
+    return &kerning_;
+  }).share();
+  groups_future_ = pool->enqueue([this, path]() -> const Groups * {
+    groups_.open(path);
+    return &groups_;
+  }).share();
+  glyph_futures_.reserve(glyphs_.size());
+  for (std::size_t id{}; id < glyphs_.size(); ++id) {
+    glyph_futures_.emplace_back(pool->enqueue([this, id]() -> const Glyph * {
+      return glyphs_.find(id);
+    }).share());
+  }
+}
+
+// MARK: Readiness
+
+std::shared_future<const Glyph *> Loader::glyph(const std::string& name) const {
+  const auto id = glyphs_.id(name);
+  if (id == Glyphs::npos) {
+    std::promise<const Glyph *> promise;
+    promise.set_value(nullptr);
+    return promise.get_future().share();
+  }
+  return glyph(id);
+}
+
+void Loader::wait() const {
+  if (font_info_future_.valid()) {
+    font_info_future_.wait();
+  }
+  if (kerning_future_.valid()) {
+    kerning_future_.wait();
+  }
+  if (groups_future_.valid()) {
+    groups_future_.wait();
+  }
+  for (const auto& future : glyph_futures_) {
+    future.wait();
+  }
+}
+
+}  // namespace ufo
+}  // namespace token
@@ -0,0 +1,90 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_LOADER_H_
+#define TOKEN_UFO_LOADER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <future>
+#include <string>
+#include <vector>
+
+#include "token/thread_pool.h"
+#include "token/ufo/font_info.h"
+#include "token/ufo/glyph.h"
+#include "token/ufo/glyphs.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace ufo {
+
+// Loads a UFO on a thread pool. The contents of the glyphs are read on
+// construction, and everything else is parsed in parallel afterwards. Each
+// part of the font becomes available through its future as soon as it is
+// parsed, so that glyphs can be processed before the whole font is loaded.
+class Loader final {
+ public:
+  Loader(const std::string& path, ThreadPool *pool);
+  ~Loader();
+
+  // Disallow copy semantics
+  Loader(const Loader&) = delete;
+  Loader& operator=(const Loader&) = delete;
+
+  // Readiness
+  const std::shared_future<const FontInfo *>& font_info() const;
+  const std::shared_future<const Kerning *>& kerning() const;
+  const std::shared_future<const Groups *>& groups() const;
+  const std::shared_future<const Glyph *>& glyph(std::size_t id) const;
+  std::shared_future<const Glyph *> glyph(const std::string& name) const;
+  void wait() const;
+
+  // Glyphs can be accessed without waiting for the futures because loading
+  // a glyph is synchronized per glyph.
+  const Glyphs& glyphs() const { return glyphs_; }
+
+ private:
+  FontInfo font_info_;
+  Kerning kerning_;
+  Groups groups_;
+  Glyphs glyphs_;
+  std::shared_future<const FontInfo *> font_info_future_;
+  std::shared_future<const Kerning *> kerning_future_;
+  std::shared_future<const Groups *> groups_future_;
+  std::vector<std::shared_future<const Glyph *>> glyph_futures_;
+};
+
+// MARK: -
+
+inline Loader::~Loader() {
+  // Tasks in the pool refer to the members.
+  wait();
+}
+
+// MARK: Readiness
+
+inline const std::shared_future<const FontInfo *>& Loader::font_info() const {
+  return font_info_future_;
+}
+
+inline const std::shared_future<const Kerning *>& Loader::kerning() const {
+  return kerning_future_;
+}
+
+inline const std::shared_future<const Groups *>& Loader::groups() const {
+  return groups_future_;
+}
+
+inline const std::shared_future<const Glyph *>& Loader::glyph(
+    std::size_t id) const {
+  assert(id < glyph_futures_.size());
+  return glyph_futures_[id];
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_LOADER_H_
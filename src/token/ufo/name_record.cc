@@ -3,20 +3,30 @@
 
 #include "token/ufo/name_record.h"
 
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
 namespace ufo {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("nameID", &NameRecord::name_id),
+    plist::bind("platformID", &NameRecord::platform_id),
+    plist::bind("encodingID", &NameRecord::encoding_id),
+    plist::bind("languageID", &NameRecord::language_id),
+    plist::bind("string", &NameRecord::string));
+
+}  // namespace
+
 // MARK: Property list
 
-NameRecord::NameRecord(const PropertyList& plist) : NameRecord() {
-  plist::readNumber(plist, "nameID", &name_id);
-  plist::readNumber(plist, "platformID", &platform_id);
-  plist::readNumber(plist, "encodingID", &encoding_id);
-  plist::readNumber(plist, "languageID", &language_id);
-  plist::readString(plist, "string", &string);
+NameRecord::NameRecord(const plist::Value& value) : NameRecord() {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList NameRecord::plist() const {
@@ -7,6 +7,7 @@
 
 #include <string>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 
 namespace token {
@@ -21,7 +22,7 @@ class NameRecord final {
   NameRecord& operator=(const NameRecord&) = default;
 
   // Property list
-  explicit NameRecord(const PropertyList& plist);
+  explicit NameRecord(const plist::Value& value);
   PropertyList plist() const;
 
  public:
@@ -25,134 +25,6 @@ namespace token {
 namespace ufo {
 namespace plist {
 
-inline void readBoolean(plist_t plist, const std::string& name, bool *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_BOOLEAN);
-    std::uint8_t value{};
-    plist_get_bool_val(node, &value);
-    *output = value;
-  }
-}
-
-inline void readBoolean(plist_t plist,
-                        const std::string& name,
-                        Optional<bool> *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_BOOLEAN);
-    std::uint8_t value{};
-    plist_get_bool_val(node, &value);
-    *output = value;
-  }
-}
-
-template <class T>
-inline void readNumber(plist_t plist, const std::string& name, T *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    const auto type = plist_get_node_type(node);
-    if (type == PLIST_UINT) {
-      std::uint64_t value{};
-      plist_get_uint_val(node, &value);
-      *output = *reinterpret_cast<std::int64_t *>(&value);
-    } else if (type == PLIST_REAL) {
-      double value{};
-      plist_get_real_val(node, &value);
-      *output = value;
-    }
-  }
-}
-
-template <class T>
-inline void readString(plist_t plist, const std::string& name, T *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_STRING);
-    char *value{};
-    plist_get_string_val(node, &value);
-    *output = value;
-    std::free(value);
-  }
-}
-
-template <class T>
-inline void readObject(plist_t plist, const std::string& name, T *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_DICT);
-    *output = T(PropertyList(node, false));
-  }
-}
-
-template <class T>
-inline void readObject(plist_t plist,
-                       const std::string& name,
-                       Optional<T> *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_DICT);
-    *output = T(PropertyList(node, false));
-  }
-}
-
-template <
-  class T,
-  std::enable_if_t<std::is_arithmetic<T>::value> * = nullptr
->
-inline void readVector(plist_t plist,
-                       const std::string& name,
-                       std::vector<T> *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_ARRAY);
-    const auto size = plist_array_get_size(node);
-    for (std::uint32_t i{}; i < size; ++i) {
-      const auto item = plist_array_get_item(node, i);
-      const auto type = plist_get_node_type(item);
-      if (type == PLIST_UINT) {
-        std::uint64_t value{};
-        plist_get_uint_val(item, &value);
-        output->emplace_back(*reinterpret_cast<std::int64_t *>(&value));
-      } else if (type == PLIST_REAL) {
-        double value{};
-        plist_get_real_val(item, &value);
-        output->emplace_back(value);
-      }
-    }
-  }
-}
-
-template <
-  class T,
-  std::enable_if_t<std::is_class<T>::value> * = nullptr
->
-inline void readVector(plist_t plist,
-                       const std::string& name,
-                       std::vector<T> *output) {
-  assert(output);
-  assert(plist_get_node_type(plist) == PLIST_DICT);
-  const auto node = plist_dict_get_item(plist, name.c_str());
-  if (node) {
-    assert(plist_get_node_type(node) == PLIST_DICT);
-    output->emplace_back(T(PropertyList(node, false)));
-  }
-}
-
 inline void writeBoolean(plist_t plist, const std::string& name, bool value) {
   assert(plist_get_node_type(plist) == PLIST_DICT);
   const auto node = plist_new_bool(value);
@@ -0,0 +1,120 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/plist_reader.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <string>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "token/ufo/xml_reader.h"
+
+namespace token {
+namespace ufo {
+namespace plist {
+
+// MARK: Attributes
+
+Value::Type Value::type() const {
+  if (!element_) {
+    return Type::UNDEFINED;
+  }
+  const auto name = element_.name();
+  if (name == "dict") {
+    return Type::DICTIONARY;
+  } else if (name == "array") {
+    return Type::ARRAY;
+  } else if (name == "string" || name == "key") {
+    return Type::STRING;
+  } else if (name == "integer") {
+    return Type::INTEGER;
+  } else if (name == "real") {
+    return Type::REAL;
+  } else if (name == "true" || name == "false") {
+    return Type::BOOLEAN;
+  } else if (name == "date") {
+    return Type::DATE;
+  } else if (name == "data") {
+    return Type::DATA;
+  }
+  return Type::UNDEFINED;
+}
+
+// MARK: Scalars
+
+bool Value::boolean() const {
+  return element_ && element_.name() == "true";
+}
+
+std::int64_t Value::integer() const {
+  // Contents are always followed by the end tag, which stops the conversion
+  // without copying them.
+  const auto type = this->type();
+  if (type == Type::INTEGER) {
+    return std::strtoll(element_.content().data(), nullptr, 10);
+  } else if (type == Type::REAL) {
+    return static_cast<std::int64_t>(real());
+  }
+  return 0;
+}
+
+double Value::real() const {
+  const auto type = this->type();
+  if (type == Type::INTEGER || type == Type::REAL) {
+    return std::strtod(element_.content().data(), nullptr);
+  }
+  return 0.0;
+}
+
+std::string Value::string() const {
+  if (type() != Type::STRING) {
+    return std::string();
+  }
+  return element_.text();
+}
+
+bool Value::equals(boost::string_ref string) const {
+  if (type() != Type::STRING) {
+    return false;
+  }
+  const auto content = element_.content();
+  if (content.find('&') == boost::string_ref::npos &&
+      content.find('<') == boost::string_ref::npos) {
+    return content == string;
+  }
+  return element_.text() == string;
+}
+
+// MARK: Dictionaries
+
+Value Value::operator[](boost::string_ref key) const {
+  Value result;
+  forEachEntry([&result, &key](const Value& entry, const Value& value) {
+    if (!result.exists() && entry.equals(key)) {
+      result = value;
+    }
+  });
+  return result;
+}
+
+// MARK: Parsing
+
+bool Document::parse(const char *data, std::size_t size) {
+  return document_.parse(data, size);
+}
+
+// MARK: Attributes
+
+Value Document::root() const {
+  const auto root = document_.root();
+  if (root && root.name() == "plist") {
+    return Value(root.firstChild());
+  }
+  return Value(root);
+}
+
+}  // namespace plist
+}  // namespace ufo
+}  // namespace token
@@ -0,0 +1,302 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_PLIST_READER_H_
+#define TOKEN_UFO_PLIST_READER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "token/ufo/optional.h"
+#include "token/ufo/xml_reader.h"
+
+namespace token {
+namespace ufo {
+namespace plist {
+
+// A handle to a value of an XML property list, which reads the element of
+// the value in place instead of building nodes of libplist.
+class Value final {
+ public:
+  enum class Type {
+    UNDEFINED,
+    DICTIONARY,
+    ARRAY,
+    STRING,
+    INTEGER,
+    REAL,
+    BOOLEAN,
+    DATE,
+    DATA
+  };
+
+ public:
+  Value() = default;
+  explicit Value(const xml::Element& element);
+
+  // Copy semantics
+  Value(const Value&) = default;
+  Value& operator=(const Value&) = default;
+
+  // Attributes
+  Type type() const;
+  bool exists() const { return static_cast<bool>(element_); }
+
+  // Scalars, which are zero or empty when the types don't match
+  bool boolean() const;
+  std::int64_t integer() const;
+  double real() const;
+  std::string string() const;
+  bool equals(boost::string_ref string) const;
+
+  // Dictionaries, whose keys are also given as values
+  Value operator[](boost::string_ref key) const;
+  template <class Function>
+  void forEachEntry(Function function) const;
+
+  // Arrays
+  template <class Function>
+  void forEachItem(Function function) const;
+
+ private:
+  xml::Element element_;
+};
+
+// A property list that is parsed from an XML buffer, which must outlive the
+// document and its values.
+class Document final {
+ public:
+  Document() = default;
+  Document(const char *data, std::size_t size);
+
+  // Disallow copy semantics
+  Document(const Document&) = delete;
+  Document& operator=(const Document&) = delete;
+
+  // Parsing
+  bool parse(const char *data, std::size_t size);
+
+  // Attributes
+  Value root() const;
+
+ private:
+  xml::Document document_;
+};
+
+// Associates the key of a dictionary with a member of an object. A tuple of
+// bindings is a table that read() resolves at compile time, so that reading
+// a dictionary takes one pass over its entries without building nodes.
+template <class Object, class Member>
+class Binding final {
+ public:
+  constexpr Binding(const char *key, Member Object::*member)
+      : key(key),
+        member(member) {}
+
+ public:
+  const char *key;
+  Member Object::*member;
+};
+
+template <class Object, class Member>
+constexpr Binding<Object, Member> bind(const char *key,
+                                       Member Object::*member) {
+  return Binding<Object, Member>(key, member);
+}
+
+// Values, which are left as they are and false is returned when the types
+// don't match
+bool read(const Value& value, bool *output);
+bool read(const Value& value, std::string *output);
+template <
+  class T,
+  std::enable_if_t<std::is_arithmetic<T>::value> * = nullptr
+>
+bool read(const Value& value, T *output);
+template <
+  class T,
+  std::enable_if_t<std::is_constructible<T, const Value&>::value> * = nullptr
+>
+bool read(const Value& value, T *output);
+template <class T>
+bool read(const Value& value, Optional<T> *output);
+template <class T>
+bool read(const Value& value, std::vector<T> *output);
+
+// Dictionaries
+template <class Object, class... Members>
+void read(const Value& dictionary,
+          const std::tuple<Binding<Object, Members>...>& bindings,
+          Object *object);
+
+// MARK: -
+
+inline Value::Value(const xml::Element& element) : element_(element) {}
+
+inline Document::Document(const char *data, std::size_t size) {
+  parse(data, size);
+}
+
+// MARK: Dictionaries
+
+template <class Function>
+inline void Value::forEachEntry(Function function) const {
+  if (type() != Type::DICTIONARY) {
+    return;
+  }
+  for (auto key = element_.firstChild("key"); key;
+       key = key.nextSibling("key")) {
+    const auto value = key.nextSibling();
+    if (!value) {
+      break;
+    }
+    function(Value(key), Value(value));
+    key = value;
+  }
+}
+
+// MARK: Arrays
+
+template <class Function>
+inline void Value::forEachItem(Function function) const {
+  if (type() != Type::ARRAY) {
+    return;
+  }
+  for (auto item = element_.firstChild(); item; item = item.nextSibling()) {
+    function(Value(item));
+  }
+}
+
+// MARK: Values
+
+inline bool read(const Value& value, bool *output) {
+  assert(output);
+  if (value.type() != Value::Type::BOOLEAN) {
+    return false;
+  }
+  *output = value.boolean();
+  return true;
+}
+
+inline bool read(const Value& value, std::string *output) {
+  assert(output);
+  if (value.type() != Value::Type::STRING) {
+    return false;
+  }
+  *output = value.string();
+  return true;
+}
+
+template <
+  class T,
+  std::enable_if_t<std::is_arithmetic<T>::value> *
+>
+inline bool read(const Value& value, T *output) {
+  assert(output);
+  const auto type = value.type();
+  if (type == Value::Type::INTEGER) {
+    *output = static_cast<T>(value.integer());
+  } else if (type == Value::Type::REAL) {
+    *output = static_cast<T>(value.real());
+  } else {
+    return false;
+  }
+  return true;
+}
+
+template <
+  class T,
+  std::enable_if_t<std::is_constructible<T, const Value&>::value> *
+>
+inline bool read(const Value& value, T *output) {
+  assert(output);
+  if (value.type() != Value::Type::DICTIONARY) {
+    return false;
+  }
+  *output = T(value);
+  return true;
+}
+
+template <class T>
+inline bool read(const Value& value, Optional<T> *output) {
+  assert(output);
+  T result{};
+  if (!read(value, &result)) {
+    return false;
+  }
+  *output = std::move(result);
+  return true;
+}
+
+template <class T>
+inline bool read(const Value& value, std::vector<T> *output) {
+  assert(output);
+  if (value.type() != Value::Type::ARRAY) {
+    return false;
+  }
+  output->clear();
+  value.forEachItem([output](const Value& item) {
+    T result{};
+    if (read(item, &result)) {
+      output->emplace_back(std::move(result));
+    }
+  });
+  return true;
+}
+
+// MARK: Dictionaries
+
+namespace detail {
+
+template <class Object, class Tuple>
+inline bool readEntry(const Value&,
+                      const Value&,
+                      const Tuple&,
+                      Object *,
+                      std::index_sequence<>) {
+  return false;
+}
+
+template <class Object, class Tuple, std::size_t Index, std::size_t... Rest>
+inline bool readEntry(const Value& key,
+                      const Value& value,
+                      const Tuple& bindings,
+                      Object *object,
+                      std::index_sequence<Index, Rest...>) {
+  const auto& binding = std::get<Index>(bindings);
+  if (key.equals(binding.key)) {
+    read(value, &(object->*binding.member));
+    return true;
+  }
+  return readEntry(key, value, bindings, object,
+                   std::index_sequence<Rest...>());
+}
+
+}  // namespace detail
+
+template <class Object, class... Members>
+inline void read(const Value& dictionary,
+                 const std::tuple<Binding<Object, Members>...>& bindings,
+                 Object *object) {
+  assert(object);
+  dictionary.forEachEntry([&bindings, object](const Value& key,
+                                              const Value& value) {
+    detail::readEntry(key, value, bindings, object,
+                      std::index_sequence_for<Members...>());
+  });
+}
+
+}  // namespace plist
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_PLIST_READER_H_
@@ -10,9 +10,9 @@ extern "C" {
 }  // extern "C"
 
 #include <cassert>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
-#include <iterator>
 #include <ostream>
 #include <string>
 
@@ -21,18 +21,6 @@ namespace ufo {
 
 PropertyList::PropertyList() : plist_(plist_new_dict()), owner_(true) {}
 
-PropertyList::PropertyList(std::istream& stream) : plist_(), owner_() {
-  assert(stream.good());
-  const std::istreambuf_iterator<char> first(stream);
-  const std::string contents(first, std::istreambuf_iterator<char>());
-  plist_t node{};
-  plist_from_xml(contents.c_str(), contents.size(), &node);
-  assert(node);
-  assert(plist_get_node_type(node) == PLIST_DICT);
-  plist_ = node;
-  owner_ = true;
-}
-
 PropertyList::PropertyList(void *plist, bool owner)
     : plist_(plist),
       owner_(owner) {
@@ -5,7 +5,7 @@
 #ifndef TOKEN_UFO_PROPERTY_LIST_H_
 #define TOKEN_UFO_PROPERTY_LIST_H_
 
-#include <istream>
+#include <cstddef>
 #include <ostream>
 #include <utility>
 
@@ -15,7 +15,6 @@ namespace ufo {
 class PropertyList final {
  public:
   PropertyList();
-  explicit PropertyList(std::istream& stream);
   explicit PropertyList(void *plist, bool owner = true);
   ~PropertyList();
 
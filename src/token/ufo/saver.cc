@@ -0,0 +1,301 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/saver.h"
+
+#include <sys/stat.h>
+
+#if __APPLE__
+#include <sys/clonefile.h>
+#endif  // __APPLE__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <ios>
+#include <iterator>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "token/hash.h"
+
+namespace token {
+namespace ufo {
+
+namespace {
+
+// Writes to a temporary file and moves it into place. This never writes
+// through a hard link into the source, and a reader never sees a partially
+// written file.
+bool replace(const boost::filesystem::path& path,
+             const std::string& contents) {
+  boost::system::error_code error;
+  boost::filesystem::create_directories(path.parent_path(), error);
+  const auto temporary = path.string() + ".tmp";
+  {
+    std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+    stream.write(contents.data(), contents.size());
+    if (!stream.good()) {
+      return false;
+    }
+  }
+  boost::filesystem::rename(temporary, path, error);
+  if (error) {
+    boost::filesystem::remove(temporary, error);
+    return false;
+  }
+  return true;
+}
+
+// Whether the target is the clone of the source, which keeps the size and
+// the modification time of the source until either of them changes.
+bool isCloneOf(const boost::filesystem::path& target,
+               const boost::filesystem::path& source) {
+  namespace fs = boost::filesystem;
+  boost::system::error_code error;
+  const auto source_size = fs::file_size(source, error);
+  if (error) {
+    return false;
+  }
+  const auto target_size = fs::file_size(target, error);
+  if (error || target_size != source_size) {
+    return false;
+  }
+  const auto source_time = fs::last_write_time(source, error);
+  if (error) {
+    return false;
+  }
+  const auto target_time = fs::last_write_time(target, error);
+  return !error && target_time == source_time;
+}
+
+}  // namespace
+
+const char * const Saver::manifest_name =
+    "data/com.shotamatsuda.token.manifest";
+
+Saver::Saver(const std::string& source, const std::string& path)
+    : source_(source),
+      path_(path),
+      written_() {
+  readManifest();
+}
+
+// MARK: Saving
+
+bool Saver::write(const std::string& name, const std::string& contents) {
+  Entry entry{hash(contents.data(), contents.size()), contents.size(), 0, 0};
+  Entry previous{};
+  bool found{};
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const auto itr = previous_.find(name);
+    found = itr != std::end(previous_);
+    if (found) {
+      previous = itr->second;
+    }
+  }
+  const auto path = boost::filesystem::path(path_) / name;
+  if (found && previous.hash == entry.hash) {
+    // Still write the file if it was removed, modified or replaced in the
+    // meantime. The size is of the file as it was last recorded, which the
+    // tools may have changed.
+    Entry existing{};
+    if (readStatus(path.string(), &existing) &&
+        existing.size == previous.size &&
+        existing.time == previous.time &&
+        existing.inode == previous.inode) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      current_[name] = previous;
+      return true;
+    }
+  }
+  if (!replace(path, contents)) {
+    return false;
+  }
+  // A file whose status can't be read is recorded without it, which makes
+  // the next save write it again.
+  readStatus(path.string(), &entry);
+  std::lock_guard<std::mutex> lock(mutex_);
+  current_[name] = entry;
+  ++written_;
+  return true;
+}
+
+bool Saver::commit() {
+  namespace fs = boost::filesystem;
+  std::lock_guard<std::mutex> lock(mutex_);
+  boost::system::error_code error;
+
+  // Remove the generated files of the previous save that are not generated
+  // anymore, before linking the source files that may replace them.
+  for (const auto& pair : previous_) {
+    if (!current_.count(pair.first)) {
+      fs::remove(fs::path(path_) / pair.first, error);
+    }
+  }
+  error.clear();
+  const fs::path source(source_);
+  auto prefix = source.generic_string().size();
+  if (prefix && source.generic_string().back() != '/') {
+    ++prefix;
+  }
+  for (fs::recursive_directory_iterator itr(source, error), end;
+       !error && itr != end; itr.increment(error)) {
+    if (!fs::is_regular_file(itr->status())) {
+      continue;
+    }
+    const auto name = itr->path().generic_string().substr(prefix);
+    if (name == manifest_name || current_.count(name)) {
+      continue;  // Generated by this save
+    }
+    if (!clone(name)) {
+      return false;
+    }
+  }
+  if (error) {
+    return false;
+  }
+
+  // Remove the files left by earlier saves that are neither generated by
+  // this save nor in the source anymore, such as the glyphs removed from the
+  // source. The data directory is left to the tools.
+  const fs::path target(path_);
+  prefix = target.generic_string().size();
+  if (prefix && target.generic_string().back() != '/') {
+    ++prefix;
+  }
+  std::vector<fs::path> stale;
+  for (fs::recursive_directory_iterator itr(target, error), end;
+       !error && itr != end; itr.increment(error)) {
+    if (!fs::is_regular_file(itr->status())) {
+      continue;
+    }
+    const auto name = itr->path().generic_string().substr(prefix);
+    if (name.compare(0, 5, "data/") && !current_.count(name) &&
+        !fs::exists(source / name)) {
+      stale.emplace_back(itr->path());
+    }
+  }
+  if (error) {
+    return false;
+  }
+  for (const auto& path : stale) {
+    fs::remove(path, error);
+  }
+  if (!writeManifest()) {
+    return false;
+  }
+  previous_ = current_;
+  return true;
+}
+
+bool Saver::record(const std::string& path) {
+  // Files whose status can't be read keep the status they were written
+  // with, which doesn't match them anymore.
+  Saver saver(std::string(), path);
+  if (saver.previous_.empty()) {
+    return false;  // Not saved by a saver
+  }
+  for (auto& pair : saver.previous_) {
+    readStatus((boost::filesystem::path(path) / pair.first).string(),
+               &pair.second);
+  }
+  saver.current_ = saver.previous_;
+  return saver.writeManifest();
+}
+
+bool Saver::clone(const std::string& name) const {
+  namespace fs = boost::filesystem;
+  const auto source = fs::path(source_) / name;
+  const auto target = fs::path(path_) / name;
+  boost::system::error_code error;
+  if (fs::exists(target, error)) {
+    if (isCloneOf(target, source)) {
+      return true;
+    }
+    fs::remove(target, error);
+    if (error) {
+      return false;
+    }
+  }
+  fs::create_directories(target.parent_path(), error);
+  if (error) {
+    return false;
+  }
+#if __APPLE__
+  // The deployment target predates clonefile, which is weakly linked and
+  // null on older systems. They fall back to copying.
+  if (__builtin_available(macOS 10.12, *)) {
+    if (!clonefile(source.c_str(), target.c_str(), 0)) {
+      return true;
+    }
+  }
+#endif  // __APPLE__
+  fs::copy_file(source, target, fs::copy_option::overwrite_if_exists, error);
+  if (error) {
+    return false;
+  }
+  // Copies take the modification time of the source as clones do, so that
+  // a copy modified later is told apart from the source.
+  const auto time = fs::last_write_time(source, error);
+  if (error) {
+    return false;
+  }
+  fs::last_write_time(target, time, error);
+  return !error;
+}
+
+// MARK: Manifest
+
+bool Saver::readStatus(const std::string& path, Entry *entry) {
+  struct stat status;
+  if (::stat(path.c_str(), &status)) {
+    return false;
+  }
+#if __APPLE__
+  const auto& time = status.st_mtimespec;
+#else
+  const auto& time = status.st_mtim;
+#endif  // __APPLE__
+  entry->size = static_cast<std::uint64_t>(status.st_size);
+  entry->time = static_cast<std::int64_t>(time.tv_sec) * 1000000000 +
+                time.tv_nsec;
+  entry->inode = static_cast<std::uint64_t>(status.st_ino);
+  return true;
+}
+
+void Saver::readManifest() {
+  std::ifstream stream((boost::filesystem::path(path_) /
+                        manifest_name).string());
+  std::string name;
+  Entry entry{};
+  while (stream >> std::hex >> entry.hash >> std::dec >> entry.size >>
+                   entry.time >> entry.inode &&
+         stream.get() == ' ' && std::getline(stream, name)) {
+    previous_[name] = entry;
+  }
+}
+
+bool Saver::writeManifest() const {
+  std::string contents;
+  for (const auto& pair : current_) {
+    char line[96];
+    std::snprintf(line, sizeof(line), "%016llx %llu %lld %llu ",
+                  static_cast<unsigned long long>(pair.second.hash),
+                  static_cast<unsigned long long>(pair.second.size),
+                  static_cast<long long>(pair.second.time),
+                  static_cast<unsigned long long>(pair.second.inode));
+    contents += line;
+    contents += pair.first;
+    contents += '\n';
+  }
+  return replace(boost::filesystem::path(path_) / manifest_name, contents);
+}
+
+}  // namespace ufo
+}  // namespace token
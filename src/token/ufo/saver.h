@@ -0,0 +1,84 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_SAVER_H_
+#define TOKEN_UFO_SAVER_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace token {
+namespace ufo {
+
+// Saves a UFO derived from a source UFO into a directory that may contain a
+// previous save. Generated files are compared by their content hashes with
+// the manifest written by the previous save, and only the ones that changed
+// are written. The manifest also records the size, modification time and
+// inode of each file as written, so that a file modified or replaced since
+// by the tools that run on the saved UFO is written again. The other files
+// of the source are cloned, or copied where the file system doesn't support
+// cloning. They are not hard linked, because the tools that run on the saved
+// UFO may modify files in place. Once they have, the status of the files as
+// the tools left them is recorded in the manifest, so that the next save
+// only writes the files that changed since.
+class Saver final {
+ public:
+  Saver(const std::string& source, const std::string& path);
+
+  // Disallow copy semantics
+  Saver(const Saver&) = delete;
+  Saver& operator=(const Saver&) = delete;
+
+  // Saving
+  bool write(const std::string& name, const std::string& contents);
+  bool commit();
+
+  // Records the status of the files of the previous save to the path as they
+  // are now, after the tools have run on them.
+  static bool record(const std::string& path);
+
+  // Attributes
+  const std::string& source() const { return source_; }
+  const std::string& path() const { return path_; }
+  std::size_t number_of_written_files() const;
+
+ private:
+  struct Entry final {
+    std::uint64_t hash;
+    std::uint64_t size;
+    std::int64_t time;  // In nanoseconds
+    std::uint64_t inode;
+  };
+
+  static bool readStatus(const std::string& path, Entry *entry);
+  void readManifest();
+  bool writeManifest() const;
+  bool clone(const std::string& name) const;
+
+ public:
+  static const char * const manifest_name;
+
+ private:
+  std::string source_;
+  std::string path_;
+  std::map<std::string, Entry> previous_;
+  std::map<std::string, Entry> current_;
+  std::size_t written_;
+  mutable std::mutex mutex_;
+};
+
+// MARK: -
+
+inline std::size_t Saver::number_of_written_files() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return written_;
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_SAVER_H_
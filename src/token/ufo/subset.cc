@@ -0,0 +1,98 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/subset.h"
+
+#include <cstddef>
+#include <iterator>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "token/ufo/glyph.h"
+#include "token/ufo/glyph_index.h"
+#include "token/ufo/glyphs.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace ufo {
+
+// MARK: Glyphs
+
+std::vector<std::string> Subset::names() const {
+  std::vector<std::string> result;
+  result.reserve(glyphs_.size());
+  for (const auto& glyph : glyphs_) {
+    result.emplace_back(glyph.second);
+  }
+  return result;
+}
+
+void Subset::addText(const Glyphs& glyphs,
+                     const GlyphIndex& index,
+                     const std::string& text) {
+  for (const auto id : index.find(text)) {
+    add(glyphs, index[id].name);
+  }
+}
+
+void Subset::add(const Glyphs& glyphs, const std::string& name) {
+  std::vector<std::string> stack{name};
+  while (!stack.empty()) {
+    const auto id = glyphs.id(stack.back());
+    stack.pop_back();
+    if (id == Glyphs::npos || !glyphs_.emplace(id, glyphs.name(id)).second) {
+      continue;
+    }
+    names_.emplace(glyphs.name(id));
+    const auto glyph = glyphs.find(id);
+    if (glyph && glyph->outline.exists()) {
+      for (const auto& component : glyph->outline->components) {
+        stack.emplace_back(component.base);
+      }
+    }
+  }
+}
+
+// MARK: Pruning
+
+Groups Subset::groups(const Groups& groups) const {
+  Groups result;
+  for (const auto& group : groups) {
+    Groups::Members members;
+    for (const auto& member : group.second) {
+      if (contains(member)) {
+        members.emplace_back(member);
+      }
+    }
+    if (!members.empty()) {
+      result.set(group.first, members);
+    }
+  }
+  return result;
+}
+
+Kerning Subset::kerning(const Kerning& kerning, const Groups& groups) const {
+  const auto pruned_groups = this->groups(groups);
+  const auto included = [this, &groups, &pruned_groups](
+      const std::string& name) {
+    return groups.find(name) ? pruned_groups.find(name) != nullptr
+                             : contains(name);
+  };
+  Kerning result;
+  for (const auto& first : kerning) {
+    if (!included(first.first)) {
+      continue;
+    }
+    for (const auto& second : first.second) {
+      if (included(second.first)) {
+        result.set(first.first, second.first, second.second);
+      }
+    }
+  }
+  return result;
+}
+
+}  // namespace ufo
+}  // namespace token
@@ -0,0 +1,81 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_SUBSET_H_
+#define TOKEN_UFO_SUBSET_H_
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "token/ufo/glyph_index.h"
+#include "token/ufo/glyphs.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace ufo {
+
+// The glyphs of a font needed to render a text, which are the glyphs whose
+// unicodes appear in the text, .notdef, and the glyphs they refer to as
+// components recursively. Characters are looked up in the glyph index, so
+// that only the glyphs in the subset are parsed. Kerning and groups can be
+// pruned to the subset so that compiling them costs as much as the subset.
+class Subset final {
+ public:
+  Subset() = default;
+  Subset(const Glyphs& glyphs,
+         const GlyphIndex& index,
+         const std::string& text);
+
+  // Copy semantics
+  Subset(const Subset&) = default;
+  Subset& operator=(const Subset&) = default;
+
+  // Glyphs
+  bool empty() const { return glyphs_.empty(); }
+  std::size_t size() const { return glyphs_.size(); }
+  bool contains(const std::string& name) const;
+  // The names of the glyphs in the order of the font.
+  std::vector<std::string> names() const;
+
+  // Adds the glyphs of the characters in the UTF-8 text, or the glyph of the
+  // name, along with the glyphs they refer to.
+  void addText(const Glyphs& glyphs,
+               const GlyphIndex& index,
+               const std::string& text);
+  void add(const Glyphs& glyphs, const std::string& name);
+
+  // Pruning
+  // Groups only have the members in the subset, and the ones left empty are
+  // removed. Kerning only has the pairs whose both sides are glyphs in the
+  // subset or groups that have members in the subset.
+  Groups groups(const Groups& groups) const;
+  Kerning kerning(const Kerning& kerning, const Groups& groups) const;
+
+ private:
+  std::map<std::size_t, std::string> glyphs_;
+  std::unordered_set<std::string> names_;
+};
+
+// MARK: -
+
+inline Subset::Subset(const Glyphs& glyphs,
+                      const GlyphIndex& index,
+                      const std::string& text) {
+  add(glyphs, ".notdef");
+  addText(glyphs, index, text);
+}
+
+inline bool Subset::contains(const std::string& name) const {
+  return names_.find(name) != std::end(names_);
+}
+
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_SUBSET_H_
@@ -3,18 +3,30 @@
 
 #include "token/ufo/woff/metadata/copyright.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("text", &Copyright::text));
+
+}  // namespace
+
 // MARK: Property list
 
-Copyright::Copyright(const PropertyList& plist) {
-  plist::readVector(plist, "text", &text);
+Copyright::Copyright(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Copyright::plist() const {
@@ -23,6 +35,13 @@ PropertyList Copyright::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Copyright::write(xml::Writer *writer) const {
+  assert(writer);
+  xml::writeChildren(writer, "text", text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
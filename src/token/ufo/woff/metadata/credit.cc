@@ -3,21 +3,33 @@
 
 #include "token/ufo/woff/metadata/credit.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("name", &Credit::name),
+    plist::bind("url", &Credit::url),
+    plist::bind("dir", &Credit::dir),
+    plist::bind("class", &Credit::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-Credit::Credit(const PropertyList& plist) {
-  plist::readString(plist, "name", &name);
-  plist::readString(plist, "url", &url);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+Credit::Credit(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Credit::plist() const {
@@ -29,6 +41,16 @@ PropertyList Credit::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Credit::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("name", name);
+  writer->attribute("url", url, "");
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
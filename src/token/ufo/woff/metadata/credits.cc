@@ -3,18 +3,30 @@
 
 #include "token/ufo/woff/metadata/credits.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("credits", &Credits::credits));
+
+}  // namespace
+
 // MARK: Property list
 
-Credits::Credits(const PropertyList& plist) {
-  plist::readVector(plist, "credits", &credits);
+Credits::Credits(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Credits::plist() const {
@@ -23,6 +35,13 @@ PropertyList Credits::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Credits::write(xml::Writer *writer) const {
+  assert(writer);
+  xml::writeChildren(writer, "credit", credits);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -7,8 +7,10 @@
 
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff/metadata/credit.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -24,9 +26,12 @@ class Credits final {
   Credits& operator=(const Credits&) = default;
 
   // Property list
-  explicit Credits(const PropertyList& plist);
+  explicit Credits(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::vector<Credit> credits;
 };
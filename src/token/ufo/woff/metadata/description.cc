@@ -3,19 +3,31 @@
 
 #include "token/ufo/woff/metadata/description.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("url", &Description::url),
+    plist::bind("text", &Description::text));
+
+}  // namespace
+
 // MARK: Property list
 
-Description::Description(const PropertyList& plist) {
-  plist::readString(plist, "url", &url);
-  plist::readVector(plist, "text", &text);
+Description::Description(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Description::plist() const {
@@ -25,6 +37,14 @@ PropertyList Description::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Description::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("url", url, "");
+  xml::writeChildren(writer, "text", text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
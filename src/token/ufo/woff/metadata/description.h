@@ -8,8 +8,10 @@
 #include <string>
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff/metadata/text.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -25,9 +27,12 @@ class Description final {
   Description& operator=(const Description&) = default;
 
   // Property list
-  explicit Description(const PropertyList& plist);
+  explicit Description(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::string url;
   std::vector<Text> text;
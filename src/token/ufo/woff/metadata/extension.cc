@@ -3,20 +3,32 @@
 
 #include "token/ufo/woff/metadata/extension.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("identifier", &Extension::identifier),
+    plist::bind("names", &Extension::names),
+    plist::bind("items", &Extension::items));
+
+}  // namespace
+
 // MARK: Property list
 
-Extension::Extension(const PropertyList& plist) {
-  plist::readString(plist, "identifier", &identifier);
-  plist::readVector(plist, "names", &names);
-  plist::readVector(plist, "items", &items);
+Extension::Extension(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Extension::plist() const {
@@ -27,6 +39,15 @@ PropertyList Extension::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Extension::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("id", identifier, "");
+  xml::writeChildren(writer, "name", names);
+  xml::writeChildren(writer, "item", items);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
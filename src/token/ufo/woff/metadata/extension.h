@@ -8,9 +8,11 @@
 #include <string>
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff/metadata/extension_item.h"
 #include "token/ufo/woff/metadata/extension_name.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -26,9 +28,12 @@ class Extension final {
   Extension& operator=(const Extension&) = default;
 
   // Property list
-  explicit Extension(const PropertyList& plist);
+  explicit Extension(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::string identifier;
   std::vector<ExtensionName> names;
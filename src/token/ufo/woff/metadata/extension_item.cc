@@ -3,20 +3,32 @@
 
 #include "token/ufo/woff/metadata/extension_item.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("identifier", &ExtensionItem::identifier),
+    plist::bind("names", &ExtensionItem::names),
+    plist::bind("values", &ExtensionItem::values));
+
+}  // namespace
+
 // MARK: Property list
 
-ExtensionItem::ExtensionItem(const PropertyList& plist) {
-  plist::readString(plist, "identifier", &identifier);
-  plist::readVector(plist, "names", &names);
-  plist::readVector(plist, "values", &values);
+ExtensionItem::ExtensionItem(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList ExtensionItem::plist() const {
@@ -27,6 +39,15 @@ PropertyList ExtensionItem::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void ExtensionItem::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("id", identifier, "");
+  xml::writeChildren(writer, "name", names);
+  xml::writeChildren(writer, "value", values);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -8,9 +8,11 @@
 #include <string>
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff/metadata/extension_name.h"
 #include "token/ufo/woff/metadata/extension_value.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -26,9 +28,12 @@ class ExtensionItem final {
   ExtensionItem& operator=(const ExtensionItem&) = default;
 
   // Property list
-  explicit ExtensionItem(const PropertyList& plist);
+  explicit ExtensionItem(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::string identifier;
   std::vector<ExtensionName> names;
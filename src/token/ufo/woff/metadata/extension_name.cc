@@ -3,21 +3,33 @@
 
 #include "token/ufo/woff/metadata/extension_name.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("text", &ExtensionName::text),
+    plist::bind("language", &ExtensionName::language),
+    plist::bind("dir", &ExtensionName::dir),
+    plist::bind("class", &ExtensionName::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-ExtensionName::ExtensionName(const PropertyList& plist) {
-  plist::readString(plist, "text", &text);
-  plist::readString(plist, "language", &language);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+ExtensionName::ExtensionName(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList ExtensionName::plist() const {
@@ -29,6 +41,16 @@ PropertyList ExtensionName::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void ExtensionName::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("lang", language, "");
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+  writer->text(text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -7,7 +7,9 @@
 
 #include <string>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -23,9 +25,12 @@ class ExtensionName final {
   ExtensionName& operator=(const ExtensionName&) = default;
 
   // Property list
-  explicit ExtensionName(const PropertyList& plist);
+  explicit ExtensionName(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::string text;
   std::string language;
@@ -3,21 +3,33 @@
 
 #include "token/ufo/woff/metadata/extension_value.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("text", &ExtensionValue::text),
+    plist::bind("language", &ExtensionValue::language),
+    plist::bind("dir", &ExtensionValue::dir),
+    plist::bind("class", &ExtensionValue::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-ExtensionValue::ExtensionValue(const PropertyList& plist) {
-  plist::readString(plist, "text", &text);
-  plist::readString(plist, "language", &language);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+ExtensionValue::ExtensionValue(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList ExtensionValue::plist() const {
@@ -29,6 +41,16 @@ PropertyList ExtensionValue::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void ExtensionValue::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("lang", language, "");
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+  writer->text(text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -3,20 +3,32 @@
 
 #include "token/ufo/woff/metadata/license.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("url", &License::url),
+    plist::bind("identifier", &License::identifier),
+    plist::bind("text", &License::text));
+
+}  // namespace
+
 // MARK: Property list
 
-License::License(const PropertyList& plist) {
-  plist::readString(plist, "url", &url);
-  plist::readString(plist, "identifier", &identifier);
-  plist::readVector(plist, "text", &text);
+License::License(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList License::plist() const {
@@ -27,6 +39,15 @@ PropertyList License::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void License::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("url", url, "");
+  writer->attribute("id", identifier, "");
+  xml::writeChildren(writer, "text", text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
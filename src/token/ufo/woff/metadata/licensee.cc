@@ -3,20 +3,32 @@
 
 #include "token/ufo/woff/metadata/licensee.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("name", &Licensee::name),
+    plist::bind("dir", &Licensee::dir),
+    plist::bind("class", &Licensee::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-Licensee::Licensee(const PropertyList& plist) {
-  plist::readString(plist, "name", &name);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+Licensee::Licensee(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Licensee::plist() const {
@@ -27,6 +39,15 @@ PropertyList Licensee::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Licensee::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("name", name);
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
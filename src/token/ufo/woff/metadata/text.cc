@@ -3,21 +3,33 @@
 
 #include "token/ufo/woff/metadata/text.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("text", &Text::text),
+    plist::bind("language", &Text::language),
+    plist::bind("dir", &Text::dir),
+    plist::bind("class", &Text::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-Text::Text(const PropertyList& plist) {
-  plist::readString(plist, "text", &text);
-  plist::readString(plist, "language", &language);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+Text::Text(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Text::plist() const {
@@ -29,6 +41,16 @@ PropertyList Text::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Text::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("lang", language, "");
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+  writer->text(text);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -7,8 +7,10 @@
 
 #include <vector>
 
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
 #include "token/ufo/woff/metadata/text.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
@@ -24,9 +26,12 @@ class Trademark final {
   Trademark& operator=(const Trademark&) = default;
 
   // Property list
-  explicit Trademark(const PropertyList& plist);
+  explicit Trademark(const plist::Value& value);
   PropertyList plist() const;
 
+  // XML writer
+  void write(xml::Writer *writer) const;
+
  public:
   std::vector<Text> text;
 };
@@ -3,18 +3,30 @@
 
 #include "token/ufo/woff/metadata/unique_id.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("identifier", &UniqueID::identifier));
+
+}  // namespace
+
 // MARK: Property list
 
-UniqueID::UniqueID(const PropertyList& plist) {
-  plist::readString(plist, "identifier", &identifier);
+UniqueID::UniqueID(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList UniqueID::plist() const {
@@ -23,6 +35,13 @@ PropertyList UniqueID::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void UniqueID::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("id", identifier);
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
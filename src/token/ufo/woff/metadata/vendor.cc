@@ -3,21 +3,33 @@
 
 #include "token/ufo/woff/metadata/vendor.h"
 
+#include <cassert>
+#include <tuple>
+
 #include "token/ufo/plist.h"
+#include "token/ufo/plist_reader.h"
 #include "token/ufo/property_list.h"
+#include "token/ufo/xml_writer.h"
 
 namespace token {
 namespace ufo {
 namespace woff {
 namespace metadata {
 
+namespace {
+
+constexpr auto kBindings = std::make_tuple(
+    plist::bind("name", &Vendor::name),
+    plist::bind("url", &Vendor::url),
+    plist::bind("dir", &Vendor::dir),
+    plist::bind("class", &Vendor::klass));
+
+}  // namespace
+
 // MARK: Property list
 
-Vendor::Vendor(const PropertyList& plist) {
-  plist::readString(plist, "name", &name);
-  plist::readString(plist, "url", &url);
-  plist::readString(plist, "dir", &dir);
-  plist::readString(plist, "class", &klass);
+Vendor::Vendor(const plist::Value& value) {
+  plist::read(value, kBindings, this);
 }
 
 PropertyList Vendor::plist() const {
@@ -29,6 +41,16 @@ PropertyList Vendor::plist() const {
   return plist;
 }
 
+// MARK: XML writer
+
+void Vendor::write(xml::Writer *writer) const {
+  assert(writer);
+  writer->attribute("name", name);
+  writer->attribute("url", url, "");
+  writer->attribute("dir", dir, "");
+  writer->attribute("class", klass, "");
+}
+
 }  // namespace metadata
 }  // namespace woff
 }  // namespace ufo
@@ -6,113 +6,74 @@
 #define TOKEN_UFO_XML_H_
 
 #include <cassert>
+#include <cstdlib>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
-#include <boost/property_tree/ptree.hpp>
+#include <boost/utility/string_ref.hpp>
 
 #include "token/ufo/optional.h"
+#include "token/ufo/xml_reader.h"
 
 namespace token {
 namespace ufo {
 namespace xml {
 
-template <class T>
-inline void readAttribute(const boost::property_tree::ptree& tree,
-                          const std::string& name,
+template <
+  class T,
+  std::enable_if_t<std::is_arithmetic<T>::value> * = nullptr
+>
+inline void readAttribute(const Element& element,
+                          boost::string_ref name,
                           T *output) {
   assert(output);
-  const auto attrs = tree.find("<xmlattr>");
-  if (attrs != tree.not_found()) {
-    const auto itr = attrs->second.find(name);
-    if (itr != attrs->second.not_found()) {
-      *output = itr->second.get_value<T>();
-    }
+  boost::string_ref value;
+  if (element.attribute(name, &value)) {
+    // Values are always followed by their closing quotes, which stop the
+    // conversion without copying them.
+    *output = static_cast<T>(std::strtod(value.data(), nullptr));
   }
 }
 
+inline void readAttribute(const Element& element,
+                          boost::string_ref name,
+                          std::string *output) {
+  assert(output);
+  element.attribute(name, output);
+}
+
 template <class T>
-inline void readChild(const boost::property_tree::ptree& tree,
-                      const std::string& name,
+inline void readChild(const Element& element,
+                      boost::string_ref name,
                       T *output) {
   assert(output);
-  const auto itr = tree.find(name);
-  if (itr != tree.not_found()) {
-    *output = T(itr->second);
+  const auto child = element.firstChild(name);
+  if (child) {
+    *output = T(child);
   }
 }
 
 template <class T>
-inline void readChild(const boost::property_tree::ptree& tree,
-                      const std::string& name,
+inline void readChild(const Element& element,
+                      boost::string_ref name,
                       Optional<T> *output) {
   assert(output);
-  const auto itr = tree.find(name);
-  if (itr != tree.not_found()) {
-    *output = T(itr->second);
+  const auto child = element.firstChild(name);
+  if (child) {
+    *output = T(child);
   }
 }
 
 template <class T>
-inline void readChildren(const boost::property_tree::ptree& tree,
-                         const std::string& name,
+inline void readChildren(const Element& element,
+                         boost::string_ref name,
                          std::vector<T> *output) {
   assert(output);
-  const auto values = tree.find(name);
-  if (values != tree.not_found()) {
-    auto end = values;
-    std::advance(end, tree.count(name));
-    for (auto itr = values; itr != end; ++itr) {
-      output->emplace_back(itr->second);
-    }
-  }
-}
-
-template <class T>
-inline void writeAttribute(boost::property_tree::ptree *tree,
-                           const std::string& name,
-                           const T& value) {
-  assert(tree);
-  tree->put("<xmlattr>." + name, value);
-}
-
-template <class T, class U>
-inline void writeAttribute(boost::property_tree::ptree *tree,
-                           const std::string& name,
-                           const T& value,
-                           const U& default_value) {
-  assert(tree);
-  if (value != default_value) {
-    tree->put("<xmlattr>." + name, value);
-  }
-}
-
-template <class T>
-inline void writeChild(boost::property_tree::ptree *tree,
-                       const std::string& name,
-                       const T& value) {
-  assert(tree);
-  tree->add_child(name, value.ptree());
-}
-
-template <class T>
-inline void writeChild(boost::property_tree::ptree *tree,
-                       const std::string& name,
-                       const Optional<T>& value) {
-  assert(tree);
-  if (value.exists()) {
-    tree->add_child(name, value->ptree());
-  }
-}
-
-template <class T>
-inline void writeChildren(boost::property_tree::ptree *tree,
-                          const std::string& name,
-                          const std::vector<T>& values) {
-  assert(tree);
-  for (const auto& value : values) {
-    tree->add_child(name, value.ptree());
+  for (auto child = element.firstChild(name); child;
+       child = child.nextSibling(name)) {
+    output->emplace_back(child);
   }
 }
 
@@ -0,0 +1,240 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/xml_reader.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+namespace {
+
+bool isSpace(char c) {
+  return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+bool isNameEnd(char c) {
+  return isSpace(c) || c == '/' || c == '>' || c == '=';
+}
+
+bool startsWith(const char *first, const char *last, const char *prefix) {
+  const auto size = std::strlen(prefix);
+  return (static_cast<std::size_t>(last - first) >= size &&
+          std::equal(prefix, prefix + size, first));
+}
+
+// Returns the position after the token, or nullptr when there's none.
+const char * skipPast(const char *first, const char *last, const char *token) {
+  const auto size = std::strlen(token);
+  const auto result = std::search(first, last, token, token + size);
+  return result == last ? nullptr : result + size;
+}
+
+const char * skipSpaces(const char *first, const char *last) {
+  return std::find_if_not(first, last, isSpace);
+}
+
+const char * skipName(const char *first, const char *last) {
+  return std::find_if(first, last, isNameEnd);
+}
+
+void appendUTF8(std::uint32_t code_point, std::string *output) {
+  assert(output);
+  if (code_point < 0x80) {
+    output->push_back(static_cast<char>(code_point));
+  } else if (code_point < 0x800) {
+    output->push_back(static_cast<char>(0xc0 | (code_point >> 6)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else if (code_point < 0x10000) {
+    output->push_back(static_cast<char>(0xe0 | (code_point >> 12)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  } else if (code_point < 0x110000) {
+    output->push_back(static_cast<char>(0xf0 | (code_point >> 18)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 12) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | ((code_point >> 6) & 0x3f)));
+    output->push_back(static_cast<char>(0x80 | (code_point & 0x3f)));
+  }
+}
+
+}  // namespace
+
+constexpr std::size_t Document::npos;
+
+// MARK: Parsing
+
+bool Document::parse(const char *data, std::size_t size) {
+  assert(data || !size);
+  nodes_.clear();
+  attributes_.clear();
+  std::vector<std::size_t> stack;
+  const auto last = data + size;
+  auto first = data;
+  while ((first = std::find(first, last, '<')) != last) {
+    const auto tag = first++;
+    if (startsWith(first, last, "?")) {
+      first = skipPast(first, last, "?>");
+    } else if (startsWith(first, last, "!--")) {
+      first = skipPast(first, last, "-->");
+    } else if (startsWith(first, last, "![CDATA[")) {
+      first = skipPast(first, last, "]]>");
+    } else if (startsWith(first, last, "!")) {
+      // Document type declarations may have an internal subset.
+      const auto end = std::find(first, last, '>');
+      const auto subset = std::find(first, end, '[');
+      first = subset == end ? end : skipPast(subset, last, "]");
+      first = first ? std::find(first, last, '>') : nullptr;
+      if (first && first != last) {
+        ++first;
+      }
+    } else if (startsWith(first, last, "/")) {
+      const auto name = ++first;
+      first = skipName(first, last);
+      if (stack.empty() ||
+          nodes_[stack.back()].name != boost::string_ref(name, first - name)) {
+        return false;
+      }
+      auto& node = nodes_[stack.back()];
+      const auto content = node.content.data();
+      node.content = boost::string_ref(content, tag - content);
+      stack.pop_back();
+      first = std::find(first, last, '>');
+      if (first != last) {
+        ++first;
+      }
+    } else {
+      const auto name = first;
+      first = skipName(first, last);
+      Node node{};
+      node.name = boost::string_ref(name, first - name);
+      node.first_attribute = attributes_.size();
+      node.first_child = npos;
+      node.last_child = npos;
+      node.next_sibling = npos;
+      for (first = skipSpaces(first, last);
+           first != last && *first != '>' && *first != '/';
+           first = skipSpaces(first, last)) {
+        const auto key = first;
+        first = skipName(first, last);
+        const boost::string_ref attribute(key, first - key);
+        first = skipSpaces(first, last);
+        if (first == last || *first != '=') {
+          return false;
+        }
+        first = skipSpaces(first + 1, last);
+        if (first == last || (*first != '"' && *first != '\'')) {
+          return false;
+        }
+        const auto quote = *first++;
+        const auto value = first;
+        first = std::find(first, last, quote);
+        if (first == last) {
+          return false;
+        }
+        attributes_.emplace_back(attribute,
+                                 boost::string_ref(value, first - value));
+        ++first;
+      }
+      if (first == last) {
+        return false;
+      }
+      node.last_attribute = attributes_.size();
+      const bool closed = *first == '/';
+      first = std::find(first, last, '>');
+      if (first == last) {
+        return false;
+      }
+      ++first;
+      node.content = boost::string_ref(first, 0);
+      const auto index = nodes_.size();
+      if (!stack.empty()) {
+        auto& parent = nodes_[stack.back()];
+        if (parent.last_child == npos) {
+          parent.first_child = index;
+        } else {
+          nodes_[parent.last_child].next_sibling = index;
+        }
+        parent.last_child = index;
+      } else if (index) {
+        return false;  // Multiple root elements
+      }
+      nodes_.emplace_back(node);
+      if (!closed) {
+        stack.emplace_back(index);
+      }
+    }
+    if (!first) {
+      return false;
+    }
+  }
+  return stack.empty() && !nodes_.empty();
+}
+
+// MARK: Decoding
+
+std::string Document::decode(boost::string_ref text) {
+  std::string result;
+  result.reserve(text.size());
+  const auto last = text.end();
+  for (auto first = text.begin(); first != last;) {
+    if (*first == '&') {
+      const auto end = std::find(first, last, ';');
+      if (end == last) {
+        result.append(first, last);
+        break;
+      }
+      const boost::string_ref entity(first + 1, end - first - 1);
+      if (entity == "amp") {
+        result.push_back('&');
+      } else if (entity == "lt") {
+        result.push_back('<');
+      } else if (entity == "gt") {
+        result.push_back('>');
+      } else if (entity == "quot") {
+        result.push_back('"');
+      } else if (entity == "apos") {
+        result.push_back('\'');
+      } else if (entity.starts_with("#x")) {
+        appendUTF8(static_cast<std::uint32_t>(std::strtoul(
+            std::string(entity.substr(2)).c_str(), nullptr, 16)), &result);
+      } else if (entity.starts_with("#")) {
+        appendUTF8(static_cast<std::uint32_t>(std::strtoul(
+            std::string(entity.substr(1)).c_str(), nullptr, 10)), &result);
+      } else {
+        result.append(first, end + 1);
+      }
+      first = end + 1;
+    } else if (*first == '<' && startsWith(first, last, "<![CDATA[")) {
+      const auto contents = first + std::strlen("<![CDATA[");
+      const auto end = skipPast(contents, last, "]]>");
+      if (!end) {
+        result.append(contents, last);
+        break;
+      }
+      result.append(contents, end - std::strlen("]]>"));
+      first = end;
+    } else {
+      const auto end = std::find_if(first, last, [](char c) {
+        return c == '&' || c == '<';
+      });
+      result.append(first, end == first ? end + 1 : end);
+      first = end == first ? end + 1 : end;
+    }
+  }
+  return result;
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token
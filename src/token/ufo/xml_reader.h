@@ -0,0 +1,196 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_XML_READER_H_
+#define TOKEN_UFO_XML_READER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+class Document;
+
+// A handle to an element in a document. Names, attributes and contents refer
+// to the characters of the buffer that the document was parsed from, and
+// are only decoded when they are requested as strings.
+class Element final {
+ public:
+  Element();
+  Element(const Document *document, std::size_t index);
+
+  // Copy semantics
+  Element(const Element&) = default;
+  Element& operator=(const Element&) = default;
+
+  // Attributes
+  explicit operator bool() const { return document_; }
+  boost::string_ref name() const;
+  bool attribute(boost::string_ref name, boost::string_ref *value) const;
+  bool attribute(boost::string_ref name, std::string *value) const;
+
+  // Contents, which are meaningful for elements without children
+  boost::string_ref content() const;
+  std::string text() const;
+
+  // Children
+  Element firstChild() const;
+  Element firstChild(boost::string_ref name) const;
+  Element nextSibling() const;
+  Element nextSibling(boost::string_ref name) const;
+
+ private:
+  const Document *document_;
+  std::size_t index_;
+};
+
+// A non-validating parser that builds a flat array of elements over the
+// buffer instead of copying it into a tree. The buffer must outlive the
+// document and its elements. Processing instructions, comments and document
+// type declarations are skipped.
+class Document final {
+ public:
+  Document() = default;
+  Document(const char *data, std::size_t size);
+
+  // Disallow copy semantics
+  Document(const Document&) = delete;
+  Document& operator=(const Document&) = delete;
+
+  // Parsing
+  bool parse(const char *data, std::size_t size);
+
+  // Attributes
+  bool empty() const { return nodes_.empty(); }
+  Element root() const;
+
+  // Decodes the entity references and character data sections.
+  static std::string decode(boost::string_ref text);
+
+ private:
+  friend class Element;
+
+  static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+  struct Node final {
+    boost::string_ref name;
+    boost::string_ref content;
+    std::size_t first_attribute;
+    std::size_t last_attribute;
+    std::size_t first_child;
+    std::size_t last_child;
+    std::size_t next_sibling;
+  };
+
+  using Attribute = std::pair<boost::string_ref, boost::string_ref>;
+
+ private:
+  std::vector<Node> nodes_;
+  std::vector<Attribute> attributes_;
+};
+
+// MARK: -
+
+inline Element::Element() : document_(), index_() {}
+
+inline Element::Element(const Document *document, std::size_t index)
+    : document_(document),
+      index_(index) {
+  assert(!document_ || index_ < document_->nodes_.size());
+}
+
+inline Document::Document(const char *data, std::size_t size) {
+  parse(data, size);
+}
+
+// MARK: Attributes
+
+inline boost::string_ref Element::name() const {
+  assert(document_);
+  return document_->nodes_[index_].name;
+}
+
+inline bool Element::attribute(boost::string_ref name,
+                               boost::string_ref *value) const {
+  assert(document_);
+  assert(value);
+  const auto& node = document_->nodes_[index_];
+  for (auto i = node.first_attribute; i < node.last_attribute; ++i) {
+    const auto& attribute = document_->attributes_[i];
+    if (attribute.first == name) {
+      *value = attribute.second;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline bool Element::attribute(boost::string_ref name,
+                               std::string *value) const {
+  assert(value);
+  boost::string_ref raw;
+  if (!attribute(name, &raw)) {
+    return false;
+  }
+  *value = Document::decode(raw);
+  return true;
+}
+
+// MARK: Contents
+
+inline boost::string_ref Element::content() const {
+  assert(document_);
+  return document_->nodes_[index_].content;
+}
+
+inline std::string Element::text() const {
+  return Document::decode(content());
+}
+
+// MARK: Children
+
+inline Element Element::firstChild() const {
+  assert(document_);
+  const auto child = document_->nodes_[index_].first_child;
+  return child == Document::npos ? Element() : Element(document_, child);
+}
+
+inline Element Element::firstChild(boost::string_ref name) const {
+  auto child = firstChild();
+  return !child || child.name() == name ? child : child.nextSibling(name);
+}
+
+inline Element Element::nextSibling() const {
+  assert(document_);
+  const auto sibling = document_->nodes_[index_].next_sibling;
+  return sibling == Document::npos ? Element() : Element(document_, sibling);
+}
+
+inline Element Element::nextSibling(boost::string_ref name) const {
+  auto sibling = nextSibling();
+  while (sibling && sibling.name() != name) {
+    sibling = sibling.nextSibling();
+  }
+  return sibling;
+}
+
+// MARK: Attributes
+
+inline Element Document::root() const {
+  return nodes_.empty() ? Element() : Element(this, 0);
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_XML_READER_H_
@@ -0,0 +1,247 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "token/ufo/xml_writer.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <utility>
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+namespace {
+
+std::size_t formatInteger(std::int64_t value, char *buffer) {
+  char digits[20];
+  std::size_t size{};
+  std::uint64_t magnitude = value < 0 ? -static_cast<std::uint64_t>(value)
+                                      : static_cast<std::uint64_t>(value);
+  do {
+    digits[size++] = '0' + magnitude % 10;
+    magnitude /= 10;
+  } while (magnitude);
+  std::size_t length{};
+  if (value < 0) {
+    buffer[length++] = '-';
+  }
+  while (size) {
+    buffer[length++] = digits[--size];
+  }
+  buffer[length] = '\0';
+  return length;
+}
+
+std::size_t formatPrecision(double value, int precision, char *buffer) {
+  const auto length = std::snprintf(buffer, 32, "%.*g", precision, value);
+  assert(length > 0 && length < 32);
+  return static_cast<std::size_t>(length);
+}
+
+}  // namespace
+
+std::size_t format(double value, char *buffer) {
+  assert(buffer);
+  if (!std::isfinite(value)) {
+    return formatPrecision(value, 1, buffer);
+  }
+  // Most coordinates in a font are integers, which don't need the search
+  // below. Negative zero is written as zero.
+  constexpr double kIntegerLimit = 9007199254740992.0;  // 2^53
+  if (std::trunc(value) == value && std::abs(value) < kIntegerLimit) {
+    return formatInteger(static_cast<std::int64_t>(value), buffer);
+  }
+  // Round-trip is monotonic in precision, so the shortest precision that
+  // reads back to the same value is found by a binary search.
+  int lower = 1;
+  int upper = std::numeric_limits<double>::max_digits10;
+  while (lower < upper) {
+    const auto middle = (lower + upper) / 2;
+    formatPrecision(value, middle, buffer);
+    if (std::strtod(buffer, nullptr) == value) {
+      upper = middle;
+    } else {
+      lower = middle + 1;
+    }
+  }
+  const auto length = formatPrecision(value, lower, buffer);
+  if (!std::strchr(buffer, 'e')) {
+    return length;
+  }
+  // Avoid exponents, which some readers of UFO don't accept. The digits are
+  // the same, only their placement differs.
+  const auto exponent = static_cast<int>(std::floor(std::log10(
+      std::abs(value))));
+  const auto decimals = std::max(0, lower - 1 - exponent);
+  const int result = std::snprintf(buffer, 32, "%.*f", decimals, value);
+  if (result < 0 || result >= 32) {
+    // Too many digits for the buffer, which is impossible for coordinates.
+    return formatPrecision(value, lower, buffer);
+  }
+  return static_cast<std::size_t>(result);
+}
+
+// MARK: Writer
+
+Writer::Writer(std::ostream *stream)
+    : stream_(stream),
+      open_(),
+      text_() {
+  assert(stream_);
+}
+
+Writer::~Writer() {
+  flush();
+}
+
+void Writer::declaration() {
+  buffer_ += "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n";
+}
+
+void Writer::open(const std::string& name) {
+  terminate();
+  indent();
+  buffer_ += '<';
+  buffer_ += name;
+  elements_.emplace_back(name);
+  open_ = true;
+}
+
+void Writer::close() {
+  assert(!elements_.empty());
+  const auto name = std::move(elements_.back());
+  elements_.pop_back();
+  if (open_) {
+    buffer_ += "/>\n";
+    open_ = false;
+  } else if (text_) {
+    buffer_ += "</";
+    buffer_ += name;
+    buffer_ += ">\n";
+    text_ = false;
+  } else {
+    indent();
+    buffer_ += "</";
+    buffer_ += name;
+    buffer_ += ">\n";
+  }
+  if (elements_.empty()) {
+    flush();
+  }
+}
+
+void Writer::element(const std::string& name) {
+  open(name);
+  close();
+}
+
+void Writer::element(const std::string& name, const std::string& text) {
+  terminate();
+  indent();
+  buffer_ += '<';
+  buffer_ += name;
+  buffer_ += '>';
+  escape(text, false);
+  buffer_ += "</";
+  buffer_ += name;
+  buffer_ += ">\n";
+}
+
+void Writer::element(const std::string& name, double value) {
+  char buffer[32];
+  const auto size = format(value, buffer);
+  element(name, std::string(buffer, size));
+}
+
+void Writer::attribute(const std::string& name, const std::string& value) {
+  assert(open_);
+  buffer_ += ' ';
+  buffer_ += name;
+  buffer_ += "=\"";
+  escape(value, true);
+  buffer_ += '"';
+}
+
+void Writer::attribute(const std::string& name, const char *value) {
+  assert(open_);
+  buffer_ += ' ';
+  buffer_ += name;
+  buffer_ += "=\"";
+  escape(value, true);
+  buffer_ += '"';
+}
+
+void Writer::attribute(const std::string& name, double value) {
+  assert(open_);
+  char buffer[32];
+  const auto size = format(value, buffer);
+  buffer_ += ' ';
+  buffer_ += name;
+  buffer_ += "=\"";
+  buffer_.append(buffer, size);
+  buffer_ += '"';
+}
+
+void Writer::text(const std::string& value) {
+  assert(open_);
+  buffer_ += '>';
+  escape(value, false);
+  open_ = false;
+  text_ = true;
+}
+
+void Writer::flush() {
+  if (!buffer_.empty()) {
+    stream_->write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+}
+
+void Writer::terminate() {
+  assert(!text_);
+  if (open_) {
+    buffer_ += ">\n";
+    open_ = false;
+  }
+}
+
+void Writer::indent() {
+  assert(!open_);
+  buffer_.append(elements_.size() * 2, ' ');
+}
+
+void Writer::escape(const std::string& value, bool attribute) {
+  for (const auto character : value) {
+    switch (character) {
+      case '&':
+        buffer_ += "&amp;";
+        break;
+      case '<':
+        buffer_ += "&lt;";
+        break;
+      case '>':
+        buffer_ += "&gt;";
+        break;
+      case '"':
+        buffer_ += attribute ? "&quot;" : "\"";
+        break;
+      default:
+        buffer_ += character;
+        break;
+    }
+  }
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token
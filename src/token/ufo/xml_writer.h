@@ -0,0 +1,125 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#pragma once
+#ifndef TOKEN_UFO_XML_WRITER_H_
+#define TOKEN_UFO_XML_WRITER_H_
+
+#include <cassert>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "token/ufo/optional.h"
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+// Formats the shortest decimal representation of the given value that reads
+// back to the same value, and returns the number of characters written into
+// the buffer. The buffer must be able to hold 32 characters.
+std::size_t format(double value, char *buffer);
+
+// Streams XML without building a tree, indenting each level of elements by
+// 2 spaces.
+class Writer final {
+ public:
+  explicit Writer(std::ostream *stream);
+  ~Writer();
+
+  // Disallow copy semantics
+  Writer(const Writer&) = delete;
+  Writer& operator=(const Writer&) = delete;
+
+  // Writing
+  void declaration();
+  void open(const std::string& name);
+  void close();
+  void element(const std::string& name);
+  void element(const std::string& name, const std::string& text);
+  void element(const std::string& name, double value);
+  void attribute(const std::string& name, const std::string& value);
+  void attribute(const std::string& name, const char *value);
+  void attribute(const std::string& name, double value);
+  template <class T, class U>
+  void attribute(const std::string& name,
+                 const T& value,
+                 const U& default_value);
+  // Writes the text as the content of the element just opened, which then
+  // has no children.
+  void text(const std::string& value);
+  void flush();
+
+ private:
+  void terminate();
+  void indent();
+  void escape(const std::string& value, bool attribute);
+
+ private:
+  std::ostream *stream_;
+  std::string buffer_;
+  std::vector<std::string> elements_;
+  bool open_;
+  bool text_;
+};
+
+// Writes an element by letting the value write its own attributes and
+// children.
+template <class T>
+void writeChild(Writer *writer, const std::string& name, const T& value);
+template <class T>
+void writeChild(Writer *writer,
+                const std::string& name,
+                const Optional<T>& value);
+template <class T>
+void writeChildren(Writer *writer,
+                   const std::string& name,
+                   const std::vector<T>& values);
+
+// MARK: -
+
+template <class T, class U>
+inline void Writer::attribute(const std::string& name,
+                              const T& value,
+                              const U& default_value) {
+  if (value != default_value) {
+    attribute(name, value);
+  }
+}
+
+template <class T>
+inline void writeChild(Writer *writer, const std::string& name,
+                       const T& value) {
+  assert(writer);
+  writer->open(name);
+  value.write(writer);
+  writer->close();
+}
+
+template <class T>
+inline void writeChild(Writer *writer,
+                       const std::string& name,
+                       const Optional<T>& value) {
+  assert(writer);
+  if (value.exists()) {
+    writeChild(writer, name, *value);
+  }
+}
+
+template <class T>
+inline void writeChildren(Writer *writer,
+                          const std::string& name,
+                          const std::vector<T>& values) {
+  assert(writer);
+  for (const auto& value : values) {
+    writeChild(writer, name, value);
+  }
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token
+
+#endif  // TOKEN_UFO_XML_WRITER_H_
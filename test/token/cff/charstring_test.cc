@@ -0,0 +1,248 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/cff/charstring.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+// Decodes the charstring into operations, which has no masks of hintmask and
+// cntrmask. The operation of endchar is included.
+std::vector<Operation> decode(const std::string& encoding) {
+  std::vector<Operation> result;
+  std::vector<double> operands;
+  const auto byte = [&encoding](std::size_t offset) {
+    return static_cast<std::uint8_t>(encoding.at(offset));
+  };
+  for (std::size_t i{}; i < encoding.size();) {
+    const int b0 = byte(i);
+    if (b0 == 28) {
+      operands.emplace_back(static_cast<std::int16_t>(
+          (byte(i + 1) << 8) | byte(i + 2)));
+      i += 3;
+    } else if (b0 >= 32 && b0 <= 246) {
+      operands.emplace_back(b0 - 139);
+      i += 1;
+    } else if (b0 >= 247 && b0 <= 250) {
+      operands.emplace_back((b0 - 247) * 256 + byte(i + 1) + 108);
+      i += 2;
+    } else if (b0 >= 251 && b0 <= 254) {
+      operands.emplace_back(-(b0 - 251) * 256 - byte(i + 1) - 108);
+      i += 2;
+    } else if (b0 == 255) {
+      const auto bits = ((static_cast<std::uint32_t>(byte(i + 1)) << 24) |
+                         (byte(i + 2) << 16) |
+                         (byte(i + 3) << 8) |
+                         byte(i + 4));
+      operands.emplace_back(static_cast<std::int32_t>(bits) / 65536.0);
+      i += 5;
+    } else {
+      int op = b0;
+      if (b0 == 12) {
+        op = 1200 + byte(i + 1);
+        i += 1;
+      }
+      result.emplace_back(static_cast<Operator>(op), operands);
+      operands.clear();
+      i += 1;
+    }
+  }
+  EXPECT_TRUE(operands.empty());
+  return result;
+}
+
+// The operations that remain after specializing, followed by endchar after
+// encoding them.
+void expectOperations(const CharString& charstring,
+                      const std::vector<Operation>& expected) {
+  EXPECT_EQ(charstring.operations(), expected);
+  auto terminated = expected;
+  terminated.emplace_back(Operator::ENDCHAR, std::vector<double>());
+  EXPECT_EQ(decode(charstring.encode(charstring.width(), 0.0)), terminated);
+}
+
+}  // namespace
+
+TEST(CharStringTest, EncodesNumbersInShortestForm) {
+  const struct {
+    double value;
+    std::size_t size;
+  } cases[] = {
+    {0.0, 1}, {107.0, 1}, {-107.0, 1},
+    {108.0, 2}, {1131.0, 2}, {-108.0, 2}, {-1131.0, 2},
+    {1132.0, 3}, {-1132.0, 3}, {32767.0, 3}, {-32768.0, 3},
+    {0.5, 5}, {-1.25, 5}, {1000.75, 5},
+  };
+  for (const auto& test : cases) {
+    std::string encoding;
+    CharString::encodeNumber(test.value, &encoding);
+    EXPECT_EQ(encoding.size(), test.size) << test.value;
+    encoding.push_back(static_cast<char>(Operator::RETURN));
+    const auto operations = decode(encoding);
+    ASSERT_EQ(operations.size(), 1u);
+    EXPECT_EQ(operations.front().operands, std::vector<double>{test.value});
+  }
+}
+
+TEST(CharStringTest, SpecializesMovesAndLines) {
+  // The square begins at the origin, and the line that closes it is
+  // implicit. Lines alternate between horizontal and vertical.
+  shota::Shape2d shape;
+  shape.moveTo(0.4, -0.4);
+  shape.lineTo(100.0, 0.0);
+  shape.lineTo(100.0, 100.0);
+  shape.lineTo(0.0, 100.0);
+  shape.lineTo(0.0, 0.0);
+  shape.close();
+  const CharString charstring(shape, 500.0);
+  expectOperations(charstring, {
+    Operation(Operator::VMOVETO, {0.0}),
+    Operation(Operator::HLINETO, {100.0, 100.0, -100.0}),
+  });
+
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 0.0}),
+    Operation(Operator::RLINETO, {0.0, 20.0}),
+    Operation(Operator::RLINETO, {0.0, 30.0}),
+    Operation(Operator::RLINETO, {10.0, 20.0}),
+    Operation(Operator::RLINETO, {30.0, 40.0}),
+  }, 0.0), {
+    Operation(Operator::HMOVETO, {10.0}),
+    Operation(Operator::VLINETO, {20.0}),
+    Operation(Operator::VLINETO, {30.0}),
+    Operation(Operator::RLINETO, {10.0, 20.0, 30.0, 40.0}),
+  });
+}
+
+TEST(CharStringTest, SpecializesCurves) {
+  // Only the first curve of hhcurveto and vvcurveto has the extra operand.
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RRCURVETO, {10.0, 0.0, 20.0, 30.0, 40.0, 0.0}),
+    Operation(Operator::RRCURVETO, {5.0, 0.0, 6.0, 7.0, 8.0, 0.0}),
+    Operation(Operator::RRCURVETO, {3.0, 4.0, 5.0, 6.0, 7.0, 0.0}),
+  }, 0.0), {
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::HHCURVETO, {10.0, 20.0, 30.0, 40.0,
+                                    5.0, 6.0, 7.0, 8.0}),
+    Operation(Operator::HHCURVETO, {4.0, 3.0, 5.0, 6.0, 7.0}),
+  });
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RRCURVETO, {1.0, 2.0, 3.0, 4.0, 0.0, 5.0}),
+    Operation(Operator::RRCURVETO, {0.0, 10.0, 20.0, 30.0, 0.0, 40.0}),
+  }, 0.0), {
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::VVCURVETO, {1.0, 2.0, 3.0, 4.0, 5.0,
+                                    10.0, 20.0, 30.0, 40.0}),
+  });
+
+  // Curves alternate between starting horizontal and vertical, and only the
+  // last one has the extra operand.
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RRCURVETO, {10.0, 0.0, 20.0, 30.0, 0.0, 40.0}),
+    Operation(Operator::RRCURVETO, {0.0, 10.0, 20.0, 30.0, 40.0, 0.0}),
+    Operation(Operator::RRCURVETO, {1.0, 0.0, 2.0, 3.0, 4.0, 5.0}),
+    Operation(Operator::RRCURVETO, {0.0, 1.0, 2.0, 3.0, 4.0, 0.0}),
+  }, 0.0), {
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::HVCURVETO, {10.0, 20.0, 30.0, 40.0,
+                                    10.0, 20.0, 30.0, 40.0,
+                                    1.0, 2.0, 3.0, 5.0, 4.0}),
+    Operation(Operator::VHCURVETO, {1.0, 2.0, 3.0, 4.0}),
+  });
+}
+
+TEST(CharStringTest, MergesLinesAndCurves) {
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RLINETO, {10.0, 20.0}),
+    Operation(Operator::RLINETO, {30.0, 40.0}),
+    Operation(Operator::RRCURVETO, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}),
+    Operation(Operator::RRCURVETO, {6.0, 5.0, 4.0, 3.0, 2.0, 1.0}),
+  }, 0.0), {
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RLINECURVE, {10.0, 20.0, 30.0, 40.0,
+                                     1.0, 2.0, 3.0, 4.0, 5.0, 6.0}),
+    Operation(Operator::RRCURVETO, {6.0, 5.0, 4.0, 3.0, 2.0, 1.0}),
+  });
+  expectOperations(CharString({
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RRCURVETO, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}),
+    Operation(Operator::RRCURVETO, {6.0, 5.0, 4.0, 3.0, 2.0, 1.0}),
+    Operation(Operator::RLINETO, {10.0, 20.0}),
+    Operation(Operator::RLINETO, {30.0, 40.0}),
+  }, 0.0), {
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::RCURVELINE, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0,
+                                     6.0, 5.0, 4.0, 3.0, 2.0, 1.0,
+                                     10.0, 20.0}),
+    Operation(Operator::RLINETO, {30.0, 40.0}),
+  });
+}
+
+TEST(CharStringTest, MergesWithinStackLimit) {
+  std::vector<Operation> operations{
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+  };
+  for (int i{}; i < 30; ++i) {
+    operations.emplace_back(Operator::RLINETO, std::vector<double>{
+        static_cast<double>(i + 1), 1.0});
+  }
+  const CharString charstring(operations, 0.0);
+  ASSERT_EQ(charstring.operations().size(), 3u);
+  EXPECT_EQ(charstring.operations()[1].operands.size(),
+            CharString::stack_limit);
+  EXPECT_EQ(charstring.operations()[2].operands.size(), 12u);
+  EXPECT_EQ(charstring.operations()[2].operands.front(), 25.0);
+}
+
+TEST(CharStringTest, EncodesWidth) {
+  // The width precedes the operands of the first operator, as the difference
+  // from the nominal width, only when it isn't the default.
+  const CharString charstring({
+    Operation(Operator::HSTEM, {0.0, 50.0}),
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+  }, 600.0);
+  EXPECT_EQ(decode(charstring.encode(500.0, 400.0)), (std::vector<Operation>{
+    Operation(Operator::HSTEM, {200.0, 0.0, 50.0}),
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::ENDCHAR, {}),
+  }));
+  EXPECT_EQ(decode(charstring.encode(600.0, 400.0)), (std::vector<Operation>{
+    Operation(Operator::HSTEM, {0.0, 50.0}),
+    Operation(Operator::RMOVETO, {10.0, 20.0}),
+    Operation(Operator::ENDCHAR, {}),
+  }));
+
+  const CharString empty(std::vector<Operation>(), 250.0);
+  EXPECT_EQ(decode(empty.encode(0.0, 0.0)), (std::vector<Operation>{
+    Operation(Operator::ENDCHAR, {250.0}),
+  }));
+  EXPECT_EQ(empty.encode(250.0, 0.0),
+            std::string(1, static_cast<char>(Operator::ENDCHAR)));
+}
+
+TEST(CharStringTest, EncodesEscapedOperatorsAndMasks) {
+  Operation mask(Operator::HINTMASK, {});
+  mask.mask = std::string("\xc0", 1);
+  std::string encoding;
+  CharString::encodeOperation(mask, &encoding);
+  CharString::encodeOperation(
+      Operation(static_cast<Operator>(1234), {1.0, 2.0}), &encoding);
+  EXPECT_EQ(encoding, std::string("\x13\xc0\x8c\x8d\x0c\x22", 6));
+}
+
+}  // namespace cff
+}  // namespace token
@@ -0,0 +1,111 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "token/cff/dict.h"
+
+namespace token {
+namespace cff {
+
+TEST(DictTest, EncodesNumbersInShortestForm) {
+  const struct {
+    double value;
+    std::size_t size;
+  } cases[] = {
+    {0.0, 1}, {107.0, 1}, {-107.0, 1},
+    {108.0, 2}, {1131.0, 2}, {-108.0, 2}, {-1131.0, 2},
+    {1132.0, 3}, {-1132.0, 3}, {32767.0, 3}, {-32768.0, 3},
+    {32768.0, 5}, {-32769.0, 5}, {2147483647.0, 5}, {-2147483647.0, 5},
+  };
+  for (const auto& test : cases) {
+    std::string encoding;
+    Dict::encodeNumber(test.value, &encoding);
+    EXPECT_EQ(encoding.size(), test.size) << test.value;
+    Dict dict;
+    ASSERT_TRUE(dict.decode(encoding + '\x01')) << test.value;
+    ASSERT_NE(dict.get(1), nullptr);
+    EXPECT_EQ(*dict.get(1), std::vector<double>{test.value});
+  }
+}
+
+TEST(DictTest, EncodesRealNumbers) {
+  // Nibbles of the decimal digits end with 0xf, and are padded to a byte.
+  std::string encoding;
+  Dict::encodeNumber(-2.25, &encoding);
+  EXPECT_EQ(encoding, std::string("\x1e\xe2\xa2\x5f", 4));
+  encoding.clear();
+  Dict::encodeNumber(0.001, &encoding);
+  EXPECT_EQ(encoding, std::string("\x1e\x0a\x00\x1f", 4));
+
+  for (const auto value : {0.5, -2.25, 0.001, 1e-5, 1.5e12, -3.125e-20}) {
+    encoding.clear();
+    Dict::encodeNumber(value, &encoding);
+    Dict dict;
+    ASSERT_TRUE(dict.decode(encoding + '\x01')) << value;
+    ASSERT_NE(dict.get(1), nullptr);
+    ASSERT_EQ(dict.get(1)->size(), 1u);
+    EXPECT_DOUBLE_EQ(dict.get(1)->front(), value);
+  }
+}
+
+TEST(DictTest, RoundTripsEntries) {
+  Dict dict;
+  dict.set(0, 391.0);
+  dict.set(1207, {0.001, 0.0, 0.0, 0.001, 0.0, 0.0});
+  dict.set(5, {-50.0, -250.0, 1200.0, 900.0});
+  dict.setDelta(6, {-10.0, 0.0, 500.0, 510.0});
+  dict.setOffset(17, {100.0});
+  dict.setOffset(18, {20.0, 4000.0});
+  dict.set(0, 392.0);
+  EXPECT_EQ(*dict.get(6), (std::vector<double>{-10.0, 10.0, 500.0, 10.0}));
+
+  Dict decoded;
+  ASSERT_TRUE(decoded.decode(dict.encode()));
+  ASSERT_EQ(decoded.entries().size(), dict.entries().size());
+  for (std::size_t i{}; i < dict.entries().size(); ++i) {
+    const auto& expected = dict.entries()[i];
+    const auto& entry = decoded.entries()[i];
+    EXPECT_EQ(entry.op, expected.op);
+    EXPECT_EQ(entry.offset, expected.offset) << entry.op;
+    ASSERT_EQ(entry.operands.size(), expected.operands.size()) << entry.op;
+    for (std::size_t j{}; j < entry.operands.size(); ++j) {
+      EXPECT_DOUBLE_EQ(entry.operands[j], expected.operands[j]) << entry.op;
+    }
+  }
+  EXPECT_EQ(decoded.encode(), dict.encode());
+}
+
+TEST(DictTest, EncodesOffsetsInFixedSize) {
+  // Offsets take 5 bytes regardless of their values, so that the DICT can
+  // be encoded before the offsets are known.
+  Dict dict;
+  dict.setOffset(17, {0.0});
+  const auto size = dict.encode().size();
+  EXPECT_EQ(size, 6u);
+  dict.setOffset(17, {100000.0});
+  EXPECT_EQ(dict.encode().size(), size);
+  dict.set(17, 0.0);
+  EXPECT_EQ(dict.encode().size(), 2u);
+}
+
+TEST(DictTest, RejectsMalformedDict) {
+  Dict dict;
+  // Operands without an operator
+  EXPECT_FALSE(dict.decode(std::string("\x8b", 1)));
+  // Truncated numbers and operators
+  EXPECT_FALSE(dict.decode(std::string("\x1c\x00", 2)));
+  EXPECT_FALSE(dict.decode(std::string("\x1d\x00\x00\x00", 4)));
+  EXPECT_FALSE(dict.decode(std::string("\xf7", 1)));
+  EXPECT_FALSE(dict.decode(std::string("\x1e\x12", 2)));
+  EXPECT_FALSE(dict.decode(std::string("\x8b\x0c", 2)));
+  // Reserved
+  EXPECT_FALSE(dict.decode(std::string("\xff\x01", 2)));
+}
+
+}  // namespace cff
+}  // namespace token
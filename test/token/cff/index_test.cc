@@ -0,0 +1,77 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "token/cff/index.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+// Decodes the INDEX after a prefix, and expects the position to be advanced
+// to the suffix that follows it.
+void expectRoundTrip(const std::vector<std::string>& objects,
+                     std::size_t offset_size) {
+  const auto encoding = encodeIndex(objects);
+  if (!objects.empty()) {
+    ASSERT_GT(encoding.size(), 2u);
+    EXPECT_EQ(static_cast<std::size_t>(encoding[2]), offset_size);
+  }
+  const auto data = "prefix" + encoding + "suffix";
+  std::size_t position = 6;
+  std::vector<std::string> decoded{"stale"};
+  ASSERT_TRUE(decodeIndex(data, &position, &decoded));
+  EXPECT_EQ(decoded, objects);
+  EXPECT_EQ(position, 6 + encoding.size());
+}
+
+}  // namespace
+
+TEST(IndexTest, EncodesEmptyIndex) {
+  EXPECT_EQ(encodeIndex({}), std::string(2, '\0'));
+  expectRoundTrip({}, 0);
+}
+
+TEST(IndexTest, EncodesObjects) {
+  EXPECT_EQ(encodeIndex({"a", "bc", ""}),
+            std::string("\x00\x03\x01\x01\x02\x04\x04" "abc", 10));
+  expectRoundTrip({"a", "bc", ""}, 1);
+}
+
+TEST(IndexTest, ChoosesSmallestOffsetSize) {
+  // The last offset points past the data, which is one larger than its size.
+  expectRoundTrip({std::string(254, 'a')}, 1);
+  expectRoundTrip({std::string(255, 'a')}, 2);
+  expectRoundTrip({std::string(300, 'a'), "b"}, 2);
+  expectRoundTrip({std::string(0xffff, 'a')}, 3);
+  expectRoundTrip({std::string(0x10000, 'a'), "b", "c"}, 3);
+}
+
+TEST(IndexTest, RejectsMalformedIndex) {
+  const auto encoding = encodeIndex({"abc", "de"});
+  std::vector<std::string> objects;
+  for (std::size_t size{}; size < encoding.size(); ++size) {
+    std::size_t position{};
+    EXPECT_FALSE(decodeIndex(encoding.substr(0, size), &position, &objects))
+        << size;
+  }
+
+  // Offsets must start from 1 and never decrease.
+  auto invalid = encoding;
+  invalid[3] = 2;
+  std::size_t position{};
+  EXPECT_FALSE(decodeIndex(invalid, &position, &objects));
+  invalid = encoding;
+  invalid[5] = 3;
+  position = 0;
+  EXPECT_FALSE(decodeIndex(invalid, &position, &objects));
+}
+
+}  // namespace cff
+}  // namespace token
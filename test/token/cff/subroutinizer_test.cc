@@ -0,0 +1,292 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "token/cff/charstring.h"
+#include "token/cff/font.h"
+#include "token/cff/subroutinizer.h"
+
+namespace token {
+namespace cff {
+
+namespace {
+
+// The Type 2 limit of the depth of subroutine calls
+constexpr int kMaxCallDepth = 10;
+
+int bias(std::size_t count) {
+  if (count < 1240) {
+    return 107;
+  } else if (count < 33900) {
+    return 1131;
+  }
+  return 32768;
+}
+
+// Glyphs that share runs of operations drawn from a small vocabulary, so
+// that the subroutinizer finds repeats across and within them. Every glyph
+// begins with hints and ends with endchar, which must stay in place.
+Font makeFont(std::size_t size, unsigned int seed) {
+  std::mt19937 random(seed);
+  std::uniform_int_distribution<int> pick(0, 5);
+  std::uniform_int_distribution<int> length(8, 40);
+  const std::vector<Operation> vocabulary{
+    Operation(Operator::RLINETO, {10.0, 20.0}),
+    Operation(Operator::RLINETO, {-30.0, 500.0}),
+    Operation(Operator::HLINETO, {200.0}),
+    Operation(Operator::VLINETO, {-1000.0}),
+    Operation(Operator::RRCURVETO, {1.0, 2.0, 3.0, 4.0, 5.0, 6.0}),
+    Operation(Operator::HVCURVETO, {0.5, 20.0, 30.0, 40.0}),
+  };
+  Font font;
+  for (std::size_t i{}; i < size; ++i) {
+    Font::Glyph glyph{};
+    glyph.name = "glyph" + std::to_string(i);
+    auto& operations = glyph.charstring.operations();
+    operations.emplace_back(Operator::HSTEM, std::vector<double>{
+        0.0, static_cast<double>(i % 7 + 10)});
+    operations.emplace_back(Operator::RMOVETO, std::vector<double>{
+        static_cast<double>(i), 0.0});
+    const auto count = length(random);
+    for (int j{}; j < count; ++j) {
+      operations.emplace_back(vocabulary[pick(random)]);
+    }
+    operations.emplace_back(Operator::ENDCHAR, std::vector<double>());
+    font.glyphs().emplace_back(std::move(glyph));
+  }
+  return font;
+}
+
+std::string encode(const std::vector<Operation>& operations) {
+  std::string result;
+  for (const auto& operation : operations) {
+    CharString::encodeOperation(operation, &result);
+  }
+  return result;
+}
+
+// The operators in the encoding, which has no masks of hintmask and
+// cntrmask. Two-byte operators are offset by 1200.
+std::vector<int> decodeOperators(const std::string& encoding) {
+  std::vector<int> result;
+  for (std::size_t i{}; i < encoding.size();) {
+    const auto byte = static_cast<unsigned char>(encoding[i]);
+    if (byte == 28) {
+      i += 3;
+    } else if (byte >= 32 && byte <= 246) {
+      i += 1;
+    } else if (byte >= 247 && byte <= 254) {
+      i += 2;
+    } else if (byte == 255) {
+      i += 5;
+    } else if (byte == 12) {
+      result.emplace_back(1200 + static_cast<unsigned char>(encoding[i + 1]));
+      i += 2;
+    } else {
+      result.emplace_back(byte);
+      i += 1;
+    }
+  }
+  return result;
+}
+
+bool isCall(int op) {
+  return (op == static_cast<int>(Operator::CALLSUBR) ||
+          op == static_cast<int>(Operator::CALLGSUBR));
+}
+
+// Replaces the calls in the operations with the bodies of the subroutines
+// they call, and records the deepest nesting of calls.
+void expand(const std::string& encoding,
+            const std::vector<std::string>& subrs,
+            int depth,
+            std::string *output,
+            int *max_depth) {
+  ASSERT_LE(depth, kMaxCallDepth);
+  *max_depth = std::max(*max_depth, depth);
+  std::size_t start{};
+  std::vector<int> numbers;
+  for (std::size_t i{}; i < encoding.size();) {
+    const auto byte = static_cast<unsigned char>(encoding[i]);
+    if (byte == 28) {
+      numbers.emplace_back(static_cast<std::int16_t>(
+          (static_cast<unsigned char>(encoding[i + 1]) << 8) |
+          static_cast<unsigned char>(encoding[i + 2])));
+      i += 3;
+    } else if (byte >= 32 && byte <= 246) {
+      numbers.emplace_back(byte - 139);
+      i += 1;
+    } else if (byte >= 247 && byte <= 250) {
+      numbers.emplace_back((byte - 247) * 256 +
+                           static_cast<unsigned char>(encoding[i + 1]) + 108);
+      i += 2;
+    } else if (byte >= 251 && byte <= 254) {
+      numbers.emplace_back(-(byte - 251) * 256 -
+                           static_cast<unsigned char>(encoding[i + 1]) - 108);
+      i += 2;
+    } else if (byte == 255) {
+      numbers.emplace_back(0);
+      i += 5;
+    } else if (isCall(byte)) {
+      ASSERT_EQ(numbers.size(), 1u);
+      const auto index = numbers.back() + bias(subrs.size());
+      ASSERT_GE(index, 0);
+      ASSERT_LT(index, static_cast<int>(subrs.size()));
+      const auto& subr = subrs[index];
+      ASSERT_FALSE(subr.empty());
+      ASSERT_EQ(subr.back(), static_cast<char>(Operator::RETURN));
+      expand(subr.substr(0, subr.size() - 1), subrs, depth + 1, output,
+             max_depth);
+      numbers.clear();
+      i += 1;
+      start = i;
+    } else {
+      i += (byte == 12) ? 2 : 1;
+      output->append(encoding, start, i - start);
+      numbers.clear();
+      start = i;
+    }
+  }
+  output->append(encoding, start, encoding.size() - start);
+}
+
+std::size_t totalSize(const Font& font) {
+  std::size_t result{};
+  for (const auto& glyph : font.glyphs()) {
+    result += encode(glyph.charstring.operations()).size();
+  }
+  for (const auto& subr : font.global_subrs) {
+    result += subr.size();
+  }
+  for (const auto& subr : font.local_subrs) {
+    result += subr.size();
+  }
+  return result;
+}
+
+void expectRoundTrip(const Font& original,
+                     const Font& font,
+                     const std::vector<std::string>& subrs) {
+  ASSERT_EQ(original.glyphs().size(), font.glyphs().size());
+  for (std::size_t i{}; i < font.glyphs().size(); ++i) {
+    const auto& operations = font.glyphs()[i].charstring.operations();
+    std::string expanded;
+    int max_depth{};
+    expand(encode(operations), subrs, 0, &expanded, &max_depth);
+    EXPECT_EQ(encode(original.glyphs()[i].charstring.operations()), expanded)
+        << font.glyphs()[i].name;
+  }
+}
+
+}  // namespace
+
+TEST(SubroutinizerTest, ExpandsToOriginal) {
+  const auto original = makeFont(64, 1);
+  auto font = original;
+  Subroutinizer()(&font);
+  ASSERT_FALSE(font.global_subrs.empty());
+  EXPECT_TRUE(font.local_subrs.empty());
+  EXPECT_LT(totalSize(font), totalSize(original));
+  expectRoundTrip(original, font, font.global_subrs);
+}
+
+TEST(SubroutinizerTest, ExpandsLocalSubroutinesToOriginal) {
+  const auto original = makeFont(64, 2);
+  auto font = original;
+  Subroutinizer subroutinizer;
+  subroutinizer.set_global(false);
+  subroutinizer(&font);
+  ASSERT_FALSE(font.local_subrs.empty());
+  EXPECT_TRUE(font.global_subrs.empty());
+  for (const auto& glyph : font.glyphs()) {
+    for (const auto& operation : glyph.charstring.operations()) {
+      EXPECT_NE(operation.op, Operator::CALLGSUBR);
+    }
+  }
+  expectRoundTrip(original, font, font.local_subrs);
+}
+
+TEST(SubroutinizerTest, KeepsHintsAndEndcharOutOfSubroutines) {
+  auto font = makeFont(64, 3);
+  Subroutinizer()(&font);
+  ASSERT_FALSE(font.global_subrs.empty());
+  for (const auto& subr : font.global_subrs) {
+    const auto operators = decodeOperators(subr);
+    ASSERT_FALSE(operators.empty());
+    EXPECT_EQ(operators.back(), static_cast<int>(Operator::RETURN));
+    for (std::size_t i{}; i + 1 < operators.size(); ++i) {
+      const auto op = static_cast<Operator>(operators[i]);
+      EXPECT_NE(op, Operator::RETURN);
+      EXPECT_NE(op, Operator::ENDCHAR);
+      EXPECT_NE(op, Operator::HSTEM);
+    }
+  }
+  for (const auto& glyph : font.glyphs()) {
+    const auto& operations = glyph.charstring.operations();
+    ASSERT_GE(operations.size(), 3u);
+    EXPECT_EQ(operations.front().op, Operator::HSTEM);
+    EXPECT_EQ(operations.back().op, Operator::ENDCHAR);
+  }
+}
+
+TEST(SubroutinizerTest, NestsCallsWithinLimit) {
+  auto font = makeFont(256, 4);
+  Subroutinizer()(&font);
+  int max_depth{};
+  for (const auto& glyph : font.glyphs()) {
+    std::string expanded;
+    expand(encode(glyph.charstring.operations()), font.global_subrs, 0,
+           &expanded, &max_depth);
+  }
+  EXPECT_GE(max_depth, 1);
+  EXPECT_LE(max_depth, kMaxCallDepth);
+}
+
+TEST(SubroutinizerTest, LimitsNumberOfSubroutines) {
+  const auto original = makeFont(128, 5);
+  for (const std::size_t limit : {1u, 2u, 16u}) {
+    auto font = original;
+    Subroutinizer subroutinizer;
+    subroutinizer.set_max_subroutines(limit);
+    subroutinizer(&font);
+    EXPECT_FALSE(font.global_subrs.empty());
+    EXPECT_LE(font.global_subrs.size(), limit);
+    expectRoundTrip(original, font, font.global_subrs);
+  }
+}
+
+TEST(SubroutinizerTest, LeavesExistingSubroutines) {
+  const auto original = makeFont(16, 6);
+  auto font = original;
+  font.local_subrs.emplace_back(1, static_cast<char>(Operator::RETURN));
+  Subroutinizer()(&font);
+  EXPECT_TRUE(font.global_subrs.empty());
+  EXPECT_EQ(font.local_subrs.size(), 1u);
+  for (std::size_t i{}; i < font.glyphs().size(); ++i) {
+    EXPECT_EQ(encode(original.glyphs()[i].charstring.operations()),
+              encode(font.glyphs()[i].charstring.operations()));
+  }
+}
+
+TEST(SubroutinizerTest, IsDeterministic) {
+  auto font1 = makeFont(64, 7);
+  auto font2 = font1;
+  Subroutinizer()(&font1);
+  Subroutinizer()(&font2);
+  EXPECT_EQ(font1.global_subrs, font2.global_subrs);
+  for (std::size_t i{}; i < font1.glyphs().size(); ++i) {
+    EXPECT_EQ(encode(font1.glyphs()[i].charstring.operations()),
+              encode(font2.glyphs()[i].charstring.operations()));
+  }
+}
+
+}  // namespace cff
+}  // namespace token
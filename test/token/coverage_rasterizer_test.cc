@@ -0,0 +1,197 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/coverage_rasterizer.h"
+
+namespace token {
+
+namespace {
+
+// Draws the rectangle clockwise on the screen, or counterclockwise when the
+// direction is reversed.
+void drawRectangle(CoverageRasterizer *rasterizer,
+                   double left,
+                   double top,
+                   double right,
+                   double bottom,
+                   bool reversed = false) {
+  rasterizer->moveTo(shota::Vec2d(left, top));
+  if (reversed) {
+    rasterizer->lineTo(shota::Vec2d(left, bottom));
+    rasterizer->lineTo(shota::Vec2d(right, bottom));
+    rasterizer->lineTo(shota::Vec2d(right, top));
+  } else {
+    rasterizer->lineTo(shota::Vec2d(right, top));
+    rasterizer->lineTo(shota::Vec2d(right, bottom));
+    rasterizer->lineTo(shota::Vec2d(left, bottom));
+  }
+  rasterizer->close();
+}
+
+// The coverage of the mask in pixels
+double sum(const std::vector<std::uint8_t>& mask) {
+  double result{};
+  for (const auto value : mask) {
+    result += value / 255.0;
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(CoverageRasterizerTest, FillsPixelAlignedRectangle) {
+  CoverageRasterizer rasterizer(8, 6);
+  drawRectangle(&rasterizer, 2.0, 1.0, 6.0, 4.0);
+  const auto mask = rasterizer.resolve();
+  ASSERT_EQ(mask.size(), 8u * 6u);
+  for (int y{}; y < 6; ++y) {
+    for (int x{}; x < 8; ++x) {
+      const bool inside = x >= 2 && x < 6 && y >= 1 && y < 4;
+      EXPECT_EQ(mask[y * 8 + x], inside ? 255 : 0) << x << ", " << y;
+    }
+  }
+}
+
+TEST(CoverageRasterizerTest, FillsHalfPixelRectangle) {
+  CoverageRasterizer rasterizer(6, 6);
+  drawRectangle(&rasterizer, 1.5, 0.5, 4.5, 3.5);
+  const auto mask = rasterizer.resolve();
+  // The edges cover a half of their pixels, and the corners a quarter.
+  const int expected[6][6] = {
+    {0, 64, 128, 128, 64, 0},
+    {0, 128, 255, 255, 128, 0},
+    {0, 128, 255, 255, 128, 0},
+    {0, 64, 128, 128, 64, 0},
+    {0, 0, 0, 0, 0, 0},
+    {0, 0, 0, 0, 0, 0},
+  };
+  for (int y{}; y < 6; ++y) {
+    for (int x{}; x < 6; ++x) {
+      EXPECT_EQ(mask[y * 6 + x], expected[y][x]) << x << ", " << y;
+    }
+  }
+}
+
+TEST(CoverageRasterizerTest, CancelsOppositeWindings) {
+  CoverageRasterizer rasterizer(8, 8);
+  drawRectangle(&rasterizer, 1.0, 1.0, 7.0, 7.0);
+  drawRectangle(&rasterizer, 1.0, 1.0, 7.0, 7.0, true);
+  for (const auto value : rasterizer.resolve()) {
+    EXPECT_EQ(value, 0);
+  }
+
+  // A hole drawn in the opposite direction is left empty, while an overlap
+  // in the same direction stays covered by the nonzero rule.
+  rasterizer.reset(8, 8);
+  drawRectangle(&rasterizer, 0.0, 0.0, 8.0, 8.0);
+  drawRectangle(&rasterizer, 2.0, 2.0, 4.0, 4.0, true);
+  drawRectangle(&rasterizer, 4.5, 4.5, 7.5, 7.5);
+  const auto mask = rasterizer.resolve();
+  for (int y{}; y < 8; ++y) {
+    for (int x{}; x < 8; ++x) {
+      const bool hole = x >= 2 && x < 4 && y >= 2 && y < 4;
+      EXPECT_EQ(mask[y * 8 + x], hole ? 0 : 255) << x << ", " << y;
+    }
+  }
+}
+
+TEST(CoverageRasterizerTest, ClipsAtLeftAndRightEdges) {
+  CoverageRasterizer rasterizer(6, 4);
+  drawRectangle(&rasterizer, -5.0, 0.0, 3.0, 4.0);
+  auto mask = rasterizer.resolve();
+  for (int y{}; y < 4; ++y) {
+    for (int x{}; x < 6; ++x) {
+      EXPECT_EQ(mask[y * 6 + x], x < 3 ? 255 : 0) << x << ", " << y;
+    }
+  }
+
+  rasterizer.reset(6, 4);
+  drawRectangle(&rasterizer, 3.0, 0.0, 20.0, 4.0);
+  mask = rasterizer.resolve();
+  for (int y{}; y < 4; ++y) {
+    for (int x{}; x < 6; ++x) {
+      EXPECT_EQ(mask[y * 6 + x], x < 3 ? 0 : 255) << x << ", " << y;
+    }
+  }
+
+  rasterizer.reset(6, 4);
+  drawRectangle(&rasterizer, -10.0, -10.0, 20.0, 20.0);
+  for (const auto value : rasterizer.resolve()) {
+    EXPECT_EQ(value, 255);
+  }
+}
+
+TEST(CoverageRasterizerTest, ClipsDiagonalSegments) {
+  // The diagonal of the mask extends past both of the edges, and the
+  // triangles on either side of it cover a half each.
+  CoverageRasterizer rasterizer(10, 10);
+  rasterizer.moveTo(shota::Vec2d(-5.0, -5.0));
+  rasterizer.lineTo(shota::Vec2d(15.0, 15.0));
+  rasterizer.lineTo(shota::Vec2d(15.0, -5.0));
+  rasterizer.close();
+  const auto upper = rasterizer.resolve();
+  EXPECT_NEAR(sum(upper), 50.0, 0.1);
+
+  rasterizer.reset(10, 10);
+  rasterizer.moveTo(shota::Vec2d(-5.0, -5.0));
+  rasterizer.lineTo(shota::Vec2d(-5.0, 15.0));
+  rasterizer.lineTo(shota::Vec2d(15.0, 15.0));
+  rasterizer.close();
+  const auto lower = rasterizer.resolve();
+  EXPECT_NEAR(sum(lower), 50.0, 0.1);
+
+  for (int y{}; y < 10; ++y) {
+    for (int x{}; x < 10; ++x) {
+      const auto i = y * 10 + x;
+      if (x == y) {
+        EXPECT_EQ(upper[i], 128) << x << ", " << y;
+        EXPECT_EQ(lower[i], 128) << x << ", " << y;
+      } else {
+        EXPECT_EQ(upper[i], x > y ? 255 : 0) << x << ", " << y;
+        EXPECT_EQ(lower[i], x < y ? 255 : 0) << x << ", " << y;
+      }
+    }
+  }
+}
+
+TEST(CoverageRasterizerTest, SpreadsShallowSegmentsAcrossPixels) {
+  // The edge rises a pixel for every 4 pixels, and extends past the edges
+  // of the mask. The pixels it crosses are covered by the average height of
+  // the edge in them.
+  CoverageRasterizer rasterizer(8, 2);
+  rasterizer.moveTo(shota::Vec2d(-4.0, -1.0));
+  rasterizer.lineTo(shota::Vec2d(12.0, -1.0));
+  rasterizer.lineTo(shota::Vec2d(12.0, 3.0));
+  rasterizer.close();
+  const auto mask = rasterizer.resolve();
+  const int expected[2][8] = {
+    {32, 96, 159, 223, 255, 255, 255, 255},
+    {0, 0, 0, 0, 32, 96, 159, 223},
+  };
+  for (int y{}; y < 2; ++y) {
+    for (int x{}; x < 8; ++x) {
+      EXPECT_EQ(mask[y * 8 + x], expected[y][x]) << x << ", " << y;
+    }
+  }
+}
+
+TEST(CoverageRasterizerTest, ResolvesIntoStride) {
+  CoverageRasterizer rasterizer(4, 2);
+  drawRectangle(&rasterizer, 0.0, 0.0, 4.0, 2.0);
+  std::vector<std::uint8_t> mask(6 * 2, 1);
+  rasterizer.resolve(mask.data(), 6);
+  for (int y{}; y < 2; ++y) {
+    for (int x{}; x < 6; ++x) {
+      EXPECT_EQ(mask[y * 6 + x], x < 4 ? 255 : 1) << x << ", " << y;
+    }
+  }
+}
+
+}  // namespace token
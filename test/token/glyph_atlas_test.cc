@@ -0,0 +1,177 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "shotamatsuda/graphics.h"
+#include "token/coverage_rasterizer.h"
+#include "token/glyph_atlas.h"
+
+namespace token {
+
+namespace {
+
+// A square in units whose y-axis points upward
+shota::Shape2d makeSquare(double left, double bottom, double size) {
+  shota::Shape2d shape;
+  shape.moveTo(left, bottom);
+  shape.lineTo(left + size, bottom);
+  shape.lineTo(left + size, bottom + size);
+  shape.lineTo(left, bottom + size);
+  shape.close();
+  return shape;
+}
+
+// The pixels of the region copied out of the atlas
+std::vector<std::uint8_t> extract(const GlyphAtlas& atlas,
+                                  const GlyphAtlas::Region& region) {
+  std::vector<std::uint8_t> result;
+  for (int y{}; y < region.height; ++y) {
+    const auto row = atlas.data() + (region.y + y) * atlas.width() + region.x;
+    result.insert(result.end(), row, row + region.width);
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(GlyphAtlasTest, FindsInsertedRegion) {
+  GlyphAtlas atlas(64, 64);
+  EXPECT_EQ(atlas.find("a", 10.0, 1.0), nullptr);
+  const auto inserted = atlas.insert("a", 10.0, 1.0, makeSquare(0, 0, 10));
+  ASSERT_NE(inserted, nullptr);
+  const auto region = *inserted;
+  EXPECT_EQ(region.width, 10);
+  EXPECT_EQ(region.height, 10);
+  EXPECT_EQ(region.left, 0);
+  EXPECT_EQ(region.top, -10);
+  EXPECT_EQ(atlas.size(), 1u);
+
+  const auto found = atlas.find("a", 10.0, 1.0);
+  ASSERT_NE(found, nullptr);
+  EXPECT_EQ(found->x, region.x);
+  EXPECT_EQ(found->y, region.y);
+  EXPECT_EQ(atlas.insert("a", 10.0, 1.0, makeSquare(0, 0, 10)), found);
+  EXPECT_EQ(atlas.size(), 1u);
+
+  // The stroke width and the scale are parts of the key.
+  EXPECT_EQ(atlas.find("b", 10.0, 1.0), nullptr);
+  EXPECT_EQ(atlas.find("a", 20.0, 1.0), nullptr);
+  EXPECT_EQ(atlas.find("a", 10.0, 2.0), nullptr);
+}
+
+TEST(GlyphAtlasTest, StoresRasterizedMask) {
+  shota::Shape2d shape;
+  shape.moveTo(-3.25, -2.5);
+  shape.lineTo(6.5, -2.5);
+  shape.quadraticTo(6.5, 8.0, -3.25, 8.0);
+  shape.close();
+  GlyphAtlas atlas(64, 64);
+  atlas.insert("a", 10.0, 1.0, makeSquare(0, 0, 5));
+  const auto inserted = atlas.insert("b", 10.0, 2.0, shape);
+  ASSERT_NE(inserted, nullptr);
+  const auto region = *inserted;
+  EXPECT_EQ(region.left, -7);
+  EXPECT_EQ(region.top, -16);
+  EXPECT_EQ(region.width, 20);
+  EXPECT_EQ(region.height, 21);
+
+  CoverageRasterizer rasterizer(region.width, region.height);
+  rasterizer.draw(shape, 2.0, shota::Vec2d(-region.left, -region.top));
+  EXPECT_EQ(extract(atlas, region), rasterizer.resolve());
+
+  // The mask inserted before is left as is.
+  const auto square = atlas.find("a", 10.0, 1.0);
+  ASSERT_NE(square, nullptr);
+  EXPECT_EQ(extract(atlas, *square), std::vector<std::uint8_t>(5 * 5, 255));
+}
+
+TEST(GlyphAtlasTest, StartsOverWhenFull) {
+  // Each mask takes 8 by 8 pixels with its padding, and 4 of them fill the
+  // atlas.
+  GlyphAtlas atlas(16, 16);
+  for (int i{}; i < 4; ++i) {
+    ASSERT_NE(atlas.insert(std::to_string(i), 1.0, 1.0, makeSquare(0, 0, 7)),
+              nullptr);
+  }
+  EXPECT_EQ(atlas.size(), 4u);
+  EXPECT_EQ(atlas.generation(), 0u);
+  const auto inserted = atlas.insert("4", 1.0, 1.0, makeSquare(0, 0, 7));
+  ASSERT_NE(inserted, nullptr);
+  const auto region = *inserted;
+  EXPECT_EQ(atlas.generation(), 1u);
+  EXPECT_EQ(region.x, 0);
+  EXPECT_EQ(region.y, 0);
+  EXPECT_EQ(atlas.size(), 1u);
+  for (int i{}; i < 4; ++i) {
+    EXPECT_EQ(atlas.find(std::to_string(i), 1.0, 1.0), nullptr);
+  }
+  EXPECT_EQ(extract(atlas, region), std::vector<std::uint8_t>(7 * 7, 255));
+
+  // Pixels of the masks that were removed are cleared.
+  int covered{};
+  for (int i{}; i < atlas.width() * atlas.height(); ++i) {
+    covered += atlas.data()[i] != 0;
+  }
+  EXPECT_EQ(covered, 7 * 7);
+}
+
+TEST(GlyphAtlasTest, ReinsertsAfterClear) {
+  GlyphAtlas atlas(32, 32);
+  atlas.insert("a", 1.0, 1.0, makeSquare(0, 0, 4));
+  atlas.insert("b", 1.0, 1.0, makeSquare(0, 0, 6));
+  const auto generation = atlas.generation();
+  atlas.clear();
+  EXPECT_TRUE(atlas.empty());
+  EXPECT_EQ(atlas.generation(), generation + 1);
+  EXPECT_EQ(atlas.find("a", 1.0, 1.0), nullptr);
+  EXPECT_EQ(atlas.find("b", 1.0, 1.0), nullptr);
+  for (int i{}; i < atlas.width() * atlas.height(); ++i) {
+    ASSERT_EQ(atlas.data()[i], 0);
+  }
+
+  const auto inserted = atlas.insert("b", 1.0, 1.0, makeSquare(0, 0, 6));
+  ASSERT_NE(inserted, nullptr);
+  EXPECT_EQ(inserted->x, 0);
+  EXPECT_EQ(inserted->y, 0);
+  EXPECT_EQ(atlas.find("b", 1.0, 1.0), inserted);
+  EXPECT_EQ(extract(atlas, *inserted), std::vector<std::uint8_t>(6 * 6, 255));
+}
+
+TEST(GlyphAtlasTest, RejectsMaskLargerThanAtlas) {
+  GlyphAtlas atlas(16, 16);
+  atlas.insert("a", 1.0, 1.0, makeSquare(0, 0, 4));
+  EXPECT_EQ(atlas.insert("b", 1.0, 1.0, makeSquare(0, 0, 16)), nullptr);
+  EXPECT_EQ(atlas.find("b", 1.0, 1.0), nullptr);
+  EXPECT_NE(atlas.find("a", 1.0, 1.0), nullptr);
+  EXPECT_EQ(atlas.size(), 1u);
+}
+
+TEST(GlyphAtlasTest, StoresEmptyShape) {
+  GlyphAtlas atlas(16, 16);
+  const auto inserted = atlas.insert("space", 1.0, 1.0, shota::Shape2d());
+  ASSERT_NE(inserted, nullptr);
+  EXPECT_TRUE(inserted->empty());
+  const auto found = atlas.find("space", 1.0, 1.0);
+  ASSERT_NE(found, nullptr);
+  EXPECT_TRUE(found->empty());
+
+  // A shape without area is empty as well, and takes no space.
+  shota::Shape2d line;
+  line.moveTo(0, 0);
+  line.lineTo(10, 0);
+  const auto flat = atlas.insert("line", 1.0, 1.0, line);
+  ASSERT_NE(flat, nullptr);
+  EXPECT_TRUE(flat->empty());
+  const auto square = atlas.insert("a", 1.0, 1.0, makeSquare(0, 0, 4));
+  ASSERT_NE(square, nullptr);
+  EXPECT_EQ(square->x, 0);
+  EXPECT_EQ(square->y, 0);
+  EXPECT_EQ(atlas.size(), 3u);
+}
+
+}  // namespace token
@@ -0,0 +1,250 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/kerning_compiler.h"
+#include "token/sfnt/layout.h"
+#include "token/sfnt/reader.h"
+#include "token/ufo/groups.h"
+#include "token/ufo/kerning.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+// The glyphs of the coverage table in the order of their coverage indices
+std::vector<std::uint16_t> decodeCoverage(const std::string& data,
+                                          std::size_t offset) {
+  Reader reader(data);
+  reader.seek(offset);
+  std::vector<std::uint16_t> result;
+  const auto format = reader.uint16();
+  const auto count = reader.uint16();
+  for (std::size_t i{}; i < count; ++i) {
+    if (format == 1) {
+      result.emplace_back(reader.uint16());
+    } else {
+      const auto first = reader.uint16();
+      const auto last = reader.uint16();
+      EXPECT_EQ(reader.uint16(), result.size());
+      for (auto glyph = first; glyph <= last; ++glyph) {
+        result.emplace_back(glyph);
+      }
+    }
+  }
+  EXPECT_TRUE(reader.good());
+  return result;
+}
+
+std::map<std::uint16_t, std::uint16_t> decodeClassDef(const std::string& data,
+                                                      std::size_t offset) {
+  Reader reader(data);
+  reader.seek(offset);
+  std::map<std::uint16_t, std::uint16_t> result;
+  if (reader.uint16() == 1) {
+    const auto first = reader.uint16();
+    const auto count = reader.uint16();
+    for (std::size_t i{}; i < count; ++i) {
+      result[static_cast<std::uint16_t>(first + i)] = reader.uint16();
+    }
+  } else {
+    const auto count = reader.uint16();
+    for (std::size_t i{}; i < count; ++i) {
+      const auto first = reader.uint16();
+      const auto last = reader.uint16();
+      const auto value = reader.uint16();
+      for (auto glyph = first; glyph <= last; ++glyph) {
+        result[glyph] = value;
+      }
+    }
+  }
+  EXPECT_TRUE(reader.good());
+  return result;
+}
+
+// The adjustment of the advance of the first glyph, which the first subtable
+// that has the pair determines as shaping engines do. Glyph pairs apply only
+// to the second glyphs in their pair sets, whereas class pairs apply to every
+// glyph after the first glyphs they cover.
+int kern(const Lookup& lookup, std::uint16_t first, std::uint16_t second) {
+  for (const auto& subtable : lookup.subtables) {
+    Reader reader(subtable);
+    const auto format = reader.uint16();
+    const auto coverage = decodeCoverage(subtable, reader.uint16());
+    EXPECT_EQ(reader.uint16(), 0x0004);
+    EXPECT_EQ(reader.uint16(), 0);
+    const auto index = std::find(coverage.begin(), coverage.end(), first);
+    if (index == coverage.end()) {
+      continue;
+    }
+    if (format == 1) {
+      const auto count = reader.uint16();
+      EXPECT_EQ(count, coverage.size());
+      reader.skip(2 * (index - coverage.begin()));
+      reader.seek(reader.uint16());
+      const auto pairs = reader.uint16();
+      for (std::size_t i{}; i < pairs; ++i) {
+        const auto glyph = reader.uint16();
+        const auto value = reader.int16();
+        if (glyph == second) {
+          EXPECT_TRUE(reader.good());
+          return value;
+        }
+      }
+    } else {
+      EXPECT_EQ(format, 2);
+      const auto first_classes = decodeClassDef(subtable, reader.uint16());
+      const auto second_classes = decodeClassDef(subtable, reader.uint16());
+      reader.skip(2);
+      const auto columns = reader.uint16();
+      const auto row = first_classes.find(first);
+      const auto column = second_classes.find(second);
+      reader.skip(2 * ((row == first_classes.end() ? 0 : row->second) *
+                       columns +
+                       (column == second_classes.end() ? 0 : column->second)));
+      const auto value = reader.int16();
+      EXPECT_TRUE(reader.good());
+      return value;
+    }
+  }
+  return 0;
+}
+
+const std::vector<std::string> kGlyphOrder{
+  ".notdef", "A", "V", "T", "o", "e", "a", "period",
+};
+
+enum Glyph : std::uint16_t { NOTDEF, A, V, T, O, E, LOWER_A, PERIOD };
+
+KerningCompiler makeCompiler() {
+  ufo::Groups groups;
+  groups.set("public.kern1.round", {"o", "e"});
+  groups.set("public.kern1.e", {"e"});
+  groups.set("public.kern2.round", {"o", "e", "a", "missing"});
+  groups.set("@MMK_L_V", {"V"});
+  groups.set("@MMK_R_period", {"period"});
+  ufo::Kerning kerning;
+  kerning.set("A", "V", -70.4);
+  kerning.set("T", "public.kern2.round", -80.0);
+  kerning.set("T", "a", -60.0);
+  kerning.set("public.kern1.round", "V", -30.0);
+  kerning.set("public.kern1.round", "@MMK_R_period", -15.0);
+  kerning.set("public.kern1.e", "@MMK_R_period", -5.0);
+  kerning.set("@MMK_L_V", "public.kern2.round", -50.0);
+  kerning.set("@MMK_L_V", "@MMK_R_period", -100.0);
+  kerning.set("V", "o", -45.0);
+  kerning.set("V", "e", 0.0);
+  kerning.set("missing", "V", -20.0);
+  return KerningCompiler(kerning, groups);
+}
+
+}  // namespace
+
+TEST(KerningCompilerTest, ResolvesPairsByPrecedence) {
+  const auto lookup = makeCompiler().lookup(kGlyphOrder);
+  EXPECT_EQ(lookup.type, 2);
+  ASSERT_EQ(lookup.subtables.size(), 2u);
+
+  // Glyph and glyph, rounded
+  EXPECT_EQ(kern(lookup, A, V), -70);
+  // Glyph and group, whose members missing from the glyph order are skipped
+  EXPECT_EQ(kern(lookup, T, O), -80);
+  EXPECT_EQ(kern(lookup, T, E), -80);
+  // Glyph and glyph in place of glyph and group
+  EXPECT_EQ(kern(lookup, T, LOWER_A), -60);
+  // Group and glyph
+  EXPECT_EQ(kern(lookup, O, V), -30);
+  EXPECT_EQ(kern(lookup, E, V), -30);
+  // Group and group, in UFO 2 and UFO 3 groups
+  EXPECT_EQ(kern(lookup, V, PERIOD), -100);
+  EXPECT_EQ(kern(lookup, V, LOWER_A), -50);
+  // Glyph and glyph in place of group and group, including zero
+  EXPECT_EQ(kern(lookup, V, O), -45);
+  EXPECT_EQ(kern(lookup, V, E), 0);
+  // A glyph belongs to the first of the groups by name.
+  EXPECT_EQ(kern(lookup, O, PERIOD), -15);
+  EXPECT_EQ(kern(lookup, E, PERIOD), -5);
+  // Pairs without kerning
+  EXPECT_EQ(kern(lookup, A, O), 0);
+  EXPECT_EQ(kern(lookup, O, O), 0);
+  EXPECT_EQ(kern(lookup, V, A), 0);
+  EXPECT_EQ(kern(lookup, PERIOD, V), 0);
+}
+
+TEST(KerningCompilerTest, SplitsSubtables) {
+  const auto compiler = makeCompiler();
+  const auto expected = compiler.lookup(kGlyphOrder);
+  auto split = compiler;
+  split.set_max_subtable_size(48);
+  const auto lookup = split.lookup(kGlyphOrder);
+  EXPECT_GT(lookup.subtables.size(), expected.subtables.size());
+  for (const auto& subtable : lookup.subtables) {
+    EXPECT_LE(subtable.size(), 48u);
+  }
+  for (std::uint16_t first{}; first < kGlyphOrder.size(); ++first) {
+    for (std::uint16_t second{}; second < kGlyphOrder.size(); ++second) {
+      EXPECT_EQ(kern(lookup, first, second), kern(expected, first, second))
+          << kGlyphOrder[first] << " " << kGlyphOrder[second];
+    }
+  }
+}
+
+TEST(KerningCompilerTest, SplitsPairsBeyondOffsetLimit) {
+  // Glyph pairs of 4 bytes each exceed the 16-bit offsets of a subtable.
+  std::vector<std::string> glyph_order;
+  for (int i{}; i < 300; ++i) {
+    glyph_order.emplace_back("glyph" + std::to_string(i));
+  }
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> distribution(-200, 200);
+  ufo::Kerning kerning;
+  std::map<std::pair<std::uint16_t, std::uint16_t>, int> expected;
+  for (std::uint16_t first{}; first < 300; ++first) {
+    for (std::uint16_t second{}; second < 60; ++second) {
+      const auto value = distribution(random);
+      kerning.set(glyph_order[first], glyph_order[second * 5], value);
+      expected[std::make_pair(first, second * 5)] = value;
+    }
+  }
+  const KerningCompiler compiler(kerning, ufo::Groups());
+  const auto lookup = compiler.lookup(glyph_order);
+  EXPECT_GT(lookup.subtables.size(), 1u);
+  for (const auto& subtable : lookup.subtables) {
+    EXPECT_LE(subtable.size(), 0xffffu);
+  }
+  for (const auto& pair : expected) {
+    ASSERT_EQ(kern(lookup, pair.first.first, pair.first.second), pair.second)
+        << pair.first.first << " " << pair.first.second;
+  }
+}
+
+TEST(KerningCompilerTest, WritesFeatures) {
+  const auto features = makeCompiler().features(kGlyphOrder);
+  EXPECT_NE(features.find("pos A V -70;\n"), std::string::npos);
+  EXPECT_NE(features.find("pos T o -80;\n"), std::string::npos);
+  EXPECT_NE(features.find("pos T a -60;\n"), std::string::npos);
+  EXPECT_NE(features.find("pos V e 0;\n"), std::string::npos);
+  EXPECT_NE(features.find("@MMK_L_V = [V];\n"), std::string::npos);
+  EXPECT_NE(features.find("@public.kern1.e = [e];\n"), std::string::npos);
+  EXPECT_NE(features.find("@public.kern1.round = [o];\n"), std::string::npos);
+  EXPECT_NE(features.find("pos @MMK_L_V @MMK_R_period -100;\n"),
+            std::string::npos);
+  // Glyph pairs precede class pairs.
+  EXPECT_LT(features.rfind("pos V e"), features.find("pos @"));
+  EXPECT_EQ(features.find("subtable;"), std::string::npos);
+  EXPECT_EQ(features.find("missing"), std::string::npos);
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,220 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "token/sfnt/layout.h"
+#include "token/sfnt/mark_compiler.h"
+#include "token/sfnt/reader.h"
+#include "token/ufo/glif/anchor.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+using Offset = std::pair<int, int>;
+
+// The glyphs of the coverage table in the order of their coverage indices
+std::vector<std::uint16_t> decodeCoverage(const std::string& data,
+                                          std::size_t offset) {
+  Reader reader(data);
+  reader.seek(offset);
+  std::vector<std::uint16_t> result;
+  const auto format = reader.uint16();
+  const auto count = reader.uint16();
+  for (std::size_t i{}; i < count; ++i) {
+    if (format == 1) {
+      result.emplace_back(reader.uint16());
+    } else {
+      const auto first = reader.uint16();
+      const auto last = reader.uint16();
+      EXPECT_EQ(reader.uint16(), result.size());
+      for (auto glyph = first; glyph <= last; ++glyph) {
+        result.emplace_back(glyph);
+      }
+    }
+  }
+  EXPECT_TRUE(reader.good());
+  return result;
+}
+
+Offset decodeAnchor(const std::string& data, std::size_t offset) {
+  Reader reader(data);
+  reader.seek(offset);
+  EXPECT_EQ(reader.uint16(), 1);
+  const int x = reader.int16();
+  const int y = reader.int16();
+  EXPECT_TRUE(reader.good());
+  return Offset(x, y);
+}
+
+// The offset of the mark from the base, which the first subtable that covers
+// both of them determines as shaping engines do.
+bool attach(const Lookup& lookup,
+            std::uint16_t mark,
+            std::uint16_t base,
+            Offset *offset) {
+  for (const auto& subtable : lookup.subtables) {
+    Reader reader(subtable);
+    EXPECT_EQ(reader.uint16(), 1);
+    const auto marks = decodeCoverage(subtable, reader.uint16());
+    const auto bases = decodeCoverage(subtable, reader.uint16());
+    const auto class_count = reader.uint16();
+    const auto mark_array = reader.uint16();
+    const auto base_array = reader.uint16();
+    const auto mark_index = std::find(marks.begin(), marks.end(), mark);
+    const auto base_index = std::find(bases.begin(), bases.end(), base);
+    if (mark_index == marks.end() || base_index == bases.end()) {
+      continue;
+    }
+    reader.seek(mark_array);
+    EXPECT_EQ(reader.uint16(), marks.size());
+    reader.skip(4 * (mark_index - marks.begin()));
+    const auto mark_class = reader.uint16();
+    const auto mark_anchor = decodeAnchor(
+        subtable, mark_array + reader.uint16());
+    reader.seek(base_array);
+    EXPECT_EQ(reader.uint16(), bases.size());
+    reader.skip(2 * ((base_index - bases.begin()) * class_count +
+                     mark_class));
+    const auto base_anchor = decodeAnchor(
+        subtable, base_array + reader.uint16());
+    EXPECT_TRUE(reader.good());
+    *offset = Offset(base_anchor.first - mark_anchor.first,
+                     base_anchor.second - mark_anchor.second);
+    return true;
+  }
+  return false;
+}
+
+ufo::glif::Anchor anchor(double x, double y, const std::string& name) {
+  return ufo::glif::Anchor(x, y, name, std::string(), std::string());
+}
+
+const std::vector<std::string> kGlyphOrder{
+  ".notdef", "a", "o", "acutecomb", "gravecomb", "dotbelowcomb", "f",
+};
+
+enum Glyph : std::uint16_t {
+  NOTDEF, A, O, ACUTECOMB, GRAVECOMB, DOTBELOWCOMB, F,
+};
+
+MarkCompiler makeCompiler() {
+  MarkCompiler compiler;
+  compiler.add("a", {
+    anchor(250.0, 500.4, "top"),
+    anchor(250.0, 0.0, "bottom"),
+    anchor(999.0, 999.0, "top"),
+  });
+  compiler.add("o", {anchor(260.0, 510.0, "top")});
+  compiler.add("acutecomb", {
+    anchor(100.0, 700.0, "top"),
+    anchor(100.0, 480.0, "_top"),
+  });
+  compiler.add("gravecomb", {anchor(90.0, 480.0, "_top")});
+  compiler.add("dotbelowcomb", {anchor(50.0, -9.6, "_bottom")});
+  compiler.add("f", {});
+  compiler.add("missing", {anchor(0.0, 0.0, "_top")});
+  return compiler;
+}
+
+}  // namespace
+
+TEST(MarkCompilerTest, AttachesMarksToBases) {
+  const auto lookup = makeCompiler().markToBase(kGlyphOrder);
+  EXPECT_EQ(lookup.type, 4);
+  // Each mark class has its own subtable.
+  ASSERT_EQ(lookup.subtables.size(), 2u);
+
+  Offset offset;
+  ASSERT_TRUE(attach(lookup, ACUTECOMB, A, &offset));
+  EXPECT_EQ(offset, Offset(150, 20));
+  ASSERT_TRUE(attach(lookup, GRAVECOMB, A, &offset));
+  EXPECT_EQ(offset, Offset(160, 20));
+  ASSERT_TRUE(attach(lookup, ACUTECOMB, O, &offset));
+  EXPECT_EQ(offset, Offset(160, 30));
+  ASSERT_TRUE(attach(lookup, DOTBELOWCOMB, A, &offset));
+  EXPECT_EQ(offset, Offset(200, 10));
+
+  // Marks aren't bases in mark-to-base attachment.
+  EXPECT_FALSE(attach(lookup, DOTBELOWCOMB, O, &offset));
+  EXPECT_FALSE(attach(lookup, GRAVECOMB, ACUTECOMB, &offset));
+  EXPECT_FALSE(attach(lookup, ACUTECOMB, F, &offset));
+  EXPECT_FALSE(attach(lookup, A, O, &offset));
+}
+
+TEST(MarkCompilerTest, AttachesMarksToMarks) {
+  const auto lookup = makeCompiler().markToMark(kGlyphOrder);
+  EXPECT_EQ(lookup.type, 6);
+  ASSERT_EQ(lookup.subtables.size(), 1u);
+
+  Offset offset;
+  ASSERT_TRUE(attach(lookup, GRAVECOMB, ACUTECOMB, &offset));
+  EXPECT_EQ(offset, Offset(10, 220));
+  EXPECT_FALSE(attach(lookup, ACUTECOMB, A, &offset));
+  EXPECT_FALSE(attach(lookup, DOTBELOWCOMB, ACUTECOMB, &offset));
+}
+
+TEST(MarkCompilerTest, ClassifiesGlyphs) {
+  const auto definitions = makeCompiler().definitions(kGlyphOrder);
+  Reader reader(definitions);
+  EXPECT_EQ(reader.uint32(), 0x00010000u);
+  const auto class_def = reader.uint16();
+  EXPECT_EQ(reader.uint16(), 0);
+  EXPECT_EQ(reader.uint16(), 0);
+  EXPECT_EQ(reader.uint16(), 0);
+  EXPECT_EQ(class_def, reader.position());
+
+  // Glyph classes are in format 1 for consecutive glyphs.
+  EXPECT_EQ(reader.uint16(), 1);
+  EXPECT_EQ(reader.uint16(), A);
+  std::vector<std::uint16_t> classes;
+  for (auto count = reader.uint16(); count; --count) {
+    classes.emplace_back(reader.uint16());
+  }
+  EXPECT_TRUE(reader.good());
+  EXPECT_EQ(reader.position(), definitions.size());
+  EXPECT_EQ(classes, (std::vector<std::uint16_t>{1, 1, 3, 3, 3}));
+}
+
+TEST(MarkCompilerTest, CompilesNothingWithoutMarks) {
+  MarkCompiler compiler;
+  EXPECT_TRUE(compiler.empty());
+  compiler.add("a", {anchor(250.0, 500.0, "top")});
+  compiler.add("o", {});
+  EXPECT_FALSE(compiler.empty());
+  EXPECT_TRUE(compiler.markToBase(kGlyphOrder).subtables.empty());
+  EXPECT_TRUE(compiler.markToMark(kGlyphOrder).subtables.empty());
+  EXPECT_TRUE(compiler.definitions(kGlyphOrder).empty());
+  EXPECT_TRUE(compiler.features(kGlyphOrder).empty());
+}
+
+TEST(MarkCompilerTest, WritesFeatures) {
+  const auto features = makeCompiler().features(kGlyphOrder);
+  EXPECT_NE(features.find("markClass acutecomb <anchor 100 480> @MC_top;\n"),
+            std::string::npos);
+  EXPECT_NE(features.find("markClass dotbelowcomb <anchor 50 -10> "
+                          "@MC_bottom;\n"), std::string::npos);
+  EXPECT_NE(features.find("feature mark {\n"), std::string::npos);
+  EXPECT_NE(features.find("pos base a <anchor 250 500> mark @MC_top;\n"),
+            std::string::npos);
+  EXPECT_NE(features.find("feature mkmk {\n"), std::string::npos);
+  EXPECT_NE(features.find("pos mark acutecomb <anchor 100 700> "
+                          "mark @MC_top;\n"), std::string::npos);
+  EXPECT_EQ(features.find("999"), std::string::npos);
+  EXPECT_EQ(features.find("missing"), std::string::npos);
+  // Mark classes precede the features that refer to them.
+  EXPECT_LT(features.rfind("markClass"), features.find("feature"));
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,201 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <zlib.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "token/sfnt/font.h"
+#include "token/sfnt/reader.h"
+#include "token/sfnt/woff_encoder.h"
+#include "token/thread_pool.h"
+#include "token/ufo/font_info.h"
+
+namespace token {
+namespace sfnt {
+
+namespace {
+
+std::string uncompress(const std::string& data, std::size_t size) {
+  std::string result(size, '\0');
+  auto length = static_cast<uLongf>(size);
+  EXPECT_EQ(::uncompress(reinterpret_cast<Bytef *>(&result[0]), &length,
+                         reinterpret_cast<const Bytef *>(data.data()),
+                         static_cast<uLong>(data.size())), Z_OK);
+  EXPECT_EQ(length, size);
+  return result;
+}
+
+std::string randomBytes(std::size_t size) {
+  std::mt19937 random(1);
+  std::uniform_int_distribution<int> distribution(0, 255);
+  std::string result;
+  for (std::size_t i{}; i < size; ++i) {
+    result.push_back(static_cast<char>(distribution(random)));
+  }
+  return result;
+}
+
+// A font of a compressible head with a nonzero checksum adjustment, a CFF
+// that doesn't get smaller, and a name whose size isn't a multiple of 4.
+Font makeFont() {
+  std::string head(54, '\0');
+  head[0] = 0x01;
+  head[8] = 0x12;
+  head[11] = 0x34;
+  head[18] = 0x03;
+  head[19] = static_cast<char>(0xe8);
+  Font font;
+  font.set("head", head);
+  font.set("CFF ", randomBytes(37));
+  font.set("name", std::string(1001, 'a'));
+  return font;
+}
+
+}  // namespace
+
+TEST(WOFFEncoderTest, EncodesHeaderAndTables) {
+  const auto font = makeFont();
+  Font source;
+  ASSERT_TRUE(source.decode(font.encode()));
+  WOFFEncoder encoder;
+  encoder.set_major_version(2);
+  encoder.set_minor_version(3);
+  const auto woff = encoder.encode(font);
+
+  Reader reader(woff);
+  EXPECT_EQ(reader.tag(), "wOFF");
+  EXPECT_EQ(reader.tag(), "OTTO");
+  EXPECT_EQ(reader.uint32(), woff.size());
+  EXPECT_EQ(reader.uint16(), 3);
+  EXPECT_EQ(reader.uint16(), 0);
+  EXPECT_EQ(reader.uint32(), font.encode().size());
+  EXPECT_EQ(reader.uint16(), 2);
+  EXPECT_EQ(reader.uint16(), 3);
+  for (int i{}; i < 5; ++i) {
+    EXPECT_EQ(reader.uint32(), 0u);
+  }
+  EXPECT_EQ(reader.position(), 44u);
+
+  // Tables are in the order of their tags, and the head table has the
+  // checksum adjustment of the font that decoders reconstruct.
+  std::size_t end = 44 + 3 * 20;
+  for (const auto& table : source.tables()) {
+    EXPECT_EQ(reader.tag(), table.first);
+    const auto offset = reader.uint32();
+    const auto compressed_size = reader.uint32();
+    const auto size = reader.uint32();
+    const auto checksum = reader.uint32();
+    EXPECT_EQ(offset, end);
+    EXPECT_EQ(size, table.second.size());
+    ASSERT_LE(offset + compressed_size, woff.size());
+    const auto data = woff.substr(offset, compressed_size);
+    if (compressed_size < size) {
+      EXPECT_EQ(uncompress(data, size), table.second) << table.first;
+    } else {
+      EXPECT_EQ(data, table.second) << table.first;
+    }
+    auto unadjusted = table.second;
+    if (table.first == "head") {
+      EXPECT_NE(unadjusted.substr(8, 4), std::string(4, '\0'));
+      unadjusted.replace(8, 4, 4, '\0');
+    }
+    EXPECT_EQ(checksum, Font::checksum(unadjusted)) << table.first;
+    end = (offset + compressed_size + 3) & ~static_cast<std::size_t>(3);
+  }
+  EXPECT_TRUE(reader.good());
+  EXPECT_EQ(end, woff.size());
+
+  // Only the CFF doesn't get smaller.
+  Reader directory(woff);
+  directory.seek(44);
+  for (const auto& table : source.tables()) {
+    directory.skip(8);
+    const auto compressed_size = directory.uint32();
+    const auto size = directory.uint32();
+    directory.skip(4);
+    EXPECT_EQ(compressed_size == size, table.first == "CFF ") << table.first;
+  }
+}
+
+TEST(WOFFEncoderTest, EncodesMetadataAndPrivateData) {
+  const std::string metadata =
+      "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+      "<metadata version=\"1.0\">\n"
+      "  <uniqueid id=\"com.example.token\"/>\n"
+      "</metadata>\n";
+  const std::string private_data = "private";
+  Font font;
+  font.set("name", std::string(1001, 'a'));
+  WOFFEncoder encoder;
+  encoder.set_metadata(metadata);
+  encoder.set_private_data(private_data);
+  const auto woff = encoder.encode(font);
+
+  Reader reader(woff);
+  EXPECT_EQ(reader.tag(), "wOFF");
+  EXPECT_EQ(reader.uint32(), 0x00010000u);
+  EXPECT_EQ(reader.uint32(), woff.size());
+  reader.seek(24);
+  const auto metadata_offset = reader.uint32();
+  const auto metadata_size = reader.uint32();
+  EXPECT_EQ(reader.uint32(), metadata.size());
+  const auto private_offset = reader.uint32();
+  EXPECT_EQ(reader.uint32(), private_data.size());
+  reader.skip(4);
+  const auto table_offset = reader.uint32();
+  const auto table_size = reader.uint32();
+  EXPECT_TRUE(reader.good());
+
+  // Metadata follows the last table, and private data begins on a 4-byte
+  // boundary at the end.
+  EXPECT_EQ(metadata_offset,
+            (table_offset + table_size + 3) & ~std::uint32_t(3));
+  EXPECT_EQ(uncompress(woff.substr(metadata_offset, metadata_size),
+                       metadata.size()), metadata);
+  EXPECT_EQ(private_offset,
+            (metadata_offset + metadata_size + 3) & ~std::uint32_t(3));
+  EXPECT_EQ(private_offset + private_data.size(), woff.size());
+  EXPECT_EQ(woff.substr(private_offset), private_data);
+}
+
+TEST(WOFFEncoderTest, EncodesSameInThreadPool) {
+  const auto font = makeFont();
+  ThreadPool pool(2);
+  WOFFEncoder encoder;
+  EXPECT_EQ(encoder.encode(font, &pool), encoder.encode(font));
+}
+
+TEST(WOFFEncoderTest, ReadsFontInfo) {
+  ufo::FontInfo font_info;
+  font_info.version_major = 1;
+  font_info.version_minor = 5u;
+  font_info.woff_minor_version = 7u;
+  EXPECT_TRUE(WOFFEncoder::metadata(font_info).empty());
+
+  ufo::woff::metadata::UniqueID unique_id;
+  unique_id.identifier = "com.example.token";
+  font_info.woff_metadata_unique_id = unique_id;
+  ufo::woff::metadata::Vendor vendor;
+  vendor.name = "Example & Co.";
+  vendor.url = "https://example.com";
+  font_info.woff_metadata_vendor = vendor;
+  const WOFFEncoder encoder(font_info);
+  EXPECT_EQ(encoder.major_version(), 1);
+  EXPECT_EQ(encoder.minor_version(), 7);
+  EXPECT_EQ(encoder.metadata(),
+            "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+            "<metadata version=\"1.0\">\n"
+            "  <uniqueid id=\"com.example.token\"/>\n"
+            "  <vendor name=\"Example &amp; Co.\" "
+            "url=\"https://example.com\"/>\n"
+            "</metadata>\n");
+}
+
+}  // namespace sfnt
+}  // namespace token
@@ -0,0 +1,196 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "token/ufo/optional.h"
+#include "token/ufo/plist_reader.h"
+
+namespace token {
+namespace ufo {
+namespace plist {
+
+namespace {
+
+const std::string kPropertyList =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" "
+    "\"http://www.apple.com/DTDs/PropertyList-1.0.dtd\">\n"
+    "<plist version=\"1.0\">\n"
+    "  <dict>\n"
+    "    <key>familyName</key>\n"
+    "    <string>Token &amp; Co.</string>\n"
+    "    <key>unitsPerEm</key>\n"
+    "    <integer>1000</integer>\n"
+    "    <key>italicAngle</key>\n"
+    "    <real>-12.5</real>\n"
+    "    <key>postscriptIsFixedPitch</key>\n"
+    "    <true/>\n"
+    "    <key>stems</key>\n"
+    "    <array>\n"
+    "      <integer>40</integer>\n"
+    "      <real>52.5</real>\n"
+    "      <string>ignored</string>\n"
+    "    </array>\n"
+    "    <key>nested</key>\n"
+    "    <dict>\n"
+    "      <key>name</key>\n"
+    "      <string>inner</string>\n"
+    "      <key>value</key>\n"
+    "      <integer>-3</integer>\n"
+    "    </dict>\n"
+    "    <key>note</key>\n"
+    "    <string></string>\n"
+    "  </dict>\n"
+    "</plist>\n";
+
+struct Nested final {
+  Nested() = default;
+  explicit Nested(const Value& value);
+
+  std::string name;
+  int value;
+};
+
+struct Object final {
+  std::string family_name;
+  unsigned int units_per_em;
+  double italic_angle;
+  bool fixed_pitch;
+  std::vector<double> stems;
+  Optional<Nested> nested;
+  Optional<std::string> note;
+  Optional<double> missing;
+};
+
+Nested::Nested(const Value& value) : Nested() {
+  read(value, std::make_tuple(
+      bind("name", &Nested::name),
+      bind("value", &Nested::value)), this);
+}
+
+}  // namespace
+
+TEST(PlistReaderTest, ReadsValues) {
+  const Document document(kPropertyList.data(), kPropertyList.size());
+  const auto root = document.root();
+  ASSERT_EQ(root.type(), Value::Type::DICTIONARY);
+  EXPECT_EQ(root["familyName"].type(), Value::Type::STRING);
+  EXPECT_EQ(root["familyName"].string(), "Token & Co.");
+  EXPECT_TRUE(root["familyName"].equals("Token & Co."));
+  EXPECT_FALSE(root["familyName"].equals("Token &amp; Co."));
+  EXPECT_EQ(root["unitsPerEm"].type(), Value::Type::INTEGER);
+  EXPECT_EQ(root["unitsPerEm"].integer(), 1000);
+  EXPECT_EQ(root["unitsPerEm"].real(), 1000.0);
+  EXPECT_EQ(root["italicAngle"].type(), Value::Type::REAL);
+  EXPECT_EQ(root["italicAngle"].real(), -12.5);
+  EXPECT_EQ(root["italicAngle"].integer(), -12);
+  EXPECT_EQ(root["postscriptIsFixedPitch"].type(), Value::Type::BOOLEAN);
+  EXPECT_TRUE(root["postscriptIsFixedPitch"].boolean());
+  EXPECT_EQ(root["nested"]["value"].integer(), -3);
+
+  // Values of other types read as zero or empty.
+  EXPECT_EQ(root["familyName"].integer(), 0);
+  EXPECT_EQ(root["unitsPerEm"].string(), "");
+  EXPECT_FALSE(root["unitsPerEm"].boolean());
+
+  // Missing values don't exist, including the values in them.
+  EXPECT_FALSE(root["missing"].exists());
+  EXPECT_EQ(root["missing"].type(), Value::Type::UNDEFINED);
+  EXPECT_FALSE(root["missing"]["deeper"].exists());
+  EXPECT_FALSE(root["familyName"]["key"].exists());
+}
+
+TEST(PlistReaderTest, IteratesEntriesAndItems) {
+  const Document document(kPropertyList.data(), kPropertyList.size());
+  const auto root = document.root();
+  std::vector<std::string> keys;
+  root.forEachEntry([&keys](const Value& key, const Value& value) {
+    keys.emplace_back(key.string());
+  });
+  EXPECT_EQ(keys, (std::vector<std::string>{
+      "familyName", "unitsPerEm", "italicAngle", "postscriptIsFixedPitch",
+      "stems", "nested", "note"}));
+
+  std::vector<Value::Type> types;
+  root["stems"].forEachItem([&types](const Value& item) {
+    types.emplace_back(item.type());
+  });
+  EXPECT_EQ(types, (std::vector<Value::Type>{
+      Value::Type::INTEGER, Value::Type::REAL, Value::Type::STRING}));
+
+  // Dictionaries have no items, and arrays no entries.
+  int count{};
+  root.forEachItem([&count](const Value&) { ++count; });
+  root["stems"].forEachEntry([&count](const Value&, const Value&) {
+    ++count;
+  });
+  EXPECT_EQ(count, 0);
+}
+
+TEST(PlistReaderTest, ReadsBindings) {
+  const Document document(kPropertyList.data(), kPropertyList.size());
+  Object object{};
+  object.missing = 1.0;
+  read(document.root(), std::make_tuple(
+      bind("familyName", &Object::family_name),
+      bind("unitsPerEm", &Object::units_per_em),
+      bind("italicAngle", &Object::italic_angle),
+      bind("postscriptIsFixedPitch", &Object::fixed_pitch),
+      bind("stems", &Object::stems),
+      bind("nested", &Object::nested),
+      bind("note", &Object::note),
+      bind("missing", &Object::missing)), &object);
+  EXPECT_EQ(object.family_name, "Token & Co.");
+  EXPECT_EQ(object.units_per_em, 1000u);
+  EXPECT_EQ(object.italic_angle, -12.5);
+  EXPECT_TRUE(object.fixed_pitch);
+  // Items of other types are skipped.
+  EXPECT_EQ(object.stems, (std::vector<double>{40.0, 52.5}));
+  ASSERT_TRUE(object.nested.exists());
+  EXPECT_EQ(object.nested->name, "inner");
+  EXPECT_EQ(object.nested->value, -3);
+  ASSERT_TRUE(object.note.exists());
+  EXPECT_EQ(*object.note, "");
+  // Members without entries are left as they are.
+  ASSERT_TRUE(object.missing.exists());
+  EXPECT_EQ(*object.missing, 1.0);
+}
+
+TEST(PlistReaderTest, LeavesMismatchedTypes) {
+  const Document document(kPropertyList.data(), kPropertyList.size());
+  const auto root = document.root();
+  std::string string = "unchanged";
+  EXPECT_FALSE(read(root["unitsPerEm"], &string));
+  EXPECT_EQ(string, "unchanged");
+  double number = 7.0;
+  EXPECT_FALSE(read(root["familyName"], &number));
+  EXPECT_EQ(number, 7.0);
+  bool boolean = false;
+  EXPECT_FALSE(read(root["missing"], &boolean));
+  EXPECT_FALSE(boolean);
+  std::vector<double> numbers{1.0};
+  EXPECT_FALSE(read(root["nested"], &numbers));
+  EXPECT_EQ(numbers, std::vector<double>{1.0});
+  Optional<Nested> nested;
+  EXPECT_FALSE(read(root["stems"], &nested));
+  EXPECT_FALSE(nested.exists());
+}
+
+TEST(PlistReaderTest, ReadsRootWithoutPlistElement) {
+  const std::string data = "<array><integer>1</integer></array>";
+  const Document document(data.data(), data.size());
+  EXPECT_EQ(document.root().type(), Value::Type::ARRAY);
+  std::vector<std::int64_t> values;
+  EXPECT_TRUE(read(document.root(), &values));
+  EXPECT_EQ(values, std::vector<std::int64_t>{1});
+}
+
+}  // namespace plist
+}  // namespace ufo
+}  // namespace token
@@ -0,0 +1,142 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+#include <boost/utility/string_ref.hpp>
+
+#include "token/ufo/xml_reader.h"
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+namespace {
+
+bool parse(const std::string& data) {
+  Document document;
+  return document.parse(data.data(), data.size());
+}
+
+std::vector<std::string> childNames(const Element& element) {
+  std::vector<std::string> result;
+  for (auto child = element.firstChild(); child;
+       child = child.nextSibling()) {
+    result.emplace_back(child.name().to_string());
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(XMLReaderTest, ReadsElementsAndAttributes) {
+  const std::string data =
+      "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+      "<!-- <comment/> -->\n"
+      "<glyph name=\"a\" format = '2'>\n"
+      "  <advance width=\"500\"/>\n"
+      "  <unicode hex=\"0061\"/>\n"
+      "  <outline>\n"
+      "    <contour><point x=\"1\" y=\"2\"/></contour>\n"
+      "    <contour/>\n"
+      "  </outline>\n"
+      "  <unicode hex=\"0041\"/>\n"
+      "</glyph>\n";
+  Document document(data.data(), data.size());
+  ASSERT_FALSE(document.empty());
+  const auto root = document.root();
+  ASSERT_TRUE(root);
+  EXPECT_EQ(root.name(), "glyph");
+  boost::string_ref value;
+  ASSERT_TRUE(root.attribute("name", &value));
+  EXPECT_EQ(value, "a");
+  ASSERT_TRUE(root.attribute("format", &value));
+  EXPECT_EQ(value, "2");
+  EXPECT_FALSE(root.attribute("missing", &value));
+  EXPECT_EQ(childNames(root), (std::vector<std::string>{
+      "advance", "unicode", "outline", "unicode"}));
+
+  // Children are found by their names in order.
+  auto unicode = root.firstChild("unicode");
+  ASSERT_TRUE(unicode);
+  ASSERT_TRUE(unicode.attribute("hex", &value));
+  EXPECT_EQ(value, "0061");
+  unicode = unicode.nextSibling("unicode");
+  ASSERT_TRUE(unicode);
+  ASSERT_TRUE(unicode.attribute("hex", &value));
+  EXPECT_EQ(value, "0041");
+  EXPECT_FALSE(unicode.nextSibling("unicode"));
+  EXPECT_FALSE(root.firstChild("image"));
+
+  const auto outline = root.firstChild("outline");
+  ASSERT_TRUE(outline);
+  EXPECT_EQ(childNames(outline),
+            (std::vector<std::string>{"contour", "contour"}));
+  const auto point = outline.firstChild().firstChild("point");
+  ASSERT_TRUE(point);
+  ASSERT_TRUE(point.attribute("y", &value));
+  EXPECT_EQ(value, "2");
+  EXPECT_FALSE(point.firstChild());
+  EXPECT_FALSE(outline.firstChild().nextSibling().firstChild());
+}
+
+TEST(XMLReaderTest, DecodesContents) {
+  const std::string data =
+      "<!DOCTYPE plist PUBLIC \"-//Apple//DTD PLIST 1.0//EN\" "
+      "\"http://www.apple.com/DTDs/PropertyList-1.0.dtd\" [<!ENTITY a 'b'>]>"
+      "<a title=\"&quot;x&quot; &amp; y\">"
+      "<b>1 &lt; 2 &amp;&amp; 3 &gt; 2</b>"
+      "<c>&#65;&#x42;&#xe9;&#x3042;&#x1F600;&apos;&unknown;</c>"
+      "<d><![CDATA[<raw> & text]]> after</d>"
+      "<e></e>"
+      "</a>";
+  Document document(data.data(), data.size());
+  const auto root = document.root();
+  ASSERT_TRUE(root);
+  std::string value;
+  ASSERT_TRUE(root.attribute("title", &value));
+  EXPECT_EQ(value, "\"x\" & y");
+  EXPECT_EQ(root.firstChild("b").text(), "1 < 2 && 3 > 2");
+  EXPECT_EQ(root.firstChild("b").content(), "1 &lt; 2 &amp;&amp; 3 &gt; 2");
+  EXPECT_EQ(root.firstChild("c").text(),
+            "AB\xc3\xa9\xe3\x81\x82\xf0\x9f\x98\x80'&unknown;");
+  EXPECT_EQ(root.firstChild("d").text(), "<raw> & text after");
+  EXPECT_EQ(root.firstChild("e").text(), "");
+}
+
+TEST(XMLReaderTest, RejectsMalformedDocuments) {
+  EXPECT_TRUE(parse("<a><b/></a>"));
+  EXPECT_FALSE(parse(""));
+  EXPECT_FALSE(parse("<?xml version=\"1.0\"?>"));
+  EXPECT_FALSE(parse("<a>"));
+  EXPECT_FALSE(parse("<a></b>"));
+  EXPECT_FALSE(parse("<a><b></a></b>"));
+  EXPECT_FALSE(parse("</a>"));
+  EXPECT_FALSE(parse("<a/><b/>"));
+  EXPECT_FALSE(parse("<a b=\"c/>"));
+  EXPECT_FALSE(parse("<a b=c/>"));
+  EXPECT_FALSE(parse("<a b/>"));
+  EXPECT_FALSE(parse("<a"));
+  EXPECT_FALSE(parse("<a><!-- </a>"));
+}
+
+TEST(XMLReaderTest, ReparsesIntoSameDocument) {
+  Document document;
+  const std::string first = "<a><b/><c/></a>";
+  ASSERT_TRUE(document.parse(first.data(), first.size()));
+  const std::string second = "<d x=\"1\"/>";
+  ASSERT_TRUE(document.parse(second.data(), second.size()));
+  const auto root = document.root();
+  EXPECT_EQ(root.name(), "d");
+  EXPECT_FALSE(root.firstChild());
+  boost::string_ref value;
+  EXPECT_TRUE(root.attribute("x", &value));
+  EXPECT_EQ(value, "1");
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token
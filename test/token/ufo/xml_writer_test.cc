@@ -0,0 +1,117 @@
+// The MIT License
+// Copyright (C) 2015-Present Shota Matsuda
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+#include <cstdlib>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "token/ufo/xml_writer.h"
+
+namespace token {
+namespace ufo {
+namespace xml {
+
+namespace {
+
+std::string format(double value) {
+  char buffer[32];
+  const auto size = xml::format(value, buffer);
+  return std::string(buffer, size);
+}
+
+}  // namespace
+
+TEST(XMLWriterTest, FormatsIntegers) {
+  EXPECT_EQ(format(0.0), "0");
+  EXPECT_EQ(format(-0.0), "0");
+  EXPECT_EQ(format(1.0), "1");
+  EXPECT_EQ(format(-250.0), "-250");
+  EXPECT_EQ(format(1000000.0), "1000000");
+  EXPECT_EQ(format(9007199254740991.0), "9007199254740991");
+  EXPECT_EQ(format(-9007199254740991.0), "-9007199254740991");
+}
+
+TEST(XMLWriterTest, FormatsShortestFractions) {
+  EXPECT_EQ(format(0.5), "0.5");
+  EXPECT_EQ(format(0.1), "0.1");
+  EXPECT_EQ(format(-12.25), "-12.25");
+  EXPECT_EQ(format(0.1 + 0.2), "0.30000000000000004");
+  EXPECT_EQ(format(1.0 / 3.0), "0.3333333333333333");
+}
+
+TEST(XMLWriterTest, FormatsWithoutExponents) {
+  EXPECT_EQ(format(0.0001), "0.0001");
+  EXPECT_EQ(format(1e-7), "0.0000001");
+  EXPECT_EQ(format(-2.5e-6), "-0.0000025");
+  EXPECT_EQ(format(1e20), "100000000000000000000");
+  EXPECT_EQ(format(1.5e17), "150000000000000000");
+}
+
+TEST(XMLWriterTest, FormatsValuesThatReadBack) {
+  std::mt19937 random(1);
+  std::uniform_real_distribution<double> distribution(-10000.0, 10000.0);
+  for (int i{}; i < 10000; ++i) {
+    const auto value = distribution(random);
+    const auto text = format(value);
+    EXPECT_EQ(std::strtod(text.c_str(), nullptr), value) << text;
+    EXPECT_EQ(text.find('e'), std::string::npos) << text;
+  }
+}
+
+TEST(XMLWriterTest, WritesIndentedElements) {
+  std::ostringstream stream;
+  {
+    Writer writer(&stream);
+    writer.declaration();
+    writer.open("glyph");
+    writer.attribute("name", "a&b");
+    writer.attribute("format", 2.0);
+    writer.open("advance");
+    writer.attribute("width", 500.5);
+    writer.attribute("height", 0.0, 0.0);
+    writer.close();
+    writer.open("note");
+    writer.text("x < \"y\"");
+    writer.close();
+    writer.open("outline");
+    writer.open("contour");
+    writer.element("point");
+    writer.close();
+    writer.close();
+    writer.element("string", "<b>");
+    writer.element("integer", -3.0);
+    writer.close();
+  }
+  EXPECT_EQ(stream.str(),
+            "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n"
+            "<glyph name=\"a&amp;b\" format=\"2\">\n"
+            "  <advance width=\"500.5\"/>\n"
+            "  <note>x &lt; \"y\"</note>\n"
+            "  <outline>\n"
+            "    <contour>\n"
+            "      <point/>\n"
+            "    </contour>\n"
+            "  </outline>\n"
+            "  <string>&lt;b&gt;</string>\n"
+            "  <integer>-3</integer>\n"
+            "</glyph>\n");
+}
+
+TEST(XMLWriterTest, EscapesQuotesInAttributes) {
+  std::ostringstream stream;
+  {
+    Writer writer(&stream);
+    writer.open("a");
+    writer.attribute("b", std::string("\"<>&'"));
+    writer.close();
+  }
+  EXPECT_EQ(stream.str(), "<a b=\"&quot;&lt;&gt;&amp;'\"/>\n");
+}
+
+}  // namespace xml
+}  // namespace ufo
+}  // namespace token